@@ -49,6 +49,8 @@ SOURCES += src/AbsoluteLayout.cpp \
     src/Game.cpp \
     src/Game.inl \
     src/Gamepad.cpp \
+    src/GLNull.cpp \
+    src/GLRecorder.cpp \
     src/HeightField.cpp \
     src/Image.cpp \
     src/Image.inl \
@@ -96,6 +98,7 @@ SOURCES += src/AbsoluteLayout.cpp \
     src/PhysicsVehicleWheel.cpp \
     src/Plane.cpp \
     src/Plane.inl \
+    src/Profiler.cpp \
     src/Platform.cpp \
     src/Properties.cpp \
     src/Quaternion.cpp \
@@ -117,8 +120,10 @@ SOURCES += src/AbsoluteLayout.cpp \
     src/Slider.cpp \
     src/Sprite.cpp \
     src/SpriteBatch.cpp \
+    src/StaticBatch.cpp \
     src/Technique.cpp \
     src/Terrain.cpp \
+    src/TerrainPager.cpp \
     src/TerrainPatch.cpp \
     src/Text.cpp \
     src/TextBox.cpp \
@@ -310,6 +315,8 @@ HEADERS += src/AbsoluteLayout.h \
     src/Gamepad.h \
     src/gameplay.h \
     src/Gesture.h \
+    src/GLNull.h \
+    src/GLRecorder.h \
     src/HeightField.h \
     src/Image.h \
     src/ImageControl.h \
@@ -348,6 +355,7 @@ HEADERS += src/AbsoluteLayout.h \
     src/PhysicsVehicle.h \
     src/PhysicsVehicleWheel.h \
     src/Plane.h \
+    src/Profiler.h \
     src/Platform.h \
     src/Properties.h \
     src/Quaternion.h \
@@ -366,9 +374,11 @@ HEADERS += src/AbsoluteLayout.h \
     src/Slider.h \
     src/Sprite.h \
     src/SpriteBatch.h \
+    src/StaticBatch.h \
     src/Stream.h \
     src/Technique.h \
     src/Terrain.h \
+    src/TerrainPager.h \
     src/TerrainPatch.h \
     src/Text.h \
     src/TextBox.h \
@@ -529,6 +539,7 @@ INCLUDEPATH += $$PWD/../external-deps/include
 
 # linux
 linux: SOURCES += src/PlatformLinux.cpp
+linux: SOURCES += src/PlatformHeadless.cpp
 linux: SOURCES += src/gameplay-main-linux.cpp
 linux: QMAKE_CXXFLAGS += -lstdc++ -pthread -w
 linux: DEFINES += GP_USE_GAMEPAD
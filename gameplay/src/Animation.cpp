@@ -39,6 +39,15 @@ Animation::Animation(const char* id)
 {
 }
 
+Animation::Animation(const char* id, AnimationTarget* target, int propertyId, Curve* curve, unsigned long duration)
+    : _controller(Game::getInstance()->getAnimationController()), _id(id), _duration(0L), _defaultClip(NULL), _clips(NULL)
+{
+    createChannel(target, propertyId, curve, duration);
+    // Release the animation because a newly created animation has a ref count of 1 and the channels hold the ref to animation.
+    release();
+    GP_ASSERT(getRefCount() == 1);
+}
+
 Animation::~Animation()
 {
     _channels.clear();
@@ -399,6 +408,17 @@ Animation::Channel* Animation::createChannel(AnimationTarget* target, int proper
     return channel;
 }
 
+Animation::Channel* Animation::createChannel(AnimationTarget* target, int propertyId, Curve* curve, unsigned long duration)
+{
+    GP_ASSERT(target);
+    GP_ASSERT(curve);
+    GP_ASSERT(curve->getComponentCount() == target->getAnimationPropertyComponentCount(propertyId));
+
+    Channel* channel = new Channel(this, target, propertyId, curve, duration);
+    addChannel(channel);
+    return channel;
+}
+
 void Animation::addChannel(Channel* channel)
 {
     GP_ASSERT(channel);
@@ -162,6 +162,11 @@ private:
      */
     Animation(const char* id);
 
+    /**
+     * Constructor.
+     */
+    Animation(const char* id, AnimationTarget* target, int propertyId, Curve* curve, unsigned long duration);
+
     /**
      * Destructor.
      */
@@ -202,6 +207,11 @@ private:
      */
     Channel* createChannel(AnimationTarget* target, int propertyId, unsigned int keyCount, unsigned int* keyTimes, float* keyValues, float* keyInValue, float* keyOutValue, unsigned int type);
 
+    /**
+     * Creates a channel within this animation that animates the given curve over the given duration.
+     */
+    Channel* createChannel(AnimationTarget* target, int propertyId, Curve* curve, unsigned long duration);
+
     /**
      * Adds a channel to the animation.
      */
@@ -3,6 +3,9 @@
 #include "Animation.h"
 #include "AnimationTarget.h"
 #include "Game.h"
+#include "Joint.h"
+#include "MeshSkin.h"
+#include "Model.h"
 #include "Quaternion.h"
 #include "ScriptController.h"
 
@@ -15,7 +18,8 @@ AnimationClip::AnimationClip(const char* id, Animation* animation, unsigned long
     : _id(id), _animation(animation), _startTime(startTime), _endTime(endTime), _duration(_endTime - _startTime), 
       _stateBits(0x00), _repeatCount(1.0f), _loopBlendTime(0), _activeDuration(_duration * _repeatCount), _speed(1.0f), _timeStarted(0), 
       _elapsedTime(0), _crossFadeToClip(NULL), _crossFadeOutElapsed(0), _crossFadeOutDuration(0), _blendWeight(1.0f),
-      _beginListeners(NULL), _endListeners(NULL), _listeners(NULL), _listenerItr(NULL)
+      _beginListeners(NULL), _endListeners(NULL), _listeners(NULL), _listenerItr(NULL),
+      _lodNode(NULL), _lod(AnimationController::LOD_FULL), _lodUpdateFrame(0), _lodUpdateInterval(1)
 {
     GP_REGISTER_SCRIPT_EVENTS();
 
@@ -41,6 +45,7 @@ AnimationClip::~AnimationClip()
     _values.clear();
 
     SAFE_RELEASE(_crossFadeToClip);
+    SAFE_RELEASE(_lodNode);
     SAFE_DELETE(_beginListeners);
     SAFE_DELETE(_endListeners);
 
@@ -170,6 +175,46 @@ float AnimationClip::getBlendWeight() const
     return _blendWeight;
 }
 
+void AnimationClip::setLodNode(Node* node)
+{
+    if (node != _lodNode)
+    {
+        SAFE_RELEASE(_lodNode);
+        _lodNode = node;
+        if (_lodNode)
+            _lodNode->addRef();
+    }
+}
+
+Node* AnimationClip::getLodNode() const
+{
+    if (_lodNode)
+        return _lodNode;
+
+    for (size_t i = 0, count = _animation->_channels.size(); i < count; i++)
+    {
+        Node* node = dynamic_cast<Node*>(_animation->_channels[i]->_target);
+        if (!node)
+            continue;
+
+        // Joints are sized by the skinned model they deform
+        if (node->getType() == Node::JOINT)
+        {
+            MeshSkin* skin = static_cast<Joint*>(node)->getSkin();
+            Model* model = skin ? skin->getModel() : NULL;
+            if (model && model->getNode())
+                return model->getNode();
+        }
+        return node;
+    }
+    return NULL;
+}
+
+unsigned int AnimationClip::getLod() const
+{
+    return _lod;
+}
+
 void AnimationClip::setLoopBlendTime(float loopBlendTime)
 {
     if (loopBlendTime < 0.0f)
@@ -551,7 +596,61 @@ bool AnimationClip::update(float elapsedTime)
         }
     }
     
-    // Evaluate this clip.
+    // Evaluate this clip. A clip that is ending is evaluated in full, so that it comes to
+    // rest exactly on its final pose.
+    evaluate(percentComplete, isClipStateBitSet(CLIP_IS_STARTED_BIT) ? _lod : AnimationController::LOD_FULL);
+
+    // When ended. Probably should move to it's own method so we can call it when the clip is ended early.
+    if (isClipStateBitSet(CLIP_IS_MARKED_FOR_REMOVAL_BIT) || !isClipStateBitSet(CLIP_IS_STARTED_BIT))
+    {
+        onEnd();
+        return true;
+    }
+
+    return false;
+}
+
+// Returns true for joints at the ends of a skeleton (fingers, toes, twist bones and the like),
+// which are not animated at low animation levels of detail. Joints with attached nodes are kept.
+static bool isLeafJoint(AnimationTarget* target)
+{
+    Node* node = dynamic_cast<Node*>(target);
+    return node && node->getType() == Node::JOINT && node->getFirstChild() == NULL;
+}
+
+// Returns true for the targets whose channels are evaluated at reduced rates below LOD_FULL.
+// Only joints qualify, except the root joint of their skin, which carries root motion, and the
+// joints the LOD node is attached under, since these move the LOD node itself.
+static bool isLodJoint(AnimationTarget* target, Node* lodNode)
+{
+    Node* node = dynamic_cast<Node*>(target);
+    if (!node || node->getType() != Node::JOINT)
+        return false;
+
+    MeshSkin* skin = static_cast<Joint*>(node)->getSkin();
+    if (skin && skin->getRootJoint() == node)
+        return false;
+
+    for (Node* n = lodNode; n; n = n->getParent())
+    {
+        if (n == node)
+            return false;
+    }
+    return true;
+}
+
+void AnimationClip::evaluate(float percentComplete, unsigned int lod)
+{
+    // Below LOD_FULL, joint channels are evaluated at a reduced rate: between evaluations,
+    // low detail joints hold their last values and reduced detail joints are interpolated
+    // between the last two evaluations. Hidden clips do not evaluate them at all.
+    // Channels that move the LOD node are evaluated every frame at every level.
+    bool full = lod == AnimationController::LOD_FULL;
+    bool interpolate = lod == AnimationController::LOD_REDUCED;
+    bool update = full || _lodUpdateFrame == 0 || (interpolate && _lodValues.empty());
+    bool skipJoints = lod == AnimationController::LOD_HIDDEN || (!update && !interpolate);
+    Node* lodNode = full ? NULL : getLodNode();
+
     Animation::Channel* channel = NULL;
     AnimationValue* value = NULL;
     AnimationTarget* target = NULL;
@@ -559,6 +658,19 @@ bool AnimationClip::update(float elapsedTime)
     float percentageStart = (float)_startTime / (float)_animation->_duration;
     float percentageEnd = (float)_endTime / (float)_animation->_duration;
     float percentageBlend = (float)_loopBlendTime / (float)_animation->_duration;
+    float interpolation = (float)_lodUpdateFrame / (float)_lodUpdateInterval;
+    bool reset = false;
+    if (interpolate && _lodValues.empty())
+    {
+        size_t valueCount = 0;
+        for (size_t i = 0; i < channelCount; i++)
+            valueCount += _values[i]->_componentCount;
+        _lodValues.resize(valueCount * 2);
+        reset = true;
+    }
+    float* fromValues = interpolate && !_lodValues.empty() ? &_lodValues[0] : NULL;
+    float* toValues = interpolate && !_lodValues.empty() ? &_lodValues[_lodValues.size() / 2] : NULL;
+
     for (size_t i = 0; i < channelCount; i++)
     {
         channel = _animation->_channels[i];
@@ -567,28 +679,50 @@ bool AnimationClip::update(float elapsedTime)
         GP_ASSERT(target);
         value = _values[i];
         GP_ASSERT(value);
-
-        // Evaluate the point on Curve
         GP_ASSERT(channel->getCurve());
-        channel->getCurve()->evaluate(percentComplete, percentageStart, percentageEnd, percentageBlend, value->_value);
+        unsigned int componentCount = value->_componentCount;
+
+        if (full || !isLodJoint(target, lodNode))
+        {
+            // Evaluate the point on Curve
+            channel->getCurve()->evaluate(percentComplete, percentageStart, percentageEnd, percentageBlend, value->_value);
+        }
+        else
+        {
+            if (skipJoints || (lod == AnimationController::LOD_LOW && isLeafJoint(target)))
+                continue;
+
+            if (update)
+            {
+                // Evaluate the point on Curve
+                channel->getCurve()->evaluate(percentComplete, percentageStart, percentageEnd, percentageBlend, value->_value);
+            }
+            if (interpolate)
+            {
+                if (update)
+                {
+                    // Start from the previous evaluation, or from this one when the level was just entered
+                    memcpy(fromValues, reset ? value->_value : toValues, sizeof(float) * componentCount);
+                    memcpy(toValues, value->_value, sizeof(float) * componentCount);
+                }
+                channel->getCurve()->interpolateValues(update ? 0.0f : interpolation, fromValues, toValues, value->_value);
+            }
+        }
+        if (interpolate)
+        {
+            fromValues += componentCount;
+            toValues += componentCount;
+        }
 
         // Set the animation value on the target property.
         target->setAnimationPropertyValue(channel->_propertyId, value, _blendWeight);
     }
-
-    // When ended. Probably should move to it's own method so we can call it when the clip is ended early.
-    if (isClipStateBitSet(CLIP_IS_MARKED_FOR_REMOVAL_BIT) || !isClipStateBitSet(CLIP_IS_STARTED_BIT))
-    {
-        onEnd();
-        return true;
-    }
-
-    return false;
 }
 
 void AnimationClip::onBegin()
 {
     addRef();
+    _lodValues.clear();
 
     // Initialize animation to play.
     setClipStateBit(CLIP_IS_STARTED_BIT);
@@ -11,6 +11,7 @@ namespace gameplay
 
 class Animation;
 class AnimationValue;
+class Node;
 
 /**
  * Defines the runtime session of an Animation to be played.
@@ -207,6 +208,31 @@ public:
      */
     float getLoopBlendTime() const;
 
+    /**
+     * Sets the node whose projected size selects the animation level of detail of this clip.
+     *
+     * By default the node is found from the clip's targets: it is the node of the skinned
+     * model deformed by the first animated joint, or else the first animated node.
+     *
+     * @param node The node, or NULL to find it from the clip's targets.
+     * @see AnimationController::setLodEnabled
+     */
+    void setLodNode(Node* node);
+
+    /**
+     * Gets the node whose projected size selects the animation level of detail of this clip.
+     *
+     * @return The node set with setLodNode, or else the node found from the clip's targets (may be NULL).
+     */
+    Node* getLodNode() const;
+
+    /**
+     * Gets the animation level of detail the clip was last updated at.
+     *
+     * @return The animation level of detail (see AnimationController::LodLevel).
+     */
+    unsigned int getLod() const;
+
     /**
      * Checks if the AnimationClip is playing.
      *
@@ -352,6 +378,15 @@ private:
      */
     bool update(float elapsedTime);
 
+    /**
+     * Evaluates the clip's channels and applies them to their targets, at the clip's
+     * animation level of detail.
+     *
+     * @param percentComplete The position within the clip.
+     * @param lod The animation level of detail to evaluate at.
+     */
+    void evaluate(float percentComplete, unsigned int lod);
+
     /**
      * Handles when the AnimationClip begins.
      */
@@ -407,6 +442,11 @@ private:
     std::vector<Listener*>* _endListeners;              // Collection of end listeners on the clip.
     std::list<ListenerEvent*>* _listeners;              // Ordered collection of listeners on the clip.
     std::list<ListenerEvent*>::iterator* _listenerItr;  // Iterator that points to the next listener event to be triggered.
+    Node* _lodNode;                                     // Node whose projected size selects the animation LOD (NULL to find it from the targets).
+    unsigned int _lod;                                  // Animation LOD selected by the AnimationController for this frame.
+    unsigned int _lodUpdateFrame;                       // Frames since the clip was last evaluated at a reduced rate (0 to evaluate).
+    unsigned int _lodUpdateInterval;                    // Frames between evaluations at the current animation LOD.
+    std::vector<float> _lodValues;                      // Values of the last two reduced rate evaluations, interpolated in between.
 };
 
 }
@@ -2,13 +2,22 @@
 #include "AnimationController.h"
 #include "Game.h"
 #include "Curve.h"
+#include "Node.h"
+#include "Scene.h"
 
 namespace gameplay
 {
 
 AnimationController::AnimationController()
-    : _state(STOPPED)
+    : _state(STOPPED), _lodEnabled(false), _frameCount(0)
 {
+    _lodScreenSizes[LOD_FULL] = FLT_MAX;
+    _lodScreenSizes[LOD_REDUCED] = 0.2f;
+    _lodScreenSizes[LOD_LOW] = 0.05f;
+    _lodUpdateIntervals[LOD_FULL] = 1;
+    _lodUpdateIntervals[LOD_REDUCED] = 2;
+    _lodUpdateIntervals[LOD_LOW] = 4;
+    memset(_lodClipCounts, 0, sizeof(_lodClipCounts));
 }
 
 AnimationController::~AnimationController()
@@ -27,6 +36,46 @@ void AnimationController::stopAllAnimations()
     }
 }
 
+void AnimationController::setLodEnabled(bool enabled)
+{
+    _lodEnabled = enabled;
+}
+
+bool AnimationController::isLodEnabled() const
+{
+    return _lodEnabled;
+}
+
+void AnimationController::setLodScreenSize(LodLevel lod, float screenSize)
+{
+    GP_ASSERT(lod == LOD_REDUCED || lod == LOD_LOW);
+    _lodScreenSizes[lod] = screenSize;
+}
+
+float AnimationController::getLodScreenSize(LodLevel lod) const
+{
+    GP_ASSERT(lod == LOD_REDUCED || lod == LOD_LOW);
+    return _lodScreenSizes[lod];
+}
+
+void AnimationController::setLodUpdateInterval(LodLevel lod, unsigned int frames)
+{
+    GP_ASSERT(lod == LOD_REDUCED || lod == LOD_LOW);
+    _lodUpdateIntervals[lod] = std::max(frames, 1u);
+}
+
+unsigned int AnimationController::getLodUpdateInterval(LodLevel lod) const
+{
+    GP_ASSERT(lod == LOD_REDUCED || lod == LOD_LOW);
+    return _lodUpdateIntervals[lod];
+}
+
+unsigned int AnimationController::getLodClipCount(LodLevel lod) const
+{
+    GP_ASSERT(lod <= LOD_HIDDEN);
+    return _lodClipCounts[lod];
+}
+
 AnimationController::State AnimationController::getState() const
 {
     return _state;
@@ -100,6 +149,9 @@ void AnimationController::update(float elapsedTime)
     
     Transform::suspendTransformChanged();
 
+    ++_frameCount;
+    memset(_lodClipCounts, 0, sizeof(_lodClipCounts));
+
     // Loop through running clips and call update() on them.
     std::list<AnimationClip*>::iterator clipIter = _runningClips.begin();
     while (clipIter != _runningClips.end())
@@ -107,6 +159,7 @@ void AnimationController::update(float elapsedTime)
         AnimationClip* clip = (*clipIter);
         GP_ASSERT(clip);
         clip->addRef();
+        updateLod(clip);
         if (clip->isClipStateBitSet(AnimationClip::CLIP_IS_RESTARTED_BIT))
         {   // If the CLIP_IS_RESTARTED_BIT is set, we should end the clip and 
             // move it from where it is in the running clips list to the back.
@@ -133,4 +186,60 @@ void AnimationController::update(float elapsedTime)
         _state = IDLE;
 }
 
+void AnimationController::updateLod(AnimationClip* clip)
+{
+    GP_ASSERT(clip);
+
+    unsigned int lod = LOD_FULL;
+    Node* node = _lodEnabled ? clip->getLodNode() : NULL;
+    if (node)
+    {
+        if (node->getAnimationLod() >= 0)
+        {
+            lod = std::min((unsigned int)node->getAnimationLod(), (unsigned int)LOD_HIDDEN);
+        }
+        else
+        {
+            Scene* scene = node->getScene();
+            Camera* camera = scene ? scene->getActiveCamera() : NULL;
+            if (camera)
+            {
+                const BoundingSphere& sphere = node->getBoundingSphere();
+                if (!camera->getFrustum().intersects(sphere))
+                {
+                    lod = LOD_HIDDEN;
+                }
+                else
+                {
+                    float screenSize = camera->getProjectedSize(sphere);
+                    if (screenSize < _lodScreenSizes[LOD_LOW])
+                        lod = LOD_LOW;
+                    else if (screenSize < _lodScreenSizes[LOD_REDUCED])
+                        lod = LOD_REDUCED;
+                }
+            }
+        }
+    }
+    ++_lodClipCounts[lod];
+
+    // Spread the evaluations of different nodes over the frames of the update interval,
+    // but keep all clips of a node in step so that their blended values are applied together.
+    // The low bits of a heap address are always zero, so mix the node address before using it as a phase.
+    size_t phase = (size_t)node >> 4;
+    phase ^= phase >> 16;
+    phase *= 0x45d9f3b;
+    phase ^= phase >> 16;
+    unsigned int interval = lod == LOD_HIDDEN ? 1 : _lodUpdateIntervals[lod];
+    unsigned int frame = (_frameCount + (unsigned int)phase) % interval;
+    if (lod != clip->_lod)
+    {
+        // Evaluate as soon as the level changes, and restart interpolation from there
+        frame = 0;
+        clip->_lodValues.clear();
+    }
+    clip->_lod = lod;
+    clip->_lodUpdateFrame = frame;
+    clip->_lodUpdateInterval = interval;
+}
+
 }
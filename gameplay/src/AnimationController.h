@@ -21,10 +21,92 @@ class AnimationController
 
 public:
 
+    /**
+     * Animation levels of detail.
+     *
+     * The level of a clip is selected from the projected size of its LOD node (see
+     * AnimationClip::setLodNode), or set explicitly with Node::setAnimationLod.
+     *
+     * Only channels that animate joints are reduced. Channels of other targets, of the root
+     * joint of a skin and of the joints the LOD node is attached under move the LOD node,
+     * so they are evaluated every frame at every level.
+     */
+    enum LodLevel
+    {
+        /** The clip is evaluated every frame. */
+        LOD_FULL,
+        /** The clip's joints are evaluated at a reduced rate and interpolated in between. */
+        LOD_REDUCED,
+        /** The clip's joints are evaluated at a low rate and held in between, without leaf joints. */
+        LOD_LOW,
+        /** The clip's LOD node is outside the view: the clip advances but its joints are not evaluated. */
+        LOD_HIDDEN
+    };
+
     /** 
      * Stops all AnimationClips currently playing on the AnimationController.
      */
     void stopAllAnimations();
+
+    /**
+     * Sets whether animation clips are evaluated at reduced levels of detail when their
+     * LOD nodes are small on screen or out of view. Disabled by default, since reduced
+     * levels lag behind by a few frames and leave joints of distant characters unanimated.
+     *
+     * @param enabled true to enable animation levels of detail.
+     */
+    void setLodEnabled(bool enabled);
+
+    /**
+     * Gets whether animation levels of detail are enabled.
+     *
+     * @return true if animation levels of detail are enabled.
+     */
+    bool isLodEnabled() const;
+
+    /**
+     * Sets the projected size below which clips drop to the given level of detail.
+     *
+     * @param lod LOD_REDUCED or LOD_LOW.
+     * @param screenSize The diameter of the LOD node's bounding sphere relative to the viewport height.
+     * @see Camera::getProjectedSize
+     */
+    void setLodScreenSize(LodLevel lod, float screenSize);
+
+    /**
+     * Gets the projected size below which clips drop to the given level of detail.
+     *
+     * @param lod LOD_REDUCED or LOD_LOW.
+     *
+     * @return The projected size.
+     */
+    float getLodScreenSize(LodLevel lod) const;
+
+    /**
+     * Sets the number of frames between evaluations of clips at the given level of detail.
+     *
+     * @param lod LOD_REDUCED or LOD_LOW.
+     * @param frames The number of frames, at least 1.
+     */
+    void setLodUpdateInterval(LodLevel lod, unsigned int frames);
+
+    /**
+     * Gets the number of frames between evaluations of clips at the given level of detail.
+     *
+     * @param lod LOD_REDUCED or LOD_LOW.
+     *
+     * @return The number of frames.
+     */
+    unsigned int getLodUpdateInterval(LodLevel lod) const;
+
+    /**
+     * Gets the number of running clips that were updated at the given level of detail in the last frame.
+     *
+     * @param lod The level of detail.
+     *
+     * @return The number of clips.
+     */
+    unsigned int getLodClipCount(LodLevel lod) const;
        
 private:
 
@@ -95,9 +177,19 @@ private:
      * Callback for when the controller receives a frame update event.
      */
     void update(float elapsedTime);
+
+    /**
+     * Selects the level of detail of a clip for this frame, and whether it is evaluated.
+     */
+    void updateLod(AnimationClip* clip);
     
     State _state;                                 // The current state of the AnimationController.
     std::list<AnimationClip*> _runningClips;      // A list of running AnimationClips.
+    bool _lodEnabled;                             // Whether clips are evaluated at reduced levels of detail.
+    float _lodScreenSizes[LOD_HIDDEN];            // Projected sizes below which clips drop to each level of detail.
+    unsigned int _lodUpdateIntervals[LOD_HIDDEN]; // Frames between evaluations at each level of detail.
+    unsigned int _lodClipCounts[LOD_HIDDEN + 1];  // Clips updated at each level of detail in the last frame.
+    unsigned int _frameCount;                     // Frames updated while running, to schedule reduced rate evaluations.
 };
 
 }
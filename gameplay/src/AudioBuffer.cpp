@@ -5,8 +5,23 @@
 namespace gameplay
 {
 
-// Audio buffer cache
-static std::vector<AudioBuffer*> __buffers;
+// Default memory budget of the audio buffer cache
+#define AUDIO_BUFFER_CACHE_BUDGET (16 * 1024 * 1024)
+
+// Audio buffer cache, which holds a reference to every buffer that is not streamed
+static std::unordered_map<std::string, AudioBuffer*> __buffers;
+static unsigned int __cacheBudget = AUDIO_BUFFER_CACHE_BUDGET;
+static unsigned int __residentPCMBytes = 0;
+static unsigned int __residentCompressedBytes = 0;
+static unsigned int __useCounter = 0;
+
+// Read position within the compressed data of an ogg file held in memory
+struct MemoryStream
+{
+    const char* data;
+    size_t size;
+    size_t position;
+};
 
 // Callbacks for loading an ogg file using Stream
 static size_t readStream(void* ptr, size_t size, size_t nmemb, void* datasource)
@@ -38,28 +53,112 @@ static long tellStream(void* datasource)
     return stream->position();
 }
 
+// Callbacks for decoding an ogg file held in memory
+static size_t readMemory(void* ptr, size_t size, size_t nmemb, void* datasource)
+{
+    GP_ASSERT(datasource);
+    MemoryStream* stream = reinterpret_cast<MemoryStream*>(datasource);
+    if (size == 0)
+        return 0;
+    size_t count = std::min(nmemb, (stream->size - stream->position) / size);
+    memcpy(ptr, stream->data + stream->position, count * size);
+    stream->position += count * size;
+    return count;
+}
+
+static int seekMemory(void *datasource, ogg_int64_t offset, int whence)
+{
+    GP_ASSERT(datasource);
+    MemoryStream* stream = reinterpret_cast<MemoryStream*>(datasource);
+    ogg_int64_t position;
+    switch (whence)
+    {
+    case SEEK_SET:
+        position = offset;
+        break;
+    case SEEK_CUR:
+        position = (ogg_int64_t)stream->position + offset;
+        break;
+    case SEEK_END:
+        position = (ogg_int64_t)stream->size + offset;
+        break;
+    default:
+        return -1;
+    }
+    if (position < 0 || position > (ogg_int64_t)stream->size)
+        return -1;
+    stream->position = (size_t)position;
+    return 0;
+}
+
+static long tellMemory(void* datasource)
+{
+    GP_ASSERT(datasource);
+    return (long)reinterpret_cast<MemoryStream*>(datasource)->position;
+}
+
+// Decodes all remaining data of an ogg file into an OpenAL buffer and returns the number of bytes decoded.
+static long decodeOgg(OggVorbis_File* oggFile, ALuint buffer, ALenum format, long frequency, long dataSize)
+{
+    char* data = new char[dataSize];
+    long size = 0;
+    int section;
+    while (size < dataSize)
+    {
+        long result = ov_read(oggFile, data + size, dataSize - size, 0, 2, 1, &section);
+        if (result > 0)
+        {
+            size += result;
+        }
+        else if (result < 0)
+        {
+            SAFE_DELETE_ARRAY(data);
+            GP_ERROR("Failed to read ogg file; file is missing data.");
+            return 0;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if (size > 0)
+        AL_CHECK( alBufferData(buffer, format, data, size, frequency) );
+    SAFE_DELETE_ARRAY(data);
+    return size;
+}
+
+// Returns the number of bytes in one sample frame of an OpenAL buffer format.
+static unsigned int getFrameSize(ALuint format)
+{
+    switch (format)
+    {
+    case AL_FORMAT_MONO8:
+        return 1;
+    case AL_FORMAT_STEREO8:
+    case AL_FORMAT_MONO16:
+        return 2;
+    default:
+        return 4;
+    }
+}
+
 AudioBuffer::AudioBuffer(const char* path, ALuint* buffer, bool streamed)
-: _filePath(path), _streamed(streamed), _buffersNeededCount(0)
+: _filePath(path), _streamed(streamed), _pcmSize(0), _duration(0.0f), _voiceCount(0), _lastUsed(0), _buffersNeededCount(0), _decodeHead(0), _decodeTail(0), _decodeEnded(false),
+  _looped(false), _decodeScheduled(false), _decoding(false)
 {
     memcpy(_alBufferQueue, buffer, sizeof(_alBufferQueue));
+    if (streamed)
+        _decodeQueue.reset(new DecodedBlock[STREAMING_DECODE_QUEUE_SIZE]);
 }
 
 AudioBuffer::~AudioBuffer()
 {
-    // Remove the buffer from the cache.
-    unsigned int bufferCount = (unsigned int)__buffers.size();
-
+    // The cache holds a reference to the buffer, so it has already been removed from the cache.
     if (!_streamed)
     {
-        unsigned int bufferCount = (unsigned int)__buffers.size();
-        for (unsigned int i = 0; i < bufferCount; i++)
-        {
-            if (this == __buffers[i])
-            {
-                __buffers.erase(__buffers.begin() + i);
-                break;
-            }
-        }
+        __residentPCMBytes -= _pcmSize;
+        __residentCompressedBytes -= (unsigned int)_compressedData.size();
     }
     else if (_streamStateOgg.get())
     {
@@ -76,23 +175,21 @@ AudioBuffer::~AudioBuffer()
     }
 }
 
-AudioBuffer* AudioBuffer::create(const char* path, bool streamed)
+AudioBuffer* AudioBuffer::create(const char* path, bool streamed, bool compressed)
 {
     GP_ASSERT(path);
 
     AudioBuffer* buffer = NULL;
     if (!streamed)
     {
-        unsigned int bufferCount = (unsigned int)__buffers.size();
-        for (unsigned int i = 0; i < bufferCount; i++)
+        std::unordered_map<std::string, AudioBuffer*>::iterator itr = __buffers.find(path);
+        if (itr != __buffers.end())
         {
-            buffer = __buffers[i];
+            buffer = itr->second;
             GP_ASSERT(buffer);
-            if (buffer->_filePath.compare(path) == 0)
-            {
-                buffer->addRef();
-                return buffer;
-            }
+            buffer->touch();
+            buffer->addRef();
+            return buffer;
         }
     }
     ALuint alBuffer[STREAMING_BUFFER_QUEUE_SIZE];
@@ -142,6 +239,20 @@ AudioBuffer* AudioBuffer::create(const char* path, bool streamed)
             goto cleanup;
         }
     }
+    else if (memcmp(header, "OggS", 4) == 0 && compressed && !streamed)
+    {
+        buffer = createCompressed(path, stream.get(), alBuffer[0]);
+        if (buffer == NULL)
+        {
+            GP_ERROR("Invalid ogg file: %s", path);
+            goto cleanup;
+        }
+        buffer->touch();
+        buffer->addRef();
+        __buffers[path] = buffer;
+        trimCache();
+        return buffer;
+    }
     else if (memcmp(header, "OggS", 4) == 0)
     {
         // Fill at least one buffer with sound data.
@@ -169,7 +280,19 @@ AudioBuffer* AudioBuffer::create(const char* path, bool streamed)
         buffer->_buffersNeededCount = (buffer->_streamStateOgg->dataSize + STREAMING_BUFFER_SIZE - 1) / STREAMING_BUFFER_SIZE;
 
     if (!streamed)
-        __buffers.push_back(buffer);
+    {
+        ALint size = 0;
+        AL_CHECK( alGetBufferi(alBuffer[0], AL_SIZE, &size) );
+        buffer->_pcmSize = (unsigned int)size;
+        __residentPCMBytes += buffer->_pcmSize;
+        buffer->_duration = buffer->getDuration();
+
+        // The cache keeps its own reference until the buffer is evicted.
+        buffer->touch();
+        buffer->addRef();
+        __buffers[path] = buffer;
+        trimCache();
+    }
 
     return buffer;
     
@@ -388,7 +511,6 @@ bool AudioBuffer::loadOgg(Stream* stream, ALuint buffer, bool streamed, AudioStr
     vorbis_info* info;
     ALenum format;
     long result;
-    int section;
     long size = 0;
 
     stream->rewind();
@@ -428,60 +550,176 @@ bool AudioBuffer::loadOgg(Stream* stream, ALuint buffer, bool streamed, AudioStr
             data_size = STREAMING_BUFFER_SIZE;
     }
 
-    char* data = new char[data_size];
+    size = decodeOgg(&streamState->oggFile, buffer, format, info->rate, data_size);
+    if (size == 0)
+    {
+        GP_ERROR("Filed to read ogg file; unable to read any data.");
+        return false;
+    }
+
+    if (!streamed)
+        ov_clear(&streamState->oggFile);
+
+    return true;
+}
+
+AudioBuffer* AudioBuffer::createCompressed(const char* path, Stream* stream, ALuint buffer)
+{
+    GP_ASSERT(stream);
 
-    while (size < data_size)
+    // Keep the whole file in memory and only decode it when it is first played.
+    std::vector<char> data(stream->length());
+    stream->rewind();
+    if (data.empty() || stream->read(&data[0], 1, data.size()) != data.size())
     {
-        result = ov_read(&streamState->oggFile, data + size, data_size - size, 0, 2, 1, &section);
-        if (result > 0)
-        {
-            size += result;
-        }
-        else if (result < 0)
+        GP_ERROR("Failed to read ogg file; file is missing data.");
+        return NULL;
+    }
+
+    ov_callbacks callbacks;
+    callbacks.read_func = readMemory;
+    callbacks.seek_func = seekMemory;
+    callbacks.close_func = NULL;
+    callbacks.tell_func = tellMemory;
+
+    MemoryStream memoryStream = { &data[0], data.size(), 0 };
+    OggVorbis_File oggFile;
+    if (ov_open_callbacks(&memoryStream, &oggFile, NULL, 0, callbacks) < 0)
+    {
+        GP_ERROR("Failed to open ogg file.");
+        return NULL;
+    }
+    float duration = (float)ov_time_total(&oggFile, -1);
+    ov_clear(&oggFile);
+
+    ALuint alBuffer[STREAMING_BUFFER_QUEUE_SIZE];
+    memset(alBuffer, 0, sizeof(alBuffer));
+    alBuffer[0] = buffer;
+
+    AudioBuffer* audioBuffer = new AudioBuffer(path, alBuffer, false);
+    audioBuffer->_compressedData.swap(data);
+    audioBuffer->_duration = duration;
+    __residentCompressedBytes += (unsigned int)audioBuffer->_compressedData.size();
+    return audioBuffer;
+}
+
+bool AudioBuffer::decode()
+{
+    if (_compressedData.empty() || _pcmSize > 0)
+        return true;
+
+    ov_callbacks callbacks;
+    callbacks.read_func = readMemory;
+    callbacks.seek_func = seekMemory;
+    callbacks.close_func = NULL;
+    callbacks.tell_func = tellMemory;
+
+    MemoryStream memoryStream = { &_compressedData[0], _compressedData.size(), 0 };
+    OggVorbis_File oggFile;
+    if (ov_open_callbacks(&memoryStream, &oggFile, NULL, 0, callbacks) < 0)
+    {
+        GP_ERROR("Failed to open ogg file: %s", _filePath.c_str());
+        return false;
+    }
+
+    vorbis_info* info = ov_info(&oggFile, -1);
+    GP_ASSERT(info);
+    ALenum format = info->channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+    long size = decodeOgg(&oggFile, _alBufferQueue[0], format, info->rate, (long)ov_pcm_total(&oggFile, -1) * info->channels * 2);
+    ov_clear(&oggFile);
+    if (size == 0)
+    {
+        GP_ERROR("Failed to decode ogg file: %s", _filePath.c_str());
+        return false;
+    }
+
+    _pcmSize = (unsigned int)size;
+    __residentPCMBytes += _pcmSize;
+    return true;
+}
+
+void AudioBuffer::touch()
+{
+    _lastUsed = ++__useCounter;
+}
+
+void AudioBuffer::trimCache()
+{
+    if (__residentPCMBytes + __residentCompressedBytes <= __cacheBudget)
+        return;
+
+    // Visit the buffers from least to most recently used.
+    std::vector<std::pair<unsigned int, AudioBuffer*> > buffers;
+    buffers.reserve(__buffers.size());
+    for (std::unordered_map<std::string, AudioBuffer*>::iterator itr = __buffers.begin(); itr != __buffers.end(); ++itr)
+        buffers.push_back(std::make_pair(itr->second->_lastUsed, itr->second));
+    std::sort(buffers.begin(), buffers.end());
+
+    for (size_t i = 0, count = buffers.size(); i < count && __residentPCMBytes + __residentCompressedBytes > __cacheBudget; ++i)
+    {
+        AudioBuffer* buffer = buffers[i].second;
+        if (buffer->getRefCount() == 1)
         {
-            SAFE_DELETE_ARRAY(data);
-            GP_ERROR("Failed to read ogg file; file is missing data.");
-            return false;
+            // Only the cache references the buffer.
+            __buffers.erase(buffer->_filePath);
+            SAFE_RELEASE(buffer);
         }
-        else
+        else if (!buffer->_compressedData.empty() && buffer->_pcmSize > 0 && buffer->_voiceCount == 0)
         {
-            break;
+            // Drop the decoded data of a compressed buffer that is not playing. OpenAL cannot
+            // shrink a buffer, so it is replaced with an empty one.
+            AL_CHECK( alDeleteBuffers(1, &buffer->_alBufferQueue[0]) );
+            AL_CHECK( alGenBuffers(1, &buffer->_alBufferQueue[0]) );
+            __residentPCMBytes -= buffer->_pcmSize;
+            buffer->_pcmSize = 0;
         }
     }
-    
-    if (size == 0)
+}
+
+void AudioBuffer::clearCache()
+{
+    for (std::unordered_map<std::string, AudioBuffer*>::iterator itr = __buffers.begin(); itr != __buffers.end(); ++itr)
     {
-        SAFE_DELETE_ARRAY(data);
-        GP_ERROR("Filed to read ogg file; unable to read any data.");
-        return false;
+        SAFE_RELEASE(itr->second);
     }
+    __buffers.clear();
+}
 
-    AL_CHECK(alBufferData(buffer, format, data, size, info->rate));
+void AudioBuffer::setCacheBudget(unsigned int bytes)
+{
+    __cacheBudget = bytes;
+    trimCache();
+}
 
-    SAFE_DELETE_ARRAY(data);
+unsigned int AudioBuffer::getCacheBudget()
+{
+    return __cacheBudget;
+}
 
-    if (!streamed)
-        ov_clear(&streamState->oggFile);
+unsigned int AudioBuffer::getResidentPCMBytes()
+{
+    return __residentPCMBytes;
+}
 
-    return true;
+unsigned int AudioBuffer::getResidentCompressedBytes()
+{
+    return __residentCompressedBytes;
 }
 
-bool AudioBuffer::streamData(ALuint buffer, bool looped)
+ALsizei AudioBuffer::readData(char* data)
 {
-    static char buffers[STREAMING_BUFFER_SIZE];
-    
+    GP_ASSERT(data);
+
+    bool looped = _looped;
     if (_streamStateWav.get())
     {
-        ALsizei bytesRead = _fileStream->read(buffers, sizeof(char), STREAMING_BUFFER_SIZE);
+        ALsizei bytesRead = _fileStream->read(data, sizeof(char), STREAMING_BUFFER_SIZE);
         if (bytesRead != STREAMING_BUFFER_SIZE)
         {
             if (looped)
                 _fileStream->seek(_streamStateWav->dataStart, SEEK_SET);
         }
-        if (bytesRead > 0)
-            AL_CHECK(alBufferData(buffer, _streamStateWav->format, buffers, bytesRead, _streamStateWav->frequency));
-        
-        return bytesRead > 0 || looped;
+        return std::max(bytesRead, 0);
     }
     else if (_streamStateOgg.get())
     {
@@ -491,7 +729,7 @@ bool AudioBuffer::streamData(ALuint buffer, bool looped)
 
         while (bytesRead < STREAMING_BUFFER_SIZE)
         {
-            result = ov_read(&_streamStateOgg->oggFile, buffers + bytesRead, STREAMING_BUFFER_SIZE - bytesRead, 0, 2, 1, &section);
+            result = ov_read(&_streamStateOgg->oggFile, data + bytesRead, STREAMING_BUFFER_SIZE - bytesRead, 0, 2, 1, &section);
             if (result > 0)
             {
                 bytesRead += result;
@@ -503,14 +741,98 @@ bool AudioBuffer::streamData(ALuint buffer, bool looped)
                 break;
             }
         }
+        return bytesRead;
+    }
+
+    return 0;
+}
+
+void AudioBuffer::decodeData()
+{
+    GP_ASSERT(_streamed && _decodeQueue.get());
+
+    unsigned int head = _decodeHead.load(std::memory_order_relaxed);
+    while (!_decodeEnded && head - _decodeTail.load(std::memory_order_acquire) < STREAMING_DECODE_QUEUE_SIZE)
+    {
+        DecodedBlock& block = _decodeQueue[head % STREAMING_DECODE_QUEUE_SIZE];
+        block.size = readData(block.data);
+
+        // A looped stream that ended exactly on a block boundary has just been rewound
+        if (block.size == 0 && _looped)
+            block.size = readData(block.data);
+
+        if (block.size == 0)
+        {
+            _decodeEnded = true;
+            break;
+        }
 
-        if (bytesRead > 0)
-            AL_CHECK(alBufferData(buffer, _streamStateOgg->format, buffers, bytesRead, _streamStateOgg->frequency));
-        
-        return (bytesRead > 0) || looped;
+        // Publish the block to the streaming thread
+        _decodeHead.store(++head, std::memory_order_release);
     }
-    
-    return false;
+}
+
+bool AudioBuffer::needsDecode() const
+{
+    return !_decodeEnded && _decodeHead.load(std::memory_order_relaxed) - _decodeTail.load(std::memory_order_relaxed) < STREAMING_DECODE_QUEUE_SIZE;
+}
+
+bool AudioBuffer::popDecodedData(ALuint buffer)
+{
+    GP_ASSERT(_streamed && _decodeQueue.get());
+
+    unsigned int tail = _decodeTail.load(std::memory_order_relaxed);
+    if (tail == _decodeHead.load(std::memory_order_acquire))
+        return false;
+
+    const DecodedBlock& block = _decodeQueue[tail % STREAMING_DECODE_QUEUE_SIZE];
+    if (_streamStateWav.get())
+    {
+        AL_CHECK( alBufferData(buffer, _streamStateWav->format, block.data, block.size, _streamStateWav->frequency) );
+    }
+    else if (_streamStateOgg.get())
+    {
+        AL_CHECK( alBufferData(buffer, _streamStateOgg->format, block.data, block.size, _streamStateOgg->frequency) );
+    }
+
+    // Hand the block back to the decoder
+    _decodeTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool AudioBuffer::isStreamFinished() const
+{
+    return _decodeEnded && _decodeHead.load(std::memory_order_acquire) == _decodeTail.load(std::memory_order_relaxed);
+}
+
+float AudioBuffer::getStreamingBufferDuration() const
+{
+    ALuint format = 0;
+    ALuint frequency = 0;
+    if (_streamStateWav.get())
+    {
+        format = _streamStateWav->format;
+        frequency = _streamStateWav->frequency;
+    }
+    else if (_streamStateOgg.get())
+    {
+        format = _streamStateOgg->format;
+        frequency = _streamStateOgg->frequency;
+    }
+    return frequency > 0 ? (float)STREAMING_BUFFER_SIZE / (frequency * getFrameSize(format)) : 0.0f;
+}
+
+float AudioBuffer::getDuration() const
+{
+    if (!_streamed && _duration > 0.0f)
+        return _duration;
+
+    ALint size = 0, frequency = 0, channels = 0, bits = 0;
+    AL_CHECK( alGetBufferi(_alBufferQueue[0], AL_SIZE, &size) );
+    AL_CHECK( alGetBufferi(_alBufferQueue[0], AL_FREQUENCY, &frequency) );
+    AL_CHECK( alGetBufferi(_alBufferQueue[0], AL_CHANNELS, &channels) );
+    AL_CHECK( alGetBufferi(_alBufferQueue[0], AL_BITS, &bits) );
+    return (frequency > 0 && channels > 0 && bits > 0) ? (float)size / (frequency * channels * (bits / 8)) : 0.0f;
 }
 
 }
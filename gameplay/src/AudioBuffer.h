@@ -17,6 +17,7 @@ class AudioSource;
 class AudioBuffer : public Ref
 {
     friend class AudioSource;
+    friend class AudioController;
 
 private:
     
@@ -37,12 +38,82 @@ private:
 
     /**
      * Creates an audio buffer from a file.
+     *
+     * Buffers that are not streamed are cached by path. The cache keeps buffers that are
+     * no longer used until the memory budget requires them to be evicted.
      * 
      * @param path The path to the audio buffer on the filesystem.
+     * @param streamed True to stream the file while it plays.
+     * @param compressed True to keep an Ogg file compressed in memory and decode it when
+     *      it is first played. Ignored for streamed buffers and other file types.
      * 
      * @return The buffer from a file.
      */
-    static AudioBuffer* create(const char* path, bool streamed);
+    static AudioBuffer* create(const char* path, bool streamed, bool compressed = false);
+
+    /**
+     * Creates a buffer that keeps an Ogg file compressed in memory.
+     *
+     * @param path The path to the file.
+     * @param stream The stream of the file, positioned after the header.
+     * @param buffer The OpenAL buffer that is filled when the buffer is decoded.
+     *
+     * @return The buffer, or NULL if the file is not a valid Ogg file.
+     */
+    static AudioBuffer* createCompressed(const char* path, Stream* stream, ALuint buffer);
+
+    /**
+     * Decodes the compressed data of the buffer, if it is not already decoded.
+     *
+     * @return True if the buffer holds decoded data.
+     */
+    bool decode();
+
+    /**
+     * Marks the buffer as used, which moves it to the back of the eviction order.
+     */
+    void touch();
+
+    /**
+     * Evicts the least recently used buffers from the cache until the resident memory fits the budget.
+     *
+     * Buffers that are only referenced by the cache are deleted. Compressed buffers that
+     * are not playing drop their decoded data.
+     */
+    static void trimCache();
+
+    /**
+     * Releases all buffers held by the cache.
+     */
+    static void clearCache();
+
+    /**
+     * Sets the memory budget of the buffer cache.
+     *
+     * @param bytes The number of decoded and compressed bytes the cache may keep resident.
+     */
+    static void setCacheBudget(unsigned int bytes);
+
+    /**
+     * Gets the memory budget of the buffer cache.
+     *
+     * @return The budget in bytes.
+     */
+    static unsigned int getCacheBudget();
+
+    /**
+     * Gets the number of bytes of decoded data held by buffers that are not streamed.
+     *
+     * @return The resident decoded data, in bytes.
+     */
+    static unsigned int getResidentPCMBytes();
+
+    /**
+     * Gets the number of bytes of compressed data held by buffers that are decoded when first played.
+     *
+     * @return The resident compressed data, in bytes.
+     */
+    static unsigned int getResidentCompressedBytes();
 
     struct AudioStreamStateWav
     {
@@ -63,20 +134,98 @@ private:
 
     enum { STREAMING_BUFFER_QUEUE_SIZE = 3 };
     enum { STREAMING_BUFFER_SIZE = 48000 };
+    enum { STREAMING_DECODE_QUEUE_SIZE = 4 };
+
+    /**
+     * A block of decoded audio data waiting to be copied into an OpenAL buffer.
+     */
+    struct DecodedBlock
+    {
+        char data[STREAMING_BUFFER_SIZE];
+        ALsizei size;
+    };
 
     static bool loadWav(Stream* stream, ALuint buffer, bool streamed, AudioStreamStateWav* streamState);
     
     static bool loadOgg(Stream* stream, ALuint buffer, bool streamed, AudioStreamStateOgg* streamState);
 
-    bool streamData(ALuint buffer, bool looped);
+    /**
+     * Reads and decodes the next block of a streamed file.
+     *
+     * @param data The buffer to decode into, STREAMING_BUFFER_SIZE bytes long.
+     *
+     * @return The number of bytes decoded, or 0 at the end of a stream that does not loop.
+     */
+    ALsizei readData(char* data);
+
+    /**
+     * Decodes blocks of a streamed file until the decode queue is full or the stream ends.
+     *
+     * This is called from the audio decode threads. Only one thread decodes a buffer at a time.
+     */
+    void decodeData();
+
+    /**
+     * Determines if the decode queue has room for more blocks of a stream that has not ended.
+     *
+     * @return True if the stream needs decoding.
+     */
+    bool needsDecode() const;
+
+    /**
+     * Copies the oldest decoded block into an OpenAL buffer and removes it from the decode queue.
+     *
+     * @param buffer The OpenAL buffer to fill.
+     *
+     * @return True if a block was copied, false if the decode queue is empty.
+     */
+    bool popDecodedData(ALuint buffer);
+
+    /**
+     * Determines if the stream has ended and all of its decoded blocks have been consumed.
+     *
+     * @return True if there is no more data to stream.
+     */
+    bool isStreamFinished() const;
+
+    /**
+     * Gets the playback duration of a full streaming buffer.
+     *
+     * @return The duration of STREAMING_BUFFER_SIZE bytes of the stream, in seconds.
+     */
+    float getStreamingBufferDuration() const;
+
+    /**
+     * Gets the playback duration of a buffer that is not streamed.
+     *
+     * @return The duration in seconds.
+     */
+    float getDuration() const;
 
     ALuint _alBufferQueue[STREAMING_BUFFER_QUEUE_SIZE];
     std::string _filePath;
     bool _streamed;
+    /** The size of the decoded data of a buffer that is not streamed, in bytes. */
+    unsigned int _pcmSize;
+    /** The compressed file data of a buffer that is decoded when it is first played. */
+    std::vector<char> _compressedData;
+    float _duration;
+    /** The number of sources playing the buffer through a voice. */
+    unsigned int _voiceCount;
+    unsigned int _lastUsed;
     std::unique_ptr<Stream> _fileStream;
     std::unique_ptr<AudioStreamStateWav> _streamStateWav;
     std::unique_ptr<AudioStreamStateOgg> _streamStateOgg;
     int _buffersNeededCount;
+    /** Single producer, single consumer queue of decoded blocks. */
+    std::unique_ptr<DecodedBlock[]> _decodeQueue;
+    std::atomic<unsigned int> _decodeHead;
+    std::atomic<unsigned int> _decodeTail;
+    std::atomic<bool> _decodeEnded;
+    std::atomic<bool> _looped;
+    /** If the buffer is waiting in or being decoded by the decode queue of the audio controller. */
+    bool _decodeScheduled;
+    bool _decoding;
 };
 
 }
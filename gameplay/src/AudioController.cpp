@@ -3,13 +3,36 @@
 #include "AudioListener.h"
 #include "AudioBuffer.h"
 #include "AudioSource.h"
+#include "Node.h"
+
+// The number of threads decoding streamed audio
+#define AUDIO_DECODE_THREAD_COUNT 2
+
+// The default maximum number of voices for sources that are not streamed
+#define AUDIO_DEFAULT_MAX_VOICES 32
+
+// Audibility bonus for sources that already have a voice, so that sources of
+// similar loudness don't keep trading voices
+#define AUDIO_VOICE_HYSTERESIS 1.1f
+
+// The longest and shortest time the streaming thread sleeps between refills, in seconds
+#define AUDIO_STREAMING_MAX_WAIT 0.1f
+#define AUDIO_STREAMING_MIN_WAIT 0.005f
 
 namespace gameplay
 {
 
 AudioController::AudioController() 
-: _alcDevice(NULL), _alcContext(NULL), _pausingSource(NULL), _streamingThreadActive(true)
+: _alcDevice(NULL), _alcContext(NULL), _pausingSource(NULL), _voiceCount(0), _maxVoices(AUDIO_DEFAULT_MAX_VOICES),
+  _streamingThreadActive(true)
+{
+}
+
+bool AudioController::compareVoices(const AudioSource* a, const AudioSource* b)
 {
+    if (a->getPriority() != b->getPriority())
+        return a->getPriority() > b->getPriority();
+    return a->_audibility > b->_audibility;
 }
 
 AudioController::~AudioController()
@@ -21,7 +44,12 @@ void AudioController::initialize()
     _alcDevice = alcOpenDevice(NULL);
     if (!_alcDevice)
     {
+#ifdef GP_HEADLESS
+        // Servers commonly have no audio device; run without audio.
+        GP_WARN("Unable to open OpenAL device.\n");
+#else
         GP_ERROR("Unable to open OpenAL device.\n");
+#endif
         return;
     }
     
@@ -41,6 +69,10 @@ void AudioController::initialize()
         GP_ERROR("Unable to make OpenAL context current. Error: %d\n", alcErr);
     }
     _streamingMutex.reset(new std::mutex());
+    _streamingCondition.reset(new std::condition_variable());
+    _decodeMutex.reset(new std::mutex());
+    _decodeCondition.reset(new std::condition_variable());
+    _decodeDoneCondition.reset(new std::condition_variable());
 }
 
 void AudioController::finalize()
@@ -49,9 +81,29 @@ void AudioController::finalize()
     if (_streamingThread.get())
     {
         _streamingThreadActive = false;
+        _streamingCondition->notify_one();
         _streamingThread->join();
         _streamingThread.reset(NULL);
+
+        {
+            std::lock_guard<std::mutex> lock(*_decodeMutex);
+            _decodeCondition->notify_all();
+        }
+        for (size_t i = 0, count = _decodeThreads.size(); i < count; ++i)
+        {
+            _decodeThreads[i]->join();
+        }
+        _decodeThreads.clear();
+    }
+
+    AudioBuffer::clearCache();
+
+    for (size_t i = 0, count = _freeVoices.size(); i < count; ++i)
+    {
+        AL_CHECK( alDeleteSources(1, &_freeVoices[i]) );
     }
+    _freeVoices.clear();
+    _voiceCount = 0;
 
     alcMakeContextCurrent(NULL);
     if (_alcContext)
@@ -103,13 +155,134 @@ void AudioController::resume()
 void AudioController::update(float elapsedTime)
 {
     AudioListener* listener = AudioListener::getInstance();
-    if (listener)
+    if (listener && _alcContext)
     {
         AL_CHECK( alListenerf(AL_GAIN, listener->getGain()) );
         AL_CHECK( alListenerfv(AL_ORIENTATION, (ALfloat*)listener->getOrientation()) );
         AL_CHECK( alListenerfv(AL_VELOCITY, (ALfloat*)&listener->getVelocity()) );
         AL_CHECK( alListenerfv(AL_POSITION, (ALfloat*)&listener->getPosition()) );
     }
+
+    updateVoices(elapsedTime);
+}
+
+unsigned int AudioController::getMaxVoices() const
+{
+    return _maxVoices;
+}
+
+void AudioController::setMaxVoices(unsigned int maxVoices)
+{
+    _maxVoices = maxVoices;
+}
+
+unsigned int AudioController::getBufferCacheBudget() const
+{
+    return AudioBuffer::getCacheBudget();
+}
+
+void AudioController::setBufferCacheBudget(unsigned int bytes)
+{
+    AudioBuffer::setCacheBudget(bytes);
+}
+
+unsigned int AudioController::getResidentPCMBytes() const
+{
+    return AudioBuffer::getResidentPCMBytes();
+}
+
+unsigned int AudioController::getResidentCompressedBytes() const
+{
+    return AudioBuffer::getResidentCompressedBytes();
+}
+
+void AudioController::updateVoices(float elapsedTime)
+{
+    AudioListener* listener = AudioListener::getInstance();
+    Vector3 listenerPosition = listener ? listener->getPosition() : Vector3::zero();
+
+    // Find the sources that stopped and estimate how loud the others are at the listener
+    std::vector<AudioSource*> stoppedSources;
+    std::vector<AudioSource*> voices;
+    for (std::set<AudioSource*>::iterator itr = _playingSources.begin(); itr != _playingSources.end(); ++itr)
+    {
+        AudioSource* source = *itr;
+        if (source->isStreamed())
+        {
+            source->updatePosition();
+            continue;
+        }
+
+        if (source->_alSource ? source->getState() == AudioSource::STOPPED : !source->updateVirtualVoice(elapsedTime))
+        {
+            stoppedSources.push_back(source);
+            continue;
+        }
+
+        // Matches the default inverse distance clamped attenuation of OpenAL
+        float distance = source->_node ? source->_node->getTranslationWorld().distance(listenerPosition) : 0.0f;
+        source->_audibility = source->_gain / std::max(distance, 1.0f);
+        if (source->_alSource)
+            source->_audibility *= AUDIO_VOICE_HYSTERESIS;
+        voices.push_back(source);
+    }
+    for (size_t i = 0, count = stoppedSources.size(); i < count; ++i)
+    {
+        removePlayingSource(stoppedSources[i]);
+    }
+
+    if (!_alcContext)
+        return;
+
+    // Take the voices from the sources that lost them before handing them out again
+    std::stable_sort(voices.begin(), voices.end(), compareVoices);
+    for (size_t i = 0, count = voices.size(); i < count; ++i)
+    {
+        AudioSource* source = voices[i];
+        if (source->_alSource && (i >= _maxVoices || source->_audibility <= 0.0f))
+            _freeVoices.push_back(source->unbindVoice());
+    }
+    while (_voiceCount > _maxVoices && !_freeVoices.empty())
+    {
+        AL_CHECK( alDeleteSources(1, &_freeVoices.back()) );
+        _freeVoices.pop_back();
+        --_voiceCount;
+    }
+    for (size_t i = 0, count = std::min(voices.size(), (size_t)_maxVoices); i < count; ++i)
+    {
+        AudioSource* source = voices[i];
+        if (source->_alSource)
+        {
+            source->updatePosition();
+        }
+        else if (source->_audibility > 0.0f)
+        {
+            ALuint voice = acquireVoice();
+            if (!voice)
+                break;
+            source->bindVoice(voice);
+        }
+    }
+}
+
+ALuint AudioController::acquireVoice()
+{
+    if (!_freeVoices.empty())
+    {
+        ALuint voice = _freeVoices.back();
+        _freeVoices.pop_back();
+        return voice;
+    }
+
+    ALuint voice = 0;
+    if (_voiceCount < _maxVoices)
+    {
+        AL_CHECK( alGenSources(1, &voice) );
+        if (AL_LAST_ERROR())
+            return 0;
+        ++_voiceCount;
+    }
+    return voice;
 }
 
 void AudioController::addPlayingSource(AudioSource* source)
@@ -118,6 +291,15 @@ void AudioController::addPlayingSource(AudioSource* source)
     {
         _playingSources.insert(source);
 
+        // Start playing right away if there is a voice to spare, otherwise the
+        // source plays virtually until the next update assigns the voices.
+        if (!source->isStreamed() && !source->_alSource && _alcContext)
+        {
+            ALuint voice = acquireVoice();
+            if (voice)
+                source->bindVoice(voice);
+        }
+
         if (source->isStreamed())
         {
             GP_ASSERT(_streamingSources.find(source) == _streamingSources.end());
@@ -127,7 +309,14 @@ void AudioController::addPlayingSource(AudioSource* source)
             _streamingMutex->unlock();
 
             if (startThread)
+            {
                 _streamingThread.reset(new std::thread(&streamingThreadProc, this));
+                for (unsigned int i = 0; i < AUDIO_DECODE_THREAD_COUNT; ++i)
+                    _decodeThreads.push_back(std::unique_ptr<std::thread>(new std::thread(&decodeThreadProc, this)));
+            }
+
+            // Wake the streaming thread so it starts refilling the source right away
+            _streamingCondition->notify_one();
         }
     }
 }
@@ -140,6 +329,9 @@ void AudioController::removePlayingSource(AudioSource* source)
         if (iter != _playingSources.end())
         {
             _playingSources.erase(iter);
+
+            if (!source->isStreamed() && source->_alSource)
+                _freeVoices.push_back(source->unbindVoice());
  
             if (source->isStreamed())
             {
@@ -147,24 +339,99 @@ void AudioController::removePlayingSource(AudioSource* source)
                 _streamingMutex->lock();
                 _streamingSources.erase(source);
                 _streamingMutex->unlock();
+
+                // The streaming thread can no longer schedule the buffer, so cancel any pending decode
+                cancelDecode(source->_buffer);
             }
         }
     } 
 }
 
+void AudioController::scheduleDecode(AudioBuffer* buffer)
+{
+    GP_ASSERT(buffer);
+
+    std::lock_guard<std::mutex> lock(*_decodeMutex);
+    if (!buffer->_decodeScheduled)
+    {
+        buffer->_decodeScheduled = true;
+        _decodeQueue.push_back(buffer);
+        _decodeCondition->notify_one();
+    }
+}
+
+void AudioController::cancelDecode(AudioBuffer* buffer)
+{
+    GP_ASSERT(buffer);
+
+    std::unique_lock<std::mutex> lock(*_decodeMutex);
+    std::deque<AudioBuffer*>::iterator itr = std::find(_decodeQueue.begin(), _decodeQueue.end(), buffer);
+    if (itr != _decodeQueue.end())
+    {
+        _decodeQueue.erase(itr);
+        buffer->_decodeScheduled = false;
+    }
+    while (buffer->_decoding)
+    {
+        _decodeDoneCondition->wait(lock);
+    }
+}
+
 void AudioController::streamingThreadProc(void* arg)
 {
     AudioController* controller = (AudioController*)arg;
 
+    // The lock is only held while refilling sources. Decoding happens on the decode
+    // threads, so play and stop calls never wait for it.
+    std::unique_lock<std::mutex> lock(*controller->_streamingMutex);
     while (controller->_streamingThreadActive)
     {
-        controller->_streamingMutex->lock();
+        float wait = AUDIO_STREAMING_MAX_WAIT;
+        for (std::set<AudioSource*>::iterator itr = controller->_streamingSources.begin(); itr != controller->_streamingSources.end(); ++itr)
+        {
+            AudioSource* source = *itr;
+            float timeUntilRefill;
+            if (source->streamDataIfNeeded(&timeUntilRefill))
+            {
+                wait = std::min(wait, timeUntilRefill);
+                if (source->_buffer->needsDecode())
+                    controller->scheduleDecode(source->_buffer);
+            }
+        }
+
+        // Sleep until the earliest source has a buffer to refill, or until a source
+        // starts playing or a decode finishes.
+        wait = std::max(wait, AUDIO_STREAMING_MIN_WAIT);
+        controller->_streamingCondition->wait_for(lock, std::chrono::microseconds((long long)(wait * 1000000.0f)));
+    }
+}
+
+void AudioController::decodeThreadProc(void* arg)
+{
+    AudioController* controller = (AudioController*)arg;
+
+    std::unique_lock<std::mutex> lock(*controller->_decodeMutex);
+    while (true)
+    {
+        while (controller->_streamingThreadActive && controller->_decodeQueue.empty())
+        {
+            controller->_decodeCondition->wait(lock);
+        }
+        if (!controller->_streamingThreadActive)
+            break;
+
+        AudioBuffer* buffer = controller->_decodeQueue.front();
+        controller->_decodeQueue.pop_front();
+        buffer->_decoding = true;
+
+        lock.unlock();
+        buffer->decodeData();
+        lock.lock();
 
-        std::for_each(controller->_streamingSources.begin(), controller->_streamingSources.end(), std::mem_fn(&AudioSource::streamDataIfNeeded));
-        
-        controller->_streamingMutex->unlock();
-   
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        buffer->_decoding = false;
+        buffer->_decodeScheduled = false;
+        controller->_decodeDoneCondition->notify_all();
+        controller->_streamingCondition->notify_one();
     }
 }
 
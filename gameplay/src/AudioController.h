@@ -6,6 +6,7 @@ namespace gameplay
 
 class AudioListener;
 class AudioSource;
+class AudioBuffer;
 
 /**
  * Defines a class for controlling game audio.
@@ -22,6 +23,62 @@ public:
      */
     virtual ~AudioController();
 
+    /**
+     * Gets the maximum number of voices used by audio sources that are not streamed.
+     *
+     * @return The maximum number of voices.
+     * @script{ignore}
+     */
+    unsigned int getMaxVoices() const;
+
+    /**
+     * Sets the maximum number of voices used by audio sources that are not streamed.
+     *
+     * Each voice is an OpenAL source. When more sources are playing than there are
+     * voices, the sources with the highest priority and audibility get the voices and
+     * the others play virtually until a voice is available.
+     *
+     * @param maxVoices The maximum number of voices.
+     * @script{ignore}
+     */
+    void setMaxVoices(unsigned int maxVoices);
+
+    /**
+     * Gets the memory budget of the cache of audio buffers that are not streamed.
+     *
+     * @return The budget in bytes.
+     * @script{ignore}
+     */
+    unsigned int getBufferCacheBudget() const;
+
+    /**
+     * Sets the memory budget of the cache of audio buffers that are not streamed.
+     *
+     * The budget covers both decoded and compressed data. Buffers that are no longer used
+     * by any audio source stay cached until the budget is exceeded, and are then evicted
+     * least recently used first.
+     *
+     * @param bytes The budget in bytes.
+     * @script{ignore}
+     */
+    void setBufferCacheBudget(unsigned int bytes);
+
+    /**
+     * Gets the number of bytes of decoded audio data held by buffers that are not streamed.
+     *
+     * @return The resident decoded data, in bytes.
+     * @script{ignore}
+     */
+    unsigned int getResidentPCMBytes() const;
+
+    /**
+     * Gets the number of bytes of compressed audio data held by buffers that are decoded when first played.
+     *
+     * @return The resident compressed data, in bytes.
+     * @script{ignore}
+     */
+    unsigned int getResidentCompressedBytes() const;
+
 private:
     
     /**
@@ -58,17 +115,62 @@ private:
     
     void removePlayingSource(AudioSource* source);
 
+    /**
+     * Assigns the voices to the playing sources with the highest priority and audibility
+     * and advances the virtual sources.
+     *
+     * @param elapsedTime The elapsed time, in milliseconds.
+     */
+    void updateVoices(float elapsedTime);
+
+    /**
+     * Gets an unused voice, creating one if the voice limit allows.
+     *
+     * @return The OpenAL source of the voice, or 0 if none is available.
+     */
+    ALuint acquireVoice();
+
+    /**
+     * Orders sources by descending priority, then by descending audibility.
+     */
+    static bool compareVoices(const AudioSource* a, const AudioSource* b);
+
+    /**
+     * Queues a streamed buffer for decoding on the decode threads, unless it is already queued.
+     *
+     * @param buffer The buffer to decode.
+     */
+    void scheduleDecode(AudioBuffer* buffer);
+
+    /**
+     * Removes a streamed buffer from the decode queue and waits for any decoding of it to finish.
+     *
+     * @param buffer The buffer to stop decoding.
+     */
+    void cancelDecode(AudioBuffer* buffer);
+
     static void streamingThreadProc(void* arg);
 
+    static void decodeThreadProc(void* arg);
+
     ALCdevice* _alcDevice;
     ALCcontext* _alcContext;
     std::set<AudioSource*> _playingSources;
     std::set<AudioSource*> _streamingSources;
     AudioSource* _pausingSource;
+    std::vector<ALuint> _freeVoices;
+    unsigned int _voiceCount;
+    unsigned int _maxVoices;
 
-    bool _streamingThreadActive;
+    std::atomic<bool> _streamingThreadActive;
     std::unique_ptr<std::thread> _streamingThread;
     std::unique_ptr<std::mutex> _streamingMutex;
+    std::unique_ptr<std::condition_variable> _streamingCondition;
+    std::vector<std::unique_ptr<std::thread>> _decodeThreads;
+    std::deque<AudioBuffer*> _decodeQueue;
+    std::unique_ptr<std::mutex> _decodeMutex;
+    std::unique_ptr<std::condition_variable> _decodeCondition;
+    std::unique_ptr<std::condition_variable> _decodeDoneCondition;
 };
 
 }
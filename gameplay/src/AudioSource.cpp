@@ -10,16 +10,25 @@ namespace gameplay
 {
 
 AudioSource::AudioSource(AudioBuffer* buffer, ALuint source) 
-    : _alSource(source), _buffer(buffer), _looped(false), _gain(1.0f), _pitch(1.0f), _node(NULL)
+    : _alSource(source), _buffer(buffer), _freeBufferCount(0), _state(INITIAL), _playOffset(0.0f), _priority(0), _audibility(0.0f),
+      _positionDirty(true), _looped(false), _gain(1.0f), _pitch(1.0f), _node(NULL)
 {
     GP_ASSERT(buffer);
 
-    if (isStreamed())
-        AL_CHECK(alSourceQueueBuffers(_alSource, 1, &buffer->_alBufferQueue[0]));
-    else
-        AL_CHECK(alSourcei(_alSource, AL_BUFFER, buffer->_alBufferQueue[0]));
+    // Sources that are not streamed only get an OpenAL source while the
+    // audio controller has a voice for them.
+    if (!_alSource)
+        return;
+
+    GP_ASSERT(isStreamed());
+
+    // The first buffer was filled when the file was loaded, the others are filled while streaming
+    AL_CHECK(alSourceQueueBuffers(_alSource, 1, &buffer->_alBufferQueue[0]));
+    int buffersNeeded = std::min<int>(buffer->_buffersNeededCount, AudioBuffer::STREAMING_BUFFER_QUEUE_SIZE);
+    for (int i = buffersNeeded - 1; i > 0; --i)
+        _freeBuffers[_freeBufferCount++] = buffer->_alBufferQueue[i];
     
-    AL_CHECK(alSourcei(_alSource, AL_LOOPING, _looped && !isStreamed()));
+    AL_CHECK(alSourcei(_alSource, AL_LOOPING, AL_FALSE));
     
     AL_CHECK( alSourcef(_alSource, AL_PITCH, _pitch) );
     AL_CHECK( alSourcef(_alSource, AL_GAIN, _gain) );
@@ -28,21 +37,25 @@ AudioSource::AudioSource(AudioBuffer* buffer, ALuint source)
 
 AudioSource::~AudioSource()
 {
+    // Remove the source from the controller's set of currently playing sources
+    // regardless of the source's state. E.g. when the AudioController::pause is called
+    // all sources are paused but still remain in controller's set of currently 
+    // playing sources. When the source is deleted afterwards, it should be removed
+    // from controller's set regardless of its playing state. This also returns the
+    // voice of a source that is not streamed.
+    AudioController* audioController = Game::getInstance()->getAudioController();
+    GP_ASSERT(audioController);
+    audioController->removePlayingSource(this);
+
     if (_alSource)
     {
-        // Remove the source from the controller's set of currently playing sources
-        // regardless of the source's state. E.g. when the AudioController::pause is called
-        // all sources are paused but still remain in controller's set of currently 
-        // playing sources. When the source is deleted afterwards, it should be removed
-        // from controller's set regardless of its playing state.
-        AudioController* audioController = Game::getInstance()->getAudioController();
-        GP_ASSERT(audioController);
-        audioController->removePlayingSource(this);
-
         AL_CHECK(alDeleteSources(1, &_alSource));
         _alSource = 0;
     }
     SAFE_RELEASE(_buffer);
+
+    // The buffer may now only be referenced by the buffer cache.
+    AudioBuffer::trimCache();
 }
 
 AudioSource* AudioSource::create(const char* url, bool streamed)
@@ -63,20 +76,27 @@ AudioSource* AudioSource::create(const char* url, bool streamed)
         return audioSource;
     }
 
+    return create(url, streamed, false);
+}
+
+AudioSource* AudioSource::create(const char* url, bool streamed, bool compressed)
+{
     // Create an audio buffer from this URL.
-    AudioBuffer* buffer = AudioBuffer::create(url, streamed);
+    AudioBuffer* buffer = AudioBuffer::create(url, streamed, compressed);
     if (buffer == NULL)
         return NULL;
 
-    // Load the audio source.
+    // Load the audio source. Streamed sources always keep their own OpenAL source.
     ALuint alSource = 0;
-
-    AL_CHECK( alGenSources(1, &alSource) );
-    if (AL_LAST_ERROR())
+    if (streamed)
     {
-        SAFE_RELEASE(buffer);
-        GP_ERROR("Error generating audio source.");
-        return NULL;
+        AL_CHECK( alGenSources(1, &alSource) );
+        if (AL_LAST_ERROR())
+        {
+            SAFE_RELEASE(buffer);
+            GP_ERROR("Error generating audio source.");
+            return NULL;
+        }
     }
     
     return new AudioSource(buffer, alSource);
@@ -105,8 +125,14 @@ AudioSource* AudioSource::create(Properties* properties)
         streamed = properties->getBool("streamed");
     }
 
+    bool compressed = false;
+    if (properties->exists("compressed"))
+    {
+        compressed = properties->getBool("compressed");
+    }
+
     // Create the audio source.
-    AudioSource* audio = AudioSource::create(path.c_str(), streamed);
+    AudioSource* audio = AudioSource::create(path.c_str(), streamed, compressed);
     if (audio == NULL)
     {
         GP_ERROR("Audio file '%s' failed to load properly.", path.c_str());
@@ -137,6 +163,9 @@ AudioSource* AudioSource::create(Properties* properties)
 
 AudioSource::State AudioSource::getState() const
 {
+    if (!_alSource)
+        return _state;
+
     ALint state;
     AL_CHECK( alGetSourcei(_alSource, AL_SOURCE_STATE, &state) );
 
@@ -162,7 +191,16 @@ bool AudioSource::isStreamed() const
 
 void AudioSource::play()
 {
-    AL_CHECK( alSourcePlay(_alSource) );
+    // Playing restarts the source unless it is paused
+    if (getState() != PAUSED)
+        _playOffset = 0.0f;
+    _state = PLAYING;
+
+    if (_alSource)
+    {
+        updatePosition();
+        AL_CHECK( alSourcePlay(_alSource) );
+    }
 
     // Add the source to the controller's list of currently playing sources.
     AudioController* audioController = Game::getInstance()->getAudioController();
@@ -172,13 +210,19 @@ void AudioSource::play()
 
 void AudioSource::pause()
 {
-    AL_CHECK( alSourcePause(_alSource) );
-
     // Remove the source from the controller's set of currently playing sources
     // if the source is being paused by the user and not the controller itself.
+    // This is done first so the streaming thread cannot restart a streamed source
+    // that ran out of data while it is being paused.
     AudioController* audioController = Game::getInstance()->getAudioController();
     GP_ASSERT(audioController);
     audioController->removePlayingSource(this);
+
+    _state = PAUSED;
+    if (_alSource)
+    {
+        AL_CHECK( alSourcePause(_alSource) );
+    }
 }
 
 void AudioSource::resume()
@@ -191,17 +235,37 @@ void AudioSource::resume()
 
 void AudioSource::stop()
 {
-    AL_CHECK( alSourceStop(_alSource) );
-
     // Remove the source from the controller's set of currently playing sources.
+    // This is done first so the streaming thread cannot restart a streamed source
+    // that ran out of data after it is stopped.
     AudioController* audioController = Game::getInstance()->getAudioController();
     GP_ASSERT(audioController);
     audioController->removePlayingSource(this);
+
+    _state = STOPPED;
+    _playOffset = 0.0f;
+    if (_alSource)
+    {
+        AL_CHECK( alSourceStop(_alSource) );
+    }
 }
 
 void AudioSource::rewind()
 {
-    AL_CHECK( alSourceRewind(_alSource) );
+    _state = INITIAL;
+    _playOffset = 0.0f;
+    if (_alSource)
+    {
+        AL_CHECK( alSourceRewind(_alSource) );
+    }
+
+    // A rewound source is no longer playing and does not need a voice
+    if (!isStreamed())
+    {
+        AudioController* audioController = Game::getInstance()->getAudioController();
+        GP_ASSERT(audioController);
+        audioController->removePlayingSource(this);
+    }
 }
 
 bool AudioSource::isLooped() const
@@ -211,12 +275,16 @@ bool AudioSource::isLooped() const
 
 void AudioSource::setLooped(bool looped)
 {
-    AL_CHECK(alSourcei(_alSource, AL_LOOPING, (looped && !isStreamed()) ? AL_TRUE : AL_FALSE));
-    if (AL_LAST_ERROR())
+    if (_alSource)
     {
-        GP_ERROR("Failed to set audio source's looped attribute with error: %d", AL_LAST_ERROR());
+        AL_CHECK(alSourcei(_alSource, AL_LOOPING, (looped && !isStreamed()) ? AL_TRUE : AL_FALSE));
+        if (AL_LAST_ERROR())
+        {
+            GP_ERROR("Failed to set audio source's looped attribute with error: %d", AL_LAST_ERROR());
+        }
     }
     _looped = looped;
+    _buffer->_looped = looped;
 }
 
 float AudioSource::getGain() const
@@ -226,7 +294,8 @@ float AudioSource::getGain() const
 
 void AudioSource::setGain(float gain)
 {
-    AL_CHECK( alSourcef(_alSource, AL_GAIN, gain) );
+    if (_alSource)
+        AL_CHECK( alSourcef(_alSource, AL_GAIN, gain) );
     _gain = gain;
 }
 
@@ -237,7 +306,8 @@ float AudioSource::getPitch() const
 
 void AudioSource::setPitch(float pitch)
 {
-    AL_CHECK( alSourcef(_alSource, AL_PITCH, pitch) );
+    if (_alSource)
+        AL_CHECK( alSourcef(_alSource, AL_PITCH, pitch) );
     _pitch = pitch;
 }
 
@@ -248,7 +318,8 @@ const Vector3& AudioSource::getVelocity() const
 
 void AudioSource::setVelocity(const Vector3& velocity)
 {
-    AL_CHECK( alSourcefv(_alSource, AL_VELOCITY, (ALfloat*)&velocity) );
+    if (_alSource)
+        AL_CHECK( alSourcefv(_alSource, AL_VELOCITY, (ALfloat*)&velocity) );
     _velocity = velocity;
 }
 
@@ -257,6 +328,16 @@ void AudioSource::setVelocity(float x, float y, float z)
     setVelocity(Vector3(x, y, z));
 }
 
+int AudioSource::getPriority() const
+{
+    return _priority;
+}
+
+void AudioSource::setPriority(int priority)
+{
+    _priority = priority;
+}
+
 Node* AudioSource::getNode() const
 {
     return _node;
@@ -286,11 +367,98 @@ void AudioSource::setNode(Node* node)
 
 void AudioSource::transformChanged(Transform* transform, long cookie)
 {
-    if (_node)
+    // The audio controller pushes the position to OpenAL once per frame
+    _positionDirty = true;
+}
+
+void AudioSource::updatePosition()
+{
+    if (_alSource && _positionDirty)
     {
-        Vector3 translation = _node->getTranslationWorld();
+        Vector3 translation = _node ? _node->getTranslationWorld() : Vector3::zero();
         AL_CHECK( alSourcefv(_alSource, AL_POSITION, (const ALfloat*)&translation.x) );
+        _positionDirty = false;
+    }
+}
+
+void AudioSource::bindVoice(ALuint alSource)
+{
+    GP_ASSERT(!isStreamed());
+    GP_ASSERT(_alSource == 0 && alSource);
+
+    // Compressed buffers are decoded when they are first played.
+    ++_buffer->_voiceCount;
+    _buffer->touch();
+    _buffer->decode();
+    AudioBuffer::trimCache();
+
+    _alSource = alSource;
+    AL_CHECK( alSourcei(_alSource, AL_BUFFER, _buffer->_alBufferQueue[0]) );
+    AL_CHECK( alSourcei(_alSource, AL_LOOPING, _looped ? AL_TRUE : AL_FALSE) );
+    AL_CHECK( alSourcef(_alSource, AL_PITCH, _pitch) );
+    AL_CHECK( alSourcef(_alSource, AL_GAIN, _gain) );
+    AL_CHECK( alSourcefv(_alSource, AL_VELOCITY, (const ALfloat*)&_velocity) );
+    _positionDirty = true;
+    updatePosition();
+
+    // Continue from where the virtual voice got to
+    AL_CHECK( alSourcef(_alSource, AL_SEC_OFFSET, _playOffset) );
+    if (_state == PLAYING)
+    {
+        AL_CHECK( alSourcePlay(_alSource) );
+    }
+    else if (_state == PAUSED)
+    {
+        AL_CHECK( alSourcePause(_alSource) );
+    }
+}
+
+ALuint AudioSource::unbindVoice()
+{
+    GP_ASSERT(!isStreamed());
+
+    ALuint alSource = _alSource;
+    if (alSource)
+    {
+        // Remember the playback position so the virtual voice can continue from it
+        _state = getState();
+        if (_state == PLAYING || _state == PAUSED)
+            AL_CHECK( alGetSourcef(alSource, AL_SEC_OFFSET, &_playOffset) );
+        else
+            _playOffset = 0.0f;
+
+        AL_CHECK( alSourceStop(alSource) );
+        AL_CHECK( alSourcei(alSource, AL_BUFFER, 0) );
+        _alSource = 0;
+        --_buffer->_voiceCount;
+    }
+    return alSource;
+}
+
+bool AudioSource::updateVirtualVoice(float elapsedTime)
+{
+    GP_ASSERT(!isStreamed() && _alSource == 0);
+
+    if (_state != PLAYING)
+        return _state == PAUSED;
+
+    // Advance the playback position as if the source were playing
+    float duration = _buffer->getDuration();
+    _playOffset += elapsedTime * 0.001f * _pitch;
+    if (_playOffset >= duration)
+    {
+        if (_looped && duration > 0.0f)
+        {
+            _playOffset = fmodf(_playOffset, duration);
+        }
+        else
+        {
+            _state = STOPPED;
+            _playOffset = 0.0f;
+            return false;
+        }
     }
+    return true;
 }
 
 AudioSource* AudioSource::clone(NodeCloneContext& context)
@@ -298,15 +466,19 @@ AudioSource* AudioSource::clone(NodeCloneContext& context)
     GP_ASSERT(_buffer);
 
     ALuint alSource = 0;
-    AL_CHECK( alGenSources(1, &alSource) );
-    if (AL_LAST_ERROR())
+    if (isStreamed())
     {
-        GP_ERROR("Unable to cloning audio.");
-        return NULL;
+        AL_CHECK( alGenSources(1, &alSource) );
+        if (AL_LAST_ERROR())
+        {
+            GP_ERROR("Unable to cloning audio.");
+            return NULL;
+        }
     }
     AudioSource* audioClone = new AudioSource(_buffer, alSource);
 
     _buffer->addRef();
+    audioClone->setPriority(getPriority());
     audioClone->setLooped(isLooped());
     audioClone->setGain(getGain());
     audioClone->setPitch(getPitch());
@@ -322,42 +494,49 @@ AudioSource* AudioSource::clone(NodeCloneContext& context)
     return audioClone;
 }
 
-bool AudioSource::streamDataIfNeeded()
+bool AudioSource::streamDataIfNeeded(float* timeUntilRefill)
 {
     GP_ASSERT( isStreamed() );
-    if( getState() != PLAYING )
+    GP_ASSERT(timeUntilRefill);
+
+    *timeUntilRefill = 0.0f;
+    State state = getState();
+    if (state != PLAYING && state != STOPPED)
         return false;
 
-    int queuedBuffers;
-    alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queuedBuffers);
- 
-    int buffersNeeded = std::min<int>(_buffer->_buffersNeededCount, AudioBuffer::STREAMING_BUFFER_QUEUE_SIZE);
-    if (queuedBuffers < buffersNeeded)
+    // Reclaim the buffers that have finished playing
+    int processedBuffers;
+    alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &processedBuffers);
+    while (processedBuffers-- > 0)
     {
-        while (queuedBuffers < buffersNeeded)
-        {
-            if (!_buffer->streamData(_buffer->_alBufferQueue[queuedBuffers], _looped))
-                return false;
-            
-            AL_CHECK( alSourceQueueBuffers(_alSource, 1, &_buffer->_alBufferQueue[queuedBuffers]) );
-            queuedBuffers++;
-        }
+        ALuint bufferID;
+        AL_CHECK( alSourceUnqueueBuffers(_alSource, 1, &bufferID) );
+        GP_ASSERT(_freeBufferCount < AudioBuffer::STREAMING_BUFFER_QUEUE_SIZE);
+        _freeBuffers[_freeBufferCount++] = bufferID;
     }
-    else
+
+    // Refill them with whatever the decode threads have ready
+    bool queued = false;
+    while (_freeBufferCount > 0 && _buffer->popDecodedData(_freeBuffers[_freeBufferCount - 1]))
     {
-        int processedBuffers;
-        alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &processedBuffers);
- 
-        while (processedBuffers-- > 0)
-        {
-            ALuint bufferID;
-            AL_CHECK( alSourceUnqueueBuffers(_alSource, 1, &bufferID) );
-            if (!_buffer->streamData(bufferID, _looped))
-                return false;
-            
-            AL_CHECK( alSourceQueueBuffers(_alSource, 1, &bufferID) );
-        }
+        AL_CHECK( alSourceQueueBuffers(_alSource, 1, &_freeBuffers[--_freeBufferCount]) );
+        queued = true;
     }
+
+    int queuedBuffers;
+    alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queuedBuffers);
+    if (state == STOPPED)
+    {
+        // The source ran out of data before it was refilled; restart it with the new data.
+        if (!queued)
+            return !_buffer->isStreamFinished();
+        AL_CHECK( alSourcePlay(_alSource) );
+    }
+
+    // The next buffer is processed once the current one has finished playing
+    float offset = 0.0f;
+    alGetSourcef(_alSource, AL_SEC_OFFSET, &offset);
+    *timeUntilRefill = queuedBuffers > 0 ? std::max(_buffer->getStreamingBufferDuration() - offset, 0.0f) : 0.0f;
     return true;
 }
 
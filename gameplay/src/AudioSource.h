@@ -4,11 +4,11 @@
 #include "Vector3.h"
 #include "Ref.h"
 #include "Transform.h"
+#include "AudioBuffer.h"
 
 namespace gameplay
 {
 
-class AudioBuffer;
 class Node;
 class NodeCloneContext;
 
@@ -162,6 +162,28 @@ public:
      */
     void setVelocity(float x, float y, float z);
 
+    /**
+     * Gets the priority of the audio source.
+     *
+     * @return The priority.
+     * @script{ignore}
+     */
+    int getPriority() const;
+
+    /**
+     * Sets the priority of the audio source.
+     *
+     * When more sources are playing than the audio controller has voices for, sources
+     * with a higher priority get a voice first. Sources of equal priority are ordered by
+     * how loud they are at the listener. Sources without a voice are virtual: they are
+     * silent but keep advancing their playback position. Streamed sources always have
+     * their own voice.
+     *
+     * @param priority The priority of the source. The default is 0.
+     * @script{ignore}
+     */
+    void setPriority(int priority);
+
     /**
      * Gets the node that this source is attached to.
      * 
@@ -181,6 +203,17 @@ private:
      */
     virtual ~AudioSource();
 
+    /**
+     * Creates an audio source from a sound file.
+     *
+     * @param url The relative location on disk of the sound file.
+     * @param streamed True to play from a stream that is read on demand.
+     * @param compressed True to keep an Ogg file compressed in memory until it is first played.
+     *
+     * @return The newly created audio source, or NULL if an audio source cannot be created.
+     */
+    static AudioSource* create(const char* url, bool streamed, bool compressed);
+
     /**
      * Hidden copy assignment operator.
      */
@@ -196,6 +229,34 @@ private:
      */
     void transformChanged(Transform* transform, long cookie);
 
+    /**
+     * Pushes the position of the node to the OpenAL source if it has changed.
+     */
+    void updatePosition();
+
+    /**
+     * Gives a source that is not streamed an OpenAL source to play through.
+     *
+     * @param alSource The OpenAL source.
+     */
+    void bindVoice(ALuint alSource);
+
+    /**
+     * Takes the OpenAL source of a source that is not streamed, leaving it virtual.
+     *
+     * @return The OpenAL source, or 0 if the source was already virtual.
+     */
+    ALuint unbindVoice();
+
+    /**
+     * Advances the playback position of a virtual source.
+     *
+     * @param elapsedTime The elapsed time, in milliseconds.
+     *
+     * @return False if the source has stopped playing.
+     */
+    bool updateVirtualVoice(float elapsedTime);
+
     /**
      * Clones the audio source and returns a new audio source.
      * 
@@ -204,10 +265,24 @@ private:
      */
     AudioSource* clone(NodeCloneContext& context);
 
-    bool streamDataIfNeeded();
+    /**
+     * Refills the processed streaming buffers of the source with decoded data.
+     *
+     * @param timeUntilRefill Populated with the time until the next buffer is processed, in seconds.
+     *
+     * @return True if the source is still streaming, false if it is not playing or the stream has ended.
+     */
+    bool streamDataIfNeeded(float* timeUntilRefill);
 
     ALuint _alSource;
     AudioBuffer* _buffer;
+    ALuint _freeBuffers[AudioBuffer::STREAMING_BUFFER_QUEUE_SIZE];
+    int _freeBufferCount;
+    State _state;
+    float _playOffset;
+    int _priority;
+    float _audibility;
+    bool _positionDirty;
     bool _looped;
     float _gain;
     float _pitch;
@@ -22,6 +22,7 @@
 #include <set>
 #include <stack>
 #include <map>
+#include <unordered_map>
 #include <queue>
 #include <algorithm>
 #include <limits>
@@ -30,6 +31,8 @@
 #include <typeinfo>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include <chrono>
 #include "Logger.h"
 
@@ -223,10 +226,12 @@ using std::va_list;
         #define GLEW_STATIC
         #include <GL/glew.h>
         #define GP_USE_VAO
+        #define GP_USE_MAP_BUFFER_RANGE
 #elif __linux__
         #define GLEW_STATIC
         #include <GL/glew.h>
         #define GP_USE_VAO
+        #define GP_USE_MAP_BUFFER_RANGE
 #elif __APPLE__
     #include "TargetConditionals.h"
     #if TARGET_OS_IPHONE || TARGET_IPHONE_SIMULATOR
@@ -310,6 +315,25 @@ typedef unsigned long GamepadHandle;
  * @script{ignore} */
 extern GLenum __gl_error_code;
 
+// Headless builds have no GL context, so their GL calls go to the null GL backend.
+#if defined(GP_HEADLESS) && !defined(GP_GL_NULL)
+    #define GP_GL_NULL
+#endif
+#ifdef GP_GL_NULL
+    #if defined(OPENGL_ES) || defined(__APPLE__)
+        #error "The null GL backend is only supported on platforms that use GLEW."
+    #endif
+    #include "GLNull.h"
+#endif
+
+// Count GL calls with the GL call recorder, which forwards them to the driver or the null GL backend.
+#ifdef GP_GL_RECORDER
+    #if defined(OPENGL_ES) || defined(__APPLE__)
+        #error "The GL call recorder is only supported on platforms that use GLEW."
+    #endif
+    #include "GLRecorder.h"
+#endif
+
 /**
  * Executes the specified AL code and checks the AL error afterwards
  * to ensure it succeeded.
@@ -30,6 +30,15 @@
 #define BUNDLE_VERSION_MAJOR_FONT_FORMAT  1
 #define BUNDLE_VERSION_MINOR_FONT_FORMAT  5
 
+#define BUNDLE_VERSION_MAJOR_VERTEX_TYPE  1
+#define BUNDLE_VERSION_MINOR_VERTEX_TYPE  6
+
+#define BUNDLE_VERSION_MAJOR_MODEL_LOD    1
+#define BUNDLE_VERSION_MINOR_MODEL_LOD    7
+
+#define BUNDLE_VERSION_MAJOR_ANIMATION_COMPRESSION  1
+#define BUNDLE_VERSION_MINOR_ANIMATION_COMPRESSION  8
+
 namespace gameplay
 {
 
@@ -1023,6 +1032,37 @@ Model* Bundle::readModel(const char* nodeId)
                     }
                 }
             }
+            // In bundle version 1.7 we introduced level of detail meshes for models
+            if (getVersionMajor() >= BUNDLE_VERSION_MAJOR_MODEL_LOD && getVersionMinor() >= BUNDLE_VERSION_MINOR_MODEL_LOD)
+            {
+                unsigned int lodCount;
+                if (!read(&lodCount))
+                {
+                    GP_ERROR("Failed to load level of detail count for model with mesh '%s' in bundle '%s'.", xref.c_str() + 1, _path.c_str());
+                    SAFE_RELEASE(model);
+                    return NULL;
+                }
+                for (unsigned int i = 0; i < lodCount; ++i)
+                {
+                    std::string lodXref = readString(_stream);
+                    float screenSize;
+                    if (!read(&screenSize))
+                    {
+                        GP_ERROR("Failed to load level of detail screen size for model with mesh '%s' in bundle '%s'.", xref.c_str() + 1, _path.c_str());
+                        SAFE_RELEASE(model);
+                        return NULL;
+                    }
+                    if (lodXref.length() > 1 && lodXref[0] == '#')
+                    {
+                        Mesh* lodMesh = loadMesh(lodXref.c_str() + 1, nodeId);
+                        if (lodMesh)
+                        {
+                            model->addLod(lodMesh, screenSize);
+                            SAFE_RELEASE(lodMesh);
+                        }
+                    }
+                }
+            }
             return model;
         }
     }
@@ -1291,6 +1331,19 @@ Animation* Bundle::readAnimationChannelData(Animation* animation, const char* id
 {
     GP_ASSERT(id);
 
+    if (getVersionMajor() >= BUNDLE_VERSION_MAJOR_ANIMATION_COMPRESSION && getVersionMinor() >= BUNDLE_VERSION_MINOR_ANIMATION_COMPRESSION)
+    {
+        // Read whether the channel is stored compressed.
+        unsigned char compressed;
+        if (!read(&compressed))
+        {
+            GP_ERROR("Failed to read the compression flag for animation '%s'.", id);
+            return NULL;
+        }
+        if (compressed)
+            return readCompressedAnimationChannelData(animation, id, target, targetAttribute);
+    }
+
     std::vector<unsigned int> keyTimes;
     std::vector<float> values;
     std::vector<float> tangentsIn;
@@ -1357,6 +1410,84 @@ Animation* Bundle::readAnimationChannelData(Animation* animation, const char* id
     return animation;
 }
 
+Animation* Bundle::readCompressedAnimationChannelData(Animation* animation, const char* id, AnimationTarget* target, unsigned int targetAttribute)
+{
+    GP_ASSERT(id);
+
+    // Read the key count and the duration of the channel in milliseconds.
+    unsigned int keyCount;
+    unsigned int duration;
+    if (!read(&keyCount) || !read(&duration) || keyCount == 0)
+    {
+        GP_ERROR("Failed to read key count for animation '%s'.", id);
+        return NULL;
+    }
+
+    // Read the key times, quantized over the duration.
+    std::vector<unsigned short> keyTimes(keyCount);
+    if (_stream->read(&keyTimes[0], sizeof(unsigned short), keyCount) != keyCount)
+    {
+        GP_ERROR("Failed to read key times for animation '%s'.", id);
+        return NULL;
+    }
+
+    // Read the layout of the key values (the quaternion offset is -1 if there is no rotation).
+    unsigned int offset;
+    unsigned int componentCount;
+    if (!read(&offset) || !read(&componentCount))
+    {
+        GP_ERROR("Failed to read key value layout for animation '%s'.", id);
+        return NULL;
+    }
+    int quaternionOffset = (int)offset;
+    if (quaternionOffset >= 0 && (unsigned int)quaternionOffset + 4 > componentCount)
+    {
+        GP_ERROR("Failed to read key value layout for animation '%s'.", id);
+        return NULL;
+    }
+    unsigned int scalarCount = quaternionOffset >= 0 ? componentCount - 4 : componentCount;
+    unsigned int stride = quaternionOffset >= 0 ? scalarCount + 3 : scalarCount;
+
+    // Read the minimum and step of each scalar component.
+    std::vector<float> ranges(scalarCount * 2 + 1);
+    if (scalarCount > 0 && _stream->read(&ranges[0], sizeof(float), scalarCount * 2) != scalarCount * 2)
+    {
+        GP_ERROR("Failed to read key value ranges for animation '%s'.", id);
+        return NULL;
+    }
+
+    // Read the quantized key values.
+    std::vector<unsigned short> values(keyCount * stride + 1);
+    if (stride > 0 && _stream->read(&values[0], sizeof(unsigned short), keyCount * stride) != keyCount * stride)
+    {
+        GP_ERROR("Failed to read key values for animation '%s'.", id);
+        return NULL;
+    }
+
+    if (targetAttribute > 0)
+    {
+        GP_ASSERT(target);
+        if (target->getAnimationPropertyComponentCount(targetAttribute) != componentCount)
+        {
+            GP_ERROR("Invalid component count (%u) for compressed animation '%s'.", componentCount, id);
+            return animation;
+        }
+
+        Curve* curve = new Curve(keyCount, componentCount, quaternionOffset, &keyTimes[0], &values[0], &ranges[0]);
+        if (animation == NULL)
+        {
+            animation = new Animation(id, target, targetAttribute, curve, duration);
+        }
+        else
+        {
+            animation->createChannel(target, targetAttribute, curve, duration);
+        }
+        curve->release();
+    }
+
+    return animation;
+}
+
 Mesh* Bundle::loadMesh(const char* id)
 {
     return loadMesh(id, NULL);
@@ -1471,6 +1602,26 @@ Bundle::MeshData* Bundle::readMeshData()
 
         vertexElements[i].usage = (VertexFormat::Usage)vUsage;
         vertexElements[i].size = vSize;
+
+        // In bundle version 1.6 we introduced non-float vertex element types
+        if (getVersionMajor() >= BUNDLE_VERSION_MAJOR_VERTEX_TYPE && getVersionMinor() >= BUNDLE_VERSION_MINOR_VERTEX_TYPE)
+        {
+            unsigned int vType, vNormalized;
+            if (_stream->read(&vType, 4, 1) != 1 || _stream->read(&vNormalized, 4, 1) != 1)
+            {
+                GP_ERROR("Failed to load vertex type.");
+                SAFE_DELETE_ARRAY(vertexElements);
+                return NULL;
+            }
+            if (vType > VertexFormat::INT_2_10_10_10 || (vType == VertexFormat::INT_2_10_10_10 && vSize != 4))
+            {
+                GP_ERROR("Failed to load mesh data; invalid vertex type (%d) for vertex element of size %d.", vType, vSize);
+                SAFE_DELETE_ARRAY(vertexElements);
+                return NULL;
+            }
+            vertexElements[i].type = (VertexFormat::Type)vType;
+            vertexElements[i].normalized = vNormalized != 0;
+        }
     }
 
     MeshData* meshData = new MeshData(VertexFormat(vertexElements, vertexElementCount));
@@ -17,6 +17,7 @@ namespace gameplay
 class Bundle : public Ref
 {
     friend class PhysicsController;
+    friend class StaticBatch;
     friend class SceneLoader;
 
 public:
@@ -428,6 +429,20 @@ private:
      */
     Animation* readAnimationChannelData(Animation* animation, const char* id, AnimationTarget* target, unsigned int targetAttribute);
 
+    /**
+     * Reads the compressed animation channel data at the current file position into the given animation
+     * (with the given animation target and target attribute).
+     *
+     * @param animation The animation to the load channel into.
+     * @param id The ID of the animation that this channel is loaded into.
+     * @param target The animation target.
+     * @param targetAttribute The target attribute being animated.
+     *
+     * @return The animation that the channel was loaded into.
+     * @see Curve::isCompressed
+     */
+    Animation* readCompressedAnimationChannelData(Animation* animation, const char* id, AnimationTarget* target, unsigned int targetAttribute);
+
     /**
      * Sets the transformation matrix.
      *
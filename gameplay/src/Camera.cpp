@@ -343,6 +343,20 @@ const Frustum& Camera::getFrustum() const
     return _bounds;
 }
 
+float Camera::getProjectedSize(const BoundingSphere& sphere) const
+{
+    if (_type == Camera::PERSPECTIVE)
+    {
+        float distance = _node ? sphere.center.distance(_node->getTranslationWorld()) : sphere.center.length();
+        float halfHeight = distance * tan(MATH_DEG_TO_RAD(_fieldOfView) * 0.5f);
+        return halfHeight > 0.0f ? sphere.radius / halfHeight : FLT_MAX;
+    }
+    else
+    {
+        return 2.0f * sphere.radius / _zoom[1];
+    }
+}
+
 void Camera::project(const Rectangle& viewport, const Vector3& position, float* x, float* y, float* depth) const
 {
     GP_ASSERT(x);
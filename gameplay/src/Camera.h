@@ -249,6 +249,15 @@ public:
      */
     const Frustum& getFrustum() const;
 
+    /**
+     * Gets the diameter of a bounding sphere projected by this camera, relative to the viewport height.
+     *
+     * @param sphere The world space bounding sphere.
+     *
+     * @return The projected size, where 1 covers the height of the viewport.
+     */
+    float getProjectedSize(const BoundingSphere& sphere) const;
+
     /**
      * Projects the specified world position into the viewport coordinates.
      *
@@ -30,6 +30,15 @@ using std::strcmp;
 #define MATH_PIX2 6.28318530717958647693f
 #endif
 
+// Range of the three smallest components of a unit quaternion: [-1/sqrt(2), 1/sqrt(2)]
+#define CURVE_QUATERNION_MIN 0.70710678118654752440f
+
+// Largest quantized value of a compressed quaternion component (15 bits)
+#define CURVE_QUATERNION_QUANTIZED_MAX 32767.0f
+
+// Largest quantized value of a compressed key time (16 bits)
+#define CURVE_TIME_QUANTIZED_MAX 65535.0f
+
 // Object deletion macro
 #ifndef SAFE_DELETE
 #define SAFE_DELETE(x) \
@@ -89,7 +98,8 @@ Curve* Curve::create(unsigned int pointCount, unsigned int componentCount)
 }
 
 Curve::Curve(unsigned int pointCount, unsigned int componentCount)
-    : _pointCount(pointCount), _componentCount(componentCount), _componentSize(sizeof(float)*componentCount), _quaternionOffset(NULL), _points(NULL)
+    : _pointCount(pointCount), _componentCount(componentCount), _componentSize(sizeof(float)*componentCount), _quaternionOffset(NULL), _points(NULL),
+      _compressedTimes(NULL), _compressedValues(NULL), _compressedRanges(NULL), _compressedStride(0)
 {
     _points = new Point[_pointCount];
     for (unsigned int i = 0; i < _pointCount; i++)
@@ -103,10 +113,37 @@ Curve::Curve(unsigned int pointCount, unsigned int componentCount)
     _points[_pointCount - 1].time = 1.0f;
 }
 
+Curve::Curve(unsigned int pointCount, unsigned int componentCount, int quaternionOffset,
+             const unsigned short* keyTimes, const unsigned short* keyValues, const float* ranges)
+    : _pointCount(pointCount), _componentCount(componentCount), _componentSize(sizeof(float)*componentCount), _quaternionOffset(NULL), _points(NULL),
+      _compressedTimes(NULL), _compressedValues(NULL), _compressedRanges(NULL), _compressedStride(componentCount)
+{
+    assert(pointCount > 0 && keyTimes && keyValues && ranges);
+    assert(quaternionOffset < 0 || (unsigned int)quaternionOffset + 4 <= componentCount);
+
+    unsigned int scalarCount = componentCount;
+    if (quaternionOffset >= 0)
+    {
+        setQuaternionOffset(quaternionOffset);
+        scalarCount -= 4;
+        _compressedStride = scalarCount + 3;
+    }
+
+    _compressedTimes = new unsigned short[pointCount];
+    memcpy(_compressedTimes, keyTimes, sizeof(unsigned short) * pointCount);
+    _compressedValues = new unsigned short[pointCount * _compressedStride];
+    memcpy(_compressedValues, keyValues, sizeof(unsigned short) * pointCount * _compressedStride);
+    _compressedRanges = new float[scalarCount * 2];
+    memcpy(_compressedRanges, ranges, sizeof(float) * scalarCount * 2);
+}
+
 Curve::~Curve()
 {
     SAFE_DELETE_ARRAY(_points);
     SAFE_DELETE_ARRAY(_quaternionOffset);
+    SAFE_DELETE_ARRAY(_compressedTimes);
+    SAFE_DELETE_ARRAY(_compressedValues);
+    SAFE_DELETE_ARRAY(_compressedRanges);
 }
 
 Curve::Point::Point()
@@ -133,17 +170,28 @@ unsigned int Curve::getComponentCount() const
 
 float Curve::getStartTime() const
 {
+    if (_compressedTimes)
+        return getCompressedTime(0);
     return _points[0].time;
 }
 
 float Curve::getEndTime() const
 {
+    if (_compressedTimes)
+        return getCompressedTime(_pointCount-1);
     return _points[_pointCount-1].time;
 }
 
+bool Curve::isCompressed() const
+{
+    return _compressedTimes != NULL;
+}
+
 float Curve::getPointTime(unsigned int index) const
 {
     assert(index < _pointCount);
+    if (_compressedTimes)
+        return getCompressedTime(index);
     return _points[index].time;
 }
 
@@ -151,12 +199,26 @@ float Curve::getPointTime(unsigned int index) const
 Curve::InterpolationType Curve::getPointInterpolation(unsigned int index) const
 {
     assert(index < _pointCount);
+    if (_compressedTimes)
+        return LINEAR;
     return _points[index].type;;
 }
 
 void Curve::getPointValues(unsigned int index, float* value, float* inValue, float* outValue) const
 {
     assert(index < _pointCount);
+
+    if (_compressedTimes)
+    {
+        // Compressed curves are linear and have no tangents
+        if (value)
+            decompressPoint(index, value);
+        if (inValue)
+            memset(inValue, 0, _componentSize);
+        if (outValue)
+            memset(outValue, 0, _componentSize);
+        return;
+    }
     
     if (value)
         memcpy(value, _points[index].value, _componentSize);
@@ -176,6 +238,9 @@ void Curve::setPoint(unsigned int index, float time, float* value, Interpolation
 void Curve::setPoint(unsigned int index, float time, float* value, InterpolationType type, float* inValue, float* outValue)
 {
     assert(index < _pointCount && time >= 0.0f && time <= 1.0f && !(_pointCount > 1 && index == 0 && time != 0.0f) && !(_pointCount != 1 && index == _pointCount - 1 && time != 1.0f));
+    assert(!_compressedTimes);
+    if (_compressedTimes)
+        return;
 
     _points[index].time = time;
     _points[index].type = type;
@@ -193,6 +258,9 @@ void Curve::setPoint(unsigned int index, float time, float* value, Interpolation
 void Curve::setTangent(unsigned int index, InterpolationType type, float* inValue, float* outValue)
 {
     assert(index < _pointCount);
+    assert(!_compressedTimes);
+    if (_compressedTimes)
+        return;
 
     _points[index].type = type;
 
@@ -214,6 +282,12 @@ void Curve::evaluate(float time, float startTime, float endTime, float loopBlend
 {
     assert(dst && startTime >= 0.0f && startTime <= endTime && endTime <= 1.0f && loopBlendTime >= 0.0f);
 
+    if (_compressedTimes)
+    {
+        evaluateCompressed(time, startTime, endTime, loopBlendTime, dst);
+        return;
+    }
+
     // If there's only one point on the curve, return its value.
     if (_pointCount == 1)
     {
@@ -1198,9 +1272,11 @@ void Curve::interpolateHermiteSmooth(float s, unsigned int index, Point* from, P
 
 void Curve::interpolateLinear(float s, Point* from, Point* to, float* dst) const
 {
-    float* fromValue = from->value;
-    float* toValue = to->value;
+    interpolateValues(s, from->value, to->value, dst);
+}
 
+void Curve::interpolateValues(float s, float* fromValue, float* toValue, float* dst) const
+{
     if (!_quaternionOffset)
     {
         for (unsigned int i = 0; i < _componentCount; i++)
@@ -1267,6 +1343,147 @@ int Curve::determineIndex(float time, unsigned int min, unsigned int max) const
     return max;
 }
 
+void Curve::evaluateCompressed(float time, float startTime, float endTime, float loopBlendTime, float* dst) const
+{
+    // Same as evaluate() for linear points, decoding only the two points interpolated between.
+    if (_pointCount == 1)
+    {
+        decompressPoint(0, dst);
+        return;
+    }
+
+    unsigned int min = 0;
+    unsigned int max = _pointCount - 1;
+    float localTime = time;
+    if (startTime > 0.0f || endTime < 1.0f)
+    {
+        // Evaluating a sub section of the curve
+        min = determineCompressedIndex(startTime, 0, max);
+        max = determineCompressedIndex(endTime, min, max);
+
+        // Convert time to fall within the subregion
+        localTime = getCompressedTime(min) + (getCompressedTime(max) - getCompressedTime(min)) * time;
+    }
+
+    float minTime = getCompressedTime(min);
+    float maxTime = getCompressedTime(max);
+    if (loopBlendTime == 0.0f)
+    {
+        // If no loop blend time is specified, clamp time to end points
+        if (localTime < minTime)
+            localTime = minTime;
+        else if (localTime > maxTime)
+            localTime = maxTime;
+    }
+
+    // If an exact endpoint was specified, skip interpolation and return the value directly
+    if (localTime == minTime)
+    {
+        decompressPoint(min, dst);
+        return;
+    }
+    if (localTime == maxTime)
+    {
+        decompressPoint(max, dst);
+        return;
+    }
+
+    unsigned int from;
+    unsigned int to;
+    float t;
+    if (localTime > maxTime)
+    {
+        // Looping forward
+        from = max;
+        to = min;
+        t = (localTime - maxTime) / loopBlendTime;
+    }
+    else if (localTime < minTime)
+    {
+        // Looping in reverse
+        from = min;
+        to = max;
+        t = (minTime - localTime) / loopBlendTime;
+    }
+    else
+    {
+        from = determineCompressedIndex(localTime, min, max);
+        to = from == max ? from : from + 1;
+        float fromTime = getCompressedTime(from);
+        t = (localTime - fromTime) / (getCompressedTime(to) - fromTime);
+    }
+
+    // Decode the end point on the stack for common property sizes
+    float toBuffer[16];
+    float* toValue = _componentCount <= 16 ? toBuffer : new float[_componentCount];
+    decompressPoint(from, dst);
+    decompressPoint(to, toValue);
+    interpolateValues(t, dst, toValue, dst);
+    if (toValue != toBuffer)
+        delete[] toValue;
+}
+
+float Curve::getCompressedTime(unsigned int index) const
+{
+    return _compressedTimes[index] / CURVE_TIME_QUANTIZED_MAX;
+}
+
+void Curve::decompressPoint(unsigned int index, float* dst) const
+{
+    const unsigned short* values = _compressedValues + index * _compressedStride;
+    const float* range = _compressedRanges;
+    unsigned int quaternionOffset = _quaternionOffset ? *_quaternionOffset : _componentCount;
+
+    // Scalar components are stored as steps above the component's minimum
+    for (unsigned int i = 0; i < _componentCount; i++)
+    {
+        if (i == quaternionOffset)
+        {
+            i += 3;
+            continue;
+        }
+        dst[i] = range[0] + range[1] * (*values++);
+        range += 2;
+    }
+
+    if (_quaternionOffset)
+    {
+        // The three smallest components of the quaternion, with the index of the largest
+        // (which is positive) in the top bits of the first two values.
+        unsigned int largest = (values[0] >> 15) | ((values[1] >> 15) << 1);
+        float* q = dst + quaternionOffset;
+        float sum = 0.0f;
+        for (unsigned int i = 0, j = 0; i < 4; i++)
+        {
+            if (i == largest)
+                continue;
+            q[i] = (values[j++] & 0x7fff) * (2.0f * CURVE_QUATERNION_MIN / CURVE_QUATERNION_QUANTIZED_MAX) - CURVE_QUATERNION_MIN;
+            sum += q[i] * q[i];
+        }
+        q[largest] = sum < 1.0f ? sqrt(1.0f - sum) : 0.0f;
+    }
+}
+
+unsigned int Curve::determineCompressedIndex(float time, unsigned int min, unsigned int max) const
+{
+    unsigned int mid;
+
+    // Do a binary search to determine the index.
+    do
+    {
+        mid = (min + max) >> 1;
+
+        if (time >= getCompressedTime(mid) && (mid == max || time < getCompressedTime(mid + 1)))
+            return mid;
+        else if (time < getCompressedTime(mid))
+            max = mid - 1;
+        else
+            min = mid + 1;
+    } while (min <= max);
+
+    return max;
+}
+
 int Curve::getInterpolationType(const char* curveId)
 {
     if (strcmp(curveId, "BEZIER") == 0)
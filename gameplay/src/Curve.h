@@ -16,6 +16,7 @@ class Curve : public Ref
     friend class AnimationClip;
     friend class AnimationController;
     friend class MeshSkin;
+    friend class Bundle;
 
 public:
 
@@ -312,6 +313,20 @@ public:
      */
     float getEndTime() const;
 
+    /**
+     * Determines whether the points of the curve are stored compressed.
+     *
+     * Compressed curves are loaded from bundles written with animation compression
+     * enabled in the encoder. Their key times and values are quantized to 16 bits,
+     * with rotations stored as the three smallest quaternion components, and only
+     * the two points around the evaluated time are decoded. Compressed curves are
+     * linearly interpolated and their points cannot be changed.
+     *
+     * @return true if the curve is compressed.
+     * @script{ignore}
+     */
+    bool isCompressed() const;
+
     /**
      * Sets the given point values on the curve.
      *
@@ -468,6 +483,20 @@ private:
      */
     Curve(unsigned int pointCount, unsigned int componentCount);
 
+    /**
+     * Constructs a new compressed curve from quantized point data.
+     *
+     * @param pointCount The number of points in the curve.
+     * @param componentCount The number of float component values per key value.
+     * @param quaternionOffset The offset of the quaternion within the key values, or -1 if there is none.
+     * @param keyTimes The point times, quantized from 0-1 to 0-65535.
+     * @param keyValues The quantized values of each point: the scalar components, followed by
+     *        the three smallest quaternion components if the curve has a quaternion.
+     * @param ranges The minimum and quantization step of each scalar component.
+     */
+    Curve(unsigned int pointCount, unsigned int componentCount, int quaternionOffset,
+          const unsigned short* keyTimes, const unsigned short* keyValues, const float* ranges);
+
     /**
      * Constructor.
      */
@@ -513,6 +542,12 @@ private:
      */
     void interpolateLinear(float s, Point* from, Point* to, float* dst) const;
 
+    /**
+     * Linearly interpolates two sets of values of this curve, using spherical
+     * interpolation for the quaternion components.
+     */
+    void interpolateValues(float s, float* fromValue, float* toValue, float* dst) const;
+
     /**
      * Quaternion interpolation function.
      */
@@ -523,6 +558,26 @@ private:
      */
     int determineIndex(float time, unsigned int min, unsigned int max) const;
 
+    /**
+     * Evaluates a compressed curve at the specified time.
+     */
+    void evaluateCompressed(float time, float startTime, float endTime, float loopBlendTime, float* dst) const;
+
+    /**
+     * Returns the time of a point of a compressed curve.
+     */
+    float getCompressedTime(unsigned int index) const;
+
+    /**
+     * Decodes the values of a point of a compressed curve.
+     */
+    void decompressPoint(unsigned int index, float* dst) const;
+
+    /**
+     * Determines the point of a compressed curve to interpolate from based on the specified time.
+     */
+    unsigned int determineCompressedIndex(float time, unsigned int min, unsigned int max) const;
+
     /**
      * Sets the offset for the beginning of a Quaternion piece of data within the curve's value span at the specified
      * index. The next four components of data starting at the given index will be interpolated as a Quaternion.
@@ -545,7 +600,11 @@ private:
     unsigned int _componentCount;       // Number of components on the curve.
     unsigned int _componentSize;        // The component size (in bytes).
     unsigned int* _quaternionOffset;    // Offset for the rotation component.
-    Point* _points;                     // The points on the curve.
+    Point* _points;                     // The points on the curve (NULL if the curve is compressed).
+    unsigned short* _compressedTimes;   // Quantized point times of a compressed curve.
+    unsigned short* _compressedValues;  // Quantized point values of a compressed curve.
+    float* _compressedRanges;           // Minimum and quantization step of each scalar component of a compressed curve.
+    unsigned int _compressedStride;     // Number of quantized values per point of a compressed curve.
 };
 
 }
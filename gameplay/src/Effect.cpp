@@ -5,6 +5,11 @@
 
 #define OPENGL_ES_DEFINE  "OPENGL_ES"
 
+// Program binaries are only retrieved through GLEW (ARB_get_program_binary).
+#ifdef GLEW_STATIC
+#define GP_USE_PROGRAM_BINARY
+#endif
+
 namespace gameplay
 {
 
@@ -215,6 +220,153 @@ static void replaceIncludes(const char* filepath, const char* source, std::strin
     }
 }
 
+// FNV-1a hash used to key the program binary cache.
+static unsigned long long hashProgramSource(const char* str, unsigned long long hash)
+{
+    if (str)
+    {
+        for (const unsigned char* c = (const unsigned char*)str; *c; ++c)
+        {
+            hash ^= *c;
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    // Terminate each string so that moving text between them changes the hash.
+    hash ^= 0xff;
+    hash *= 1099511628211ULL;
+    return hash;
+}
+
+std::string Effect::getProgramHashString(const char* defines, const char* vshSource, const char* fshSource)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    hash = hashProgramSource(defines, hash);
+    hash = hashProgramSource(vshSource, hash);
+    hash = hashProgramSource(fshSource, hash);
+
+    char hex[17];
+    sprintf(hex, "%016llx", hash);
+    return hex;
+}
+
+#ifdef GP_USE_PROGRAM_BINARY
+
+// Returns a string identifying the GL driver; binaries are only valid for the driver that produced them.
+static const std::string& getDriverString()
+{
+    static std::string driver;
+    if (driver.empty())
+    {
+        const GLubyte* vendor;
+        const GLubyte* renderer;
+        const GLubyte* version;
+        GL_ASSERT( vendor = glGetString(GL_VENDOR) );
+        GL_ASSERT( renderer = glGetString(GL_RENDERER) );
+        GL_ASSERT( version = glGetString(GL_VERSION) );
+        driver = vendor ? (const char*)vendor : "";
+        driver += ';';
+        driver += renderer ? (const char*)renderer : "";
+        driver += ';';
+        driver += version ? (const char*)version : "";
+    }
+    return driver;
+}
+
+#endif
+
+static const char* getProgramBinaryCacheDirectory()
+{
+#ifdef GP_USE_PROGRAM_BINARY
+    if (!GLEW_ARB_get_program_binary)
+        return NULL;
+
+    Properties* graphicsConfig = Game::getInstance()->getConfig()->getNamespace("graphics", true);
+    const char* directory = graphicsConfig ? graphicsConfig->getString("shaderCache") : NULL;
+    return (directory && strlen(directory) > 0) ? directory : NULL;
+#else
+    return NULL;
+#endif
+}
+
+static GLuint loadProgramBinary(const char* path)
+{
+#ifdef GP_USE_PROGRAM_BINARY
+    if (!FileSystem::fileExists(path))
+        return 0;
+
+    std::unique_ptr<Stream> stream(FileSystem::open(path));
+    if (stream.get() == NULL || !stream->canRead())
+        return 0;
+
+    // Header: driver string length, driver string, binary format, binary length, binary data.
+    const std::string& driver = getDriverString();
+    unsigned int driverLength = 0;
+    if (stream->read(&driverLength, sizeof(driverLength), 1) != 1 || driverLength != driver.length())
+        return 0;
+    std::string fileDriver(driverLength, '\0');
+    if (driverLength > 0 && stream->read(&fileDriver[0], 1, driverLength) != driverLength)
+        return 0;
+    if (fileDriver != driver)
+        return 0;
+
+    GLenum format;
+    unsigned int binaryLength;
+    if (stream->read(&format, sizeof(format), 1) != 1 || stream->read(&binaryLength, sizeof(binaryLength), 1) != 1 || binaryLength == 0)
+        return 0;
+    std::vector<unsigned char> binary(binaryLength);
+    if (stream->read(&binary[0], 1, binaryLength) != binaryLength)
+        return 0;
+
+    GLuint program;
+    GLint success;
+    GL_ASSERT( program = glCreateProgram() );
+    GL_ASSERT( glProgramBinary(program, format, &binary[0], (GLsizei)binaryLength) );
+    GL_ASSERT( glGetProgramiv(program, GL_LINK_STATUS, &success) );
+    if (success != GL_TRUE)
+    {
+        // The driver rejected the binary (e.g. after a driver update), so fall back to compiling.
+        GP_WARN("Discarding stale program binary '%s'.", path);
+        GL_ASSERT( glDeleteProgram(program) );
+        return 0;
+    }
+
+    return program;
+#else
+    return 0;
+#endif
+}
+
+static void saveProgramBinary(GLuint program, const char* path)
+{
+#ifdef GP_USE_PROGRAM_BINARY
+    GLint binaryLength = 0;
+    GL_ASSERT( glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength) );
+    if (binaryLength <= 0)
+        return;
+
+    std::vector<unsigned char> binary(binaryLength);
+    GLenum format = 0;
+    GL_ASSERT( glGetProgramBinary(program, binaryLength, NULL, &format, &binary[0]) );
+
+    std::unique_ptr<Stream> stream(FileSystem::open(path, FileSystem::WRITE));
+    if (stream.get() == NULL || !stream->canWrite())
+    {
+        GP_WARN("Failed to write program binary '%s'.", path);
+        return;
+    }
+
+    const std::string& driver = getDriverString();
+    unsigned int driverLength = (unsigned int)driver.length();
+    unsigned int length = (unsigned int)binaryLength;
+    stream->write(&driverLength, sizeof(driverLength), 1);
+    stream->write(driver.c_str(), 1, driverLength);
+    stream->write(&format, sizeof(format), 1);
+    stream->write(&length, sizeof(length), 1);
+    stream->write(&binary[0], 1, length);
+#endif
+}
+
 static void writeShaderToErrorFile(const char* filePath, const char* source)
 {
     std::string path = filePath;
@@ -226,11 +378,9 @@ static void writeShaderToErrorFile(const char* filePath, const char* source)
     }
 }
 
-Effect* Effect::createFromSource(const char* vshPath, const char* vshSource, const char* fshPath, const char* fshSource, const char* defines)
+// Compiles the given (fully preprocessed) shader sources and links them into a program.
+static GLuint compileProgram(const char* vshPath, const char* vshSource, const char* fshPath, const char* fshSource, const char* defines)
 {
-    GP_ASSERT(vshSource);
-    GP_ASSERT(fshSource);
-
     const unsigned int SHADER_SOURCE_LENGTH = 3;
     const GLchar* shaderSource[SHADER_SOURCE_LENGTH];
     char* infoLog = NULL;
@@ -240,21 +390,9 @@ Effect* Effect::createFromSource(const char* vshPath, const char* vshSource, con
     GLint length;
     GLint success;
 
-    // Replace all comma separated definitions with #define prefix and \n suffix
-    std::string definesStr = "";
-    replaceDefines(defines, definesStr);
-    
-    shaderSource[0] = definesStr.c_str();
+    shaderSource[0] = defines;
     shaderSource[1] = "\n";
-    std::string vshSourceStr = "";
-    if (vshPath)
-    {
-        // Replace the #include "xxxxx.xxx" with the sources that come from file paths
-        replaceIncludes(vshPath, vshSource, vshSourceStr);
-        if (vshSource && strlen(vshSource) != 0)
-            vshSourceStr += "\n";
-    }
-    shaderSource[2] = vshPath ? vshSourceStr.c_str() :  vshSource;
+    shaderSource[2] = vshSource;
     GL_ASSERT( vertexShader = glCreateShader(GL_VERTEX_SHADER) );
     GL_ASSERT( glShaderSource(vertexShader, SHADER_SOURCE_LENGTH, shaderSource, NULL) );
     GL_ASSERT( glCompileShader(vertexShader) );
@@ -283,19 +421,11 @@ Effect* Effect::createFromSource(const char* vshPath, const char* vshSource, con
         // Clean up.
         GL_ASSERT( glDeleteShader(vertexShader) );
 
-        return NULL;
+        return 0;
     }
 
     // Compile the fragment shader.
-    std::string fshSourceStr;
-    if (fshPath)
-    {
-        // Replace the #include "xxxxx.xxx" with the sources that come from file paths
-        replaceIncludes(fshPath, fshSource, fshSourceStr);
-        if (fshSource && strlen(fshSource) != 0)
-            fshSourceStr += "\n";
-    }
-    shaderSource[2] = fshPath ? fshSourceStr.c_str() : fshSource;
+    shaderSource[2] = fshSource;
     GL_ASSERT( fragmentShader = glCreateShader(GL_FRAGMENT_SHADER) );
     GL_ASSERT( glShaderSource(fragmentShader, SHADER_SOURCE_LENGTH, shaderSource, NULL) );
     GL_ASSERT( glCompileShader(fragmentShader) );
@@ -325,11 +455,18 @@ Effect* Effect::createFromSource(const char* vshPath, const char* vshSource, con
         GL_ASSERT( glDeleteShader(vertexShader) );
         GL_ASSERT( glDeleteShader(fragmentShader) );
 
-        return NULL;
+        return 0;
     }
 
     // Link program.
     GL_ASSERT( program = glCreateProgram() );
+#ifdef GP_USE_PROGRAM_BINARY
+    if (GLEW_ARB_get_program_binary)
+    {
+        // Ask the driver to keep the linked binary around so it can be written to the cache.
+        GL_ASSERT( glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE) );
+    }
+#endif
     GL_ASSERT( glAttachShader(program, vertexShader) );
     GL_ASSERT( glAttachShader(program, fragmentShader) );
     GL_ASSERT( glLinkProgram(program) );
@@ -359,7 +496,64 @@ Effect* Effect::createFromSource(const char* vshPath, const char* vshSource, con
         // Clean up.
         GL_ASSERT( glDeleteProgram(program) );
 
-        return NULL;
+        return 0;
+    }
+
+    return program;
+}
+
+Effect* Effect::createFromSource(const char* vshPath, const char* vshSource, const char* fshPath, const char* fshSource, const char* defines)
+{
+    GP_ASSERT(vshSource);
+    GP_ASSERT(fshSource);
+
+    GLint length;
+
+    // Replace all comma separated definitions with #define prefix and \n suffix
+    std::string definesStr = "";
+    replaceDefines(defines, definesStr);
+
+    std::string vshSourceStr = "";
+    if (vshPath)
+    {
+        // Replace the #include "xxxxx.xxx" with the sources that come from file paths
+        replaceIncludes(vshPath, vshSource, vshSourceStr);
+        if (vshSource && strlen(vshSource) != 0)
+            vshSourceStr += "\n";
+    }
+    std::string fshSourceStr;
+    if (fshPath)
+    {
+        // Replace the #include "xxxxx.xxx" with the sources that come from file paths
+        replaceIncludes(fshPath, fshSource, fshSourceStr);
+        if (fshSource && strlen(fshSource) != 0)
+            fshSourceStr += "\n";
+    }
+    const char* vshFinalSource = vshPath ? vshSourceStr.c_str() : vshSource;
+    const char* fshFinalSource = fshPath ? fshSourceStr.c_str() : fshSource;
+
+    // Try the program binary cache before compiling.
+    GLuint program = 0;
+    std::string binaryPath;
+    const char* cacheDirectory = getProgramBinaryCacheDirectory();
+    if (cacheDirectory)
+    {
+        binaryPath = cacheDirectory;
+        if (binaryPath[binaryPath.length() - 1] != '/')
+            binaryPath += '/';
+        binaryPath += getProgramHashString(definesStr.c_str(), vshFinalSource, fshFinalSource);
+        binaryPath += ".bin";
+        program = loadProgramBinary(binaryPath.c_str());
+    }
+
+    if (program == 0)
+    {
+        program = compileProgram(vshPath, vshFinalSource, fshPath, fshFinalSource, definesStr.c_str());
+        if (program == 0)
+            return NULL;
+
+        if (!binaryPath.empty())
+            saveProgramBinary(program, binaryPath.c_str());
     }
 
     // Create and return the new Effect.
@@ -222,6 +222,26 @@ public:
      */
     static Effect* getCurrentEffect();
 
+    /**
+     * Returns the key used to store a program in the program binary cache.
+     *
+     * The key is a hash of the fully preprocessed shader sources (after #include
+     * expansion and with the #define block prepended), so any change to a shader,
+     * an included file or the defines produces a different key.
+     *
+     * Program binaries are cached when the game config contains a directory
+     * (which must already exist) in the "shaderCache" property of the "graphics"
+     * namespace and the driver supports program binaries.
+     *
+     * @param defines The #define block prepended to both shaders.
+     * @param vshSource The preprocessed vertex shader source.
+     * @param fshSource The preprocessed fragment shader source.
+     *
+     * @return A 16 character hexadecimal key.
+     * @script{ignore}
+     */
+    static std::string getProgramHashString(const char* defines, const char* vshSource, const char* fshSource);
+
 private:
 
     /**
@@ -0,0 +1,626 @@
+#if defined(GP_GL_NULL) || defined(GP_HEADLESS)
+
+#include "Base.h"
+#include "GLNull.h"
+
+namespace gameplay
+{
+
+// A uniform or vertex attribute declared in the sources of a program.
+struct NullVariable
+{
+    std::string name;
+    GLint size;
+    GLenum type;
+};
+
+// A program of the null backend.
+struct NullProgram
+{
+    std::vector<GLuint> shaders;
+    std::vector<NullVariable> attributes;
+    std::vector<NullVariable> uniforms;
+};
+
+static GLuint __nullName = 0;
+static std::map<GLuint, std::string> __nullShaders;
+static std::map<GLuint, NullProgram> __nullPrograms;
+static std::vector<unsigned char> __nullMappedBuffer;
+
+// Generates object names that are unique across all object types.
+static void genNullNames(GLsizei n, GLuint* names)
+{
+    for (GLsizei i = 0; i < n; ++i)
+        names[i] = ++__nullName;
+}
+
+static GLenum getNullType(const std::string& type)
+{
+    static const struct { const char* name; GLenum type; } types[] =
+    {
+        { "float", GL_FLOAT }, { "vec2", GL_FLOAT_VEC2 }, { "vec3", GL_FLOAT_VEC3 }, { "vec4", GL_FLOAT_VEC4 },
+        { "int", GL_INT }, { "ivec2", GL_INT_VEC2 }, { "ivec3", GL_INT_VEC3 }, { "ivec4", GL_INT_VEC4 },
+        { "bool", GL_BOOL }, { "mat2", GL_FLOAT_MAT2 }, { "mat3", GL_FLOAT_MAT3 }, { "mat4", GL_FLOAT_MAT4 },
+        { "sampler2D", GL_SAMPLER_2D }, { "samplerCube", GL_SAMPLER_CUBE }
+    };
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); ++i)
+    {
+        if (type == types[i].name)
+            return types[i].type;
+    }
+    return GL_FLOAT;
+}
+
+// Adds the variables declared with the given storage qualifier in a shader source. Preprocessor
+// conditionals are ignored, so variables of inactive blocks are reported as well.
+static void parseNullVariables(const std::string& source, const char* qualifier, std::vector<NullVariable>* variables)
+{
+    // Strip comments and preprocessor directives.
+    std::string code;
+    code.reserve(source.size());
+    for (size_t i = 0, length = source.size(); i < length; ++i)
+    {
+        if (source.compare(i, 2, "//") == 0 || source[i] == '#')
+        {
+            i = source.find('\n', i);
+            if (i == std::string::npos)
+                break;
+            code += '\n';
+            continue;
+        }
+        else if (source.compare(i, 2, "/*") == 0)
+        {
+            i = source.find("*/", i + 2);
+            if (i == std::string::npos)
+                break;
+            ++i;
+            continue;
+        }
+        code += source[i];
+    }
+
+    // Parse each statement of the form "<qualifier> [precision] <type> <name>[[size]], ...".
+    std::istringstream statements(code);
+    std::string statement;
+    while (std::getline(statements, statement, ';'))
+    {
+        std::istringstream tokens(statement);
+        std::string token;
+        if (!(tokens >> token) || token != qualifier)
+            continue;
+        std::string type;
+        if (!(tokens >> type))
+            continue;
+        if (type == "lowp" || type == "mediump" || type == "highp")
+            tokens >> type;
+
+        std::string declarators;
+        std::getline(tokens, declarators);
+        std::istringstream names(declarators);
+        std::string declarator;
+        while (std::getline(names, declarator, ','))
+        {
+            size_t start = declarator.find_first_not_of(" \t\r\n");
+            if (start == std::string::npos)
+                continue;
+            size_t end = declarator.find_first_of(" \t\r\n[", start);
+            NullVariable variable;
+            variable.name = declarator.substr(start, end == std::string::npos ? std::string::npos : end - start);
+            variable.type = getNullType(type);
+            size_t bracket = declarator.find('[', start);
+            variable.size = bracket != std::string::npos ? std::max(atoi(declarator.c_str() + bracket + 1), 1) : 1;
+
+            bool found = false;
+            for (size_t i = 0, count = variables->size(); i < count && !found; ++i)
+                found = (*variables)[i].name == variable.name;
+            if (!found)
+                variables->push_back(variable);
+        }
+    }
+}
+
+static void getNullVariable(const std::vector<NullVariable>& variables, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    if (index >= variables.size())
+        return;
+    const NullVariable& variable = variables[index];
+    GLsizei nameLength = bufSize > 0 ? std::min((GLsizei)variable.name.size(), bufSize - 1) : 0;
+    if (name && bufSize > 0)
+    {
+        memcpy(name, variable.name.c_str(), nameLength);
+        name[nameLength] = '\0';
+    }
+    if (length)
+        *length = nameLength;
+    if (size)
+        *size = variable.size;
+    if (type)
+        *type = variable.type;
+}
+
+static GLint getNullLocation(const std::vector<NullVariable>& variables, const GLchar* name)
+{
+    for (size_t i = 0, count = variables.size(); i < count; ++i)
+    {
+        if (variables[i].name == name)
+            return (GLint)i;
+    }
+    return -1;
+}
+
+static GLint getNullMaxNameLength(const std::vector<NullVariable>& variables)
+{
+    size_t length = 0;
+    for (size_t i = 0, count = variables.size(); i < count; ++i)
+        length = std::max(length, variables[i].name.size() + 1);
+    return (GLint)length;
+}
+
+namespace glnull
+{
+
+void ActiveTexture(GLenum texture)
+{
+}
+
+void AttachShader(GLuint program, GLuint shader)
+{
+    __nullPrograms[program].shaders.push_back(shader);
+}
+
+void BindAttribLocation(GLuint program, GLuint index, const GLchar* name)
+{
+}
+
+void BindBuffer(GLenum target, GLuint buffer)
+{
+}
+
+void BindFramebuffer(GLenum target, GLuint framebuffer)
+{
+}
+
+void BindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+}
+
+void BindTexture(GLenum target, GLuint texture)
+{
+}
+
+void BindVertexArray(GLuint array)
+{
+}
+
+void BlendFunc(GLenum sfactor, GLenum dfactor)
+{
+}
+
+void BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+}
+
+void BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+}
+
+GLenum CheckFramebufferStatus(GLenum target)
+{
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+void Clear(GLbitfield mask)
+{
+}
+
+void ClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
+{
+}
+
+void ClearDepth(GLclampd depth)
+{
+}
+
+void ClearStencil(GLint s)
+{
+}
+
+void CompileShader(GLuint shader)
+{
+}
+
+void CompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data)
+{
+}
+
+GLuint CreateProgram()
+{
+    GLuint program = ++__nullName;
+    __nullPrograms[program] = NullProgram();
+    return program;
+}
+
+GLuint CreateShader(GLenum type)
+{
+    GLuint shader = ++__nullName;
+    __nullShaders[shader] = std::string();
+    return shader;
+}
+
+void CullFace(GLenum mode)
+{
+}
+
+void DeleteBuffers(GLsizei n, const GLuint* buffers)
+{
+}
+
+void DeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
+{
+}
+
+void DeleteProgram(GLuint program)
+{
+    __nullPrograms.erase(program);
+}
+
+void DeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
+{
+}
+
+void DeleteShader(GLuint shader)
+{
+    __nullShaders.erase(shader);
+}
+
+void DeleteTextures(GLsizei n, const GLuint* textures)
+{
+}
+
+void DeleteVertexArrays(GLsizei n, const GLuint* arrays)
+{
+}
+
+void DepthFunc(GLenum func)
+{
+}
+
+void DepthMask(GLboolean flag)
+{
+}
+
+void Disable(GLenum cap)
+{
+}
+
+void DisableVertexAttribArray(GLuint index)
+{
+}
+
+void DrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+}
+
+void DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+{
+}
+
+void Enable(GLenum cap)
+{
+}
+
+void EnableVertexAttribArray(GLuint index)
+{
+}
+
+void FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+}
+
+void FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+}
+
+void FrontFace(GLenum mode)
+{
+}
+
+void GenBuffers(GLsizei n, GLuint* buffers)
+{
+    genNullNames(n, buffers);
+}
+
+void GenerateMipmap(GLenum target)
+{
+}
+
+void GenFramebuffers(GLsizei n, GLuint* framebuffers)
+{
+    genNullNames(n, framebuffers);
+}
+
+void GenRenderbuffers(GLsizei n, GLuint* renderbuffers)
+{
+    genNullNames(n, renderbuffers);
+}
+
+void GenTextures(GLsizei n, GLuint* textures)
+{
+    genNullNames(n, textures);
+}
+
+void GenVertexArrays(GLsizei n, GLuint* arrays)
+{
+    genNullNames(n, arrays);
+}
+
+void GetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    getNullVariable(__nullPrograms[program].attributes, index, bufSize, length, size, type, name);
+}
+
+void GetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    getNullVariable(__nullPrograms[program].uniforms, index, bufSize, length, size, type, name);
+}
+
+GLint GetAttribLocation(GLuint program, const GLchar* name)
+{
+    return getNullLocation(__nullPrograms[program].attributes, name);
+}
+
+GLenum GetError()
+{
+    return GL_NO_ERROR;
+}
+
+void GetIntegerv(GLenum pname, GLint* params)
+{
+    switch (pname)
+    {
+    case GL_MAX_VERTEX_ATTRIBS:
+        params[0] = 16;
+        break;
+    case GL_MAX_COLOR_ATTACHMENTS:
+        params[0] = 4;
+        break;
+    case GL_MAX_TEXTURE_SIZE:
+        params[0] = 8192;
+        break;
+    case GL_VIEWPORT:
+        params[0] = params[1] = params[2] = params[3] = 0;
+        break;
+    default:
+        params[0] = 0;
+        break;
+    }
+}
+
+void GetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary)
+{
+    if (length)
+        *length = 0;
+}
+
+void GetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+    if (length)
+        *length = 0;
+    if (infoLog && bufSize > 0)
+        infoLog[0] = '\0';
+}
+
+void GetProgramiv(GLuint program, GLenum pname, GLint* params)
+{
+    const NullProgram& nullProgram = __nullPrograms[program];
+    switch (pname)
+    {
+    case GL_LINK_STATUS:
+        params[0] = GL_TRUE;
+        break;
+    case GL_ACTIVE_ATTRIBUTES:
+        params[0] = (GLint)nullProgram.attributes.size();
+        break;
+    case GL_ACTIVE_ATTRIBUTE_MAX_LENGTH:
+        params[0] = getNullMaxNameLength(nullProgram.attributes);
+        break;
+    case GL_ACTIVE_UNIFORMS:
+        params[0] = (GLint)nullProgram.uniforms.size();
+        break;
+    case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+        params[0] = getNullMaxNameLength(nullProgram.uniforms);
+        break;
+    default:
+        params[0] = 0;
+        break;
+    }
+}
+
+void GetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+    if (length)
+        *length = 0;
+    if (infoLog && bufSize > 0)
+        infoLog[0] = '\0';
+}
+
+void GetShaderiv(GLuint shader, GLenum pname, GLint* params)
+{
+    params[0] = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+const GLubyte* GetString(GLenum name)
+{
+    switch (name)
+    {
+    case GL_VENDOR:
+        return (const GLubyte*)"gameplay";
+    case GL_RENDERER:
+        return (const GLubyte*)"null";
+    case GL_VERSION:
+        return (const GLubyte*)"2.0";
+    default:
+        return (const GLubyte*)"";
+    }
+}
+
+GLint GetUniformLocation(GLuint program, const GLchar* name)
+{
+    return getNullLocation(__nullPrograms[program].uniforms, name);
+}
+
+void Hint(GLenum target, GLenum mode)
+{
+}
+
+GLboolean IsTexture(GLuint texture)
+{
+    return texture != 0 && texture <= __nullName ? GL_TRUE : GL_FALSE;
+}
+
+void LinkProgram(GLuint program)
+{
+    // Report the variables declared in the attached shaders as active.
+    NullProgram& nullProgram = __nullPrograms[program];
+    nullProgram.attributes.clear();
+    nullProgram.uniforms.clear();
+    for (size_t i = 0, count = nullProgram.shaders.size(); i < count; ++i)
+    {
+        const std::string& source = __nullShaders[nullProgram.shaders[i]];
+        parseNullVariables(source, "attribute", &nullProgram.attributes);
+        parseNullVariables(source, "uniform", &nullProgram.uniforms);
+    }
+}
+
+void* MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    // Hand out scratch memory. Buffers of the null backend have no storage.
+    if (__nullMappedBuffer.size() < (size_t)length)
+        __nullMappedBuffer.resize(length);
+    return __nullMappedBuffer.empty() ? NULL : &__nullMappedBuffer[0];
+}
+
+void PixelStorei(GLenum pname, GLint param)
+{
+}
+
+void ProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length)
+{
+}
+
+void ProgramParameteri(GLuint program, GLenum pname, GLint value)
+{
+}
+
+void ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels)
+{
+    // The engine only reads back 8-bit RGB and RGBA images.
+    GP_ASSERT(type == GL_UNSIGNED_BYTE);
+    memset(pixels, 0, width * height * (format == GL_RGBA ? 4 : 3));
+}
+
+void RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+}
+
+void ShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)
+{
+    std::string& source = __nullShaders[shader];
+    source.clear();
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        if (string[i])
+            source.append(string[i], length && length[i] >= 0 ? length[i] : strlen(string[i]));
+    }
+}
+
+void StencilFunc(GLenum func, GLint ref, GLuint mask)
+{
+}
+
+void StencilMask(GLuint mask)
+{
+}
+
+void StencilOp(GLenum fail, GLenum zfail, GLenum zpass)
+{
+}
+
+void TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels)
+{
+}
+
+void TexParameteri(GLenum target, GLenum pname, GLint param)
+{
+}
+
+void TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+{
+}
+
+void Uniform1f(GLint location, GLfloat v0)
+{
+}
+
+void Uniform1fv(GLint location, GLsizei count, const GLfloat* value)
+{
+}
+
+void Uniform1i(GLint location, GLint v0)
+{
+}
+
+void Uniform1iv(GLint location, GLsizei count, const GLint* value)
+{
+}
+
+void Uniform2f(GLint location, GLfloat v0, GLfloat v1)
+{
+}
+
+void Uniform2fv(GLint location, GLsizei count, const GLfloat* value)
+{
+}
+
+void Uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+{
+}
+
+void Uniform3fv(GLint location, GLsizei count, const GLfloat* value)
+{
+}
+
+void Uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+{
+}
+
+void Uniform4fv(GLint location, GLsizei count, const GLfloat* value)
+{
+}
+
+void UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+}
+
+GLboolean UnmapBuffer(GLenum target)
+{
+    return GL_TRUE;
+}
+
+void UseProgram(GLuint program)
+{
+}
+
+void VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
+{
+}
+
+void Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,291 @@
+#ifndef GLNULL_H_
+#define GLNULL_H_
+
+namespace gameplay
+{
+
+/**
+ * The null GL backend, used in place of a driver by builds that have no GL context.
+ *
+ * Headless builds (GP_HEADLESS) route every GL function used by the engine to this
+ * backend, so meshes, textures, effects, fonts and forms can be created and scenes
+ * drawn without a GPU. It hands out object names, reports shaders as compiled and
+ * programs as linked, and reports the uniforms and attributes declared in the shader
+ * sources as active, so effects and materials bind as they would on a real driver.
+ * Nothing is rendered, and read back pixels are black.
+ *
+ * The null backend is only supported on platforms that load GL through GLEW.
+ */
+namespace glnull
+{
+void ActiveTexture(GLenum texture);
+void AttachShader(GLuint program, GLuint shader);
+void BindAttribLocation(GLuint program, GLuint index, const GLchar* name);
+void BindBuffer(GLenum target, GLuint buffer);
+void BindFramebuffer(GLenum target, GLuint framebuffer);
+void BindRenderbuffer(GLenum target, GLuint renderbuffer);
+void BindTexture(GLenum target, GLuint texture);
+void BindVertexArray(GLuint array);
+void BlendFunc(GLenum sfactor, GLenum dfactor);
+void BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+void BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+GLenum CheckFramebufferStatus(GLenum target);
+void Clear(GLbitfield mask);
+void ClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha);
+void ClearDepth(GLclampd depth);
+void ClearStencil(GLint s);
+void CompileShader(GLuint shader);
+void CompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data);
+GLuint CreateProgram();
+GLuint CreateShader(GLenum type);
+void CullFace(GLenum mode);
+void DeleteBuffers(GLsizei n, const GLuint* buffers);
+void DeleteFramebuffers(GLsizei n, const GLuint* framebuffers);
+void DeleteProgram(GLuint program);
+void DeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers);
+void DeleteShader(GLuint shader);
+void DeleteTextures(GLsizei n, const GLuint* textures);
+void DeleteVertexArrays(GLsizei n, const GLuint* arrays);
+void DepthFunc(GLenum func);
+void DepthMask(GLboolean flag);
+void Disable(GLenum cap);
+void DisableVertexAttribArray(GLuint index);
+void DrawArrays(GLenum mode, GLint first, GLsizei count);
+void DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices);
+void Enable(GLenum cap);
+void EnableVertexAttribArray(GLuint index);
+void FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
+void FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+void FrontFace(GLenum mode);
+void GenBuffers(GLsizei n, GLuint* buffers);
+void GenerateMipmap(GLenum target);
+void GenFramebuffers(GLsizei n, GLuint* framebuffers);
+void GenRenderbuffers(GLsizei n, GLuint* renderbuffers);
+void GenTextures(GLsizei n, GLuint* textures);
+void GenVertexArrays(GLsizei n, GLuint* arrays);
+void GetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+void GetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+GLint GetAttribLocation(GLuint program, const GLchar* name);
+GLenum GetError();
+void GetIntegerv(GLenum pname, GLint* params);
+void GetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+void GetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+void GetProgramiv(GLuint program, GLenum pname, GLint* params);
+void GetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+void GetShaderiv(GLuint shader, GLenum pname, GLint* params);
+const GLubyte* GetString(GLenum name);
+GLint GetUniformLocation(GLuint program, const GLchar* name);
+void Hint(GLenum target, GLenum mode);
+GLboolean IsTexture(GLuint texture);
+void LinkProgram(GLuint program);
+void* MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+void PixelStorei(GLenum pname, GLint param);
+void ProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+void ProgramParameteri(GLuint program, GLenum pname, GLint value);
+void ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels);
+void RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+void ShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length);
+void StencilFunc(GLenum func, GLint ref, GLuint mask);
+void StencilMask(GLuint mask);
+void StencilOp(GLenum fail, GLenum zfail, GLenum zpass);
+void TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels);
+void TexParameteri(GLenum target, GLenum pname, GLint param);
+void TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels);
+void Uniform1f(GLint location, GLfloat v0);
+void Uniform1fv(GLint location, GLsizei count, const GLfloat* value);
+void Uniform1i(GLint location, GLint v0);
+void Uniform1iv(GLint location, GLsizei count, const GLint* value);
+void Uniform2f(GLint location, GLfloat v0, GLfloat v1);
+void Uniform2fv(GLint location, GLsizei count, const GLfloat* value);
+void Uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
+void Uniform3fv(GLint location, GLsizei count, const GLfloat* value);
+void Uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+void Uniform4fv(GLint location, GLsizei count, const GLfloat* value);
+void UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+GLboolean UnmapBuffer(GLenum target);
+void UseProgram(GLuint program);
+void VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+}
+
+}
+
+// Route the GL calls of the engine to the null backend.
+#undef glActiveTexture
+#undef glAttachShader
+#undef glBindAttribLocation
+#undef glBindBuffer
+#undef glBindFramebuffer
+#undef glBindRenderbuffer
+#undef glBindTexture
+#undef glBindVertexArray
+#undef glBlendFunc
+#undef glBufferData
+#undef glBufferSubData
+#undef glCheckFramebufferStatus
+#undef glClear
+#undef glClearColor
+#undef glClearDepth
+#undef glClearStencil
+#undef glCompileShader
+#undef glCompressedTexImage2D
+#undef glCreateProgram
+#undef glCreateShader
+#undef glCullFace
+#undef glDeleteBuffers
+#undef glDeleteFramebuffers
+#undef glDeleteProgram
+#undef glDeleteRenderbuffers
+#undef glDeleteShader
+#undef glDeleteTextures
+#undef glDeleteVertexArrays
+#undef glDepthFunc
+#undef glDepthMask
+#undef glDisable
+#undef glDisableVertexAttribArray
+#undef glDrawArrays
+#undef glDrawElements
+#undef glEnable
+#undef glEnableVertexAttribArray
+#undef glFramebufferRenderbuffer
+#undef glFramebufferTexture2D
+#undef glFrontFace
+#undef glGenBuffers
+#undef glGenerateMipmap
+#undef glGenFramebuffers
+#undef glGenRenderbuffers
+#undef glGenTextures
+#undef glGenVertexArrays
+#undef glGetActiveAttrib
+#undef glGetActiveUniform
+#undef glGetAttribLocation
+#undef glGetError
+#undef glGetIntegerv
+#undef glGetProgramBinary
+#undef glGetProgramInfoLog
+#undef glGetProgramiv
+#undef glGetShaderInfoLog
+#undef glGetShaderiv
+#undef glGetString
+#undef glGetUniformLocation
+#undef glHint
+#undef glIsTexture
+#undef glLinkProgram
+#undef glMapBufferRange
+#undef glPixelStorei
+#undef glProgramBinary
+#undef glProgramParameteri
+#undef glReadPixels
+#undef glRenderbufferStorage
+#undef glShaderSource
+#undef glStencilFunc
+#undef glStencilMask
+#undef glStencilOp
+#undef glTexImage2D
+#undef glTexParameteri
+#undef glTexSubImage2D
+#undef glUniform1f
+#undef glUniform1fv
+#undef glUniform1i
+#undef glUniform1iv
+#undef glUniform2f
+#undef glUniform2fv
+#undef glUniform3f
+#undef glUniform3fv
+#undef glUniform4f
+#undef glUniform4fv
+#undef glUniformMatrix4fv
+#undef glUnmapBuffer
+#undef glUseProgram
+#undef glVertexAttribPointer
+#undef glViewport
+#define glActiveTexture gameplay::glnull::ActiveTexture
+#define glAttachShader gameplay::glnull::AttachShader
+#define glBindAttribLocation gameplay::glnull::BindAttribLocation
+#define glBindBuffer gameplay::glnull::BindBuffer
+#define glBindFramebuffer gameplay::glnull::BindFramebuffer
+#define glBindRenderbuffer gameplay::glnull::BindRenderbuffer
+#define glBindTexture gameplay::glnull::BindTexture
+#define glBindVertexArray gameplay::glnull::BindVertexArray
+#define glBlendFunc gameplay::glnull::BlendFunc
+#define glBufferData gameplay::glnull::BufferData
+#define glBufferSubData gameplay::glnull::BufferSubData
+#define glCheckFramebufferStatus gameplay::glnull::CheckFramebufferStatus
+#define glClear gameplay::glnull::Clear
+#define glClearColor gameplay::glnull::ClearColor
+#define glClearDepth gameplay::glnull::ClearDepth
+#define glClearStencil gameplay::glnull::ClearStencil
+#define glCompileShader gameplay::glnull::CompileShader
+#define glCompressedTexImage2D gameplay::glnull::CompressedTexImage2D
+#define glCreateProgram gameplay::glnull::CreateProgram
+#define glCreateShader gameplay::glnull::CreateShader
+#define glCullFace gameplay::glnull::CullFace
+#define glDeleteBuffers gameplay::glnull::DeleteBuffers
+#define glDeleteFramebuffers gameplay::glnull::DeleteFramebuffers
+#define glDeleteProgram gameplay::glnull::DeleteProgram
+#define glDeleteRenderbuffers gameplay::glnull::DeleteRenderbuffers
+#define glDeleteShader gameplay::glnull::DeleteShader
+#define glDeleteTextures gameplay::glnull::DeleteTextures
+#define glDeleteVertexArrays gameplay::glnull::DeleteVertexArrays
+#define glDepthFunc gameplay::glnull::DepthFunc
+#define glDepthMask gameplay::glnull::DepthMask
+#define glDisable gameplay::glnull::Disable
+#define glDisableVertexAttribArray gameplay::glnull::DisableVertexAttribArray
+#define glDrawArrays gameplay::glnull::DrawArrays
+#define glDrawElements gameplay::glnull::DrawElements
+#define glEnable gameplay::glnull::Enable
+#define glEnableVertexAttribArray gameplay::glnull::EnableVertexAttribArray
+#define glFramebufferRenderbuffer gameplay::glnull::FramebufferRenderbuffer
+#define glFramebufferTexture2D gameplay::glnull::FramebufferTexture2D
+#define glFrontFace gameplay::glnull::FrontFace
+#define glGenBuffers gameplay::glnull::GenBuffers
+#define glGenerateMipmap gameplay::glnull::GenerateMipmap
+#define glGenFramebuffers gameplay::glnull::GenFramebuffers
+#define glGenRenderbuffers gameplay::glnull::GenRenderbuffers
+#define glGenTextures gameplay::glnull::GenTextures
+#define glGenVertexArrays gameplay::glnull::GenVertexArrays
+#define glGetActiveAttrib gameplay::glnull::GetActiveAttrib
+#define glGetActiveUniform gameplay::glnull::GetActiveUniform
+#define glGetAttribLocation gameplay::glnull::GetAttribLocation
+#define glGetError gameplay::glnull::GetError
+#define glGetIntegerv gameplay::glnull::GetIntegerv
+#define glGetProgramBinary gameplay::glnull::GetProgramBinary
+#define glGetProgramInfoLog gameplay::glnull::GetProgramInfoLog
+#define glGetProgramiv gameplay::glnull::GetProgramiv
+#define glGetShaderInfoLog gameplay::glnull::GetShaderInfoLog
+#define glGetShaderiv gameplay::glnull::GetShaderiv
+#define glGetString gameplay::glnull::GetString
+#define glGetUniformLocation gameplay::glnull::GetUniformLocation
+#define glHint gameplay::glnull::Hint
+#define glIsTexture gameplay::glnull::IsTexture
+#define glLinkProgram gameplay::glnull::LinkProgram
+#define glMapBufferRange gameplay::glnull::MapBufferRange
+#define glPixelStorei gameplay::glnull::PixelStorei
+#define glProgramBinary gameplay::glnull::ProgramBinary
+#define glProgramParameteri gameplay::glnull::ProgramParameteri
+#define glReadPixels gameplay::glnull::ReadPixels
+#define glRenderbufferStorage gameplay::glnull::RenderbufferStorage
+#define glShaderSource gameplay::glnull::ShaderSource
+#define glStencilFunc gameplay::glnull::StencilFunc
+#define glStencilMask gameplay::glnull::StencilMask
+#define glStencilOp gameplay::glnull::StencilOp
+#define glTexImage2D gameplay::glnull::TexImage2D
+#define glTexParameteri gameplay::glnull::TexParameteri
+#define glTexSubImage2D gameplay::glnull::TexSubImage2D
+#define glUniform1f gameplay::glnull::Uniform1f
+#define glUniform1fv gameplay::glnull::Uniform1fv
+#define glUniform1i gameplay::glnull::Uniform1i
+#define glUniform1iv gameplay::glnull::Uniform1iv
+#define glUniform2f gameplay::glnull::Uniform2f
+#define glUniform2fv gameplay::glnull::Uniform2fv
+#define glUniform3f gameplay::glnull::Uniform3f
+#define glUniform3fv gameplay::glnull::Uniform3fv
+#define glUniform4f gameplay::glnull::Uniform4f
+#define glUniform4fv gameplay::glnull::Uniform4fv
+#define glUniformMatrix4fv gameplay::glnull::UniformMatrix4fv
+#define glUnmapBuffer gameplay::glnull::UnmapBuffer
+#define glUseProgram gameplay::glnull::UseProgram
+#define glVertexAttribPointer gameplay::glnull::VertexAttribPointer
+#define glViewport gameplay::glnull::Viewport
+
+#endif
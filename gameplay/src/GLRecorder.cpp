@@ -0,0 +1,606 @@
+#ifdef GP_GL_RECORDER
+
+// Call the driver (or the null backend) directly instead of routing the calls back through the recorder.
+#define GP_GL_RECORDER_IMPL
+
+#include "Base.h"
+#include "GLRecorder.h"
+
+namespace gameplay
+{
+
+static GLRecorder::Statistics __frameStatistics;
+static GLRecorder::Statistics __statistics;
+
+// Returns the size of a pixel with the given format and type, in bytes.
+static unsigned int getPixelSize(GLenum format, GLenum type)
+{
+    switch (type)
+    {
+    case GL_UNSIGNED_SHORT_5_6_5:
+    case GL_UNSIGNED_SHORT_4_4_4_4:
+    case GL_UNSIGNED_SHORT_5_5_5_1:
+        return 2;
+    }
+
+    unsigned int components;
+    switch (format)
+    {
+    case GL_RGBA:
+        components = 4;
+        break;
+    case GL_RGB:
+        components = 3;
+        break;
+    case GL_LUMINANCE_ALPHA:
+        components = 2;
+        break;
+    default:
+        components = 1;
+        break;
+    }
+
+    switch (type)
+    {
+    case GL_UNSIGNED_SHORT:
+    case GL_SHORT:
+        return components * 2;
+    case GL_UNSIGNED_INT:
+    case GL_INT:
+    case GL_FLOAT:
+        return components * 4;
+    default:
+        return components;
+    }
+}
+
+// Records an upload of uniform data.
+static void recordUniform(GLsizei count, unsigned int size)
+{
+    ++__statistics.uniformUploads;
+    __statistics.bytesUploaded += count * size;
+}
+
+const GLRecorder::Statistics& GLRecorder::getFrameStatistics()
+{
+    return __frameStatistics;
+}
+
+const GLRecorder::Statistics& GLRecorder::getCurrentStatistics()
+{
+    return __statistics;
+}
+
+bool GLRecorder::isNullBackend()
+{
+#ifdef GP_GL_NULL
+    return true;
+#else
+    return false;
+#endif
+}
+
+void GLRecorder::endFrame()
+{
+    __frameStatistics = __statistics;
+    __statistics = Statistics();
+}
+
+namespace gl
+{
+
+void ActiveTexture(GLenum texture)
+{
+    ++__statistics.stateChanges;
+    glActiveTexture(texture);
+}
+
+void AttachShader(GLuint program, GLuint shader)
+{
+    glAttachShader(program, shader);
+}
+
+void BindAttribLocation(GLuint program, GLuint index, const GLchar* name)
+{
+    glBindAttribLocation(program, index, name);
+}
+
+void BindBuffer(GLenum target, GLuint buffer)
+{
+    ++__statistics.stateChanges;
+    glBindBuffer(target, buffer);
+}
+
+void BindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    ++__statistics.stateChanges;
+    glBindFramebuffer(target, framebuffer);
+}
+
+void BindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+    ++__statistics.stateChanges;
+    glBindRenderbuffer(target, renderbuffer);
+}
+
+void BindTexture(GLenum target, GLuint texture)
+{
+    ++__statistics.stateChanges;
+    glBindTexture(target, texture);
+}
+
+void BindVertexArray(GLuint array)
+{
+    ++__statistics.stateChanges;
+    glBindVertexArray(array);
+}
+
+void BlendFunc(GLenum sfactor, GLenum dfactor)
+{
+    ++__statistics.stateChanges;
+    glBlendFunc(sfactor, dfactor);
+}
+
+void BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+    if (data)
+    {
+        ++__statistics.bufferUploads;
+        __statistics.bytesUploaded += (unsigned int)size;
+    }
+    glBufferData(target, size, data, usage);
+}
+
+void BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+    ++__statistics.bufferUploads;
+    __statistics.bytesUploaded += (unsigned int)size;
+    glBufferSubData(target, offset, size, data);
+}
+
+GLenum CheckFramebufferStatus(GLenum target)
+{
+    return glCheckFramebufferStatus(target);
+}
+
+void Clear(GLbitfield mask)
+{
+    ++__statistics.clears;
+    glClear(mask);
+}
+
+void ClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
+{
+    ++__statistics.stateChanges;
+    glClearColor(red, green, blue, alpha);
+}
+
+void ClearDepth(GLclampd depth)
+{
+    ++__statistics.stateChanges;
+    glClearDepth(depth);
+}
+
+void ClearStencil(GLint s)
+{
+    ++__statistics.stateChanges;
+    glClearStencil(s);
+}
+
+void CompileShader(GLuint shader)
+{
+    glCompileShader(shader);
+}
+
+void CompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data)
+{
+    ++__statistics.textureUploads;
+    __statistics.bytesUploaded += (unsigned int)imageSize;
+    glCompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, data);
+}
+
+GLuint CreateProgram()
+{
+    return glCreateProgram();
+}
+
+GLuint CreateShader(GLenum type)
+{
+    return glCreateShader(type);
+}
+
+void CullFace(GLenum mode)
+{
+    ++__statistics.stateChanges;
+    glCullFace(mode);
+}
+
+void DeleteBuffers(GLsizei n, const GLuint* buffers)
+{
+    glDeleteBuffers(n, buffers);
+}
+
+void DeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
+{
+    glDeleteFramebuffers(n, framebuffers);
+}
+
+void DeleteProgram(GLuint program)
+{
+    glDeleteProgram(program);
+}
+
+void DeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
+{
+    glDeleteRenderbuffers(n, renderbuffers);
+}
+
+void DeleteShader(GLuint shader)
+{
+    glDeleteShader(shader);
+}
+
+void DeleteTextures(GLsizei n, const GLuint* textures)
+{
+    glDeleteTextures(n, textures);
+}
+
+void DeleteVertexArrays(GLsizei n, const GLuint* arrays)
+{
+    glDeleteVertexArrays(n, arrays);
+}
+
+void DepthFunc(GLenum func)
+{
+    ++__statistics.stateChanges;
+    glDepthFunc(func);
+}
+
+void DepthMask(GLboolean flag)
+{
+    ++__statistics.stateChanges;
+    glDepthMask(flag);
+}
+
+void Disable(GLenum cap)
+{
+    ++__statistics.stateChanges;
+    glDisable(cap);
+}
+
+void DisableVertexAttribArray(GLuint index)
+{
+    ++__statistics.stateChanges;
+    glDisableVertexAttribArray(index);
+}
+
+void DrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    ++__statistics.drawCalls;
+    __statistics.vertices += (unsigned int)count;
+    glDrawArrays(mode, first, count);
+}
+
+void DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+{
+    ++__statistics.drawCalls;
+    __statistics.vertices += (unsigned int)count;
+    glDrawElements(mode, count, type, indices);
+}
+
+void Enable(GLenum cap)
+{
+    ++__statistics.stateChanges;
+    glEnable(cap);
+}
+
+void EnableVertexAttribArray(GLuint index)
+{
+    ++__statistics.stateChanges;
+    glEnableVertexAttribArray(index);
+}
+
+void FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+    glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+}
+
+void FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+    glFramebufferTexture2D(target, attachment, textarget, texture, level);
+}
+
+void FrontFace(GLenum mode)
+{
+    ++__statistics.stateChanges;
+    glFrontFace(mode);
+}
+
+void GenBuffers(GLsizei n, GLuint* buffers)
+{
+    glGenBuffers(n, buffers);
+}
+
+void GenerateMipmap(GLenum target)
+{
+    glGenerateMipmap(target);
+}
+
+void GenFramebuffers(GLsizei n, GLuint* framebuffers)
+{
+    glGenFramebuffers(n, framebuffers);
+}
+
+void GenRenderbuffers(GLsizei n, GLuint* renderbuffers)
+{
+    glGenRenderbuffers(n, renderbuffers);
+}
+
+void GenTextures(GLsizei n, GLuint* textures)
+{
+    glGenTextures(n, textures);
+}
+
+void GenVertexArrays(GLsizei n, GLuint* arrays)
+{
+    glGenVertexArrays(n, arrays);
+}
+
+bool hasVertexArrays()
+{
+    return glGenVertexArrays != NULL;
+}
+
+void GetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    glGetActiveAttrib(program, index, bufSize, length, size, type, name);
+}
+
+void GetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    glGetActiveUniform(program, index, bufSize, length, size, type, name);
+}
+
+GLint GetAttribLocation(GLuint program, const GLchar* name)
+{
+    return glGetAttribLocation(program, name);
+}
+
+GLenum GetError()
+{
+    return glGetError();
+}
+
+void GetIntegerv(GLenum pname, GLint* params)
+{
+    glGetIntegerv(pname, params);
+}
+
+void GetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary)
+{
+    glGetProgramBinary(program, bufSize, length, binaryFormat, binary);
+}
+
+void GetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+    glGetProgramInfoLog(program, bufSize, length, infoLog);
+}
+
+void GetProgramiv(GLuint program, GLenum pname, GLint* params)
+{
+    glGetProgramiv(program, pname, params);
+}
+
+void GetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+    glGetShaderInfoLog(shader, bufSize, length, infoLog);
+}
+
+void GetShaderiv(GLuint shader, GLenum pname, GLint* params)
+{
+    glGetShaderiv(shader, pname, params);
+}
+
+const GLubyte* GetString(GLenum name)
+{
+    return glGetString(name);
+}
+
+GLint GetUniformLocation(GLuint program, const GLchar* name)
+{
+    return glGetUniformLocation(program, name);
+}
+
+void Hint(GLenum target, GLenum mode)
+{
+    glHint(target, mode);
+}
+
+GLboolean IsTexture(GLuint texture)
+{
+    return glIsTexture(texture);
+}
+
+void LinkProgram(GLuint program)
+{
+    glLinkProgram(program);
+}
+
+void* MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    // The engine only maps buffers to write them, so count the mapped range as uploaded.
+    ++__statistics.bufferUploads;
+    __statistics.bytesUploaded += (unsigned int)length;
+    return glMapBufferRange(target, offset, length, access);
+}
+
+bool hasMapBufferRange()
+{
+    return glMapBufferRange != NULL;
+}
+
+void PixelStorei(GLenum pname, GLint param)
+{
+    glPixelStorei(pname, param);
+}
+
+void ProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length)
+{
+    glProgramBinary(program, binaryFormat, binary, length);
+}
+
+void ProgramParameteri(GLuint program, GLenum pname, GLint value)
+{
+    glProgramParameteri(program, pname, value);
+}
+
+void ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels)
+{
+    glReadPixels(x, y, width, height, format, type, pixels);
+}
+
+void RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    glRenderbufferStorage(target, internalformat, width, height);
+}
+
+void ShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)
+{
+    glShaderSource(shader, count, (const GLchar**)string, length);
+}
+
+void StencilFunc(GLenum func, GLint ref, GLuint mask)
+{
+    ++__statistics.stateChanges;
+    glStencilFunc(func, ref, mask);
+}
+
+void StencilMask(GLuint mask)
+{
+    ++__statistics.stateChanges;
+    glStencilMask(mask);
+}
+
+void StencilOp(GLenum fail, GLenum zfail, GLenum zpass)
+{
+    ++__statistics.stateChanges;
+    glStencilOp(fail, zfail, zpass);
+}
+
+void TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels)
+{
+    if (pixels)
+    {
+        ++__statistics.textureUploads;
+        __statistics.bytesUploaded += width * height * getPixelSize(format, type);
+    }
+    glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+}
+
+void TexParameteri(GLenum target, GLenum pname, GLint param)
+{
+    ++__statistics.stateChanges;
+    glTexParameteri(target, pname, param);
+}
+
+void TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+{
+    ++__statistics.textureUploads;
+    __statistics.bytesUploaded += width * height * getPixelSize(format, type);
+    glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+}
+
+void Uniform1f(GLint location, GLfloat v0)
+{
+    recordUniform(1, sizeof(GLfloat));
+    glUniform1f(location, v0);
+}
+
+void Uniform1fv(GLint location, GLsizei count, const GLfloat* value)
+{
+    recordUniform(count, sizeof(GLfloat));
+    glUniform1fv(location, count, value);
+}
+
+void Uniform1i(GLint location, GLint v0)
+{
+    recordUniform(1, sizeof(GLint));
+    glUniform1i(location, v0);
+}
+
+void Uniform1iv(GLint location, GLsizei count, const GLint* value)
+{
+    recordUniform(count, sizeof(GLint));
+    glUniform1iv(location, count, value);
+}
+
+void Uniform2f(GLint location, GLfloat v0, GLfloat v1)
+{
+    recordUniform(1, 2 * sizeof(GLfloat));
+    glUniform2f(location, v0, v1);
+}
+
+void Uniform2fv(GLint location, GLsizei count, const GLfloat* value)
+{
+    recordUniform(count, 2 * sizeof(GLfloat));
+    glUniform2fv(location, count, value);
+}
+
+void Uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+{
+    recordUniform(1, 3 * sizeof(GLfloat));
+    glUniform3f(location, v0, v1, v2);
+}
+
+void Uniform3fv(GLint location, GLsizei count, const GLfloat* value)
+{
+    recordUniform(count, 3 * sizeof(GLfloat));
+    glUniform3fv(location, count, value);
+}
+
+void Uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+{
+    recordUniform(1, 4 * sizeof(GLfloat));
+    glUniform4f(location, v0, v1, v2, v3);
+}
+
+void Uniform4fv(GLint location, GLsizei count, const GLfloat* value)
+{
+    recordUniform(count, 4 * sizeof(GLfloat));
+    glUniform4fv(location, count, value);
+}
+
+void UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    recordUniform(count, 16 * sizeof(GLfloat));
+    glUniformMatrix4fv(location, count, transpose, value);
+}
+
+GLboolean UnmapBuffer(GLenum target)
+{
+    return glUnmapBuffer(target);
+}
+
+void UseProgram(GLuint program)
+{
+    ++__statistics.stateChanges;
+    glUseProgram(program);
+}
+
+void VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
+{
+    ++__statistics.stateChanges;
+    glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+}
+
+void Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    ++__statistics.stateChanges;
+    glViewport(x, y, width, height);
+}
+
+}
+
+}
+
+#endif
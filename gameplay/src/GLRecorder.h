@@ -0,0 +1,382 @@
+#ifndef GLRECORDER_H_
+#define GLRECORDER_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines a layer between the engine and OpenGL that counts the GL calls of each frame.
+ *
+ * The recorder is compiled in when the engine is built with GP_GL_RECORDER
+ * (CMake option GP_GL_RECORDER=ON). Every GL function used by the engine is then
+ * routed through the recorder, which counts draw calls, state changes, buffer,
+ * texture and uniform uploads and the bytes transferred before calling the driver.
+ *
+ * The recorder also counts the calls of builds that use the null GL backend (see
+ * GLNull.h). Together with GP_HEADLESS this runs the full render path of a game
+ * without a GPU, so the cost of a frame can be measured on machines that have no
+ * GL driver. The benchmark sample (samples/benchmark) prints these statistics for a
+ * set of rendering scenarios.
+ *
+ * The recorder is only supported on platforms that load GL through GLEW.
+ *
+ * @script{ignore}
+ */
+class GLRecorder
+{
+    friend class Game;
+
+public:
+
+    /**
+     * The counts of the GL calls made during a frame.
+     */
+    struct Statistics
+    {
+        /** Calls to glDrawArrays and glDrawElements. */
+        unsigned int drawCalls;
+        /** Vertices or indices submitted by the draw calls. */
+        unsigned int vertices;
+        /** Calls to glClear. */
+        unsigned int clears;
+        /** Calls that change fixed-function state or bind programs, buffers, textures or vertex arrays. */
+        unsigned int stateChanges;
+        /** Calls to glBufferData and glBufferSubData that pass data, and calls to glMapBufferRange. */
+        unsigned int bufferUploads;
+        /** Calls that upload texture images. */
+        unsigned int textureUploads;
+        /** Calls to glUniform*. */
+        unsigned int uniformUploads;
+        /** Bytes passed to buffer, texture and uniform uploads. */
+        unsigned int bytesUploaded;
+    };
+
+    /**
+     * Gets the statistics of the last completed frame.
+     *
+     * @return The statistics of the last frame.
+     */
+    static const Statistics& getFrameStatistics();
+
+    /**
+     * Gets the statistics of the frame in progress.
+     *
+     * @return The statistics recorded since the last frame ended.
+     */
+    static const Statistics& getCurrentStatistics();
+
+    /**
+     * Determines if GL calls go to the null backend instead of a driver.
+     *
+     * @return True if the engine is built with GP_GL_NULL.
+     */
+    static bool isNullBackend();
+
+private:
+
+    /**
+     * Constructor.
+     */
+    GLRecorder();
+
+    /**
+     * Ends the current frame, storing its statistics and starting a new frame.
+     */
+    static void endFrame();
+};
+
+/**
+ * The GL functions used by the engine that are routed through the recorder.
+ */
+namespace gl
+{
+void ActiveTexture(GLenum texture);
+void AttachShader(GLuint program, GLuint shader);
+void BindAttribLocation(GLuint program, GLuint index, const GLchar* name);
+void BindBuffer(GLenum target, GLuint buffer);
+void BindFramebuffer(GLenum target, GLuint framebuffer);
+void BindRenderbuffer(GLenum target, GLuint renderbuffer);
+void BindTexture(GLenum target, GLuint texture);
+void BindVertexArray(GLuint array);
+void BlendFunc(GLenum sfactor, GLenum dfactor);
+void BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+void BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+GLenum CheckFramebufferStatus(GLenum target);
+void Clear(GLbitfield mask);
+void ClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha);
+void ClearDepth(GLclampd depth);
+void ClearStencil(GLint s);
+void CompileShader(GLuint shader);
+void CompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data);
+GLuint CreateProgram();
+GLuint CreateShader(GLenum type);
+void CullFace(GLenum mode);
+void DeleteBuffers(GLsizei n, const GLuint* buffers);
+void DeleteFramebuffers(GLsizei n, const GLuint* framebuffers);
+void DeleteProgram(GLuint program);
+void DeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers);
+void DeleteShader(GLuint shader);
+void DeleteTextures(GLsizei n, const GLuint* textures);
+void DeleteVertexArrays(GLsizei n, const GLuint* arrays);
+void DepthFunc(GLenum func);
+void DepthMask(GLboolean flag);
+void Disable(GLenum cap);
+void DisableVertexAttribArray(GLuint index);
+void DrawArrays(GLenum mode, GLint first, GLsizei count);
+void DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices);
+void Enable(GLenum cap);
+void EnableVertexAttribArray(GLuint index);
+void FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
+void FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+void FrontFace(GLenum mode);
+void GenBuffers(GLsizei n, GLuint* buffers);
+void GenerateMipmap(GLenum target);
+void GenFramebuffers(GLsizei n, GLuint* framebuffers);
+void GenRenderbuffers(GLsizei n, GLuint* renderbuffers);
+void GenTextures(GLsizei n, GLuint* textures);
+void GenVertexArrays(GLsizei n, GLuint* arrays);
+void GetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+void GetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+GLint GetAttribLocation(GLuint program, const GLchar* name);
+GLenum GetError();
+void GetIntegerv(GLenum pname, GLint* params);
+void GetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+void GetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+void GetProgramiv(GLuint program, GLenum pname, GLint* params);
+void GetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+void GetShaderiv(GLuint shader, GLenum pname, GLint* params);
+const GLubyte* GetString(GLenum name);
+GLint GetUniformLocation(GLuint program, const GLchar* name);
+void Hint(GLenum target, GLenum mode);
+GLboolean IsTexture(GLuint texture);
+void LinkProgram(GLuint program);
+void* MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+void PixelStorei(GLenum pname, GLint param);
+void ProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+void ProgramParameteri(GLuint program, GLenum pname, GLint value);
+void ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels);
+void RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+void ShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length);
+void StencilFunc(GLenum func, GLint ref, GLuint mask);
+void StencilMask(GLuint mask);
+void StencilOp(GLenum fail, GLenum zfail, GLenum zpass);
+void TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels);
+void TexParameteri(GLenum target, GLenum pname, GLint param);
+void TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels);
+void Uniform1f(GLint location, GLfloat v0);
+void Uniform1fv(GLint location, GLsizei count, const GLfloat* value);
+void Uniform1i(GLint location, GLint v0);
+void Uniform1iv(GLint location, GLsizei count, const GLint* value);
+void Uniform2f(GLint location, GLfloat v0, GLfloat v1);
+void Uniform2fv(GLint location, GLsizei count, const GLfloat* value);
+void Uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
+void Uniform3fv(GLint location, GLsizei count, const GLfloat* value);
+void Uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+void Uniform4fv(GLint location, GLsizei count, const GLfloat* value);
+void UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+GLboolean UnmapBuffer(GLenum target);
+void UseProgram(GLuint program);
+void VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+/**
+ * Determines if vertex array objects are available. The routed glGenVertexArrays
+ * is never NULL, so it cannot be tested to check for driver support.
+ *
+ * @return True if the driver supports vertex array objects, or if the null backend is used.
+ */
+bool hasVertexArrays();
+
+/**
+ * Determines if buffer ranges can be mapped. The routed glMapBufferRange is never
+ * NULL, so it cannot be tested to check for driver support.
+ *
+ * @return True if the driver supports glMapBufferRange, or if the null backend is used.
+ */
+bool hasMapBufferRange();
+}
+
+}
+
+// Route the GL calls of the engine through the recorder. GLRecorder.cpp defines
+// GP_GL_RECORDER_IMPL to call the driver (or the null GL backend) directly.
+#ifndef GP_GL_RECORDER_IMPL
+#undef glActiveTexture
+#undef glAttachShader
+#undef glBindAttribLocation
+#undef glBindBuffer
+#undef glBindFramebuffer
+#undef glBindRenderbuffer
+#undef glBindTexture
+#undef glBindVertexArray
+#undef glBlendFunc
+#undef glBufferData
+#undef glBufferSubData
+#undef glCheckFramebufferStatus
+#undef glClear
+#undef glClearColor
+#undef glClearDepth
+#undef glClearStencil
+#undef glCompileShader
+#undef glCompressedTexImage2D
+#undef glCreateProgram
+#undef glCreateShader
+#undef glCullFace
+#undef glDeleteBuffers
+#undef glDeleteFramebuffers
+#undef glDeleteProgram
+#undef glDeleteRenderbuffers
+#undef glDeleteShader
+#undef glDeleteTextures
+#undef glDeleteVertexArrays
+#undef glDepthFunc
+#undef glDepthMask
+#undef glDisable
+#undef glDisableVertexAttribArray
+#undef glDrawArrays
+#undef glDrawElements
+#undef glEnable
+#undef glEnableVertexAttribArray
+#undef glFramebufferRenderbuffer
+#undef glFramebufferTexture2D
+#undef glFrontFace
+#undef glGenBuffers
+#undef glGenerateMipmap
+#undef glGenFramebuffers
+#undef glGenRenderbuffers
+#undef glGenTextures
+#undef glGenVertexArrays
+#undef glGetActiveAttrib
+#undef glGetActiveUniform
+#undef glGetAttribLocation
+#undef glGetError
+#undef glGetIntegerv
+#undef glGetProgramBinary
+#undef glGetProgramInfoLog
+#undef glGetProgramiv
+#undef glGetShaderInfoLog
+#undef glGetShaderiv
+#undef glGetString
+#undef glGetUniformLocation
+#undef glHint
+#undef glIsTexture
+#undef glLinkProgram
+#undef glMapBufferRange
+#undef glPixelStorei
+#undef glProgramBinary
+#undef glProgramParameteri
+#undef glReadPixels
+#undef glRenderbufferStorage
+#undef glShaderSource
+#undef glStencilFunc
+#undef glStencilMask
+#undef glStencilOp
+#undef glTexImage2D
+#undef glTexParameteri
+#undef glTexSubImage2D
+#undef glUniform1f
+#undef glUniform1fv
+#undef glUniform1i
+#undef glUniform1iv
+#undef glUniform2f
+#undef glUniform2fv
+#undef glUniform3f
+#undef glUniform3fv
+#undef glUniform4f
+#undef glUniform4fv
+#undef glUniformMatrix4fv
+#undef glUnmapBuffer
+#undef glUseProgram
+#undef glVertexAttribPointer
+#undef glViewport
+#define glActiveTexture gameplay::gl::ActiveTexture
+#define glAttachShader gameplay::gl::AttachShader
+#define glBindAttribLocation gameplay::gl::BindAttribLocation
+#define glBindBuffer gameplay::gl::BindBuffer
+#define glBindFramebuffer gameplay::gl::BindFramebuffer
+#define glBindRenderbuffer gameplay::gl::BindRenderbuffer
+#define glBindTexture gameplay::gl::BindTexture
+#define glBindVertexArray gameplay::gl::BindVertexArray
+#define glBlendFunc gameplay::gl::BlendFunc
+#define glBufferData gameplay::gl::BufferData
+#define glBufferSubData gameplay::gl::BufferSubData
+#define glCheckFramebufferStatus gameplay::gl::CheckFramebufferStatus
+#define glClear gameplay::gl::Clear
+#define glClearColor gameplay::gl::ClearColor
+#define glClearDepth gameplay::gl::ClearDepth
+#define glClearStencil gameplay::gl::ClearStencil
+#define glCompileShader gameplay::gl::CompileShader
+#define glCompressedTexImage2D gameplay::gl::CompressedTexImage2D
+#define glCreateProgram gameplay::gl::CreateProgram
+#define glCreateShader gameplay::gl::CreateShader
+#define glCullFace gameplay::gl::CullFace
+#define glDeleteBuffers gameplay::gl::DeleteBuffers
+#define glDeleteFramebuffers gameplay::gl::DeleteFramebuffers
+#define glDeleteProgram gameplay::gl::DeleteProgram
+#define glDeleteRenderbuffers gameplay::gl::DeleteRenderbuffers
+#define glDeleteShader gameplay::gl::DeleteShader
+#define glDeleteTextures gameplay::gl::DeleteTextures
+#define glDeleteVertexArrays gameplay::gl::DeleteVertexArrays
+#define glDepthFunc gameplay::gl::DepthFunc
+#define glDepthMask gameplay::gl::DepthMask
+#define glDisable gameplay::gl::Disable
+#define glDisableVertexAttribArray gameplay::gl::DisableVertexAttribArray
+#define glDrawArrays gameplay::gl::DrawArrays
+#define glDrawElements gameplay::gl::DrawElements
+#define glEnable gameplay::gl::Enable
+#define glEnableVertexAttribArray gameplay::gl::EnableVertexAttribArray
+#define glFramebufferRenderbuffer gameplay::gl::FramebufferRenderbuffer
+#define glFramebufferTexture2D gameplay::gl::FramebufferTexture2D
+#define glFrontFace gameplay::gl::FrontFace
+#define glGenBuffers gameplay::gl::GenBuffers
+#define glGenerateMipmap gameplay::gl::GenerateMipmap
+#define glGenFramebuffers gameplay::gl::GenFramebuffers
+#define glGenRenderbuffers gameplay::gl::GenRenderbuffers
+#define glGenTextures gameplay::gl::GenTextures
+#define glGenVertexArrays gameplay::gl::GenVertexArrays
+#define glGetActiveAttrib gameplay::gl::GetActiveAttrib
+#define glGetActiveUniform gameplay::gl::GetActiveUniform
+#define glGetAttribLocation gameplay::gl::GetAttribLocation
+#define glGetError gameplay::gl::GetError
+#define glGetIntegerv gameplay::gl::GetIntegerv
+#define glGetProgramBinary gameplay::gl::GetProgramBinary
+#define glGetProgramInfoLog gameplay::gl::GetProgramInfoLog
+#define glGetProgramiv gameplay::gl::GetProgramiv
+#define glGetShaderInfoLog gameplay::gl::GetShaderInfoLog
+#define glGetShaderiv gameplay::gl::GetShaderiv
+#define glGetString gameplay::gl::GetString
+#define glGetUniformLocation gameplay::gl::GetUniformLocation
+#define glHint gameplay::gl::Hint
+#define glIsTexture gameplay::gl::IsTexture
+#define glLinkProgram gameplay::gl::LinkProgram
+#define glMapBufferRange gameplay::gl::MapBufferRange
+#define glPixelStorei gameplay::gl::PixelStorei
+#define glProgramBinary gameplay::gl::ProgramBinary
+#define glProgramParameteri gameplay::gl::ProgramParameteri
+#define glReadPixels gameplay::gl::ReadPixels
+#define glRenderbufferStorage gameplay::gl::RenderbufferStorage
+#define glShaderSource gameplay::gl::ShaderSource
+#define glStencilFunc gameplay::gl::StencilFunc
+#define glStencilMask gameplay::gl::StencilMask
+#define glStencilOp gameplay::gl::StencilOp
+#define glTexImage2D gameplay::gl::TexImage2D
+#define glTexParameteri gameplay::gl::TexParameteri
+#define glTexSubImage2D gameplay::gl::TexSubImage2D
+#define glUniform1f gameplay::gl::Uniform1f
+#define glUniform1fv gameplay::gl::Uniform1fv
+#define glUniform1i gameplay::gl::Uniform1i
+#define glUniform1iv gameplay::gl::Uniform1iv
+#define glUniform2f gameplay::gl::Uniform2f
+#define glUniform2fv gameplay::gl::Uniform2fv
+#define glUniform3f gameplay::gl::Uniform3f
+#define glUniform3fv gameplay::gl::Uniform3fv
+#define glUniform4f gameplay::gl::Uniform4f
+#define glUniform4fv gameplay::gl::Uniform4fv
+#define glUniformMatrix4fv gameplay::gl::UniformMatrix4fv
+#define glUnmapBuffer gameplay::gl::UnmapBuffer
+#define glUseProgram gameplay::gl::UseProgram
+#define glVertexAttribPointer gameplay::gl::VertexAttribPointer
+#define glViewport gameplay::gl::Viewport
+#endif
+
+#endif
@@ -8,6 +8,7 @@
 #include "ControlFactory.h"
 #include "Theme.h"
 #include "Form.h"
+#include "Profiler.h"
 
 /** @script{ignore} */
 GLenum __gl_error_code = GL_NO_ERROR;
@@ -356,6 +357,8 @@ void Game::exit()
 
 void Game::frame()
 {
+    Profiler::beginFrame();
+
     if (!_initialized)
     {
         // Perform lazy first time initialization
@@ -386,36 +389,66 @@ void Game::frame()
         lastFrameTime = frameTime;
 
         // Update the scheduled and running animations.
-        _animationController->update(elapsedTime);
+        {
+            GP_PROFILE_SCOPE("Animation");
+            _animationController->update(elapsedTime);
+        }
 
         // Update the physics.
-        _physicsController->update(elapsedTime);
+        {
+            GP_PROFILE_SCOPE("Physics");
+            _physicsController->update(elapsedTime);
+        }
 
         // Update AI.
-        _aiController->update(elapsedTime);
+        {
+            GP_PROFILE_SCOPE("AI");
+            _aiController->update(elapsedTime);
+        }
 
         // Update gamepads.
-        Gamepad::updateInternal(elapsedTime);
+        {
+            GP_PROFILE_SCOPE("Gamepad");
+            Gamepad::updateInternal(elapsedTime);
+        }
 
         // Application Update.
-        update(elapsedTime);
+        {
+            GP_PROFILE_SCOPE("Update");
+            update(elapsedTime);
+        }
 
         // Update forms.
-        Form::updateInternal(elapsedTime);
+        {
+            GP_PROFILE_SCOPE("Forms");
+            Form::updateInternal(elapsedTime);
+        }
 
         // Run script update.
         if (_scriptTarget)
+        {
+            GP_PROFILE_SCOPE("Script");
             _scriptTarget->fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(GameScriptTarget, update), elapsedTime);
+        }
+
+        // Notify deferred transform listeners of this frame's changes.
+        Transform::flushTransformChanged();
 
         // Audio Rendering.
-        _audioController->update(elapsedTime);
+        {
+            GP_PROFILE_SCOPE("Audio");
+            _audioController->update(elapsedTime);
+        }
 
         // Graphics Rendering.
-        render(elapsedTime);
+        {
+            GP_PROFILE_SCOPE("Render");
+            render(elapsedTime);
 
-        // Run script render.
-        if (_scriptTarget)
-            _scriptTarget->fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(GameScriptTarget, render), elapsedTime);
+            // Run script render.
+            if (_scriptTarget)
+                _scriptTarget->fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(GameScriptTarget, render), elapsedTime);
+        }
 
         // Update FPS.
         ++_frameCount;
@@ -441,6 +474,9 @@ void Game::frame()
         if (_scriptTarget)
             _scriptTarget->fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(GameScriptTarget, update), 0);
 
+        // Notify deferred transform listeners.
+        Transform::flushTransformChanged();
+
         // Graphics Rendering.
         render(0);
 
@@ -448,6 +484,12 @@ void Game::frame()
         if (_scriptTarget)
             _scriptTarget->fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(GameScriptTarget, render), 0);
     }
+
+    RenderState::resetFrameStatistics();
+#ifdef GP_GL_RECORDER
+    GLRecorder::endFrame();
+#endif
+    Profiler::endFrame();
 }
 
 void Game::renderOnce(const char* function)
@@ -789,7 +831,8 @@ void Game::loadConfig()
 
 void Game::loadGamepads()
 {
-    // Load virtual gamepads.
+    // Load virtual gamepads (these take touch input, so they are not available in headless builds).
+#ifndef GP_HEADLESS
     if (_properties)
     {
         // Check if there are any virtual gamepads included in the .config file.
@@ -815,6 +858,7 @@ void Game::loadGamepads()
             inner = _properties->getNextNamespace();
         }
     }
+#endif
 }
 
 void Game::ShutdownListener::timeEvent(long timeDiff, void* cookie)
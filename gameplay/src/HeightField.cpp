@@ -6,15 +6,22 @@
 namespace gameplay
 {
 
-HeightField::HeightField(unsigned int columns, unsigned int rows)
-    : _array(NULL), _cols(columns), _rows(rows)
+// The largest magnitude of a quantized height.
+#define HEIGHTFIELD_QUANTIZED_MAX 32767
+
+HeightField::HeightField(unsigned int columns, unsigned int rows, bool quantized)
+    : _array(NULL), _quantized(NULL), _quantizedOffset(0), _quantizedScale(0), _cols(columns), _rows(rows)
 {
-    _array = new float[columns * rows];
+    if (quantized)
+        _quantized = new short[columns * rows];
+    else
+        _array = new float[columns * rows];
 }
 
 HeightField::~HeightField()
 {
     SAFE_DELETE_ARRAY(_array);
+    SAFE_DELETE_ARRAY(_quantized);
 }
 
 HeightField* HeightField::create(unsigned int columns, unsigned int rows)
@@ -22,6 +29,16 @@ HeightField* HeightField::create(unsigned int columns, unsigned int rows)
     return new HeightField(columns, rows);
 }
 
+HeightField* HeightField::createQuantized(unsigned int columns, unsigned int rows, float heightMin, float heightMax)
+{
+    GP_ASSERT(heightMax >= heightMin);
+
+    HeightField* heightfield = new HeightField(columns, rows, true);
+    heightfield->_quantizedOffset = (heightMin + heightMax) * 0.5f;
+    heightfield->_quantizedScale = (heightMax - heightMin) / (2 * HEIGHTFIELD_QUANTIZED_MAX);
+    return heightfield;
+}
+
 /**
  * @script{ignore}
  */
@@ -164,45 +181,147 @@ float* HeightField::getArray() const
     return _array;
 }
 
-float HeightField::getHeight(float column, float row) const
+void HeightField::quantize()
 {
-    // Clamp to heightfield boundaries
-    column = column < 0 ? 0 : (column > (_cols-1) ? (_cols-1) : column);
-    row = row < 0 ? 0 : (row > (_rows-1) ? (_rows-1) : row);
-
-    unsigned int x1 = column;
-    unsigned int y1 = row;
-    unsigned int x2 = x1 + 1;
-    unsigned int y2 = y1 + 1;
-    float tmp;
-    float xFactor = modf(column, &tmp);
-    float yFactor = modf(row, &tmp);
-    float xFactorI = 1.0f - xFactor;
-    float yFactorI = 1.0f - yFactor;
-
-    if (x2 >= _cols && y2 >= _rows)
+    if (_quantized)
+        return;
+
+    unsigned int count = _cols * _rows;
+    float heightMin = FLT_MAX, heightMax = -FLT_MAX;
+    for (unsigned int i = 0; i < count; ++i)
     {
-        return _array[x1 + y1 * _cols];
+        heightMin = std::min(heightMin, _array[i]);
+        heightMax = std::max(heightMax, _array[i]);
     }
-    else if (x2 >= _cols)
+
+    _quantizedOffset = (heightMin + heightMax) * 0.5f;
+    _quantizedScale = (heightMax - heightMin) / (2 * HEIGHTFIELD_QUANTIZED_MAX);
+    float invScale = _quantizedScale > 0.0f ? 1.0f / _quantizedScale : 0.0f;
+
+    _quantized = new short[count];
+    for (unsigned int i = 0; i < count; ++i)
     {
-        return _array[x1 + y1 * _cols] * yFactorI + _array[x1 + y2 * _cols] * yFactor;
+        float value = (_array[i] - _quantizedOffset) * invScale;
+        value = std::max(-(float)HEIGHTFIELD_QUANTIZED_MAX, std::min((float)HEIGHTFIELD_QUANTIZED_MAX, value));
+        _quantized[i] = (short)(value < 0.0f ? value - 0.5f : value + 0.5f);
     }
-    else if (y2 >= _rows)
+    SAFE_DELETE_ARRAY(_array);
+}
+
+bool HeightField::isQuantized() const
+{
+    return _quantized != NULL;
+}
+
+short* HeightField::getQuantizedArray() const
+{
+    return _quantized;
+}
+
+float HeightField::getQuantizedOffset() const
+{
+    return _quantizedOffset;
+}
+
+float HeightField::getQuantizedScale() const
+{
+    return _quantizedScale;
+}
+
+float HeightField::getHeight(float column, float row) const
+{
+    float height;
+    getHeights(&column, &row, &height, 1);
+    return height;
+}
+
+// Bilinearly interpolates heights at the given points. Each point is clamped to the heightfield
+// and interpolated within the cell at its lower left (or the last cell on the far edges), so the
+// loop has no data dependent branches.
+template <typename T>
+static void interpolateHeights(const T* data, float offset, float scale, unsigned int cols, unsigned int rows,
+                               const float* columns, const float* rowsIn, float* heights, unsigned int count)
+{
+    const float maxColumn = (float)(cols - 1);
+    const float maxRow = (float)(rows - 1);
+    const unsigned int lastCellX = cols > 1 ? cols - 2 : 0;
+    const unsigned int lastCellY = rows > 1 ? rows - 2 : 0;
+    const unsigned int stepX = cols > 1 ? 1 : 0;
+    const unsigned int stepY = rows > 1 ? cols : 0;
+
+    for (unsigned int i = 0; i < count; ++i)
     {
-        return _array[x1 + y1 * _cols] * xFactorI + _array[x2 + y1 * _cols] * xFactor;
+        float column = std::max(0.0f, std::min(maxColumn, columns[i]));
+        float row = std::max(0.0f, std::min(maxRow, rowsIn[i]));
+        unsigned int x = std::min((unsigned int)column, lastCellX);
+        unsigned int y = std::min((unsigned int)row, lastCellY);
+        float tx = column - x;
+        float ty = row - y;
+
+        const T* p = data + y * cols + x;
+        float h00 = (float)p[0];
+        float h10 = (float)p[stepX];
+        float h01 = (float)p[stepY];
+        float h11 = (float)p[stepY + stepX];
+        float north = h00 + (h10 - h00) * tx;
+        float south = h01 + (h11 - h01) * tx;
+        heights[i] = offset + (north + (south - north) * ty) * scale;
     }
-    else
+}
+
+// Computes normals from the gradient of the bilinear surface at the given points.
+template <typename T>
+static void interpolateNormals(const T* data, float scale, unsigned int cols, unsigned int rows,
+                               const float* columns, const float* rowsIn, Vector3* normals, unsigned int count)
+{
+    const float maxColumn = (float)(cols - 1);
+    const float maxRow = (float)(rows - 1);
+    const unsigned int lastCellX = cols > 1 ? cols - 2 : 0;
+    const unsigned int lastCellY = rows > 1 ? rows - 2 : 0;
+    const unsigned int stepX = cols > 1 ? 1 : 0;
+    const unsigned int stepY = rows > 1 ? cols : 0;
+
+    for (unsigned int i = 0; i < count; ++i)
     {
-        float a = xFactorI * yFactorI;
-        float b = xFactorI * yFactor;
-        float c = xFactor * yFactor;
-        float d = xFactor * yFactorI;
-        return _array[x1 + y1 * _cols] * a + _array[x1 + y2 * _cols] * b +
-            _array[x2 + y2 * _cols] * c + _array[x2 + y1 * _cols] * d;
+        float column = std::max(0.0f, std::min(maxColumn, columns[i]));
+        float row = std::max(0.0f, std::min(maxRow, rowsIn[i]));
+        unsigned int x = std::min((unsigned int)column, lastCellX);
+        unsigned int y = std::min((unsigned int)row, lastCellY);
+        float tx = column - x;
+        float ty = row - y;
+
+        const T* p = data + y * cols + x;
+        float h00 = (float)p[0];
+        float h10 = (float)p[stepX];
+        float h01 = (float)p[stepY];
+        float h11 = (float)p[stepY + stepX];
+        float dx = ((h10 - h00) * (1.0f - ty) + (h11 - h01) * ty) * scale;
+        float dz = ((h01 - h00) * (1.0f - tx) + (h11 - h10) * tx) * scale;
+        float invLength = 1.0f / std::sqrt(dx * dx + 1.0f + dz * dz);
+        normals[i].set(-dx * invLength, invLength, -dz * invLength);
     }
 }
 
+void HeightField::getHeights(const float* columns, const float* rows, float* heights, unsigned int count) const
+{
+    GP_ASSERT(columns && rows && heights);
+
+    if (_quantized)
+        interpolateHeights(_quantized, _quantizedOffset, _quantizedScale, _cols, _rows, columns, rows, heights, count);
+    else
+        interpolateHeights(_array, 0.0f, 1.0f, _cols, _rows, columns, rows, heights, count);
+}
+
+void HeightField::getNormals(const float* columns, const float* rows, Vector3* normals, unsigned int count) const
+{
+    GP_ASSERT(columns && rows && normals);
+
+    if (_quantized)
+        interpolateNormals(_quantized, _quantizedScale, _cols, _rows, columns, rows, normals, count);
+    else
+        interpolateNormals(_array, 1.0f, _cols, _rows, columns, rows, normals, count);
+}
+
 unsigned int HeightField::getColumnCount() const
 {
     return _cols;
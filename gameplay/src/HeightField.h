@@ -2,6 +2,7 @@
 #define HEIGHTFIELD_H_
 
 #include "Ref.h"
+#include "Vector3.h"
 
 namespace gameplay
 {
@@ -12,6 +13,10 @@ namespace gameplay
      * Heightfields can be used to construct both Terrain objects as well as PhysicsCollisionShape
      * heightfield defintions, which are used in heightfield rigid body creation. Heightfields can
      * be populated manually, or loaded from images and RAW files.
+     *
+     * Heights are stored as 32-bit floats by default. A heightfield can instead store 16-bit
+     * quantized heights over a fixed height range, which halves its memory. Quantized heights
+     * are used directly by heightfield collision shapes.
      */
     class HeightField : public Ref
     {
@@ -27,6 +32,23 @@ namespace gameplay
          */
         static HeightField* create(unsigned int rows, unsigned int columns);
 
+        /**
+         * Creates a new HeightField of the given dimensions that stores 16-bit quantized heights,
+         * with uninitialized height data.
+         *
+         * Quantized values range from -32767 to 32767 and are mapped linearly to the given
+         * height range (see getQuantizedOffset and getQuantizedScale).
+         *
+         * @param rows Number of rows in the height field.
+         * @param columns Number of columns in the height field.
+         * @param heightMin The height of the smallest quantized value.
+         * @param heightMax The height of the largest quantized value (must be >= heightMin).
+         *
+         * @return The new HeightField.
+         * @script{ignore}
+         */
+        static HeightField* createQuantized(unsigned int rows, unsigned int columns, float heightMin, float heightMax);
+
         /**
          * Creates a HeightField from the specified heightfield image.
          *
@@ -78,10 +100,57 @@ namespace gameplay
          * The array is packed in row major order, meaning that the data is aligned in rows,
          * from top left to bottom right.
          *
-         * @return The underlying height array.
+         * @return The underlying height array, or NULL if the heightfield is quantized.
          */
         float* getArray() const;
 
+        /**
+         * Converts the heights of this heightfield to 16-bit values over the range between its
+         * lowest and highest height, and frees the float height array.
+         *
+         * This must be done before the heightfield is used to create a Terrain or collision shape,
+         * since those may hold on to the float height array. Has no effect if the heightfield is
+         * already quantized.
+         *
+         * @script{ignore}
+         */
+        void quantize();
+
+        /**
+         * Determines if this heightfield stores 16-bit quantized heights.
+         *
+         * @return True if the heightfield is quantized.
+         * @script{ignore}
+         */
+        bool isQuantized() const;
+
+        /**
+         * Returns a pointer to the underlying quantized height array.
+         *
+         * The array is packed in row major order like the float height array, and each height is
+         * getQuantizedOffset() + value * getQuantizedScale().
+         *
+         * @return The quantized height array, or NULL if the heightfield is not quantized.
+         * @script{ignore}
+         */
+        short* getQuantizedArray() const;
+
+        /**
+         * Returns the height that a quantized value of zero represents.
+         *
+         * @return The quantized height offset.
+         * @script{ignore}
+         */
+        float getQuantizedOffset() const;
+
+        /**
+         * Returns the height difference between consecutive quantized values.
+         *
+         * @return The quantized height scale.
+         * @script{ignore}
+         */
+        float getQuantizedScale() const;
+
         /**
          * Returns the height at the specified row and column.
          *
@@ -99,6 +168,33 @@ namespace gameplay
          */
         float getHeight(float column, float row) const;
 
+        /**
+         * Returns the heights at multiple points.
+         *
+         * Each point is interpolated and clamped in the same way as getHeight. Batches of points
+         * are processed in a single tight loop, which is considerably faster than calling getHeight
+         * for each point.
+         *
+         * @param columns The columns of the points to query.
+         * @param rows The rows of the points to query.
+         * @param heights Populated with the height of each point.
+         * @param count The number of points.
+         * @script{ignore}
+         */
+        void getHeights(const float* columns, const float* rows, float* heights, unsigned int count) const;
+
+        /**
+         * Returns the surface normals at multiple points, in the heightfield's own space where
+         * columns and rows are one unit apart along the X and Z axes and heights lie along the Y axis.
+         *
+         * @param columns The columns of the points to query.
+         * @param rows The rows of the points to query.
+         * @param normals Populated with the unit length normal of each point.
+         * @param count The number of points.
+         * @script{ignore}
+         */
+        void getNormals(const float* columns, const float* rows, Vector3* normals, unsigned int count) const;
+
         /**
          * Returns the number of rows in the heightfield.
          *
@@ -118,7 +214,7 @@ namespace gameplay
         /**
          * Hidden constructor.
          */
-        HeightField(unsigned int columns, unsigned int rows);
+        HeightField(unsigned int columns, unsigned int rows, bool quantized = false);
 
         /**
          * Hidden destructor (use Ref::release()).
@@ -131,6 +227,9 @@ namespace gameplay
         static HeightField* create(const char* path, unsigned int width, unsigned int height, float heightMin, float heightMax);
 
         float* _array;
+        short* _quantized;
+        float _quantizedOffset;
+        float _quantizedScale;
         unsigned int _cols;
         unsigned int _rows;
     };
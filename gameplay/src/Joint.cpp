@@ -35,6 +35,11 @@ Node::Type Joint::getType() const
     return Node::JOINT;
 }
 
+MeshSkin* Joint::getSkin() const
+{
+    return _skin.skin;
+}
+
 Scene* Joint::getScene() const
 {
     // Overrides Node::getScene() to search the node our skins.
@@ -41,6 +41,14 @@ public:
      */
     const Matrix& getInverseBindPose() const;
 
+    /**
+     * Returns the first mesh skin that references this joint.
+     *
+     * @return The mesh skin, or NULL if the joint is not part of a mesh skin.
+     * @script{ignore}
+     */
+    MeshSkin* getSkin() const;
+
 protected:
 
     /**
@@ -42,6 +42,8 @@ Material* Material::create(const char* url, PassCallback callback, void* cookie)
 
     Material* material = create((strlen(properties->getNamespace()) > 0) ? properties : properties->getNextNamespace(), callback, cookie);
     SAFE_DELETE(properties);
+    if (material)
+        material->_url = url;
 
     return material;
 }
@@ -190,9 +192,15 @@ void Material::setNodeBinding(Node* node)
     }
 }
 
+const char* Material::getUrl() const
+{
+    return _url.c_str();
+}
+
 Material* Material::clone(NodeCloneContext &context) const
 {
     Material* material = new Material();
+    material->_url = _url;
     RenderState::cloneInto(material, context);
 
     for (std::vector<Technique*>::const_iterator it = _techniques.begin(); it != _techniques.end(); ++it)
@@ -27,6 +27,8 @@ class Material : public RenderState
     friend class RenderState;
     friend class Node;
     friend class Model;
+    friend class SceneLoader;
+    friend class StaticBatch;
 
 public:
 
@@ -148,6 +150,19 @@ public:
      */
     void setNodeBinding(Node* node);
 
+    /**
+     * Returns the URL the material was loaded from.
+     *
+     * Materials loaded from a material file, or from a material reference in a
+     * scene file, return the URL they were loaded from. Materials created from
+     * an effect or from shader files return an empty string. Clones keep the
+     * URL of the material they were cloned from.
+     *
+     * @return The URL the material was loaded from.
+     * @script{ignore}
+     */
+    const char* getUrl() const;
+
 private:
 
     /**
@@ -195,6 +210,7 @@ private:
      */
     static void loadRenderState(RenderState* renderState, Properties* properties);
 
+    std::string _url;
     Technique* _currentTechnique;
     std::vector<Technique*> _techniques;
 };
@@ -447,6 +447,13 @@ void MaterialParameter::setSamplerArray(const Texture::Sampler** values, unsigne
 }
 
 void MaterialParameter::bind(Effect* effect)
+{
+    Uniform* uniform = getUniform(effect);
+    if (uniform)
+        bind(effect, uniform);
+}
+
+Uniform* MaterialParameter::getUniform(Effect* effect)
 {
     GP_ASSERT(effect);
 
@@ -464,9 +471,18 @@ void MaterialParameter::bind(Effect* effect)
                 GP_WARN("Material parameter for uniform '%s' not found in effect: '%s'.", _name.c_str(), effect->getId());
                 _loggerDirtyBits |= UNIFORM_NOT_FOUND;
             }
-            return;
         }
     }
+    return _uniform;
+}
+
+void MaterialParameter::bind(Effect* effect, Uniform* uniform)
+{
+    GP_ASSERT(effect);
+    GP_ASSERT(uniform);
+
+    // Method bindings read the uniform from the parameter.
+    _uniform = uniform;
 
     switch (_type)
     {
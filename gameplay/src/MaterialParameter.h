@@ -432,6 +432,16 @@ private:
 
     void bind(Effect* effect);
 
+    /**
+     * Gets the uniform of this parameter in the given effect, warning once if it does not exist.
+     */
+    Uniform* getUniform(Effect* effect);
+
+    /**
+     * Binds the value of this parameter to the given uniform of the effect.
+     */
+    void bind(Effect* effect, Uniform* uniform);
+
     void applyAnimationValue(AnimationValue* value, float blendWeight, int components);
 
     void cloneInto(MaterialParameter* materialParameter) const;
@@ -2,14 +2,108 @@
 #include "MeshBatch.h"
 #include "Material.h"
 
+// The minimum size of the vertex and index stream buffers, in bytes.
+#define MESHBATCH_STREAM_BUFFER_MIN_SIZE (1024 * 1024)
+
 namespace gameplay
 {
 
+/**
+ * A buffer object that batches stream their vertices or indices into when drawn.
+ *
+ * Consecutive draws are written one after another. When the buffer is full, its
+ * storage is orphaned and writing restarts at the beginning. The driver hands out
+ * new storage for the orphaned buffer, so draws still reading the old data never
+ * stall the upload and no fences are needed. Where buffer ranges can be mapped, the
+ * data is written straight into the buffer storage instead of being staged by
+ * glBufferSubData.
+ */
+struct StreamBuffer
+{
+    GLenum target;
+    GLuint handle;
+    size_t capacity;
+    size_t offset;
+};
+
+static StreamBuffer __vertexStream = { GL_ARRAY_BUFFER, 0, 0, 0 };
+static StreamBuffer __indexStream = { GL_ELEMENT_ARRAY_BUFFER, 0, 0, 0 };
+static unsigned int __streamBufferUsers = 0;
+
+#ifdef GP_USE_MAP_BUFFER_RANGE
+// Determines if the driver can map buffer ranges (GL 3.0 or ARB_map_buffer_range).
+static bool isMapBufferRangeSupported()
+{
+#ifdef GP_GL_RECORDER
+    return gl::hasMapBufferRange();
+#else
+    return glMapBufferRange != NULL;
+#endif
+}
+#endif
+
+// Writes data into the stream buffer (leaving it bound) and returns the offset it was written to.
+static size_t writeStreamBuffer(StreamBuffer& stream, const void* data, size_t size)
+{
+    if (stream.handle == 0)
+    {
+        GL_ASSERT( glGenBuffers(1, &stream.handle) );
+    }
+    GL_ASSERT( glBindBuffer(stream.target, stream.handle) );
+
+    // Vertex attribute offsets must be 4 byte aligned
+    size_t offset = (stream.offset + 3) & ~(size_t)3;
+    if (offset + size > stream.capacity)
+    {
+        if (size > stream.capacity)
+            stream.capacity = std::max(size, std::max(stream.capacity * 2, (size_t)MESHBATCH_STREAM_BUFFER_MIN_SIZE));
+        GL_ASSERT( glBufferData(stream.target, stream.capacity, NULL, GL_STREAM_DRAW) );
+        offset = 0;
+    }
+    stream.offset = offset + size;
+
+#ifdef GP_USE_MAP_BUFFER_RANGE
+    if (isMapBufferRangeSupported())
+    {
+        // Nothing has been written to this range since the buffer was last orphaned,
+        // so it can be mapped unsynchronized without waiting for draws in flight.
+        void* buffer = NULL;
+        GL_ASSERT( buffer = glMapBufferRange(stream.target, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT) );
+        if (buffer)
+        {
+            memcpy(buffer, data, size);
+            GLboolean unmapped = GL_FALSE;
+            GL_ASSERT( unmapped = glUnmapBuffer(stream.target) );
+            if (unmapped)
+                return offset;
+        }
+    }
+#endif
+
+    // The mapping failed or is not supported, so let the driver copy the data.
+    GL_ASSERT( glBufferSubData(stream.target, offset, size, data) );
+
+    return offset;
+}
+
+static void deleteStreamBuffer(StreamBuffer& stream)
+{
+    if (stream.handle)
+    {
+        GL_ASSERT( glDeleteBuffers(1, &stream.handle) );
+        stream.handle = 0;
+    }
+    stream.capacity = 0;
+    stream.offset = 0;
+}
+
 MeshBatch::MeshBatch(const VertexFormat& vertexFormat, Mesh::PrimitiveType primitiveType, Material* material, bool indexed, unsigned int initialCapacity, unsigned int growSize)
     : _vertexFormat(vertexFormat), _primitiveType(primitiveType), _material(material), _indexed(indexed), _capacity(0), _growSize(growSize),
     _vertexCapacity(0), _indexCapacity(0), _vertexCount(0), _indexCount(0), _vertices(NULL), _verticesPtr(NULL), _indices(NULL), _indicesPtr(NULL), _started(false)
 {
     resize(initialCapacity);
+    updateVertexAttributeBinding();
+    ++__streamBufferUsers;
 }
 
 MeshBatch::~MeshBatch()
@@ -17,6 +111,13 @@ MeshBatch::~MeshBatch()
     SAFE_RELEASE(_material);
     SAFE_DELETE_ARRAY(_vertices);
     SAFE_DELETE_ARRAY(_indices);
+
+    // Free the stream buffers along with the last batch using them
+    if (--__streamBufferUsers == 0)
+    {
+        deleteStreamBuffer(__vertexStream);
+        deleteStreamBuffer(__indexStream);
+    }
 }
 
 MeshBatch* MeshBatch::create(const VertexFormat& vertexFormat, Mesh::PrimitiveType primitiveType, const char* materialPath, bool indexed, unsigned int initialCapacity, unsigned int growSize)
@@ -116,7 +217,8 @@ void MeshBatch::updateVertexAttributeBinding()
         {
             Pass* p = t->getPassByIndex(j);
             GP_ASSERT(p);
-            VertexAttributeBinding* b = VertexAttributeBinding::create(_vertexFormat, _vertices, p->getEffect());
+            // Attribute pointers are offsets into the vertex stream buffer
+            VertexAttributeBinding* b = VertexAttributeBinding::create(_vertexFormat, NULL, p->getEffect());
             p->setVertexAttributeBinding(b);
             SAFE_RELEASE(b);
         }
@@ -211,9 +313,6 @@ bool MeshBatch::resize(unsigned int capacity)
     _vertexCapacity = vertexCapacity;
     _indexCapacity = indexCapacity;
 
-    // Update our vertex attribute bindings now that our client array pointers have changed
-    updateVertexAttributeBinding();
-
     return true;
 }
 
@@ -241,19 +340,29 @@ void MeshBatch::finish()
     _started = false;
 }
 
+void MeshBatch::upload(size_t* vertexOffset, size_t* indexOffset)
+{
+    GP_ASSERT(vertexOffset);
+    GP_ASSERT(indexOffset);
+
+    *vertexOffset = writeStreamBuffer(__vertexStream, _vertices, _vertexCount * _vertexFormat.getVertexSize());
+    *indexOffset = _indexed ? writeStreamBuffer(__indexStream, _indices, _indexCount * sizeof(unsigned short)) : 0;
+}
+
 void MeshBatch::draw()
 {
     if (_vertexCount == 0 || (_indexed && _indexCount == 0))
         return; // nothing to draw
 
-    // Not using VBOs, so unbind the element array buffer.
-    // ARRAY_BUFFER will be unbound automatically during pass->bind().
-    GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0 ) );
-
     GP_ASSERT(_material);
     if (_indexed)
         GP_ASSERT(_indices);
 
+    // Upload the batch once so that every pass draws from the same buffer data.
+    // The index stream buffer is left bound to ELEMENT_ARRAY_BUFFER.
+    size_t vertexOffset, indexOffset;
+    upload(&vertexOffset, &indexOffset);
+
     // Bind the material.
     Technique* technique = _material->getTechnique();
     GP_ASSERT(technique);
@@ -262,11 +371,14 @@ void MeshBatch::draw()
     {
         Pass* pass = technique->getPassByIndex(i);
         GP_ASSERT(pass);
+        VertexAttributeBinding* binding = pass->getVertexAttributeBinding();
+        if (binding)
+            binding->setVertexBuffer(__vertexStream.handle, vertexOffset);
         pass->bind();
 
         if (_indexed)
         {
-            GL_ASSERT( glDrawElements(_primitiveType, _indexCount, GL_UNSIGNED_SHORT, (GLvoid*)_indices) );
+            GL_ASSERT( glDrawElements(_primitiveType, _indexCount, GL_UNSIGNED_SHORT, (GLvoid*)indexOffset) );
         }
         else
         {
@@ -275,7 +387,11 @@ void MeshBatch::draw()
 
         pass->unbind();
     }
+
+    if (_indexed)
+    {
+        GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+    }
 }
-    
 
 }
@@ -162,6 +162,14 @@ private:
 
     void updateVertexAttributeBinding();
 
+    /**
+     * Copies the vertices and indices in the batch into the shared stream buffers.
+     *
+     * @param vertexOffset Populated with the offset of the vertices in the vertex stream buffer.
+     * @param indexOffset Populated with the offset of the indices in the index stream buffer.
+     */
+    void upload(size_t* vertexOffset, size_t* indexOffset);
+
     bool resize(unsigned int capacity);
 
     const VertexFormat _vertexFormat;
@@ -10,12 +10,12 @@ namespace gameplay
 {
 
 Model::Model() : Drawable(),
-    _mesh(NULL), _material(NULL), _partCount(0), _partMaterials(NULL), _skin(NULL)
+    _mesh(NULL), _material(NULL), _partCount(0), _partMaterials(NULL), _skin(NULL), _lodHysteresis(0.1f), _lod(0)
 {
 }
 
 Model::Model(Mesh* mesh) : Drawable(),
-    _mesh(mesh), _material(NULL), _partCount(0), _partMaterials(NULL), _skin(NULL)
+    _mesh(mesh), _material(NULL), _partCount(0), _partMaterials(NULL), _skin(NULL), _lodHysteresis(0.1f), _lod(0)
 {
     GP_ASSERT(mesh);
     _partCount = mesh->getPartCount();
@@ -32,6 +32,14 @@ Model::~Model()
         }
         SAFE_DELETE_ARRAY(_partMaterials);
     }
+    for (size_t i = 0, count = _lodBindings.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(_lodBindings[i]);
+    }
+    for (size_t i = 0, count = _lodMeshes.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(_lodMeshes[i]);
+    }
     SAFE_RELEASE(_mesh);
     SAFE_DELETE(_skin);
 }
@@ -151,7 +159,7 @@ void Model::setMaterial(Material* material, int partIndex)
             {
                 Pass* p = t->getPassByIndex(j);
                 GP_ASSERT(p);
-                VertexAttributeBinding* b = VertexAttributeBinding::create(_mesh, p->getEffect());
+                VertexAttributeBinding* b = VertexAttributeBinding::create(getLodMesh(_lod), p->getEffect());
                 p->setVertexAttributeBinding(b);
                 SAFE_RELEASE(b);
             }
@@ -212,6 +220,123 @@ MeshSkin* Model::getSkin() const
     return _skin;
 }
 
+bool Model::addLod(Mesh* mesh, float screenSize)
+{
+    GP_ASSERT(mesh);
+    GP_ASSERT(_mesh);
+
+    if (mesh->getPartCount() != _mesh->getPartCount())
+    {
+        GP_ERROR("Level of detail mesh has %u parts, but the model's mesh has %u parts.", mesh->getPartCount(), _mesh->getPartCount());
+        return false;
+    }
+
+    mesh->addRef();
+    _lodMeshes.push_back(mesh);
+    _lodScreenSizes.push_back(screenSize);
+    return true;
+}
+
+unsigned int Model::getLodCount() const
+{
+    return (unsigned int)_lodMeshes.size();
+}
+
+Mesh* Model::getLodMesh(unsigned int index) const
+{
+    GP_ASSERT(index <= _lodMeshes.size());
+    return index == 0 ? _mesh : _lodMeshes[index - 1];
+}
+
+float Model::getLodScreenSize(unsigned int index) const
+{
+    GP_ASSERT(index > 0 && index <= _lodScreenSizes.size());
+    return _lodScreenSizes[index - 1];
+}
+
+void Model::setLodScreenSize(unsigned int index, float screenSize)
+{
+    GP_ASSERT(index > 0 && index <= _lodScreenSizes.size());
+    _lodScreenSizes[index - 1] = screenSize;
+}
+
+unsigned int Model::getLod() const
+{
+    return _lod;
+}
+
+float Model::getLodHysteresis() const
+{
+    return _lodHysteresis;
+}
+
+void Model::setLodHysteresis(float hysteresis)
+{
+    _lodHysteresis = hysteresis;
+}
+
+void Model::updateLod()
+{
+    Node* node = getNode();
+    Scene* scene = node ? node->getScene() : NULL;
+    Camera* camera = scene ? scene->getActiveCamera() : NULL;
+    if (camera == NULL || camera->getNode() == NULL)
+        return;
+
+    float screenSize = camera->getProjectedSize(node->getBoundingSphere());
+
+    // Step to a coarser level once well below its screen size, or back to a finer one once well above it.
+    unsigned int lod = _lod;
+    while (lod < _lodMeshes.size() && screenSize < _lodScreenSizes[lod] * (1.0f - _lodHysteresis))
+        ++lod;
+    while (lod > 0 && screenSize > _lodScreenSizes[lod - 1] * (1.0f + _lodHysteresis))
+        --lod;
+
+    if (lod != _lod)
+    {
+        _lod = lod;
+        if (_material)
+        {
+            bindLod(_material);
+        }
+        if (_partMaterials)
+        {
+            for (unsigned int i = 0; i < _partCount; ++i)
+            {
+                if (_partMaterials[i])
+                {
+                    bindLod(_partMaterials[i]);
+                }
+            }
+        }
+    }
+}
+
+void Model::bindLod(Material* material)
+{
+    GP_ASSERT(material);
+
+    Mesh* mesh = getLodMesh(_lod);
+    for (unsigned int i = 0, tCount = material->getTechniqueCount(); i < tCount; ++i)
+    {
+        Technique* t = material->getTechniqueByIndex(i);
+        GP_ASSERT(t);
+        for (unsigned int j = 0, pCount = t->getPassCount(); j < pCount; ++j)
+        {
+            Pass* p = t->getPassByIndex(j);
+            GP_ASSERT(p);
+            VertexAttributeBinding* b = VertexAttributeBinding::create(mesh, p->getEffect());
+            p->setVertexAttributeBinding(b);
+
+            // Hold on to the bindings of each level so that switching back does not recreate them.
+            if (b && std::find(_lodBindings.begin(), _lodBindings.end(), b) == _lodBindings.end())
+                _lodBindings.push_back(b);
+            else
+                SAFE_RELEASE(b);
+        }
+    }
+}
+
 void Model::setSkin(MeshSkin* skin)
 {
     if (_skin != skin)
@@ -330,7 +455,11 @@ unsigned int Model::draw(bool wireframe)
 {
     GP_ASSERT(_mesh);
 
-    unsigned int partCount = _mesh->getPartCount();
+    if (!_lodMeshes.empty())
+        updateLod();
+    Mesh* mesh = getLodMesh(_lod);
+
+    unsigned int partCount = mesh->getPartCount();
     if (partCount == 0)
     {
         // No mesh parts (index buffers).
@@ -345,9 +474,9 @@ unsigned int Model::draw(bool wireframe)
                 GP_ASSERT(pass);
                 pass->bind();
                 GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
-                if (!wireframe || !drawWireframe(_mesh))
+                if (!wireframe || !drawWireframe(mesh))
                 {
-                    GL_ASSERT( glDrawArrays(_mesh->getPrimitiveType(), 0, _mesh->getVertexCount()) );
+                    GL_ASSERT( glDrawArrays(mesh->getPrimitiveType(), 0, mesh->getVertexCount()) );
                 }
                 pass->unbind();
             }
@@ -357,7 +486,7 @@ unsigned int Model::draw(bool wireframe)
     {
         for (unsigned int i = 0; i < partCount; ++i)
         {
-            MeshPart* part = _mesh->getPart(i);
+            MeshPart* part = mesh->getPart(i);
             GP_ASSERT(part);
 
             // Get the material for this mesh part.
@@ -408,6 +537,11 @@ Drawable* Model::clone(NodeCloneContext& context)
     {
         model->setSkin(getSkin()->clone(context));
     }
+    for (size_t i = 0, count = _lodMeshes.size(); i < count; ++i)
+    {
+        model->addLod(_lodMeshes[i], _lodScreenSizes[i]);
+    }
+    model->_lodHysteresis = _lodHysteresis;
     if (getMaterial())
     {
         Material* materialClone = getMaterial()->clone(context);
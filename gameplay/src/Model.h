@@ -130,6 +130,86 @@ public:
      */
     MeshSkin* getSkin() const;
 
+    /**
+     * Adds a level of detail to the end of this Model's LOD chain.
+     *
+     * Levels of detail are drawn in place of the Model's Mesh when the Model is small
+     * on screen. The screen size is the diameter of the Mesh's bounding sphere, projected
+     * by the active camera of the Model's scene, relative to the viewport height. Each
+     * level is drawn when the screen size drops below its screen size, so levels should
+     * be added from the most to the least detailed, with decreasing screen sizes.
+     *
+     * A level of detail must have the same number of mesh parts as the Model's Mesh,
+     * since it is drawn with the same materials. Skinned models need levels of detail
+     * whose blend indices refer to the joints of the Model's MeshSkin.
+     *
+     * @param mesh The mesh of the level of detail.
+     * @param screenSize The screen size below which the level is drawn.
+     *
+     * @return True if the level was added, false if the mesh has a different number of parts.
+     */
+    bool addLod(Mesh* mesh, float screenSize);
+
+    /**
+     * Returns the number of levels of detail, not counting the Model's Mesh.
+     *
+     * @return The number of levels of detail.
+     */
+    unsigned int getLodCount() const;
+
+    /**
+     * Returns the mesh of a level of detail.
+     *
+     * @param index The level of detail, where 0 is the Model's Mesh and 1 is the first added level.
+     *
+     * @return The mesh of the level of detail.
+     */
+    Mesh* getLodMesh(unsigned int index) const;
+
+    /**
+     * Returns the screen size below which a level of detail is drawn.
+     *
+     * @param index The level of detail, where 1 is the first added level.
+     *
+     * @return The screen size of the level of detail.
+     */
+    float getLodScreenSize(unsigned int index) const;
+
+    /**
+     * Sets the screen size below which a level of detail is drawn.
+     *
+     * @param index The level of detail, where 1 is the first added level.
+     * @param screenSize The screen size of the level of detail.
+     */
+    void setLodScreenSize(unsigned int index, float screenSize);
+
+    /**
+     * Returns the level of detail drawn by the last call to draw.
+     *
+     * @return The current level of detail, where 0 is the Model's Mesh.
+     */
+    unsigned int getLod() const;
+
+    /**
+     * Returns the hysteresis applied when switching between levels of detail.
+     *
+     * @return The LOD hysteresis.
+     * @see setLodHysteresis
+     */
+    float getLodHysteresis() const;
+
+    /**
+     * Sets the hysteresis applied when switching between levels of detail.
+     *
+     * A Model only switches to a less detailed level once its screen size is below the
+     * level's screen size by this fraction, and only switches back once its screen size
+     * is above it by this fraction. This keeps Models near a threshold from switching
+     * back and forth every frame. The default is 0.1.
+     *
+     * @param hysteresis The LOD hysteresis, as a fraction of the screen sizes.
+     */
+    void setLodHysteresis(float hysteresis);
+
     /**
      * @see Drawable::draw
      *
@@ -187,11 +267,26 @@ private:
 
     void validatePartCount();
 
+    /**
+     * Selects the level of detail to draw from the screen size of the model.
+     */
+    void updateLod();
+
+    /**
+     * Binds the passes of the given material to the mesh of the current level of detail.
+     */
+    void bindLod(Material* material);
+
     Mesh* _mesh;
     Material* _material;
     unsigned int _partCount;
     Material** _partMaterials;
     MeshSkin* _skin;
+    std::vector<Mesh*> _lodMeshes;
+    std::vector<float> _lodScreenSizes;
+    std::vector<VertexAttributeBinding*> _lodBindings;
+    float _lodHysteresis;
+    unsigned int _lod;
 };
 
 }
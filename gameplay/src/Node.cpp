@@ -26,7 +26,7 @@ namespace gameplay
 Node::Node(const char* id)
     : _scene(NULL), _firstChild(NULL), _nextSibling(NULL), _prevSibling(NULL), _parent(NULL), _childCount(0), _enabled(true), _tags(NULL),
     _drawable(NULL), _camera(NULL), _light(NULL), _audioSource(NULL), _collisionObject(NULL), _agent(NULL), _userObject(NULL),
-      _dirtyBits(NODE_DIRTY_ALL)
+      _animationLod(-1), _dirtyBits(NODE_DIRTY_ALL), _updateListener(false), _updateListenerCount(0)
 {
     GP_REGISTER_SCRIPT_EVENTS();
     if (id)
@@ -122,6 +122,11 @@ void Node::addChild(Node* child)
     ++_childCount;
     setBoundsDirty();
 
+    if (child->_updateListenerCount)
+    {
+        addUpdateListenerCount(child->_updateListenerCount);
+    }
+
     if (_dirtyBits & NODE_DIRTY_HIERARCHY)
     {
         hierarchyChanged();
@@ -166,6 +171,10 @@ void Node::remove()
     Node* parent = _parent;
     if (parent)
     {
+        if (_updateListenerCount)
+        {
+            parent->addUpdateListenerCount(-(int)_updateListenerCount);
+        }
         if (this == parent->_firstChild)
         {
             parent->_firstChild = _nextSibling;
@@ -401,12 +410,42 @@ void Node::update(float elapsedTime)
 {
     for (Node* node = _firstChild; node != NULL; node = node->_nextSibling)
     {
-        if (node->isEnabled())
+        // Skip subtrees that have nothing listening for the update event
+        if (node->_updateListenerCount && node->isEnabled())
         {
             node->update(elapsedTime);
         }
     }
-    fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(Node, update), dynamic_cast<void*>(this), elapsedTime);
+    if (_updateListener)
+        fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(Node, update), dynamic_cast<void*>(this), elapsedTime);
+}
+
+void Node::scriptsChanged()
+{
+    bool updateListener = hasScriptListener(GP_GET_SCRIPT_EVENT(Node, update));
+    if (updateListener != _updateListener)
+    {
+        _updateListener = updateListener;
+        addUpdateListenerCount(updateListener ? 1 : -1);
+    }
+}
+
+void Node::addUpdateListenerCount(int delta)
+{
+    Node* node = this;
+    while (true)
+    {
+        node->_updateListenerCount += delta;
+        if (!node->_parent)
+            break;
+        node = node->_parent;
+    }
+
+    // The scene this hierarchy belongs to has to rebuild its list of nodes to update
+    if (node->_scene)
+    {
+        node->_scene->_updateNodesDirty = true;
+    }
 }
 
 bool Node::isStatic() const
@@ -643,6 +682,12 @@ void Node::transformChanged()
     // Notify our children that their transform has also changed (since transforms are inherited).
     for (Node* n = getFirstChild(); n != NULL; n = n->getNextSibling())
     {
+        // A child whose world matrix is still dirty has not been resolved since it was last
+        // notified. Its whole subtree is dirty, and its listeners have not read the previous
+        // change yet, so the subtree does not need to be walked again.
+        if (n->_dirtyBits & NODE_DIRTY_WORLD)
+            continue;
+
         if (Transform::isTransformChangedSuspended())
         {
             // If the DIRTY_NOTIFY bit is not set
@@ -999,6 +1044,7 @@ void Node::cloneInto(Node* node, NodeCloneContext& context) const
 
     node->_world = _world;
     node->_bounds = _bounds;
+    node->_animationLod = _animationLod;
 
     // TODO: Clone the rest of the node data.
 }
@@ -1205,6 +1251,16 @@ void Node::setUserObject(Ref* obj)
     _userObject = obj;
 }
 
+void Node::setAnimationLod(int lod)
+{
+    _animationLod = lod;
+}
+
+int Node::getAnimationLod() const
+{
+    return _animationLod;
+}
+
 NodeCloneContext::NodeCloneContext()
 {
 }
@@ -249,10 +249,10 @@ public:
     /**
      * Called to update the state of this Node.
      *
-     * This method is called by Scene::update(float) to update the state of all active
-     * nodes in a scene. A Node is considered active if Node::isActive() returns true.
+     * If any scripts are attached to the node or its children, their update event will be fired.
      *
-     * If any scripts are attached to the node, their update event will be fired.
+     * Scene::update(float) does not call this method; it fires the update event directly on the
+     * enabled nodes that have an update listener.
      *
      * @param elapsedTime Elapsed time in milliseconds.
      */
@@ -578,6 +578,23 @@ public:
     */
     void setUserObject(Ref* obj);
 
+    /**
+     * Sets the animation level of detail of the animation clips that use this node
+     * as their LOD node, overriding the level selected from the node's projected size.
+     *
+     * @param lod The animation level of detail (see AnimationController::LodLevel),
+     *        or -1 to select it from the node's projected size.
+     * @see AnimationClip::setLodNode
+     */
+    void setAnimationLod(int lod);
+
+    /**
+     * Gets the animation level of detail set on this node.
+     *
+     * @return The animation level of detail, or -1 if it is selected from the node's projected size.
+     */
+    int getAnimationLod() const;
+
     /**
      * Returns the bounding sphere for the Node, in world space.
      *
@@ -665,6 +682,18 @@ protected:
      */
     void setBoundsDirty();
 
+    /**
+     * @see ScriptTarget::scriptsChanged
+     */
+    void scriptsChanged();
+
+    /**
+     * Adds to the number of update listeners in this node's subtree and in those of its ancestors.
+     *
+     * @param delta The number of update listeners added (or removed, if negative).
+     */
+    void addUpdateListenerCount(int delta);
+
 private:
 
     /**
@@ -713,12 +742,18 @@ protected:
     mutable AIAgent* _agent;
     /** The user object component attached to this node. */
     Ref* _userObject;
+    /** The animation level of detail, or -1 to select it from the projected size. */
+    int _animationLod;
     /** The world matrix for this node. */
     mutable Matrix _world;
     /** The bounding sphere for this node. */
     mutable BoundingSphere _bounds;
     /** The dirty bits used for optimization. */
     mutable int _dirtyBits;
+    /** If a script is listening for this node's update event. */
+    bool _updateListener;
+    /** The number of nodes in this node's subtree (including itself) with an update listener. */
+    unsigned int _updateListenerCount;
 };
 
 /**
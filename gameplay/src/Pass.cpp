@@ -8,7 +8,7 @@ namespace gameplay
 {
 
 Pass::Pass(const char* id, Technique* technique) :
-    _id(id ? id : ""), _technique(technique), _effect(NULL), _vaBinding(NULL)
+    _id(id ? id : ""), _technique(technique), _effect(NULL), _vaBinding(NULL), _bindingsBuiltVersion(0)
 {
     RenderState::_parent = _technique;
 }
@@ -26,6 +26,7 @@ bool Pass::initialize(const char* vshPath, const char* fshPath, const char* defi
 
     SAFE_RELEASE(_effect);
     SAFE_RELEASE(_vaBinding);
+    _bindingsBuiltVersion = 0;
 
     // Attempt to create/load the effect.
     _effect = Effect::createFromFile(vshPath, fshPath, defines);
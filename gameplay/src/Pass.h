@@ -109,6 +109,22 @@ private:
     Technique* _technique;
     Effect* _effect;
     VertexAttributeBinding* _vaBinding;
+
+    /**
+     * A material parameter of the render state hierarchy resolved to a uniform of the effect.
+     */
+    struct ParameterBinding
+    {
+        MaterialParameter* parameter;
+        Uniform* uniform;
+    };
+
+    /** The parameters of the render state hierarchy in binding order, top-down. */
+    std::vector<ParameterBinding> _parameterBindings;
+    /** The state blocks of the render state hierarchy, top-down. */
+    std::vector<RenderState::StateBlock*> _stateBlocks;
+    /** The sum of the render state versions of the hierarchy the bindings were built from. */
+    unsigned int _bindingsBuiltVersion;
 };
 
 }
@@ -896,6 +896,8 @@ PhysicsCollisionShape* PhysicsController::createShape(Node* node, const PhysicsC
                 // Build the heightfield from an attached terrain's height array
                 if (dynamic_cast<Terrain*>(node->getDrawable()) == NULL)
                     GP_ERROR("Empty heightfield collision shapes can only be used on nodes that have an attached Terrain.");
+                else if (dynamic_cast<Terrain*>(node->getDrawable())->isPaged())
+                    GP_ERROR("Paged terrains create heightfield collision for their loaded tiles; enable 'collision' in the terrain's paging section instead.");
                 else
                     collisionShape = createHeightfield(node, dynamic_cast<Terrain*>(node->getDrawable())->_heightfield, centerOfMassOffset);
             }
@@ -1023,15 +1025,31 @@ PhysicsCollisionShape* PhysicsController::createHeightfield(Node* node, HeightFi
     GP_ASSERT(centerOfMassOffset);
 
     // Inspect the height array for the min and max values
-    float* heights = heightfield->getArray();
     float minHeight = FLT_MAX, maxHeight = -FLT_MAX;
-    for (unsigned int i = 0, count = heightfield->getColumnCount()*heightfield->getRowCount(); i < count; ++i)
+    unsigned int count = heightfield->getColumnCount()*heightfield->getRowCount();
+    if (heightfield->isQuantized())
     {
-        float h = heights[i];
-        if (h < minHeight)
-            minHeight = h;
-        if (h > maxHeight)
-            maxHeight = h;
+        const short* values = heightfield->getQuantizedArray();
+        short minValue = SHRT_MAX, maxValue = SHRT_MIN;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            minValue = std::min(minValue, values[i]);
+            maxValue = std::max(maxValue, values[i]);
+        }
+        minHeight = heightfield->getQuantizedOffset() + minValue * heightfield->getQuantizedScale();
+        maxHeight = heightfield->getQuantizedOffset() + maxValue * heightfield->getQuantizedScale();
+    }
+    else
+    {
+        float* heights = heightfield->getArray();
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            float h = heights[i];
+            if (h < minHeight)
+                minHeight = h;
+            if (h > maxHeight)
+                maxHeight = h;
+        }
     }
 
     // Compute initial heightfield scale by pulling the current world scale out of the node
@@ -1059,8 +1077,22 @@ PhysicsCollisionShape* PhysicsController::createHeightfield(Node* node, HeightFi
     heightfieldData->maxHeight = maxHeight;
 
     // Create the bullet terrain shape
-    btHeightfieldTerrainShape* terrainShape = bullet_new<btHeightfieldTerrainShape>(
-        heightfield->getColumnCount(), heightfield->getRowCount(), heightfield->getArray(), 1.0f, minHeight, maxHeight, 1, PHY_FLOAT, false);
+    btHeightfieldTerrainShape* terrainShape;
+    if (heightfield->isQuantized())
+    {
+        // Bullet reads the quantized values directly, as value * scale. Its height range is relative
+        // to the quantized offset, which the center of mass offset accounts for since bullet
+        // centers the shape on the middle of that range.
+        float offset = heightfield->getQuantizedOffset();
+        terrainShape = bullet_new<btHeightfieldTerrainShape>(
+            heightfield->getColumnCount(), heightfield->getRowCount(), heightfield->getQuantizedArray(),
+            heightfield->getQuantizedScale(), minHeight - offset, maxHeight - offset, 1, PHY_SHORT, false);
+    }
+    else
+    {
+        terrainShape = bullet_new<btHeightfieldTerrainShape>(
+            heightfield->getColumnCount(), heightfield->getRowCount(), heightfield->getArray(), 1.0f, minHeight, maxHeight, 1, PHY_FLOAT, false);
+    }
 
     // Set initial bullet local scaling for the heightfield
     terrainShape->setLocalScaling(BV(scale));
@@ -1123,6 +1155,15 @@ PhysicsCollisionShape* PhysicsController::createMesh(Mesh* mesh, const Vector3&
         return NULL;
     }
 
+    // Positions are read directly from the start of each vertex.
+    const VertexFormat::Element& positionElement = data->vertexFormat.getElement(0);
+    if (positionElement.usage != VertexFormat::POSITION || positionElement.type != VertexFormat::FLOAT || positionElement.size < 3)
+    {
+        GP_ERROR("Mesh rigid bodies require vertices that start with a 3D float position (mesh '%s').", mesh->getUrl());
+        SAFE_DELETE(data);
+        return NULL;
+    }
+
     // Create mesh data to be populated and store in returned collision shape.
     PhysicsCollisionShape::MeshData* shapeMeshData = new PhysicsCollisionShape::MeshData();
     shapeMeshData->vertexData = NULL;
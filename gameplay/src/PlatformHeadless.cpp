@@ -0,0 +1,332 @@
+#ifdef GP_HEADLESS
+
+#include "Base.h"
+#include "Platform.h"
+#include "FileSystem.h"
+#include "Game.h"
+
+#ifdef WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <strings.h>
+#endif
+
+#ifndef WIN32
+int __argc = 0;
+char** __argv = 0;
+#endif
+
+// Default display size reported to the game when the config does not specify one.
+#define HEADLESS_DEFAULT_WIDTH      1280
+#define HEADLESS_DEFAULT_HEIGHT     720
+
+static std::chrono::steady_clock::time_point __timeStart;
+static double __timeAbsolute;
+static bool __vsync = false;
+static bool __multiSampling = false;
+static unsigned int __displayWidth = HEADLESS_DEFAULT_WIDTH;
+static unsigned int __displayHeight = HEADLESS_DEFAULT_HEIGHT;
+static double __frameRate = 0.0;
+static bool __fixedTimeStep = false;
+static unsigned int __frameCount = 0;
+
+namespace gameplay
+{
+
+extern void print(const char* format, ...)
+{
+    GP_ASSERT(format);
+    va_list argptr;
+    va_start(argptr, format);
+    vfprintf(stderr, format, argptr);
+    va_end(argptr);
+}
+
+extern int strcmpnocase(const char* s1, const char* s2)
+{
+#ifdef WIN32
+    return _strcmpi(s1, s2);
+#else
+    return strcasecmp(s1, s2);
+#endif
+}
+
+Platform::Platform(Game* game) : _game(game)
+{
+}
+
+Platform::~Platform()
+{
+}
+
+Platform* Platform::create(Game* game)
+{
+    GP_ASSERT(game);
+
+    FileSystem::setResourcePath("./");
+    Platform* platform = new Platform(game);
+
+    if (game->getConfig())
+    {
+        // The window size is still reported to the game (e.g. for camera aspect ratios).
+        Properties* config = game->getConfig()->getNamespace("window", true);
+        if (config)
+        {
+            int width = config->getInt("width");
+            int height = config->getInt("height");
+            if (width > 0)
+                __displayWidth = width;
+            if (height > 0)
+                __displayHeight = height;
+        }
+
+        // Read the simulation tick settings.
+        config = game->getConfig()->getNamespace("headless", true);
+        if (config)
+        {
+            __frameRate = std::max(0.0f, config->getFloat("frameRate"));
+            __fixedTimeStep = config->getBool("fixedTimeStep");
+            __frameCount = (unsigned int)std::max(0, config->getInt("frameCount"));
+        }
+    }
+
+    if (__fixedTimeStep && __frameRate <= 0.0)
+    {
+        GP_WARN("A fixed time step requires a frame rate; defaulting to 60 frames per second.");
+        __frameRate = 60.0;
+    }
+
+    return platform;
+}
+
+int Platform::enterMessagePump()
+{
+    GP_ASSERT(_game);
+
+    // Get the initial time.
+    __timeStart = std::chrono::steady_clock::now();
+    __timeAbsolute = 0.0;
+
+    // Run the game.
+    _game->run();
+
+    const double frameMillis = __frameRate > 0.0 ? 1000.0 / __frameRate : 0.0;
+    unsigned int frames = 0;
+    std::chrono::steady_clock::time_point nextFrame = std::chrono::steady_clock::now();
+
+    while (true)
+    {
+        // Game state will be uninitialized if game was closed through Game::exit()
+        if (_game->getState() == Game::UNINITIALIZED)
+            break;
+
+        _game->frame();
+        ++frames;
+
+        // Batch runs end after the configured number of frames.
+        if (__frameCount > 0 && frames == __frameCount)
+            _game->exit();
+
+        if (__fixedTimeStep)
+        {
+            // Advance simulated time by exactly one tick and run the next frame immediately.
+            __timeAbsolute += frameMillis;
+        }
+        else if (frameMillis > 0.0)
+        {
+            // Pace frames in real time, skipping ahead rather than bursting if a frame ran long.
+            nextFrame += std::chrono::microseconds((long long)(frameMillis * 1000.0));
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if (nextFrame > now)
+                std::this_thread::sleep_until(nextFrame);
+            else
+                nextFrame = now;
+        }
+    }
+
+    return 0;
+}
+
+void Platform::signalShutdown()
+{
+}
+
+bool Platform::canExit()
+{
+    return true;
+}
+
+unsigned int Platform::getDisplayWidth()
+{
+    return __displayWidth;
+}
+
+unsigned int Platform::getDisplayHeight()
+{
+    return __displayHeight;
+}
+
+double Platform::getAbsoluteTime()
+{
+    if (!__fixedTimeStep)
+    {
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - __timeStart;
+        __timeAbsolute = elapsed.count();
+    }
+
+    return __timeAbsolute;
+}
+
+void Platform::setAbsoluteTime(double time)
+{
+    __timeAbsolute = time;
+}
+
+bool Platform::isVsync()
+{
+    return __vsync;
+}
+
+void Platform::setVsync(bool enable)
+{
+    __vsync = enable;
+}
+
+void Platform::swapBuffers()
+{
+}
+
+void Platform::sleep(long ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void Platform::setMultiSampling(bool enabled)
+{
+    __multiSampling = enabled;
+}
+
+bool Platform::isMultiSampling()
+{
+    return __multiSampling;
+}
+
+void Platform::setMultiTouch(bool enabled)
+{
+    // not supported
+}
+
+bool Platform::isMultiTouch()
+{
+    return false;
+}
+
+bool Platform::hasAccelerometer()
+{
+    return false;
+}
+
+void Platform::getAccelerometerValues(float* pitch, float* roll)
+{
+    GP_ASSERT(pitch);
+    GP_ASSERT(roll);
+
+    *pitch = 0;
+    *roll = 0;
+}
+
+void Platform::getSensorValues(float* accelX, float* accelY, float* accelZ, float* gyroX, float* gyroY, float* gyroZ)
+{
+    if (accelX)
+        *accelX = 0;
+    if (accelY)
+        *accelY = 0;
+    if (accelZ)
+        *accelZ = 0;
+    if (gyroX)
+        *gyroX = 0;
+    if (gyroY)
+        *gyroY = 0;
+    if (gyroZ)
+        *gyroZ = 0;
+}
+
+void Platform::getArguments(int* argc, char*** argv)
+{
+    if (argc)
+        *argc = __argc;
+    if (argv)
+        *argv = __argv;
+}
+
+bool Platform::hasMouse()
+{
+    return false;
+}
+
+void Platform::setMouseCaptured(bool captured)
+{
+    // not supported
+}
+
+bool Platform::isMouseCaptured()
+{
+    return false;
+}
+
+void Platform::setCursorVisible(bool visible)
+{
+    // not supported
+}
+
+bool Platform::isCursorVisible()
+{
+    return false;
+}
+
+void Platform::displayKeyboard(bool display)
+{
+    // not supported
+}
+
+void Platform::shutdownInternal()
+{
+    Game::getInstance()->shutdown();
+}
+
+bool Platform::isGestureSupported(Gesture::GestureEvent evt)
+{
+    return false;
+}
+
+void Platform::registerGesture(Gesture::GestureEvent evt)
+{
+}
+
+void Platform::unregisterGesture(Gesture::GestureEvent evt)
+{
+}
+
+bool Platform::isGestureRegistered(Gesture::GestureEvent evt)
+{
+    return false;
+}
+
+void Platform::pollGamepadState(Gamepad* gamepad)
+{
+}
+
+bool Platform::launchURL(const char* url)
+{
+    return false;
+}
+
+std::string Platform::displayFileDialog(size_t mode, const char* title, const char* filterDescription, const char* filterExtensions, const char* initialDirectory)
+{
+    return "";
+}
+
+}
+
+#endif
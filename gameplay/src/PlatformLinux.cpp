@@ -1,4 +1,4 @@
-#ifdef __linux__
+#if defined(__linux__) && !defined(GP_HEADLESS)
 
 #include "Base.h"
 #include "Platform.h"
@@ -1128,7 +1128,7 @@ int Platform::enterMessagePump()
     static XEvent evt;
 
     // Get the initial time.
-    clock_gettime(CLOCK_REALTIME, &__timespec);
+    clock_gettime(CLOCK_MONOTONIC, &__timespec);
     __timeStart = timespec2millis(&__timespec);
     __timeAbsolute = 0L;
 
@@ -1362,7 +1362,7 @@ unsigned int Platform::getDisplayHeight()
 double Platform::getAbsoluteTime()
 {
 
-    clock_gettime(CLOCK_REALTIME, &__timespec);
+    clock_gettime(CLOCK_MONOTONIC, &__timespec);
     double now = timespec2millis(&__timespec);
     __timeAbsolute = now - __timeStart;
 
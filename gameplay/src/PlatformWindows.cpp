@@ -1,4 +1,4 @@
-#ifdef WIN32
+#if defined(WIN32) && !defined(GP_HEADLESS)
 
 #include "Base.h"
 #include "Platform.h"
@@ -0,0 +1,218 @@
+#include "Base.h"
+#include "Profiler.h"
+#include "FileSystem.h"
+
+#define PROFILER_DEFAULT_FRAME_HISTORY 120
+
+namespace gameplay
+{
+
+static bool __enabled = false;
+static unsigned int __frameHistory = PROFILER_DEFAULT_FRAME_HISTORY;
+static std::vector<Profiler::Frame> __frames;
+static unsigned int __frameIndex = 0;           // Ring buffer slot of the frame being recorded.
+static unsigned int __frameCount = 0;           // Completed frames held in the ring buffer.
+static unsigned int __frameNumber = 0;
+static bool __inFrame = false;
+static std::vector<size_t> __openEvents;
+static std::thread::id __mainThread;
+
+Profiler::Scope::Scope(const char* name)
+    : _active(__enabled && __inFrame)
+{
+    if (_active)
+        Profiler::begin(name);
+}
+
+Profiler::Scope::~Scope()
+{
+    if (_active)
+        Profiler::end();
+}
+
+Profiler::Profiler()
+{
+}
+
+Profiler::~Profiler()
+{
+}
+
+double Profiler::getTime()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+    if (enabled && !__enabled)
+        reset();
+    __enabled = enabled;
+    __inFrame = false;
+}
+
+bool Profiler::isEnabled()
+{
+    return __enabled;
+}
+
+void Profiler::setFrameHistory(unsigned int frameCount)
+{
+    GP_ASSERT(frameCount > 0);
+    __frameHistory = frameCount;
+    reset();
+}
+
+unsigned int Profiler::getFrameHistory()
+{
+    return __frameHistory;
+}
+
+void Profiler::reset()
+{
+    __frames.clear();
+    __frames.resize(__frameHistory);
+    __frameIndex = 0;
+    __frameCount = 0;
+    __frameNumber = 0;
+    __inFrame = false;
+    __openEvents.clear();
+}
+
+void Profiler::beginFrame()
+{
+    if (!__enabled)
+        return;
+
+    if (__frames.size() != __frameHistory)
+        reset();
+
+    // Reuse the oldest slot; clearing keeps the event storage allocated.
+    Frame& frame = __frames[__frameIndex];
+    frame.number = __frameNumber++;
+    frame.start = getTime();
+    frame.duration = 0.0;
+    frame.events.clear();
+
+    __openEvents.clear();
+    __mainThread = std::this_thread::get_id();
+    __inFrame = true;
+}
+
+void Profiler::endFrame()
+{
+    if (!__enabled || !__inFrame)
+        return;
+
+    // Close any markers left open so the trace stays well formed.
+    while (!__openEvents.empty())
+        end();
+
+    Frame& frame = __frames[__frameIndex];
+    frame.duration = getTime() - frame.start;
+
+    __frameIndex = (__frameIndex + 1) % __frameHistory;
+    if (__frameCount < __frameHistory)
+        ++__frameCount;
+    __inFrame = false;
+}
+
+void Profiler::begin(const char* name)
+{
+    GP_ASSERT(name);
+
+    if (!__enabled || !__inFrame || std::this_thread::get_id() != __mainThread)
+        return;
+
+    Frame& frame = __frames[__frameIndex];
+    Event event;
+    event.name = name;
+    event.start = getTime();
+    event.duration = 0.0;
+    event.depth = (unsigned int)__openEvents.size();
+    __openEvents.push_back(frame.events.size());
+    frame.events.push_back(event);
+}
+
+void Profiler::end()
+{
+    if (!__enabled || !__inFrame || __openEvents.empty() || std::this_thread::get_id() != __mainThread)
+        return;
+
+    Event& event = __frames[__frameIndex].events[__openEvents.back()];
+    event.duration = getTime() - event.start;
+    __openEvents.pop_back();
+}
+
+unsigned int Profiler::getFrameCount()
+{
+    return __frameCount;
+}
+
+const Profiler::Frame* Profiler::getFrame(unsigned int index)
+{
+    if (index >= __frameCount)
+        return NULL;
+
+    unsigned int slot = (__frameIndex + __frameHistory - 1 - index) % __frameHistory;
+    return &__frames[slot];
+}
+
+// Writes a string as a JSON string literal.
+static void writeJsonString(std::string& out, const char* str)
+{
+    out += '"';
+    for (const char* c = str; *c; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+            out += '\\';
+        if ((unsigned char)*c >= 0x20)
+            out += *c;
+    }
+    out += '"';
+}
+
+static void writeTraceEvent(std::string& out, const char* name, double start, double duration, bool& first)
+{
+    // Chrome trace timestamps and durations are in microseconds.
+    char buffer[128];
+    out += first ? "\n" : ",\n";
+    first = false;
+    out += "{\"name\":";
+    writeJsonString(out, name);
+    sprintf(buffer, ",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}", start * 1000.0, duration * 1000.0);
+    out += buffer;
+}
+
+bool Profiler::exportChromeTrace(const char* path)
+{
+    GP_ASSERT(path);
+
+    std::string json = "{\"traceEvents\":[";
+    bool first = true;
+    for (unsigned int i = __frameCount; i > 0; --i)
+    {
+        const Frame* frame = getFrame(i - 1);
+        GP_ASSERT(frame);
+        writeTraceEvent(json, "Frame", frame->start, frame->duration, first);
+        for (size_t j = 0, count = frame->events.size(); j < count; ++j)
+        {
+            const Event& event = frame->events[j];
+            writeTraceEvent(json, event.name, event.start, event.duration, first);
+        }
+    }
+    json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    std::unique_ptr<Stream> stream(FileSystem::open(path, FileSystem::WRITE));
+    if (stream.get() == NULL || !stream->canWrite())
+    {
+        GP_WARN("Failed to open file '%s' for writing the profiler trace.", path);
+        return false;
+    }
+
+    return stream->write(json.c_str(), 1, json.length()) == json.length();
+}
+
+}
@@ -0,0 +1,220 @@
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines a lightweight frame profiler.
+ *
+ * When enabled, the profiler times each phase of Game::frame (animation, physics,
+ * AI, gamepads, update, forms, script, audio and render) along with any markers
+ * added by user code, and keeps the most recent frames in a ring buffer. The recorded
+ * frames can be inspected at runtime or exported as a Chrome trace (chrome://tracing).
+ *
+ * Markers are recorded only on the thread that runs the game loop and must use names
+ * with static storage duration (such as string literals), since the names are stored
+ * by pointer.
+ *
+ @verbatim
+    void MyGame::update(float elapsedTime)
+    {
+        GP_PROFILE_SCOPE("MyGame::updateEnemies");
+        ...
+    }
+ @endverbatim
+ *
+ * @script{ignore}
+ */
+class Profiler
+{
+    friend class Game;
+
+public:
+
+    /**
+     * A single timed marker within a frame.
+     */
+    struct Event
+    {
+        /** The marker name. */
+        const char* name;
+        /** Start time, in milliseconds. */
+        double start;
+        /** Duration, in milliseconds. */
+        double duration;
+        /** Nesting depth within the frame (0 for top-level markers). */
+        unsigned int depth;
+    };
+
+    /**
+     * A recorded frame.
+     */
+    struct Frame
+    {
+        /** The frame number since the profiler was enabled. */
+        unsigned int number;
+        /** Start time, in milliseconds. */
+        double start;
+        /** Duration, in milliseconds. */
+        double duration;
+        /** The markers recorded during the frame, in the order they began. */
+        std::vector<Event> events;
+    };
+
+    /**
+     * Begins a marker on construction and ends it on destruction.
+     */
+    class Scope
+    {
+    public:
+
+        /**
+         * Begins a marker.
+         *
+         * @param name The marker name (must outlive the profiler's frame history).
+         */
+        Scope(const char* name);
+
+        /**
+         * Ends the marker.
+         */
+        ~Scope();
+
+    private:
+
+        Scope(const Scope& copy);
+        Scope& operator=(const Scope&);
+
+        bool _active;
+    };
+
+    /**
+     * Returns the current time of a monotonic, high-resolution clock.
+     *
+     * @return The time in milliseconds, relative to an arbitrary fixed point.
+     */
+    static double getTime();
+
+    /**
+     * Enables or disables the profiler.
+     *
+     * Enabling the profiler clears any previously recorded frames.
+     *
+     * @param enabled True to enable the profiler.
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * Determines if the profiler is enabled.
+     *
+     * @return True if the profiler is enabled.
+     */
+    static bool isEnabled();
+
+    /**
+     * Sets the number of recent frames kept in the ring buffer (default 120).
+     *
+     * Changing the history clears any previously recorded frames.
+     *
+     * @param frameCount The number of frames to keep.
+     */
+    static void setFrameHistory(unsigned int frameCount);
+
+    /**
+     * Returns the number of frames kept in the ring buffer.
+     *
+     * @return The frame history size.
+     */
+    static unsigned int getFrameHistory();
+
+    /**
+     * Begins a marker in the current frame.
+     *
+     * Every call must be matched by a call to end(). Prefer GP_PROFILE_SCOPE.
+     *
+     * @param name The marker name (must outlive the profiler's frame history).
+     */
+    static void begin(const char* name);
+
+    /**
+     * Ends the most recently begun marker.
+     */
+    static void end();
+
+    /**
+     * Returns the number of completed frames currently held in the ring buffer.
+     *
+     * @return The number of recorded frames.
+     */
+    static unsigned int getFrameCount();
+
+    /**
+     * Returns a completed frame from the ring buffer.
+     *
+     * @param index The frame index, where 0 is the most recently completed frame.
+     *
+     * @return The frame, or NULL if the index is out of range.
+     */
+    static const Frame* getFrame(unsigned int index);
+
+    /**
+     * Writes the recorded frames to a file in the Chrome trace event JSON format.
+     *
+     * @param path The path of the file to write.
+     *
+     * @return True if the file was written successfully.
+     */
+    static bool exportChromeTrace(const char* path);
+
+private:
+
+    /**
+     * Hidden constructor.
+     */
+    Profiler();
+
+    /**
+     * Hidden destructor.
+     */
+    ~Profiler();
+
+    /**
+     * Hidden copy constructor.
+     */
+    Profiler(const Profiler& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    Profiler& operator=(const Profiler&);
+
+    /**
+     * Starts recording a new frame (called by Game::frame).
+     */
+    static void beginFrame();
+
+    /**
+     * Finishes recording the current frame (called by Game::frame).
+     */
+    static void endFrame();
+
+    /**
+     * Clears the ring buffer.
+     */
+    static void reset();
+};
+
+}
+
+#define GP_PROFILE_SCOPE_CONCAT_(a, b) a##b
+#define GP_PROFILE_SCOPE_CONCAT(a, b) GP_PROFILE_SCOPE_CONCAT_(a, b)
+
+/**
+ * Times the enclosing scope with the profiler.
+ *
+ * @param name The marker name (a string literal).
+ */
+#define GP_PROFILE_SCOPE(name) gameplay::Profiler::Scope GP_PROFILE_SCOPE_CONCAT(__profileScope, __LINE__)(name)
+
+#endif
@@ -26,12 +26,12 @@ void calculateNamespacePath(const std::string& urlString, std::string& fileStrin
 Properties* getPropertiesFromNamespacePath(Properties* properties, const std::vector<std::string>& namespacePath);
 
 Properties::Properties()
-    : _variables(NULL), _dirPath(NULL), _parent(NULL)
+    : _variables(NULL), _dirPath(NULL), _parent(NULL), _indexDirty(true)
 {
 }
 
 Properties::Properties(const Properties& copy)
-    : _namespace(copy._namespace), _id(copy._id), _parentID(copy._parentID), _properties(copy._properties), _variables(NULL), _dirPath(NULL), _parent(copy._parent)
+    : _namespace(copy._namespace), _id(copy._id), _parentID(copy._parentID), _properties(copy._properties), _variables(NULL), _dirPath(NULL), _parent(copy._parent), _indexDirty(true)
 {
     setDirectoryPath(copy._dirPath);
     _namespaces = std::vector<Properties*>();
@@ -45,14 +45,14 @@ Properties::Properties(const Properties& copy)
 }
 
 Properties::Properties(Stream* stream)
-    : _variables(NULL), _dirPath(NULL), _parent(NULL)
+    : _variables(NULL), _dirPath(NULL), _parent(NULL), _indexDirty(true)
 {
     readProperties(stream);
     rewind();
 }
 
 Properties::Properties(Stream* stream, const char* name, const char* id, const char* parentID, Properties* parent)
-    : _namespace(name), _variables(NULL), _dirPath(NULL), _parent(parent)
+    : _namespace(name), _variables(NULL), _dirPath(NULL), _parent(parent), _indexDirty(true)
 {
     if (id)
     {
@@ -482,6 +482,7 @@ void Properties::resolveInheritance(const char* id)
                     GP_ASSERT(*itt);
                     derived->_namespaces.push_back(new Properties(**itt));
                 }
+                derived->invalidateIndex();
                 derived->rewind();
 
                 // Take the original copy of the child and override the data copied from the parent.
@@ -548,6 +549,7 @@ void Properties::mergeWith(Properties* overrides)
 
             this->_namespaces.push_back(newNamespace);
             this->_namespacesItr = this->_namespaces.end();
+            invalidateIndex();
         }
 
         overridesNamespace = overrides->getNextNamespace();
@@ -601,22 +603,26 @@ Properties* Properties::getNamespace(const char* id, bool searchNames, bool recu
 {
     GP_ASSERT(id);
 
-    for (std::vector<Properties*>::const_iterator it = _namespaces.begin(); it < _namespaces.end(); ++it)
+    buildIndex();
+
+    // Find the first direct child that matches.
+    const std::unordered_map<std::string, size_t>& index = searchNames ? _namespaceNameIndex : _namespaceIdIndex;
+    std::unordered_map<std::string, size_t>::const_iterator match = index.find(id);
+    size_t count = match == index.end() ? _namespaces.size() : match->second;
+
+    if (recurse)
     {
-        Properties* p = *it;
-        if (strcmp(searchNames ? p->_namespace.c_str() : p->_id.c_str(), id) == 0)
-            return p;
-        
-        if (recurse)
+        // Search depth-first through the children that precede the direct match,
+        // so the first match in document order is still the one returned.
+        for (size_t i = 0; i < count; ++i)
         {
-            // Search recursively.
-            p = p->getNamespace(id, searchNames, true);
+            Properties* p = _namespaces[i]->getNamespace(id, searchNames, true);
             if (p)
                 return p;
         }
     }
 
-    return NULL;
+    return match == index.end() ? NULL : _namespaces[match->second];
 }
 
 const char* Properties::getNamespace() const
@@ -634,13 +640,7 @@ bool Properties::exists(const char* name) const
     if (name == NULL)
         return false;
 
-    for (std::list<Property>::const_iterator itr = _properties.begin(); itr != _properties.end(); ++itr)
-    {
-        if (itr->name == name)
-            return true;
-    }
-
-    return false;
+    return findProperty(name) != NULL;
 }
 
 static const bool isStringNumeric(const char* str)
@@ -724,13 +724,10 @@ const char* Properties::getString(const char* name, const char* defaultValue) co
             return getVariable(variable, defaultValue);
         }
 
-        for (std::list<Property>::const_iterator itr = _properties.begin(); itr != _properties.end(); ++itr)
+        const Property* property = findProperty(name);
+        if (property)
         {
-            if (itr->name == name)
-            {
-                value = itr->value.c_str();
-                break;
-            }
+            value = property->value.c_str();
         }
     }
     else
@@ -758,18 +755,18 @@ bool Properties::setString(const char* name, const char* value)
 {
     if (name)
     {
-        for (std::list<Property>::iterator itr = _properties.begin(); itr != _properties.end(); ++itr)
+        // Update the first property that matches this name
+        Property* property = const_cast<Property*>(findProperty(name));
+        if (property)
         {
-            if (itr->name == name)
-            {
-                // Update the first property that matches this name
-                itr->value = value ? value : "";
-                return true;
-            }
+            property->value = value ? value : "";
+            return true;
         }
 
         // There is no property with this name, so add one
         _properties.push_back(Property(name, value ? value : ""));
+        if (!_indexDirty)
+            _propertyIndex[_properties.back().name] = &_properties.back();
     }
     else
     {
@@ -1022,10 +1019,53 @@ Properties* Properties::clone()
         child->_parent = p;
     }
     p->_namespacesItr = p->_namespaces.end();
+    p->invalidateIndex();
 
     return p;
 }
 
+void Properties::invalidateIndex()
+{
+    _indexDirty = true;
+}
+
+void Properties::buildIndex() const
+{
+    if (!_indexDirty)
+        return;
+
+    // Only the first occurrence of a name is indexed, matching the order of a linear search.
+    _propertyIndex.clear();
+    _propertyIndex.reserve(_properties.size());
+    for (std::list<Property>::const_iterator itr = _properties.begin(); itr != _properties.end(); ++itr)
+    {
+        _propertyIndex.insert(std::make_pair(itr->name, &(*itr)));
+    }
+
+    _namespaceIdIndex.clear();
+    _namespaceNameIndex.clear();
+    _namespaceIdIndex.reserve(_namespaces.size());
+    _namespaceNameIndex.reserve(_namespaces.size());
+    for (size_t i = 0, count = _namespaces.size(); i < count; ++i)
+    {
+        GP_ASSERT(_namespaces[i]);
+        _namespaceIdIndex.insert(std::make_pair(_namespaces[i]->_id, i));
+        _namespaceNameIndex.insert(std::make_pair(_namespaces[i]->_namespace, i));
+    }
+
+    _indexDirty = false;
+}
+
+const Properties::Property* Properties::findProperty(const char* name) const
+{
+    GP_ASSERT(name);
+
+    buildIndex();
+
+    std::unordered_map<std::string, const Property*>::const_iterator itr = _propertyIndex.find(name);
+    return itr == _propertyIndex.end() ? NULL : itr->second;
+}
+
 void Properties::setDirectoryPath(const std::string* path)
 {
     if (path)
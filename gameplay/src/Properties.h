@@ -554,6 +554,15 @@ private:
     void setDirectoryPath(const std::string* path);
     void setDirectoryPath(const std::string& path);
 
+    // Marks the property and namespace lookup tables as stale.
+    void invalidateIndex();
+
+    // Rebuilds the property and namespace lookup tables if they are stale.
+    void buildIndex() const;
+
+    // Returns the first property with the given name, or NULL.
+    const Property* findProperty(const char* name) const;
+
     std::string _namespace;
     std::string _id;
     std::string _parentID;
@@ -564,6 +573,10 @@ private:
     std::vector<Property>* _variables;
     std::string* _dirPath;
     Properties* _parent;
+    mutable std::unordered_map<std::string, const Property*> _propertyIndex;
+    mutable std::unordered_map<std::string, size_t> _namespaceIdIndex;
+    mutable std::unordered_map<std::string, size_t> _namespaceNameIndex;
+    mutable bool _indexDirty;
 };
 
 }
@@ -27,9 +27,13 @@ namespace gameplay
 
 RenderState::StateBlock* RenderState::StateBlock::_defaultState = NULL;
 std::vector<RenderState::AutoBindingResolver*> RenderState::_customAutoBindingResolvers;
+unsigned int RenderState::_parameterBindCount = 0;
+unsigned int RenderState::_parameterBindingRebuildCount = 0;
+unsigned int RenderState::_lastParameterBindCount = 0;
+unsigned int RenderState::_lastParameterBindingRebuildCount = 0;
 
 RenderState::RenderState()
-    : _nodeBinding(NULL), _state(NULL), _parent(NULL)
+    : _nodeBinding(NULL), _state(NULL), _parent(NULL), _parameterBindingsVersion(1)
 {
 }
 
@@ -57,6 +61,29 @@ void RenderState::finalize()
     SAFE_RELEASE(StateBlock::_defaultState);
 }
 
+void RenderState::parameterBindingsChanged() const
+{
+    ++_parameterBindingsVersion;
+}
+
+void RenderState::resetFrameStatistics()
+{
+    _lastParameterBindCount = _parameterBindCount;
+    _lastParameterBindingRebuildCount = _parameterBindingRebuildCount;
+    _parameterBindCount = 0;
+    _parameterBindingRebuildCount = 0;
+}
+
+unsigned int RenderState::getParameterBindCount()
+{
+    return _lastParameterBindCount;
+}
+
+unsigned int RenderState::getParameterBindingRebuildCount()
+{
+    return _lastParameterBindingRebuildCount;
+}
+
 MaterialParameter* RenderState::getParameter(const char* name) const
 {
     GP_ASSERT(name);
@@ -76,6 +103,7 @@ MaterialParameter* RenderState::getParameter(const char* name) const
     // Create a new parameter and store it in our list.
     param = new MaterialParameter(name);
     _parameters.push_back(param);
+    parameterBindingsChanged();
 
     return param;
 }
@@ -94,6 +122,7 @@ void RenderState::addParameter(MaterialParameter* param)
 {
     _parameters.push_back(param);
     param->addRef();
+    parameterBindingsChanged();
 }
 
 void RenderState::removeParameter(const char* name)
@@ -105,6 +134,7 @@ void RenderState::removeParameter(const char* name)
         {
             _parameters.erase(_parameters.begin() + i);
             SAFE_RELEASE(p);
+            parameterBindingsChanged();
             break;
         }
     }
@@ -201,6 +231,7 @@ void RenderState::setStateBlock(StateBlock* state)
         {
             _state->addRef();
         }
+        parameterBindingsChanged();
     }
 }
 
@@ -209,6 +240,7 @@ RenderState::StateBlock* RenderState::getStateBlock() const
     if (_state == NULL)
     {
         _state = StateBlock::create();
+        parameterBindingsChanged();
     }
 
     return _state;
@@ -404,37 +436,69 @@ const Vector3& RenderState::autoBindingGetAmbientColor() const
 void RenderState::bind(Pass* pass)
 {
     GP_ASSERT(pass);
+    GP_ASSERT(pass == this);
 
-    // Get the combined modified state bits for our RenderState hierarchy.
-    long stateOverrideBits = _state ? _state->_bits : 0;
-    RenderState* rs = _parent;
-    while (rs)
+    Effect* effect = pass->getEffect();
+    GP_ASSERT(effect);
+
+    // Flatten the parameters and state blocks of the hierarchy, top-down, and resolve the
+    // parameters to uniforms of the effect. This only needs to be done again after a
+    // parameter or state block is added to or removed from one of its render states.
+    // Versions only grow, so their sum over the hierarchy changes whenever one of them does,
+    // and it is never zero since every version starts at one.
+    unsigned int version = 0;
+    for (RenderState* rs = this; rs; rs = rs->_parent)
+    {
+        version += rs->_parameterBindingsVersion;
+    }
+    if (pass->_bindingsBuiltVersion != version)
     {
-        if (rs->_state)
+        pass->_parameterBindings.clear();
+        pass->_stateBlocks.clear();
+        RenderState* rs = NULL;
+        while ((rs = getTopmost(rs)))
         {
-            stateOverrideBits |= rs->_state->_bits;
+            for (size_t i = 0, count = rs->_parameters.size(); i < count; ++i)
+            {
+                GP_ASSERT(rs->_parameters[i]);
+                Pass::ParameterBinding binding;
+                binding.parameter = rs->_parameters[i];
+                binding.uniform = binding.parameter->getUniform(effect);
+                if (binding.uniform)
+                    pass->_parameterBindings.push_back(binding);
+            }
+
+            if (rs->_state)
+            {
+                pass->_stateBlocks.push_back(rs->_state);
+            }
         }
-        rs = rs->_parent;
+        pass->_bindingsBuiltVersion = version;
+        ++_parameterBindingRebuildCount;
+    }
+
+    // Get the combined modified state bits for our RenderState hierarchy.
+    long stateOverrideBits = 0;
+    for (size_t i = 0, count = pass->_stateBlocks.size(); i < count; ++i)
+    {
+        stateOverrideBits |= pass->_stateBlocks[i]->_bits;
     }
 
     // Restore renderer state to its default, except for explicitly specified states
     StateBlock::restore(stateOverrideBits);
 
     // Apply parameter bindings and renderer state for the entire hierarchy, top-down.
-    rs = NULL;
-    Effect* effect = pass->getEffect();
-    while ((rs = getTopmost(rs)))
+    // Uniforms and renderer state are independent, so all parameters are bound first.
+    for (size_t i = 0, count = pass->_parameterBindings.size(); i < count; ++i)
     {
-        for (size_t i = 0, count = rs->_parameters.size(); i < count; ++i)
-        {
-            GP_ASSERT(rs->_parameters[i]);
-            rs->_parameters[i]->bind(effect);
-        }
+        const Pass::ParameterBinding& binding = pass->_parameterBindings[i];
+        binding.parameter->bind(effect, binding.uniform);
+    }
+    _parameterBindCount += (unsigned int)pass->_parameterBindings.size();
 
-        if (rs->_state)
-        {
-            rs->_state->bindNoRestore();
-        }
+    for (size_t i = 0, count = pass->_stateBlocks.size(); i < count; ++i)
+    {
+        pass->_stateBlocks[i]->bindNoRestore();
     }
 }
 
@@ -484,6 +548,7 @@ void RenderState::cloneInto(RenderState* renderState, NodeCloneContext& context)
 
         renderState->_parameters.push_back(paramCopy);
     }
+    renderState->parameterBindingsChanged();
 
     // Clone our state block
     if (_state)
@@ -571,6 +571,26 @@ public:
      */
     virtual void setNodeBinding(Node* node);
 
+    /**
+     * Gets the number of material parameters bound during the last frame.
+     *
+     * @return The number of parameter binds.
+     * @script{ignore}
+     */
+    static unsigned int getParameterBindCount();
+
+    /**
+     * Gets the number of times a pass rebuilt its flattened parameter bindings during the last frame.
+     *
+     * A pass resolves the parameters of its render state hierarchy to uniforms of its
+     * effect once, and only resolves them again after parameters, auto-bindings or state
+     * blocks are added to or removed from its material, technique or the pass itself.
+     *
+     * @return The number of rebuilds.
+     * @script{ignore}
+     */
+    static unsigned int getParameterBindingRebuildCount();
+
 protected:
 
     /**
@@ -593,6 +613,18 @@ protected:
      */
     static void finalize();
 
+    /**
+     * Invalidates the flattened parameter bindings of the passes below this render state.
+     *
+     * This is called whenever a parameter or state block is added to or removed from this render state.
+     */
+    void parameterBindingsChanged() const;
+
+    /**
+     * Stores the statistics of the frame that ended and resets them for the next frame.
+     */
+    static void resetFrameStatistics();
+
     /**
      * Applies the specified custom auto-binding.
      *
@@ -676,10 +708,20 @@ protected:
      */
     RenderState* _parent;
 
+    /**
+     * Version of the parameter list and state block of this render state, incremented when either changes.
+     */
+    mutable unsigned int _parameterBindingsVersion;
+
     /**
      * Map of custom auto binding resolvers.
      */
     static std::vector<AutoBindingResolver*> _customAutoBindingResolvers;
+
+    static unsigned int _parameterBindCount;
+    static unsigned int _parameterBindingRebuildCount;
+    static unsigned int _lastParameterBindCount;
+    static unsigned int _lastParameterBindingRebuildCount;
 };
 
 }
@@ -61,8 +61,9 @@ static bool endsWith(const char* str, const char* suffix, bool ignoreCase)
 
 Scene::Scene()
     : _id(""), _activeCamera(NULL), _firstNode(NULL), _lastNode(NULL), _nodeCount(0), _bindAudioListenerToCamera(true), 
-      _nextItr(NULL), _nextReset(true)
+      _nextItr(NULL), _nextReset(true), _updateNodesDirty(false)
 {
+    memset(&_staticBatchStatistics, 0, sizeof(_staticBatchStatistics));
     __sceneList.push_back(this);
 }
 
@@ -82,6 +83,7 @@ Scene::~Scene()
 
     // Remove all nodes from the scene
     removeAllNodes();
+    clearUpdateNodes();
 
     // Remove the scene from global list
     std::vector<Scene*>::iterator itr = std::find(__sceneList.begin(), __sceneList.end(), this);
@@ -272,6 +274,9 @@ void Scene::addNode(Node* node)
 
     ++_nodeCount;
 
+    if (node->_updateListenerCount)
+        _updateNodesDirty = true;
+
     // If we don't have an active camera set, then check for one and set it.
     if (_activeCamera == NULL)
     {
@@ -302,6 +307,9 @@ void Scene::removeNode(Node* node)
     node->remove();
     node->_scene = NULL;
 
+    if (node->_updateListenerCount)
+        _updateNodesDirty = true;
+
     SAFE_RELEASE(node);
 
     --_nodeCount;
@@ -387,13 +395,60 @@ void Scene::setAmbientColor(float red, float green, float blue)
 
 void Scene::update(float elapsedTime)
 {
-    for (Node* node = _firstNode; node != NULL; node = node->_nextSibling)
+    if (_updateNodesDirty)
+    {
+        clearUpdateNodes();
+        for (Node* node = _firstNode; node != NULL; node = node->_nextSibling)
+        {
+            if (node->_updateListenerCount)
+                addUpdateNodes(node);
+        }
+        _updateNodesDirty = false;
+    }
+
+    // Scripts may add or remove nodes while being updated. The list holds a reference to
+    // each node so it stays valid until it is rebuilt on the next update.
+    for (size_t i = 0, count = _updateNodes.size(); i < count; ++i)
     {
-        if (node->isEnabled())
-            node->update(elapsedTime);
+        Node* node = _updateNodes[i];
+        if (node->_updateListener && node->getScene() == this && node->isEnabledInHierarchy())
+            node->fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(Node, update), dynamic_cast<void*>(node), elapsedTime);
     }
 }
 
+void Scene::addUpdateNodes(Node* node)
+{
+    for (Node* child = node->_firstChild; child != NULL; child = child->_nextSibling)
+    {
+        if (child->_updateListenerCount)
+            addUpdateNodes(child);
+    }
+    if (node->_updateListener)
+    {
+        node->addRef();
+        _updateNodes.push_back(node);
+    }
+}
+
+void Scene::clearUpdateNodes()
+{
+    for (size_t i = 0, count = _updateNodes.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(_updateNodes[i]);
+    }
+    _updateNodes.clear();
+}
+
+unsigned int Scene::batchStaticGeometry(float cellSize, unsigned int threadCount)
+{
+    return StaticBatch::build(this, cellSize, threadCount, &_staticBatchStatistics);
+}
+
+const StaticBatch::Statistics& Scene::getStaticBatchStatistics() const
+{
+    return _staticBatchStatistics;
+}
+
 void Scene::reset()
 {
     _nextItr = NULL;
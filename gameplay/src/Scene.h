@@ -6,6 +6,7 @@
 #include "ScriptController.h"
 #include "Light.h"
 #include "Model.h"
+#include "StaticBatch.h"
 
 namespace gameplay
 {
@@ -17,6 +18,8 @@ namespace gameplay
  */
 class Scene : public Ref
 {
+    friend class Node;
+
 public:
 
     /**
@@ -180,14 +183,50 @@ public:
     /**
      * Updates all active nodes in the scene.
      *
-     * This method is recursively calls the Node::update(float) method on all nodes that
-     * are active within the scene. A Node is considered active if Node::isActive()
-     * returns true.
+     * This method fires the update script event on all nodes in the scene that have an
+     * update listener and are enabled in the hierarchy. Nodes are updated in the same
+     * order as Node::update(float) visits them: children before their parent, siblings
+     * in order. Subtrees without any update listeners are never visited.
      *
      * @param elapsedTime Elapsed time in milliseconds.
      */
     void update(float elapsedTime);
 
+    /**
+     * Merges the models of static nodes that share a material into combined meshes.
+     *
+     * The mesh parts of the models of enabled nodes with a static collision object
+     * (see Node::isStatic) are transformed into world space and merged with the parts
+     * of other static models that use the same material, or a material loaded from the
+     * same URL. The merged meshes are drawn by new nodes added to the root of the scene,
+     * and the models of the merged nodes are removed from them. The merged nodes keep
+     * their collision objects, children and all other attachments.
+     *
+     * Models that are skinned, that have meshes not loaded from a bundle, that have
+     * mesh parts which are not triangle lists or that have non-float positions, normals
+     * or tangents are not merged. Each batch holds at most 65536 vertices.
+     *
+     * This is meant to be called once all static nodes of the scene have been loaded.
+     * Scene files can request it with a 'staticBatch' namespace in the scene.
+     *
+     * @param cellSize The size of the cubic cells the scene is divided into, so that
+     *      batches can still be culled, or zero to not divide the scene.
+     * @param threadCount The number of threads that merge the meshes, or zero to use
+     *      one per hardware thread.
+     *
+     * @return The number of batch nodes added to the scene.
+     * @script{ignore}
+     */
+    unsigned int batchStaticGeometry(float cellSize = 0.0f, unsigned int threadCount = 0);
+
+    /**
+     * Gets the totals of the static geometry batched in this scene.
+     *
+     * @return The static batching statistics.
+     * @script{ignore}
+     */
+    const StaticBatch::Statistics& getStaticBatchStatistics() const;
+
     /**
      * Visits each node in the scene and calls the specified method pointer.
      *
@@ -299,6 +338,16 @@ private:
 
     bool isNodeVisible(Node* node);
 
+    /**
+     * Adds the nodes with an update listener in the given subtree to the update list.
+     */
+    void addUpdateNodes(Node* node);
+
+    /**
+     * Releases and clears the nodes in the update list.
+     */
+    void clearUpdateNodes();
+
     std::string _id;
     Camera* _activeCamera;
     Node* _firstNode;
@@ -308,6 +357,9 @@ private:
     bool _bindAudioListenerToCamera;
     Node* _nextItr;
     bool _nextReset;
+    std::vector<Node*> _updateNodes;
+    bool _updateNodesDirty;
+    StaticBatch::Statistics _staticBatchStatistics;
 };
 
 template <class T>
@@ -142,6 +142,19 @@ Scene* SceneLoader::loadInternal(const char* url)
     if (physics)
         loadPhysics(physics);
 
+    // Merge the static models once the collision objects that mark nodes as static exist.
+    sceneProperties->rewind();
+    Properties* staticBatch = NULL;
+    while ((staticBatch = sceneProperties->getNextNamespace()) != NULL)
+    {
+        if (strcmp(staticBatch->getNamespace(), "staticBatch") == 0)
+        {
+            int threads = staticBatch->getInt("threads");
+            _scene->batchStaticGeometry(staticBatch->getFloat("cellSize"), threads > 0 ? (unsigned int)threads : 0);
+            break;
+        }
+    }
+
     // Clean up all loaded properties objects.
     std::map<std::string, Properties*>::iterator iter = _propertiesFromFile.begin();
     for (; iter != _propertiesFromFile.end(); ++iter)
@@ -285,6 +298,8 @@ void SceneLoader::applyNodeProperty(SceneNode& sceneNode, Node* node, const Prop
             if (model)
             {
                 Material* material = Material::create(p);
+                if (material)
+                    material->_url = snp._value;
                 model->setMaterial(material, snp._index);
                 SAFE_RELEASE(material);
             }
@@ -673,6 +688,10 @@ void SceneLoader::buildReferenceTables(Properties* sceneProperties)
             // Note: we don't load physics until the whole scene file has been 
             // loaded so that all node references (i.e. for constraints) can be resolved.
         }
+        else if (strcmp(ns->getNamespace(), "staticBatch") == 0)
+        {
+            // Note: static geometry is batched after physics has been loaded.
+        }
         else
         {
             // TODO: Should we ignore these items? They could be used for generic properties file inheritance.
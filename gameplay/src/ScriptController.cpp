@@ -649,7 +649,7 @@ void ScriptController::print(const char* str1, const char* str2)
     gameplay::print("%s%s", str1, str2);
 }
 
-ScriptController::ScriptController() : _lua(NULL)
+ScriptController::ScriptController() : _lua(NULL), _typeHierarchyDirty(false)
 {
 }
 
@@ -772,6 +772,41 @@ void ScriptController::finalize()
         lua_close(_lua);
 		_lua = NULL;
 	}
+
+    _typeNames.clear();
+    _typeMetatables.clear();
+    _typeIds.clear();
+    _metatableTypes.clear();
+    _typeNameCache.clear();
+    _typeAssignable.clear();
+}
+
+void ScriptController::updateTypeHierarchy()
+{
+    if (!_typeHierarchyDirty)
+        return;
+
+    size_t count = _typeNames.size();
+    _typeAssignable.assign(count, std::vector<bool>(count, false));
+    for (size_t i = 0; i < count; i++)
+        _typeAssignable[i][i] = true;
+
+    // The hierarchy lists every derived class of a base (not only the direct ones).
+    for (std::map<std::string, std::vector<std::string> >::const_iterator itr = _hierarchy.begin(); itr != _hierarchy.end(); ++itr)
+    {
+        std::unordered_map<std::string, int>::const_iterator base = _typeIds.find(itr->first);
+        if (base == _typeIds.end())
+            continue;
+
+        for (size_t i = 0, derivedCount = itr->second.size(); i < derivedCount; i++)
+        {
+            std::unordered_map<std::string, int>::const_iterator derived = _typeIds.find(itr->second[i]);
+            if (derived != _typeIds.end())
+                _typeAssignable[base->second][derived->second] = true;
+        }
+    }
+
+    _typeHierarchyDirty = false;
 }
 
 void ScriptController::executeFunctionHelper(int resultCount, const char* func, const char* args, va_list* list, Script* script)
@@ -1695,6 +1730,21 @@ void ScriptUtil::registerClass(const char* name, const luaL_Reg* members, lua_CF
         lua_settable(sc->_lua, -3);
     }
 
+    // Assign the type an id and keep a reference to its metatable.
+    if (sc->_typeIds.find(name) == sc->_typeIds.end())
+    {
+        int typeId = (int)sc->_typeNames.size();
+        sc->_typeNames.push_back(name);
+        sc->_typeIds[name] = typeId;
+        sc->_metatableTypes[lua_topointer(sc->_lua, -1)] = typeId;
+        lua_pushvalue(sc->_lua, -1);
+        sc->_typeMetatables.push_back(luaL_ref(sc->_lua, LUA_REGISTRYINDEX));
+        sc->_typeHierarchyDirty = true;
+
+        // Names cached as unregistered may now resolve to this type.
+        sc->_typeNameCache.clear();
+    }
+
     // Set the metatable on the main table.
     lua_settable(sc->_lua, -3);
 
@@ -1734,7 +1784,52 @@ void ScriptUtil::registerFunction(const char* luaFunction, lua_CFunction cppFunc
 
 void ScriptUtil::setGlobalHierarchyPair(const std::string& base, const std::string& derived)
 {
-    Game::getInstance()->getScriptController()->_hierarchy[base].push_back(derived);
+    ScriptController* sc = Game::getInstance()->getScriptController();
+    sc->_hierarchy[base].push_back(derived);
+    sc->_typeHierarchyDirty = true;
+}
+
+int ScriptUtil::getTypeId(const char* type)
+{
+    GP_ASSERT(type);
+    ScriptController* sc = Game::getInstance()->getScriptController();
+
+    // The cache is keyed by pointer. Entries are resolved by name once, when they are added,
+    // and the cache is cleared whenever a type is registered.
+    std::unordered_map<const char*, int>::const_iterator cached = sc->_typeNameCache.find(type);
+    if (cached != sc->_typeNameCache.end())
+        return cached->second;
+
+    std::unordered_map<std::string, int>::const_iterator itr = sc->_typeIds.find(type);
+    int typeId = itr != sc->_typeIds.end() ? itr->second : -1;
+    sc->_typeNameCache[type] = typeId;
+    return typeId;
+}
+
+bool ScriptUtil::isObjectOfType(int index, int typeId)
+{
+    ScriptController* sc = Game::getInstance()->getScriptController();
+    if (typeId < 0 || !lua_getmetatable(sc->_lua, index))
+        return false;
+
+    const void* metatable = lua_topointer(sc->_lua, -1);
+    lua_pop(sc->_lua, 1);
+
+    std::unordered_map<const void*, int>::const_iterator itr = sc->_metatableTypes.find(metatable);
+    if (itr == sc->_metatableTypes.end())
+        return false;
+
+    sc->updateTypeHierarchy();
+    return sc->_typeAssignable[typeId][itr->second];
+}
+
+void ScriptUtil::pushMetatable(lua_State* state, const char* type)
+{
+    int typeId = getTypeId(type);
+    if (typeId >= 0)
+        lua_rawgeti(state, LUA_REGISTRYINDEX, Game::getInstance()->getScriptController()->_typeMetatables[typeId]);
+    else
+        luaL_getmetatable(state, type);
 }
 
 ScriptUtil::LuaArray<bool> ScriptUtil::getBoolPointer(int index)
@@ -684,9 +684,22 @@ private:
 
     void popScript();
 
+    /**
+     * Rebuilds the table of which registered types can be converted to which
+     * (from the inheritance pairs), if registrations have changed since it was built.
+     */
+    void updateTypeHierarchy();
+
     lua_State* _lua;
     unsigned int _returnCount;
     std::map<std::string, std::vector<std::string> > _hierarchy;
+    std::vector<std::string> _typeNames;                        // Registered class names, indexed by type id.
+    std::vector<int> _typeMetatables;                           // Registry references to each type's metatable.
+    std::unordered_map<std::string, int> _typeIds;              // Type ids by class name.
+    std::unordered_map<const void*, int> _metatableTypes;       // Type ids by metatable address.
+    std::unordered_map<const char*, int> _typeNameCache;        // Type ids (or -1) by name pointer, cleared when a type is registered.
+    std::vector<std::vector<bool> > _typeAssignable;            // [type][other] is true if 'other' is or derives from 'type'.
+    bool _typeHierarchyDirty;
     std::map<std::string, std::vector<Script*> > _scripts;
     std::vector<Script*> _envStack;
     std::list<ScriptTimeListener*> _timeListeners;
@@ -1021,6 +1034,53 @@ public:
      */
     static void setGlobalHierarchyPair(const std::string& base, const std::string& derived);
 
+    /**
+     * Gets the id assigned to a registered class type.
+     *
+     * Type ids allow the bindings to validate objects without looking up
+     * metatables by name or walking the inheritance hierarchy.
+     *
+     * Ids are cached by the address of the name, so the name must stay valid
+     * and unchanged for the lifetime of the script controller (the bindings
+     * pass string literals).
+     *
+     * @param type The name of the class from within Lua.
+     *
+     * @return The type id, or -1 if the type has not been registered.
+     */
+    static int getTypeId(const char* type);
+
+    /**
+     * Checks whether the object at the given stack index is of the given type or derives from it.
+     *
+     * @param index The stack index.
+     * @param typeId The id of the type to check against (see getTypeId).
+     *
+     * @return True if the object is of the given type or a type derived from it.
+     */
+    static bool isObjectOfType(int index, int typeId);
+
+    /**
+     * Pushes the metatable of the given registered class type onto the stack.
+     *
+     * @param state The Lua state.
+     * @param type The name of the class from within Lua.
+     */
+    static void pushMetatable(lua_State* state, const char* type);
+
+    /**
+     * Pushes a copy of the given value onto the stack as an object of the given type.
+     *
+     * The value is stored inline within the Lua userdata, which avoids a separate heap
+     * allocation. This is only valid for trivially copyable types such as the math types.
+     *
+     * @param state The Lua state.
+     * @param value The value to push.
+     * @param type The name of the class from within Lua.
+     */
+    template <typename T>
+    static void pushValue(lua_State* state, const T& value, const char* type);
+
     /**
      * Gets a pointer to a bool (as an array-use SAFE_DELETE_ARRAY to clean up) for the given stack index.
      * 
@@ -173,6 +173,8 @@ Script* ScriptTarget::addScript(const char* path)
         sc->executeFunction<void>(script, "attached", args, dynamic_cast<void*>(this));
     }
 
+    scriptsChanged();
+
     return script;
 }
 
@@ -231,6 +233,8 @@ void ScriptTarget::removeScript(ScriptEntry* se)
 
     // Free the script
     SAFE_RELEASE(script);
+
+    scriptsChanged();
 }
 
 void ScriptTarget::addScriptCallback(const Event* event, const char* function)
@@ -301,6 +305,7 @@ void ScriptTarget::addScriptCallback(const Event* event, const char* function)
         if (!_scriptCallbacks)
             _scriptCallbacks = new std::map<const Event*, std::vector<CallbackFunction>>();
         (*_scriptCallbacks)[event].push_back(CallbackFunction(script, func.c_str()));
+        scriptsChanged();
     }
 }
 
@@ -367,6 +372,10 @@ void ScriptTarget::removeScriptCallback(const Event* event, const char* function
     {
         removeScript(scriptEntry);
     }
+    else if (removedCallbacks > 0)
+    {
+        scriptsChanged();
+    }
 }
 
 void ScriptTarget::clearScripts()
@@ -377,6 +386,10 @@ void ScriptTarget::clearScripts()
     }
 }
 
+void ScriptTarget::scriptsChanged()
+{
+}
+
 bool ScriptTarget::hasScriptListener(const char* eventName) const
 {
     const Event* event = getScriptEvent(eventName);
@@ -385,6 +385,13 @@ protected:
      */
     void removeScript(ScriptEntry* entry);
 
+    /**
+     * Called after a script or script callback has been added to or removed from this ScriptTarget.
+     *
+     * Derived classes can override this to track which of their script events have listeners.
+     */
+    virtual void scriptsChanged();
+
     /**
      * Registers a set of supported script events and event arguments for this ScriptTarget. 
      *
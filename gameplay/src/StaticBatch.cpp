@@ -0,0 +1,397 @@
+#include "Base.h"
+#include "StaticBatch.h"
+#include "Scene.h"
+#include "MeshPart.h"
+
+// The largest batch that can be drawn with 16-bit indices
+#define STATIC_BATCH_MAX_VERTICES 65536
+
+namespace gameplay
+{
+
+// Returns true if the element is absent or holds 3 or more floats that can be transformed.
+static bool isTransformable(const VertexFormat& vertexFormat, VertexFormat::Usage usage)
+{
+    for (unsigned int i = 0, count = vertexFormat.getElementCount(); i < count; ++i)
+    {
+        const VertexFormat::Element& e = vertexFormat.getElement(i);
+        if (e.usage == usage)
+            return e.type == VertexFormat::FLOAT && e.size >= 3;
+    }
+    return usage != VertexFormat::POSITION;
+}
+
+static unsigned int getIndexSize(Mesh::IndexFormat indexFormat)
+{
+    switch (indexFormat)
+    {
+    case Mesh::INDEX8:
+        return 1;
+    case Mesh::INDEX16:
+        return 2;
+    default:
+        return 4;
+    }
+}
+
+static unsigned int getIndex(Mesh::IndexFormat indexFormat, const unsigned char* indexData, unsigned int i)
+{
+    switch (indexFormat)
+    {
+    case Mesh::INDEX8:
+        return indexData[i];
+    case Mesh::INDEX16:
+        return ((const unsigned short*)indexData)[i];
+    default:
+        return ((const unsigned int*)indexData)[i];
+    }
+}
+
+StaticBatch::Group::Group()
+    : material(NULL), vertexFormat(NULL), maxVertexCount(0), vertexCount(0)
+{
+}
+
+StaticBatch::StaticBatch()
+    : _cellSize(0.0f), _nextGroup(0)
+{
+    memset(&_statistics, 0, sizeof(_statistics));
+}
+
+StaticBatch::~StaticBatch()
+{
+    for (size_t i = 0, count = _groups.size(); i < count; ++i)
+    {
+        SAFE_DELETE(_groups[i]);
+    }
+    for (std::map<std::string, Bundle::MeshData*>::iterator itr = _meshData.begin(); itr != _meshData.end(); ++itr)
+    {
+        SAFE_DELETE(itr->second);
+    }
+}
+
+unsigned int StaticBatch::build(Scene* scene, float cellSize, unsigned int threadCount, Statistics* statistics)
+{
+    GP_ASSERT(scene);
+    GP_ASSERT(statistics);
+
+    StaticBatch batch;
+    batch._cellSize = cellSize;
+
+    // Read the mesh data of the static models and group their parts.
+    scene->visit(&batch, &StaticBatch::visitNode);
+    if (batch._groups.empty())
+    {
+        statistics->skippedNodeCount += batch._statistics.skippedNodeCount;
+        return 0;
+    }
+
+    // Transform and merge the parts of each group.
+    batch.buildGroups(threadCount);
+
+    // Create the batch meshes and add a node for each of them.
+    unsigned int batchCount = 0;
+    for (size_t i = 0, count = batch._groups.size(); i < count; ++i)
+    {
+        Group* group = batch._groups[i];
+        if (group->indices.empty())
+            continue;
+
+        Mesh* mesh = Mesh::createMesh(*group->vertexFormat, group->vertexCount, false);
+        if (mesh == NULL)
+        {
+            GP_ERROR("Failed to create mesh for static batch.");
+            continue;
+        }
+        mesh->setVertexData((const float*)&group->vertexData[0], 0, group->vertexCount);
+        mesh->setBoundingBox(group->boundingBox);
+        mesh->setBoundingSphere(group->boundingSphere);
+        MeshPart* part = mesh->addPart(Mesh::TRIANGLES, Mesh::INDEX16, (unsigned int)group->indices.size(), false);
+        GP_ASSERT(part);
+        part->setIndexData(&group->indices[0], 0, (unsigned int)group->indices.size());
+
+        Model* model = Model::create(mesh);
+        SAFE_RELEASE(mesh);
+
+        // The batch gets its own copy of the material, bound to the batch node.
+        NodeCloneContext context;
+        Material* material = group->material->clone(context);
+        model->setMaterial(material);
+        SAFE_RELEASE(material);
+
+        char id[32];
+        sprintf(id, "staticBatch%u", statistics->batchDrawCount + batchCount);
+        Node* node = Node::create(id);
+        node->setDrawable(model);
+        SAFE_RELEASE(model);
+        scene->addNode(node);
+        SAFE_RELEASE(node);
+
+        batch._statistics.batchMemory += group->vertexData.size() + group->indices.size() * sizeof(unsigned short);
+        ++batchCount;
+    }
+
+    // The source models are drawn by the batches now.
+    for (size_t i = 0, count = batch._nodes.size(); i < count; ++i)
+    {
+        batch._nodes[i]->setDrawable(NULL);
+    }
+
+    batch._statistics.batchDrawCount = batchCount;
+    statistics->sourceNodeCount += batch._statistics.sourceNodeCount;
+    statistics->skippedNodeCount += batch._statistics.skippedNodeCount;
+    statistics->sourceDrawCount += batch._statistics.sourceDrawCount;
+    statistics->batchDrawCount += batch._statistics.batchDrawCount;
+    statistics->sourceMemory += batch._statistics.sourceMemory;
+    statistics->batchMemory += batch._statistics.batchMemory;
+
+    return batchCount;
+}
+
+bool StaticBatch::visitNode(Node* node)
+{
+    if (!node->isStatic() || !node->isEnabledInHierarchy())
+        return true;
+
+    Model* model = dynamic_cast<Model*>(node->getDrawable());
+    if (model == NULL)
+        return true;
+
+    // Skinned models are deformed every frame and meshes without a bundle URL have no
+    // vertex data that can be read back.
+    Mesh* mesh = model->getMesh();
+    Bundle::MeshData* meshData = NULL;
+    if (model->getSkin() == NULL && mesh && strlen(mesh->getUrl()) > 0)
+        meshData = getMeshData(mesh->getUrl());
+    if (meshData == NULL || meshData->parts.empty() || meshData->parts.size() != mesh->getPartCount() ||
+        !isTransformable(meshData->vertexFormat, VertexFormat::POSITION) ||
+        !isTransformable(meshData->vertexFormat, VertexFormat::NORMAL) ||
+        !isTransformable(meshData->vertexFormat, VertexFormat::TANGENT) ||
+        !isTransformable(meshData->vertexFormat, VertexFormat::BINORMAL))
+    {
+        ++_statistics.skippedNodeCount;
+        return true;
+    }
+    for (size_t i = 0, count = meshData->parts.size(); i < count; ++i)
+    {
+        const Bundle::MeshPartData* part = meshData->parts[i];
+        if (part->primitiveType != Mesh::TRIANGLES ||
+            std::min(part->indexCount, meshData->vertexCount) > STATIC_BATCH_MAX_VERTICES)
+        {
+            ++_statistics.skippedNodeCount;
+            return true;
+        }
+    }
+
+    Source source;
+    source.meshData = meshData;
+    source.worldMatrix = node->getWorldMatrix();
+    source.worldMatrix.invert(&source.normalMatrix);
+    source.normalMatrix.transpose();
+    source.flipWinding = source.worldMatrix.determinant() < 0.0f;
+
+    Vector3 center;
+    source.worldMatrix.transformPoint(meshData->boundingSphere.center, &center);
+
+    for (unsigned int i = 0, count = (unsigned int)meshData->parts.size(); i < count; ++i)
+    {
+        // Parts without a material are not drawn.
+        Material* material = model->getMaterial(i);
+        if (material == NULL)
+            continue;
+
+        const Bundle::MeshPartData* part = meshData->parts[i];
+        Group* group = getGroup(material, meshData->vertexFormat, center, std::min(part->indexCount, meshData->vertexCount));
+        source.partIndex = i;
+        group->sources.push_back(source);
+        ++_statistics.sourceDrawCount;
+    }
+
+    _nodes.push_back(node);
+    ++_statistics.sourceNodeCount;
+
+    return true;
+}
+
+Bundle::MeshData* StaticBatch::getMeshData(const char* url)
+{
+    std::map<std::string, Bundle::MeshData*>::iterator itr = _meshData.find(url);
+    if (itr != _meshData.end())
+        return itr->second;
+
+    Bundle::MeshData* meshData = Bundle::readMeshData(url);
+    _meshData[url] = meshData;
+    if (meshData)
+    {
+        _statistics.sourceMemory += meshData->vertexCount * meshData->vertexFormat.getVertexSize();
+        for (size_t i = 0, count = meshData->parts.size(); i < count; ++i)
+        {
+            _statistics.sourceMemory += meshData->parts[i]->indexCount * getIndexSize(meshData->parts[i]->indexFormat);
+        }
+    }
+    return meshData;
+}
+
+StaticBatch::Group* StaticBatch::getGroup(Material* material, const VertexFormat& vertexFormat, const Vector3& center, unsigned int vertexCount)
+{
+    // Materials loaded from the same URL are interchangeable, other materials only batch with themselves.
+    char buffer[64];
+    std::string key = material->getUrl();
+    if (key.empty())
+    {
+        sprintf(buffer, "%p", (void*)material);
+        key = buffer;
+    }
+    for (unsigned int i = 0, count = vertexFormat.getElementCount(); i < count; ++i)
+    {
+        const VertexFormat::Element& e = vertexFormat.getElement(i);
+        sprintf(buffer, "|%d,%u,%d,%d", e.usage, e.size, e.type, e.normalized ? 1 : 0);
+        key += buffer;
+    }
+    if (_cellSize > 0.0f)
+    {
+        sprintf(buffer, "|%d,%d,%d", (int)floor(center.x / _cellSize), (int)floor(center.y / _cellSize), (int)floor(center.z / _cellSize));
+        key += buffer;
+    }
+
+    // Start a new batch once the current one could exceed the range of 16-bit indices.
+    std::map<std::string, Group*>::iterator itr = _groupIndex.find(key);
+    Group* group = itr != _groupIndex.end() ? itr->second : NULL;
+    if (group == NULL || group->maxVertexCount + vertexCount > STATIC_BATCH_MAX_VERTICES)
+    {
+        group = new Group();
+        group->material = material;
+        group->vertexFormat = &vertexFormat;
+        _groups.push_back(group);
+        _groupIndex[key] = group;
+    }
+    group->maxVertexCount += vertexCount;
+    return group;
+}
+
+void StaticBatch::buildGroups(unsigned int threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, (unsigned int)_groups.size());
+
+    // The calling thread works alongside the worker threads.
+    _nextGroup = 0;
+    std::vector<std::thread*> threads;
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        threads.push_back(new std::thread(&workerThreadProc, this));
+    }
+    workerThreadProc(this);
+    for (size_t i = 0, count = threads.size(); i < count; ++i)
+    {
+        threads[i]->join();
+        SAFE_DELETE(threads[i]);
+    }
+}
+
+void StaticBatch::workerThreadProc(StaticBatch* batch)
+{
+    for (unsigned int i = batch->_nextGroup++; i < batch->_groups.size(); i = batch->_nextGroup++)
+    {
+        buildGroup(batch->_groups[i]);
+    }
+}
+
+void StaticBatch::buildGroup(Group* group)
+{
+    const VertexFormat& vertexFormat = *group->vertexFormat;
+    unsigned int vertexSize = vertexFormat.getVertexSize();
+
+    // Find the elements that are transformed into world space.
+    int positionOffset = -1;
+    std::vector<unsigned int> normalOffsets;
+    std::vector<unsigned int> tangentOffsets;
+    for (unsigned int i = 0, offset = 0, count = vertexFormat.getElementCount(); i < count; ++i)
+    {
+        const VertexFormat::Element& e = vertexFormat.getElement(i);
+        if (e.usage == VertexFormat::POSITION)
+            positionOffset = (int)offset;
+        else if (e.usage == VertexFormat::NORMAL)
+            normalOffsets.push_back(offset);
+        else if (e.usage == VertexFormat::TANGENT || e.usage == VertexFormat::BINORMAL)
+            tangentOffsets.push_back(offset);
+        offset += e.getSizeInBytes();
+    }
+    GP_ASSERT(positionOffset >= 0);
+
+    group->vertexData.reserve(group->maxVertexCount * vertexSize);
+    std::vector<int> remap;
+    Vector3 min(FLT_MAX, FLT_MAX, FLT_MAX);
+    Vector3 max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+    for (size_t s = 0, sourceCount = group->sources.size(); s < sourceCount; ++s)
+    {
+        const Source& source = group->sources[s];
+        const Bundle::MeshData* meshData = source.meshData;
+        const Bundle::MeshPartData* part = meshData->parts[source.partIndex];
+
+        // Copy only the vertices referenced by the part, once each.
+        remap.assign(meshData->vertexCount, -1);
+        for (unsigned int i = 0; i + 2 < part->indexCount; i += 3)
+        {
+            unsigned short triangle[3];
+            for (unsigned int j = 0; j < 3; ++j)
+            {
+                unsigned int index = getIndex(part->indexFormat, part->indexData, i + j);
+                GP_ASSERT(index < meshData->vertexCount);
+                if (remap[index] < 0)
+                {
+                    remap[index] = (int)group->vertexCount++;
+                    size_t start = group->vertexData.size();
+                    group->vertexData.insert(group->vertexData.end(), meshData->vertexData + index * vertexSize, meshData->vertexData + (index + 1) * vertexSize);
+                    unsigned char* vertex = &group->vertexData[start];
+
+                    Vector3 v;
+                    memcpy(&v.x, vertex + positionOffset, sizeof(float) * 3);
+                    source.worldMatrix.transformPoint(&v);
+                    memcpy(vertex + positionOffset, &v.x, sizeof(float) * 3);
+                    min.set(std::min(min.x, v.x), std::min(min.y, v.y), std::min(min.z, v.z));
+                    max.set(std::max(max.x, v.x), std::max(max.y, v.y), std::max(max.z, v.z));
+
+                    for (size_t k = 0; k < normalOffsets.size(); ++k)
+                    {
+                        memcpy(&v.x, vertex + normalOffsets[k], sizeof(float) * 3);
+                        source.normalMatrix.transformVector(&v);
+                        v.normalize();
+                        memcpy(vertex + normalOffsets[k], &v.x, sizeof(float) * 3);
+                    }
+                    for (size_t k = 0; k < tangentOffsets.size(); ++k)
+                    {
+                        memcpy(&v.x, vertex + tangentOffsets[k], sizeof(float) * 3);
+                        source.worldMatrix.transformVector(&v);
+                        v.normalize();
+                        memcpy(vertex + tangentOffsets[k], &v.x, sizeof(float) * 3);
+                    }
+                }
+                triangle[j] = (unsigned short)remap[index];
+            }
+
+            // Mirroring transforms reverse the winding of the triangles.
+            if (source.flipWinding)
+                std::swap(triangle[1], triangle[2]);
+            group->indices.insert(group->indices.end(), triangle, triangle + 3);
+        }
+    }
+
+    if (group->vertexCount == 0)
+        return;
+
+    group->boundingBox.set(min, max);
+    group->boundingBox.getCenter(&group->boundingSphere.center);
+    float radiusSquared = 0.0f;
+    for (unsigned int i = 0; i < group->vertexCount; ++i)
+    {
+        Vector3 v;
+        memcpy(&v.x, &group->vertexData[i * vertexSize + positionOffset], sizeof(float) * 3);
+        radiusSquared = std::max(radiusSquared, v.distanceSquared(group->boundingSphere.center));
+    }
+    group->boundingSphere.radius = sqrt(radiusSquared);
+}
+
+}
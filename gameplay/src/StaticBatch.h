@@ -0,0 +1,144 @@
+#ifndef STATICBATCH_H_
+#define STATICBATCH_H_
+
+#include "Bundle.h"
+#include "Matrix.h"
+
+namespace gameplay
+{
+
+class Scene;
+class Node;
+class Material;
+
+/**
+ * Merges the models of static scene nodes into combined, pre-transformed meshes.
+ *
+ * Nodes with a static collision object never move, so the mesh parts of their models
+ * can be transformed into world space once and merged with the parts of other static
+ * models that use the same material. Each merged mesh is drawn by a single node with an
+ * identity transform, which replaces one draw call and one world matrix binding per
+ * source mesh part with one draw call per batch.
+ *
+ * Mesh parts are grouped by material, vertex format and spatial cell, so that each batch
+ * covers a bounded region of the scene and can still be culled against the view frustum.
+ * Materials are considered the same when they are the same object or were loaded from the
+ * same URL (see Material::getUrl). The vertex data of the source meshes is read back from
+ * their bundles on the calling thread, and the parts are transformed and merged on worker
+ * threads. The meshes are then created on the calling thread since they create GPU resources.
+ *
+ * @script{ignore}
+ */
+class StaticBatch
+{
+    friend class Scene;
+
+public:
+
+    /**
+     * The results of batching the static geometry of a scene.
+     */
+    struct Statistics
+    {
+        /** Static nodes whose models were merged into batches. */
+        unsigned int sourceNodeCount;
+        /** Static nodes with models that could not be merged. */
+        unsigned int skippedNodeCount;
+        /** Draw calls issued by the merged models before batching. */
+        unsigned int sourceDrawCount;
+        /** Draw calls issued by the batches. */
+        unsigned int batchDrawCount;
+        /** Bytes of vertex and index data in the unique meshes of the merged models. */
+        size_t sourceMemory;
+        /** Bytes of vertex and index data in the batches. */
+        size_t batchMemory;
+    };
+
+private:
+
+    /**
+     * A mesh part of a static node to be merged into a batch.
+     */
+    struct Source
+    {
+        Bundle::MeshData* meshData;
+        unsigned int partIndex;
+        Matrix worldMatrix;
+        Matrix normalMatrix;
+        bool flipWinding;
+    };
+
+    /**
+     * The mesh parts merged into a single batch, and the merged data once built.
+     */
+    struct Group
+    {
+        Group();
+
+        Material* material;
+        const VertexFormat* vertexFormat;
+        std::vector<Source> sources;
+        unsigned int maxVertexCount;
+        unsigned int vertexCount;
+        std::vector<unsigned char> vertexData;
+        std::vector<unsigned short> indices;
+        BoundingBox boundingBox;
+        BoundingSphere boundingSphere;
+    };
+
+    /**
+     * Constructor.
+     */
+    StaticBatch();
+
+    /**
+     * Hidden copy constructor.
+     */
+    StaticBatch(const StaticBatch&);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    StaticBatch& operator=(const StaticBatch&);
+
+    /**
+     * Destructor.
+     */
+    ~StaticBatch();
+
+    /**
+     * Merges the models of the static nodes in the given scene.
+     *
+     * @param scene The scene to batch.
+     * @param cellSize The size of the spatial cells, or zero to batch the whole scene as a single cell.
+     * @param threadCount The number of worker threads, or zero to use one per hardware thread.
+     * @param statistics The statistics to add the results to.
+     *
+     * @return The number of batch nodes added to the scene.
+     */
+    static unsigned int build(Scene* scene, float cellSize, unsigned int threadCount, Statistics* statistics);
+
+    bool visitNode(Node* node);
+
+    Bundle::MeshData* getMeshData(const char* url);
+
+    Group* getGroup(Material* material, const VertexFormat& vertexFormat, const Vector3& center, unsigned int vertexCount);
+
+    void buildGroups(unsigned int threadCount);
+
+    static void buildGroup(Group* group);
+
+    static void workerThreadProc(StaticBatch* batch);
+
+    float _cellSize;
+    std::map<std::string, Bundle::MeshData*> _meshData;
+    std::map<std::string, Group*> _groupIndex;
+    std::vector<Group*> _groups;
+    std::vector<Node*> _nodes;
+    std::atomic<unsigned int> _nextGroup;
+    Statistics _statistics;
+};
+
+}
+
+#endif
@@ -1,7 +1,10 @@
 #include "Base.h"
 #include "Terrain.h"
 #include "TerrainPatch.h"
+#include "TerrainPager.h"
 #include "Node.h"
+#include "Scene.h"
+#include "Game.h"
 #include "FileSystem.h"
 
 namespace gameplay
@@ -22,19 +25,26 @@ static const unsigned int DEFAULT_TERRAIN_PATCH_SIZE = 32;
 //
 static const float DEFAULT_TERRAIN_HEIGHT_RATIO = 0.3f;
 
+// The default maximum screen-space error of a terrain patch level, in pixels.
+static const float DEFAULT_TERRAIN_PIXEL_ERROR = 4.0f;
+
+// The number of points transformed at a time by batched height and normal queries.
+static const unsigned int TERRAIN_QUERY_BATCH_SIZE = 256;
+
 // Terrain dirty flags
 static const unsigned int DIRTY_FLAG_INVERSE_WORLD = 1;
 
 static float getDefaultHeight(unsigned int width, unsigned int height);
 
 Terrain::Terrain() : Drawable(),
-    _heightfield(NULL), _normalMap(NULL), _flags(FRUSTUM_CULLING | LEVEL_OF_DETAIL),
-    _dirtyFlags(DIRTY_FLAG_INVERSE_WORLD)
+    _heightfield(NULL), _pager(NULL), _normalMap(NULL), _flags(FRUSTUM_CULLING | LEVEL_OF_DETAIL), _sharedVertices(false),
+    _pixelError(DEFAULT_TERRAIN_PIXEL_ERROR), _dirtyFlags(DIRTY_FLAG_INVERSE_WORLD)
 {
 }
 
 Terrain::~Terrain()
 {
+    SAFE_DELETE(_pager);
     for (size_t i = 0, count = _patches.size(); i < count; ++i)
     {
         SAFE_DELETE(_patches[i]);
@@ -89,7 +99,20 @@ Terrain* Terrain::create(const char* path, Properties* properties)
 
     // Read heightmap info
     Properties* pHeightmap = pTerrain->getNamespace("heightmap", true);
-    if (pHeightmap)
+    Properties* pPaging = pTerrain->getNamespace("paging", true);
+    unsigned int tileColumns = 0, tileRows = 0, tilesX = 0, tilesZ = 0;
+    if (pPaging)
+    {
+        // Paged terrains load heightmap tiles as they are needed, so only read the tile layout here
+        if (!pHeightmap || !TerrainPager::getLayout(pHeightmap, pPaging, &tileColumns, &tileRows, &tilesX, &tilesZ))
+        {
+            GP_WARN("Invalid heightmap or paging section in paged terrain definition: %s", path);
+            if (!externalProperties)
+                SAFE_DELETE(p);
+            return NULL;
+        }
+    }
+    else if (pHeightmap)
     {
         // Read heightmap path
         std::string heightmap;
@@ -198,7 +221,7 @@ Terrain* Terrain::create(const char* path, Properties* properties)
     // Read 'material'
     materialPath = pTerrain->getString("material", "");
 
-    if (heightfield == NULL)
+    if (heightfield == NULL && !pPaging)
     {
         GP_WARN("Failed to read heightfield heights for terrain definition: %s", path);
         if (!externalProperties)
@@ -206,14 +229,24 @@ Terrain* Terrain::create(const char* path, Properties* properties)
         return NULL;
     }
 
+    if (pPaging && normalMap)
+    {
+        GP_WARN("Normal maps are not supported for paged terrains; using vertex normals instead: %s", path);
+        normalMap = NULL;
+    }
+
+    // Number of height samples across the whole terrain
+    unsigned int columns = heightfield ? heightfield->getColumnCount() : tilesX * (tileColumns - 1) + 1;
+    unsigned int rows = heightfield ? heightfield->getRowCount() : tilesZ * (tileRows - 1) + 1;
+
     if (terrainSize.isZero())
     {
-        terrainSize.set(heightfield->getColumnCount(), getDefaultHeight(heightfield->getColumnCount(), heightfield->getRowCount()), heightfield->getRowCount());
+        terrainSize.set(columns, getDefaultHeight(columns, rows), rows);
     }
 
-    if (patchSize <= 0 || patchSize > (int)heightfield->getColumnCount() || patchSize > (int)heightfield->getRowCount())
+    if (patchSize <= 0 || patchSize > (int)columns || patchSize > (int)rows)
     {
-        patchSize = std::min(heightfield->getRowCount(), std::min(heightfield->getColumnCount(), DEFAULT_TERRAIN_PATCH_SIZE));
+        patchSize = std::min(rows, std::min(columns, DEFAULT_TERRAIN_PATCH_SIZE));
     }
 
     if (detailLevels <= 0)
@@ -223,11 +256,15 @@ Terrain* Terrain::create(const char* path, Properties* properties)
         skirtScale = 0;
 
     // Compute terrain scale
-    Vector3 scale(terrainSize.x / (heightfield->getColumnCount()-1), terrainSize.y, terrainSize.z / (heightfield->getRowCount()-1));
+    Vector3 scale(terrainSize.x / (columns-1), terrainSize.y, terrainSize.z / (rows-1));
 
     // Create terrain
     Terrain* terrain = create(heightfield, scale, (unsigned int)patchSize, (unsigned int)detailLevels, skirtScale, normalMap, materialPath.c_str(), pTerrain);
 
+    // Store 16-bit heights once the patches have been built from the float heights (if specified)
+    if (terrain && heightfield && pHeightmap && pHeightmap->getBool("quantized"))
+        heightfield->quantize();
+
     if (!externalProperties)
         SAFE_DELETE(p);
 
@@ -243,10 +280,7 @@ Terrain* Terrain::create(HeightField* heightfield, const Vector3& scale,
     unsigned int patchSize, unsigned int detailLevels, float skirtScale,
     const char* normalMapPath, const char* materialPath, Properties* properties)
 {
-    GP_ASSERT(heightfield);
-
-    unsigned int width = heightfield->getColumnCount();
-    unsigned int height = heightfield->getRowCount();
+    GP_ASSERT(heightfield || properties);
 
     // Create the terrain object
     Terrain* terrain = new Terrain();
@@ -256,6 +290,14 @@ Terrain* Terrain::create(HeightField* heightfield, const Vector3& scale,
     // Store terrain local scaling so it can be applied to the heightfield
     terrain->_localScale.set(scale);
 
+    // Build LOD levels as stitched index buffers over shared vertices (if specified)
+    if (properties)
+        terrain->_sharedVertices = properties->getBool("sharedVertices");
+
+    // Read the screen-space error allowed when selecting patch levels of detail (if specified)
+    if (properties && properties->exists("pixelError"))
+        terrain->_pixelError = std::max(0.0f, properties->getFloat("pixelError"));
+
     // Store reference to bounding box (it is calculated and updated from TerrainPatch)
     BoundingBox& bounds = terrain->_boundingBox;
 
@@ -265,33 +307,76 @@ Terrain* Terrain::create(HeightField* heightfield, const Vector3& scale,
         GP_ASSERT( terrain->_normalMap->getTexture()->getType() == Texture::TEXTURE_2D );
     }
 
-    float halfWidth = (width - 1) * 0.5f;
-    float halfHeight = (height - 1) * 0.5f;
-
     // Compute the maximum step size, which is a function of our lowest level of detail.
     // This determines how many vertices will be skipped per triange/quad on the lowest
     // level detail terrain patch.
     unsigned int maxStep = (unsigned int)std::pow(2.0, (double)(detailLevels-1));
 
-    // Create terrain patches
-    unsigned int x1, x2, z1, z2;
-    unsigned int row = 0, column = 0;
-    for (unsigned int z = 0; z < height-1; z = z2, ++row)
+    if (heightfield == NULL)
     {
-        z1 = z;
-        z2 = std::min(z1 + patchSize, height-1);
+        // Paged terrain: patches are built as tiles are loaded around the camera
+        terrain->_pager = TerrainPager::create(terrain, properties->getNamespace("heightmap", true),
+            properties->getNamespace("paging", true), patchSize, maxStep, skirtScale);
+        if (terrain->_pager == NULL)
+        {
+            SAFE_RELEASE(terrain);
+            return NULL;
+        }
+    }
+    else
+    {
+        unsigned int width = heightfield->getColumnCount();
+        unsigned int height = heightfield->getRowCount();
+        float halfWidth = (width - 1) * 0.5f;
+        float halfHeight = (height - 1) * 0.5f;
+
+        // Patches are built from float heights, so expand quantized heights while building them
+        std::vector<float> expandedHeights;
+        float* heights = heightfield->getArray();
+        if (heightfield->isQuantized())
+        {
+            const short* values = heightfield->getQuantizedArray();
+            expandedHeights.resize(width * height);
+            for (unsigned int i = 0, count = width * height; i < count; ++i)
+                expandedHeights[i] = heightfield->getQuantizedOffset() + values[i] * heightfield->getQuantizedScale();
+            heights = &expandedHeights[0];
+        }
 
-        for (unsigned int x = 0; x < width-1; x = x2, ++column)
+        // Create terrain patches
+        unsigned int x1, x2, z1, z2;
+        unsigned int row = 0, column = 0;
+        unsigned int patchColumns = 0;
+        for (unsigned int z = 0; z < height-1; z = z2, ++row)
         {
-            x1 = x;
-            x2 = std::min(x1 + patchSize, width-1);
+            z1 = z;
+            z2 = std::min(z1 + patchSize, height-1);
+
+            for (unsigned int x = 0; x < width-1; x = x2, ++column)
+            {
+                x1 = x;
+                x2 = std::min(x1 + patchSize, width-1);
+
+                // Create this patch
+                TerrainPatch* patch = TerrainPatch::create(terrain, terrain->_patches.size(), row, column, heights, width, height, x1, z1, x2, z2, -halfWidth, -halfHeight, maxStep, skirtScale);
+                terrain->_patches.push_back(patch);
 
-            // Create this patch
-            TerrainPatch* patch = TerrainPatch::create(terrain, terrain->_patches.size(), row, column, heightfield->getArray(), width, height, x1, z1, x2, z2, -halfWidth, -halfHeight, maxStep, skirtScale);
-            terrain->_patches.push_back(patch);
+                // Append the new patch's local bounds to the terrain local bounds
+                bounds.merge(patch->getBoundingBox(false));
+
+                if (row == 0)
+                    ++patchColumns;
+            }
+        }
 
-            // Append the new patch's local bounds to the terrain local bounds
-            bounds.merge(patch->getBoundingBox(false));
+        // Link neighboring patches (patches are stored row by row)
+        for (size_t i = 0, count = terrain->_patches.size(); i < count; ++i)
+        {
+            TerrainPatch* patch = terrain->_patches[i];
+            size_t patchColumn = i % patchColumns;
+            patch->_neighbors[TerrainPatch::EDGE_WEST] = patchColumn > 0 ? terrain->_patches[i - 1] : NULL;
+            patch->_neighbors[TerrainPatch::EDGE_EAST] = patchColumn + 1 < patchColumns ? terrain->_patches[i + 1] : NULL;
+            patch->_neighbors[TerrainPatch::EDGE_NORTH] = i >= patchColumns ? terrain->_patches[i - patchColumns] : NULL;
+            patch->_neighbors[TerrainPatch::EDGE_SOUTH] = i + patchColumns < count ? terrain->_patches[i + patchColumns] : NULL;
         }
     }
 
@@ -383,6 +468,10 @@ void Terrain::setNode(Node* node)
         if (_node)
             _node->removeListener(this);
 
+        // Tile collision nodes are recreated under the new node on the next update
+        if (_pager)
+            _pager->releaseCollision();
+
         Drawable::setNode(node);
 
         if (_node)
@@ -429,6 +518,10 @@ bool Terrain::setLayer(int index, const char* texturePath, const Vector2& textur
     if (!texturePath)
         return false;
 
+    // Remember the layer for tiles that are not loaded yet
+    if (_pager)
+        _pager->setLayer(index, texturePath, textureRepeat, blendPath, blendChannel, row, column);
+
     // Set layer on applicable patches
     bool result = true;
     for (size_t i = 0, count = _patches.size(); i < count; ++i)
@@ -497,39 +590,203 @@ const BoundingBox& Terrain::getBoundingBox() const
 
 float Terrain::getHeight(float x, float z) const
 {
+    float height;
+    getHeights(&x, &z, &height, 1);
+    return height;
+}
+
+void Terrain::getHeights(const float* x, const float* z, float* heights, unsigned int count) const
+{
+    GP_ASSERT(x && z && heights);
+
     // Calculate the correct x, z position relative to the heightfield data.
-    float cols = _heightfield->getColumnCount();
-    float rows = _heightfield->getRowCount();
+    float cols = _pager ? _pager->getColumnCount() : _heightfield->getColumnCount();
+    float rows = _pager ? _pager->getRowCount() : _heightfield->getRowCount();
 
     GP_ASSERT(cols > 0);
     GP_ASSERT(rows > 0);
 
-    // Since the specified coordinates are in world space, we need to use the 
+    // Heights are scaled by the local scale and the world scale of the terrain
+    float heightScale = _localScale.y;
+    if (_node)
+    {
+        Vector3 worldScale;
+        _node->getWorldMatrix().getScale(&worldScale);
+        heightScale *= worldScale.y;
+    }
+
+    // Since the specified coordinates are in world space, we need to use the
     // inverse of our world matrix to transform the world x,z coords back into
     // local heightfield coordinates for indexing into the height array.
-    Vector3 v = getInverseWorldMatrix() * Vector3(x, 0.0f, z);
-    x = v.x + (cols - 1) * 0.5f;
-    z = v.z + (rows - 1) * 0.5f;
+    const float* m = getInverseWorldMatrix().m;
+    float halfCols = (cols - 1) * 0.5f;
+    float halfRows = (rows - 1) * 0.5f;
+    float columns[TERRAIN_QUERY_BATCH_SIZE];
+    float batchRows[TERRAIN_QUERY_BATCH_SIZE];
+    for (unsigned int first = 0; first < count; first += TERRAIN_QUERY_BATCH_SIZE)
+    {
+        unsigned int batchCount = std::min(count - first, TERRAIN_QUERY_BATCH_SIZE);
+        for (unsigned int i = 0; i < batchCount; ++i)
+        {
+            columns[i] = m[0] * x[first + i] + m[8] * z[first + i] + m[12] + halfCols;
+            batchRows[i] = m[2] * x[first + i] + m[10] * z[first + i] + m[14] + halfRows;
+        }
 
-    // Get the unscaled height value from the HeightField
-    float height = _heightfield->getHeight(x, z);
+        // Get the unscaled height values from the HeightField
+        float* batchHeights = heights + first;
+        if (_pager)
+        {
+            // Heights of tiles that are not loaded are zero
+            for (unsigned int i = 0; i < batchCount; ++i)
+                batchHeights[i] = _pager->getHeight(columns[i], batchRows[i]);
+        }
+        else
+        {
+            _heightfield->getHeights(columns, batchRows, batchHeights, batchCount);
+        }
 
-    // Apply world scale to the height value
-    if (_node)
+        for (unsigned int i = 0; i < batchCount; ++i)
+            batchHeights[i] *= heightScale;
+    }
+}
+
+void Terrain::getNormals(const float* x, const float* z, Vector3* normals, unsigned int count) const
+{
+    GP_ASSERT(x && z && normals);
+
+    float cols = _pager ? _pager->getColumnCount() : _heightfield->getColumnCount();
+    float rows = _pager ? _pager->getRowCount() : _heightfield->getRowCount();
+
+    // The inverse world matrix maps world positions to heightfield columns, heights and rows,
+    // so its transpose maps heightfield normals back to world space.
+    const float* m = getInverseWorldMatrix().m;
+    float halfCols = (cols - 1) * 0.5f;
+    float halfRows = (rows - 1) * 0.5f;
+    float columns[TERRAIN_QUERY_BATCH_SIZE];
+    float batchRows[TERRAIN_QUERY_BATCH_SIZE];
+    for (unsigned int first = 0; first < count; first += TERRAIN_QUERY_BATCH_SIZE)
     {
-        Vector3 worldScale;
+        unsigned int batchCount = std::min(count - first, TERRAIN_QUERY_BATCH_SIZE);
+        for (unsigned int i = 0; i < batchCount; ++i)
+        {
+            columns[i] = m[0] * x[first + i] + m[8] * z[first + i] + m[12] + halfCols;
+            batchRows[i] = m[2] * x[first + i] + m[10] * z[first + i] + m[14] + halfRows;
+        }
+
+        Vector3* batchNormals = normals + first;
+        if (_pager)
+        {
+            for (unsigned int i = 0; i < batchCount; ++i)
+                batchNormals[i] = _pager->getNormal(columns[i], batchRows[i]);
+        }
+        else
+        {
+            _heightfield->getNormals(columns, batchRows, batchNormals, batchCount);
+        }
+
+        for (unsigned int i = 0; i < batchCount; ++i)
+        {
+            Vector3& n = batchNormals[i];
+            n.set(m[0] * n.x + m[1] * n.y + m[2] * n.z,
+                  m[4] * n.x + m[5] * n.y + m[6] * n.z,
+                  m[8] * n.x + m[9] * n.y + m[10] * n.z);
+            n.normalize();
+        }
+    }
+}
+
+bool Terrain::isPaged() const
+{
+    return _pager != NULL;
+}
+
+void Terrain::updatePaging(const Vector3& position)
+{
+    if (_pager == NULL)
+        return;
+
+    // Transform the position into height samples from the north west corner of the terrain
+    Vector3 v = getInverseWorldMatrix() * position;
+    _pager->update(v.x + (_pager->getColumnCount() - 1) * 0.5f, v.z + (_pager->getRowCount() - 1) * 0.5f);
+}
+
+size_t Terrain::getGeometryMemoryUsage() const
+{
+    size_t size = 0;
+    for (size_t i = 0, count = _patches.size(); i < count; ++i)
+    {
+        size += _patches[i]->_geometryMemoryUsage;
+    }
+    return size;
+}
+
+void Terrain::updateLevels()
+{
+    Scene* scene = _node ? _node->getScene() : NULL;
+    Camera* camera = scene ? scene->getActiveCamera() : NULL;
+    if (!camera || !camera->getNode())
+        return;
+
+    // Pixels covered by one unit of world-space height error, at unit distance for perspective
+    // cameras. The geometric error of each level is stored in local units, so the vertical
+    // scale of the terrain node is applied here once for all patches.
+    Vector3 worldScale(Vector3::one());
+    if (_node)
         _node->getWorldMatrix().getScale(&worldScale);
-        height *= worldScale.y;
+    bool perspective = camera->getCameraType() == Camera::PERSPECTIVE;
+    float viewportHeight = (float)Game::getInstance()->getHeight();
+    float errorScale;
+    if (perspective)
+        errorScale = viewportHeight / (2.0f * std::tan(MATH_DEG_TO_RAD(camera->getFieldOfView()) * 0.5f));
+    else
+        errorScale = viewportHeight / camera->getZoomY();
+    errorScale *= worldScale.y;
+
+    Vector3 cameraPosition = camera->getNode()->getTranslationWorld();
+    for (size_t i = 0, count = _patches.size(); i < count; ++i)
+    {
+        TerrainPatch* patch = _patches[i];
+        patch->_level = patch->computeLOD(cameraPosition, errorScale, perspective);
     }
 
-    // Apply local scale
-    height *= _localScale.y;
+    // Patches drawn from separate meshes per level need no further adjustment
+    if (!_sharedVertices)
+        return;
 
-    return height;
+    // Refine patches that are more than one level coarser than a neighbor until all
+    // neighbors are within one level (each pass can only lower levels, so this terminates).
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (size_t i = 0, count = _patches.size(); i < count; ++i)
+        {
+            TerrainPatch* patch = _patches[i];
+            for (unsigned int j = 0; j < TerrainPatch::EDGE_COUNT; ++j)
+            {
+                TerrainPatch* neighbor = patch->_neighbors[j];
+                if (neighbor && neighbor->_level > patch->_level + 1)
+                {
+                    neighbor->_level = patch->_level + 1;
+                    changed = true;
+                }
+            }
+        }
+    }
 }
 
 unsigned int Terrain::draw(bool wireframe)
 {
+    if (_pager)
+    {
+        Scene* scene = _node ? _node->getScene() : NULL;
+        Camera* camera = scene ? scene->getActiveCamera() : NULL;
+        if (camera && camera->getNode())
+            updatePaging(camera->getNode()->getTranslationWorld());
+    }
+
+    updateLevels();
+
     size_t visibleCount = 0;
     for (size_t i = 0, count = _patches.size(); i < count; ++i)
     {
@@ -14,6 +14,7 @@ namespace gameplay
 {
 
 class TerrainPatch;
+class TerrainPager;
 class TerrainAutoBindingResolver;
 
 /**
@@ -29,6 +30,10 @@ class TerrainAutoBindingResolver;
  *    compatible with many external tools such as World Machine, Unity and more. The file
  *    extension must be either .raw or .r16 for RAW files.
  *
+ * Setting the quantized property to true in the heightmap section of a terrain file stores the
+ * heights as 16-bit values once the terrain patches are built, which halves the memory used by
+ * the heightfield and by any heightfield collision shape created from it.
+ *
  * Physics/collision is supported by setting a rigid body collision object on the Node that
  * the terrain is attached to. The collision shape should be specified using
  * PhysicsCollisionShape::heightfield(), which will utilize the internal height array of the
@@ -61,8 +66,12 @@ class TerrainAutoBindingResolver;
  * flags.
  *
  * Level of detail (LOD) is supported using a technique that is similar to texture mipmapping.
- * A distance-to-camera based test, using a simple screen-space error metric is used to decide
- * the appropriate LOD for a terrain patch. The number of LOD levels is 1 by default (which
+ * The geometric error of each level (the largest height difference from the full resolution
+ * patch) is computed when the patch is built. Each frame, the terrain projects these errors to
+ * the screen using the distance from the camera to each patch and selects the coarsest level
+ * whose error stays within the pixelError property (4 pixels by default). A patch moves to a
+ * coarser level only once that level is well within the limit, which avoids popping back and
+ * forth near a threshold. The number of LOD levels is 1 by default (which
  * means only the base level is used), but can be specified via the detailLevels property.
  * Using too large a number for detailLevels can result in excessive popping in the distance
  * for very hilly terrains, so a smaller number (2-3) often works best in these cases.
@@ -79,6 +88,50 @@ class TerrainAutoBindingResolver;
  * approaches. In practice, the skirts are often not noticeable at all unless the LOD variation
  * is very large and the terrain is excessively hilly on the edge of a LOD transition.
  *
+ * Alternatively, setting the sharedVertices property to true in the terrain file builds each
+ * patch from a single full-resolution vertex buffer, with every LOD level expressed as an index
+ * buffer over those vertices. The edges of each level are stored both as is and stitched to the
+ * next coarser level, and the terrain keeps the LOD levels of neighboring patches within one of
+ * each other, so no cracks appear and no skirts are needed (skirtScale is ignored in this mode).
+ * This uses less memory than separate meshes per level and switching levels only changes the
+ * index ranges that are drawn.
+ *
+ * Terrains that are too large to keep in memory can be paged by adding a paging section to
+ * the terrain file. The heightmap path then names a grid of RAW or PNG tiles using {x} and {z}
+ * tokens for the tile column and row, and the heightmap size gives the number of height
+ * samples per tile (adjacent tiles share their border samples). Tiles within a radius of the
+ * camera are loaded on worker threads and their patches are built as the loads complete.
+ * Tiles outside the radius are kept until the memory budget is exceeded, after which the most
+ * distant ones are evicted first. getHeight returns zero over tiles that are not loaded, and
+ * when collision is enabled each loaded tile gets a static heightfield rigid body on a child
+ * node of the terrain's node. Texture coordinates span each tile rather than the whole
+ * terrain, and normal maps are not supported. Setting geometry to false pages only the tile
+ * heights and collision, without building patches, for terrains that are never drawn.
+ *
+ @verbatim
+    terrain
+    {
+        heightmap
+        {
+            path = res/terrain/tile_{x}_{z}.r16
+            size = 257, 257
+        }
+        paging
+        {
+            tiles = 32, 32      // tile columns and rows
+            radius = 1          // tiles kept loaded on each side of the camera's tile
+            memoryBudget = 256  // megabytes of tile heights and geometry
+            threads = 1         // worker threads loading tiles
+            tilesPerFrame = 1   // loaded tiles whose patches are built per frame
+            collision = true    // create heightfield rigid bodies for loaded tiles
+            geometry = true     // build patches for loaded tiles (false for heights and collision only)
+        }
+        size = 8192, 500, 8192
+        patchSize = 64
+        detailLevels = 3
+    }
+ @endverbatim
+ *
  * @see http://gameplay3d.github.io/GamePlay/docs/file-formats.html#wiki-Terrain
  */
 class Terrain : public Ref, public Drawable, private Transform::Listener
@@ -87,6 +140,7 @@ class Terrain : public Ref, public Drawable, private Transform::Listener
     friend class PhysicsController;
     friend class PhysicsRigidBody;
     friend class TerrainPatch;
+    friend class TerrainPager;
     friend class TerrainAutoBindingResolver;
 
 public:
@@ -192,6 +246,8 @@ public:
     /**
      * Gets the total number of terrain patches.
      *
+     * For paged terrains, only the patches of loaded tiles are counted.
+     *
      * @return The number of terrain patches.
      */
     unsigned int getPatchCount() const;
@@ -214,6 +270,7 @@ public:
      * The specified X and Z coordinates should be in world units and may fall between height values.
      * In this case, an interpolated value will be returned between neighboring heightfield heights.
      * If the specified point lies outside of the terrain, it is clamped to the terrain boundaries.
+     * For paged terrains, the height over tiles that are not loaded is zero.
      *
      * @param x The X coordinate, in world space.
      * @param z The Z coordinate, in world space.
@@ -222,6 +279,67 @@ public:
      */
     float getHeight(float x, float z) const;
 
+    /**
+     * Gets the world-space heights of the terrain at multiple positions on the X,Z plane.
+     *
+     * Each height is computed as in getHeight, but the positions are transformed and
+     * interpolated in batches, which is much faster than calling getHeight for each position.
+     *
+     * @param x The X coordinates, in world space.
+     * @param z The Z coordinates, in world space.
+     * @param heights Populated with the height at each position.
+     * @param count The number of positions.
+     *
+     * @script{ignore}
+     */
+    void getHeights(const float* x, const float* z, float* heights, unsigned int count) const;
+
+    /**
+     * Gets the world-space surface normals of the terrain at multiple positions on the X,Z plane.
+     *
+     * Positions outside of the terrain are clamped to the terrain boundaries. For paged terrains,
+     * the normal over tiles that are not loaded points along the terrain's up axis.
+     *
+     * @param x The X coordinates, in world space.
+     * @param z The Z coordinates, in world space.
+     * @param normals Populated with the unit length normal at each position.
+     * @param count The number of positions.
+     *
+     * @script{ignore}
+     */
+    void getNormals(const float* x, const float* z, Vector3* normals, unsigned int count) const;
+
+    /**
+     * Determines if this terrain loads its heightmap in tiles around the camera.
+     *
+     * @return True if the terrain is paged.
+     *
+     * @script{ignore}
+     */
+    bool isPaged() const;
+
+    /**
+     * Loads the tiles of a paged terrain around the specified position and evicts distant tiles.
+     *
+     * This is called with the active camera position when the terrain is drawn. Call it directly
+     * to page terrain that is not drawn, such as on a server that only needs heights and collision
+     * (with geometry set to false in the paging definition, so that no patches are built).
+     *
+     * @param position The position to load tiles around, in world space.
+     *
+     * @script{ignore}
+     */
+    void updatePaging(const Vector3& position);
+
+    /**
+     * Gets the memory used by the vertex and index data of all terrain patches.
+     *
+     * @return The size of the terrain geometry, in bytes.
+     *
+     * @script{ignore}
+     */
+    size_t getGeometryMemoryUsage() const;
+
     /**
      * Sets the detail textures information for a terrain layer.
      *
@@ -329,12 +447,22 @@ private:
      */
     BoundingBox getBoundingBox(bool worldSpace) const;
 
+    /**
+     * Selects the LOD level of all patches for the active camera in a single pass. For patches
+     * built from shared vertices, neighboring levels are then limited to one level of difference,
+     * as required for stitching.
+     */
+    void updateLevels();
+
     std::string _materialPath;
     HeightField* _heightfield;
+    TerrainPager* _pager;
     Vector3 _localScale;
     std::vector<TerrainPatch*> _patches;
     Texture::Sampler* _normalMap;
     unsigned int _flags;
+    bool _sharedVertices;
+    float _pixelError;
     mutable Matrix _inverseWorldMatrix;
     mutable unsigned int _dirtyFlags;
     BoundingBox _boundingBox;
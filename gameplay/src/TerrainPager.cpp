@@ -0,0 +1,574 @@
+#include "Base.h"
+#include "TerrainPager.h"
+#include "Terrain.h"
+#include "TerrainPatch.h"
+#include "Node.h"
+#include "FileSystem.h"
+
+namespace gameplay
+{
+
+// Default number of tiles kept loaded on each side of the tile containing the focus point.
+#define TERRAIN_PAGING_DEFAULT_RADIUS 1
+
+// Default memory budget for resident tiles, in megabytes.
+#define TERRAIN_PAGING_DEFAULT_MEMORY_BUDGET 256
+
+// Default number of loaded tiles whose patches are built per update.
+#define TERRAIN_PAGING_DEFAULT_TILES_PER_FRAME 1
+
+static int getTileDistance(int x, int z, int centerX, int centerZ)
+{
+    return std::max(std::abs(x - centerX), std::abs(z - centerZ));
+}
+
+static void replaceToken(std::string& str, const char* token, int value)
+{
+    char buffer[16];
+    sprintf(buffer, "%d", value);
+    size_t length = strlen(token);
+    for (size_t pos = str.find(token); pos != std::string::npos; pos = str.find(token, pos))
+    {
+        str.replace(pos, length, buffer);
+        pos += strlen(buffer);
+    }
+}
+
+TerrainPager::Tile::Tile()
+    : x(0), z(0), heightfield(NULL), collisionNode(NULL), memoryUsage(0), built(false), failed(false)
+{
+}
+
+TerrainPager::TerrainPager(Terrain* terrain)
+    : _terrain(terrain), _raw(false), _quantized(false), _tileColumns(0), _tileRows(0), _tilesX(0), _tilesZ(0),
+    _patchSize(0), _maxStep(1), _skirtScale(0), _radius(TERRAIN_PAGING_DEFAULT_RADIUS),
+    _memoryBudget(0), _tilesPerUpdate(TERRAIN_PAGING_DEFAULT_TILES_PER_FRAME), _collision(false), _geometry(true),
+    _budgetWarning(false), _loaderThreadsActive(true)
+{
+    _loaderMutex.reset(new std::mutex());
+    _loaderCondition.reset(new std::condition_variable());
+}
+
+TerrainPager::~TerrainPager()
+{
+    // Stop the loader threads
+    _loaderMutex->lock();
+    _loaderThreadsActive = false;
+    _requests.clear();
+    _loaderMutex->unlock();
+    _loaderCondition->notify_all();
+    for (size_t i = 0, count = _loaderThreads.size(); i < count; ++i)
+    {
+        _loaderThreads[i]->join();
+        SAFE_DELETE(_loaderThreads[i]);
+    }
+
+    for (size_t i = 0, count = _completed.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(_completed[i].heightfield);
+    }
+
+    while (!_tiles.empty())
+    {
+        evictTile(_tiles.begin()->second);
+    }
+    _terrain->_patches.clear();
+}
+
+bool TerrainPager::getLayout(Properties* heightmap, Properties* paging, unsigned int* tileColumns,
+                             unsigned int* tileRows, unsigned int* tilesX, unsigned int* tilesZ)
+{
+    GP_ASSERT(heightmap && paging);
+
+    Vector2 size;
+    if (!heightmap->getVector2("size", &size) || size.x < 2 || size.y < 2)
+    {
+        GP_WARN("Paged terrains require a 'size' attribute in the heightmap definition, giving the number of height samples per tile.");
+        return false;
+    }
+
+    Vector2 tiles;
+    if (!paging->getVector2("tiles", &tiles) || tiles.x < 1 || tiles.y < 1)
+    {
+        GP_WARN("Invalid or missing 'tiles' attribute in the paging definition of a terrain.");
+        return false;
+    }
+
+    if (tileColumns)
+        *tileColumns = (unsigned int)size.x;
+    if (tileRows)
+        *tileRows = (unsigned int)size.y;
+    if (tilesX)
+        *tilesX = (unsigned int)tiles.x;
+    if (tilesZ)
+        *tilesZ = (unsigned int)tiles.y;
+    return true;
+}
+
+TerrainPager* TerrainPager::create(Terrain* terrain, Properties* heightmap, Properties* paging,
+                                   unsigned int patchSize, unsigned int maxStep, float skirtScale)
+{
+    GP_ASSERT(terrain);
+
+    unsigned int tileColumns, tileRows, tilesX, tilesZ;
+    if (!getLayout(heightmap, paging, &tileColumns, &tileRows, &tilesX, &tilesZ))
+        return NULL;
+
+    // Tile paths contain {x} and {z} tokens, which are replaced by the tile column and row
+    const char* path = heightmap->getString("path");
+    if (path == NULL || strlen(path) == 0)
+    {
+        GP_WARN("No 'path' property supplied in heightmap section of paged terrain definition.");
+        return NULL;
+    }
+
+    std::string ext = FileSystem::getExtension(path);
+    if (ext != ".PNG" && ext != ".RAW" && ext != ".R16")
+    {
+        GP_WARN("Unsupported heightmap tile format ('%s') in paged terrain definition.", path);
+        return NULL;
+    }
+
+    TerrainPager* pager = new TerrainPager(terrain);
+    pager->_path = path;
+    pager->_raw = (ext != ".PNG");
+    pager->_quantized = heightmap->getBool("quantized");
+    pager->_tileColumns = tileColumns;
+    pager->_tileRows = tileRows;
+    pager->_tilesX = tilesX;
+    pager->_tilesZ = tilesZ;
+    pager->_patchSize = std::min(patchSize, std::min(tileColumns, tileRows) - 1);
+    pager->_maxStep = maxStep;
+    pager->_skirtScale = skirtScale;
+
+    if (paging->exists("radius"))
+        pager->_radius = std::max(0, paging->getInt("radius"));
+
+    int budget = paging->exists("memoryBudget") ? paging->getInt("memoryBudget") : TERRAIN_PAGING_DEFAULT_MEMORY_BUDGET;
+    pager->_memoryBudget = (size_t)std::max(0, budget) * 1024 * 1024;
+
+    if (paging->exists("tilesPerFrame"))
+        pager->_tilesPerUpdate = (unsigned int)std::max(1, paging->getInt("tilesPerFrame"));
+
+    pager->_collision = paging->getBool("collision");
+    pager->_geometry = paging->getBool("geometry", true);
+
+    // The terrain bounds cover every tile, since heights are normalized to [0,1]
+    const Vector3& scale = terrain->_localScale;
+    float halfWidth = (pager->getColumnCount() - 1) * 0.5f;
+    float halfHeight = (pager->getRowCount() - 1) * 0.5f;
+    terrain->_boundingBox.set(Vector3(-halfWidth * scale.x, 0, -halfHeight * scale.z),
+                              Vector3(halfWidth * scale.x, scale.y, halfHeight * scale.z));
+
+    // Start the loader threads
+    int threads = paging->exists("threads") ? std::max(1, paging->getInt("threads")) : 1;
+    for (int i = 0; i < threads; ++i)
+    {
+        pager->_loaderThreads.push_back(new std::thread(&loaderThreadProc, pager));
+    }
+
+    return pager;
+}
+
+unsigned int TerrainPager::getColumnCount() const
+{
+    return _tilesX * (_tileColumns - 1) + 1;
+}
+
+unsigned int TerrainPager::getRowCount() const
+{
+    return _tilesZ * (_tileRows - 1) + 1;
+}
+
+TerrainPager::Tile* TerrainPager::findTile(int x, int z) const
+{
+    std::map<unsigned int, Tile*>::const_iterator itr = _tiles.find(z * _tilesX + x);
+    return itr != _tiles.end() ? itr->second : NULL;
+}
+
+void TerrainPager::update(float x, float z)
+{
+    int centerX = std::max(0, std::min((int)_tilesX - 1, (int)std::floor(x / (_tileColumns - 1))));
+    int centerZ = std::max(0, std::min((int)_tilesZ - 1, (int)std::floor(z / (_tileRows - 1))));
+    bool changed = false;
+
+    // Take ownership of the tiles loaded since the last update
+    std::vector<Request> completed;
+    _loaderMutex->lock();
+    completed.swap(_completed);
+    _loaderMutex->unlock();
+
+    for (size_t i = 0, count = completed.size(); i < count; ++i)
+    {
+        Request& request = completed[i];
+        Tile* tile = findTile(request.x, request.z);
+        GP_ASSERT(tile);
+
+        HeightField* heightfield = request.heightfield;
+        if (heightfield && (heightfield->getColumnCount() != _tileColumns || heightfield->getRowCount() != _tileRows))
+        {
+            GP_WARN("Terrain tile (%d, %d) is %ux%u, but the terrain requires %ux%u tiles.", request.x, request.z,
+                heightfield->getColumnCount(), heightfield->getRowCount(), _tileColumns, _tileRows);
+            SAFE_RELEASE(heightfield);
+        }
+
+        // Failed tiles are remembered so they are not requested again while in range
+        tile->heightfield = heightfield;
+        tile->failed = (heightfield == NULL);
+        if (heightfield)
+            tile->memoryUsage += heightfield->getColumnCount() * heightfield->getRowCount() * sizeof(float);
+    }
+
+    // Request the missing tiles in range, nearest first
+    std::vector<Request> requests;
+    for (int tz = std::max(0, centerZ - _radius), tzEnd = std::min((int)_tilesZ - 1, centerZ + _radius); tz <= tzEnd; ++tz)
+    {
+        for (int tx = std::max(0, centerX - _radius), txEnd = std::min((int)_tilesX - 1, centerX + _radius); tx <= txEnd; ++tx)
+        {
+            if (findTile(tx, tz))
+                continue;
+
+            Tile* tile = new Tile();
+            tile->x = tx;
+            tile->z = tz;
+            _tiles[tz * _tilesX + tx] = tile;
+
+            Request request;
+            request.x = tx;
+            request.z = tz;
+            request.heightfield = NULL;
+            requests.push_back(request);
+        }
+    }
+    std::sort(requests.begin(), requests.end(), [&](const Request& lhs, const Request& rhs)
+    {
+        return (lhs.x - centerX) * (lhs.x - centerX) + (lhs.z - centerZ) * (lhs.z - centerZ) <
+               (rhs.x - centerX) * (rhs.x - centerX) + (rhs.z - centerZ) * (rhs.z - centerZ);
+    });
+
+    _loaderMutex->lock();
+
+    // Cancel queued loads of tiles that moved out of range
+    for (std::deque<Request>::iterator itr = _requests.begin(); itr != _requests.end(); )
+    {
+        if (getTileDistance(itr->x, itr->z, centerX, centerZ) > _radius)
+        {
+            unsigned int key = itr->z * _tilesX + itr->x;
+            SAFE_DELETE(_tiles[key]);
+            _tiles.erase(key);
+            itr = _requests.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+    _requests.insert(_requests.end(), requests.begin(), requests.end());
+    _loaderMutex->unlock();
+    if (!requests.empty())
+        _loaderCondition->notify_all();
+
+    // Build the patches of loaded tiles in range, nearest first
+    std::vector<Tile*> pending;
+    for (std::map<unsigned int, Tile*>::iterator itr = _tiles.begin(); itr != _tiles.end(); ++itr)
+    {
+        Tile* tile = itr->second;
+        if (tile->heightfield && !tile->built && getTileDistance(tile->x, tile->z, centerX, centerZ) <= _radius)
+            pending.push_back(tile);
+    }
+    std::sort(pending.begin(), pending.end(), [&](const Tile* lhs, const Tile* rhs)
+    {
+        return getTileDistance(lhs->x, lhs->z, centerX, centerZ) < getTileDistance(rhs->x, rhs->z, centerX, centerZ);
+    });
+    for (size_t i = 0, count = std::min(pending.size(), (size_t)_tilesPerUpdate); i < count; ++i)
+    {
+        buildTile(pending[i]);
+        changed = true;
+    }
+
+    // Create collision for built tiles (deferred until the terrain is attached to a node)
+    if (_collision && _terrain->_node)
+    {
+        for (std::map<unsigned int, Tile*>::iterator itr = _tiles.begin(); itr != _tiles.end(); ++itr)
+        {
+            Tile* tile = itr->second;
+            if (tile->built && tile->collisionNode == NULL)
+                createCollision(tile);
+        }
+    }
+
+    // Evict out of range tiles, farthest first, until the resident tiles fit the memory budget.
+    // Tiles still being loaded are left until their load completes.
+    size_t memoryUsage = 0;
+    std::vector<Tile*> evictable;
+    for (std::map<unsigned int, Tile*>::iterator itr = _tiles.begin(); itr != _tiles.end(); ++itr)
+    {
+        Tile* tile = itr->second;
+        memoryUsage += tile->memoryUsage;
+        if ((tile->heightfield || tile->failed) && getTileDistance(tile->x, tile->z, centerX, centerZ) > _radius)
+            evictable.push_back(tile);
+    }
+    std::sort(evictable.begin(), evictable.end(), [&](const Tile* lhs, const Tile* rhs)
+    {
+        return getTileDistance(lhs->x, lhs->z, centerX, centerZ) > getTileDistance(rhs->x, rhs->z, centerX, centerZ);
+    });
+    for (size_t i = 0, count = evictable.size(); i < count; ++i)
+    {
+        Tile* tile = evictable[i];
+        if (tile->failed || memoryUsage > _memoryBudget)
+        {
+            memoryUsage -= tile->memoryUsage;
+            changed |= !tile->patches.empty();
+            evictTile(tile);
+        }
+    }
+    if (memoryUsage > _memoryBudget && !_budgetWarning)
+    {
+        GP_WARN("Terrain tiles in range use %u KB, which exceeds the paging memory budget of %u KB.",
+            (unsigned int)(memoryUsage / 1024), (unsigned int)(_memoryBudget / 1024));
+        _budgetWarning = true;
+    }
+
+    if (changed)
+        updatePatches();
+}
+
+float TerrainPager::getHeight(float x, float z) const
+{
+    int tileX = std::max(0, std::min((int)_tilesX - 1, (int)(x / (_tileColumns - 1))));
+    int tileZ = std::max(0, std::min((int)_tilesZ - 1, (int)(z / (_tileRows - 1))));
+
+    Tile* tile = findTile(tileX, tileZ);
+    if (tile == NULL || tile->heightfield == NULL)
+        return 0.0f;
+
+    return tile->heightfield->getHeight(x - tileX * (float)(_tileColumns - 1), z - tileZ * (float)(_tileRows - 1));
+}
+
+Vector3 TerrainPager::getNormal(float x, float z) const
+{
+    int tileX = std::max(0, std::min((int)_tilesX - 1, (int)(x / (_tileColumns - 1))));
+    int tileZ = std::max(0, std::min((int)_tilesZ - 1, (int)(z / (_tileRows - 1))));
+
+    Vector3 normal(Vector3::unitY());
+    Tile* tile = findTile(tileX, tileZ);
+    if (tile && tile->heightfield)
+    {
+        float column = x - tileX * (float)(_tileColumns - 1);
+        float row = z - tileZ * (float)(_tileRows - 1);
+        tile->heightfield->getNormals(&column, &row, &normal, 1);
+    }
+    return normal;
+}
+
+void TerrainPager::setLayer(int index, const char* texturePath, const Vector2& textureRepeat,
+                            const char* blendPath, int blendChannel, int row, int column)
+{
+    GP_ASSERT(texturePath);
+
+    Layer layer;
+    layer.index = index;
+    layer.texturePath = texturePath;
+    layer.textureRepeat = textureRepeat;
+    layer.blendPath = blendPath ? blendPath : "";
+    layer.blendChannel = blendChannel;
+    layer.row = row;
+    layer.column = column;
+
+    // Replace an earlier layer set for the same patches
+    for (size_t i = 0, count = _layers.size(); i < count; ++i)
+    {
+        if (_layers[i].index == index && _layers[i].row == row && _layers[i].column == column)
+        {
+            _layers[i] = layer;
+            return;
+        }
+    }
+    _layers.push_back(layer);
+}
+
+void TerrainPager::buildTile(Tile* tile)
+{
+    GP_ASSERT(tile && tile->heightfield && !tile->built);
+    tile->built = true;
+
+    unsigned int width = _tileColumns;
+    unsigned int height = _tileRows;
+
+    // Terrains that are never drawn page only heights and collision, without patches
+    if (_geometry)
+    {
+        float xOffset = tile->x * (float)(width - 1) - (getColumnCount() - 1) * 0.5f;
+        float zOffset = tile->z * (float)(height - 1) - (getRowCount() - 1) * 0.5f;
+
+        // Patch rows and columns are numbered across the whole terrain
+        unsigned int patchColumns = (width - 2) / _patchSize + 1;
+        unsigned int patchRows = (height - 2) / _patchSize + 1;
+
+        unsigned int x1, x2, z1, z2;
+        unsigned int row = tile->z * patchRows;
+        for (unsigned int z = 0; z < height-1; z = z2, ++row)
+        {
+            z1 = z;
+            z2 = std::min(z1 + _patchSize, height-1);
+
+            unsigned int column = tile->x * patchColumns;
+            for (unsigned int x = 0; x < width-1; x = x2, ++column)
+            {
+                x1 = x;
+                x2 = std::min(x1 + _patchSize, width-1);
+
+                TerrainPatch* patch = TerrainPatch::create(_terrain, 0, row, column, tile->heightfield->getArray(), width, height,
+                    x1, z1, x2, z2, xOffset, zOffset, _maxStep, _skirtScale);
+
+                for (size_t i = 0, count = _layers.size(); i < count; ++i)
+                {
+                    const Layer& layer = _layers[i];
+                    if ((layer.row == -1 || layer.row == (int)row) && (layer.column == -1 || layer.column == (int)column))
+                    {
+                        patch->setLayer(layer.index, layer.texturePath.c_str(), layer.textureRepeat,
+                            layer.blendPath.empty() ? NULL : layer.blendPath.c_str(), layer.blendChannel);
+                    }
+                }
+                patch->updateMaterial();
+
+                tile->patches.push_back(patch);
+                tile->memoryUsage += patch->_geometryMemoryUsage;
+            }
+        }
+    }
+
+    // Keep 16-bit heights once the patches are built (if specified)
+    if (_quantized)
+    {
+        tile->heightfield->quantize();
+        tile->memoryUsage -= width * height * (sizeof(float) - sizeof(short));
+    }
+}
+
+void TerrainPager::createCollision(Tile* tile)
+{
+    GP_ASSERT(tile && tile->heightfield && _terrain->_node);
+
+    char id[64];
+    sprintf(id, "terrainTile_%d_%d", tile->x, tile->z);
+    Node* node = Node::create(id);
+
+    // Heightfield collision shapes are centered on their node, so place the node at the
+    // tile center and scale it by the terrain's local scale.
+    const Vector3& scale = _terrain->_localScale;
+    float centerX = (tile->x + 0.5f) * (_tileColumns - 1) - (getColumnCount() - 1) * 0.5f;
+    float centerZ = (tile->z + 0.5f) * (_tileRows - 1) - (getRowCount() - 1) * 0.5f;
+    node->setTranslation(centerX * scale.x, 0, centerZ * scale.z);
+    node->setScale(scale);
+    _terrain->_node->addChild(node);
+
+    PhysicsRigidBody::Parameters parameters;
+    node->setCollisionObject(PhysicsCollisionObject::RIGID_BODY, PhysicsCollisionShape::heightfield(tile->heightfield), &parameters);
+
+    tile->collisionNode = node;
+}
+
+void TerrainPager::releaseCollision()
+{
+    for (std::map<unsigned int, Tile*>::iterator itr = _tiles.begin(); itr != _tiles.end(); ++itr)
+    {
+        Node* node = itr->second->collisionNode;
+        if (node)
+        {
+            if (node->getParent())
+                node->getParent()->removeChild(node);
+            SAFE_RELEASE(itr->second->collisionNode);
+        }
+    }
+}
+
+void TerrainPager::evictTile(Tile* tile)
+{
+    GP_ASSERT(tile);
+
+    Node* node = tile->collisionNode;
+    if (node && node->getParent())
+        node->getParent()->removeChild(node);
+    SAFE_RELEASE(tile->collisionNode);
+
+    for (size_t i = 0, count = tile->patches.size(); i < count; ++i)
+    {
+        SAFE_DELETE(tile->patches[i]);
+    }
+    SAFE_RELEASE(tile->heightfield);
+
+    _tiles.erase(tile->z * _tilesX + tile->x);
+    SAFE_DELETE(tile);
+}
+
+void TerrainPager::updatePatches()
+{
+    unsigned int patchColumns = ((_tileColumns - 2) / _patchSize + 1) * _tilesX;
+
+    std::vector<TerrainPatch*>& patches = _terrain->_patches;
+    patches.clear();
+    std::unordered_map<unsigned int, TerrainPatch*> grid;
+    for (std::map<unsigned int, Tile*>::iterator itr = _tiles.begin(); itr != _tiles.end(); ++itr)
+    {
+        Tile* tile = itr->second;
+        for (size_t i = 0, count = tile->patches.size(); i < count; ++i)
+        {
+            TerrainPatch* patch = tile->patches[i];
+            patch->_index = patches.size();
+            patches.push_back(patch);
+            grid[patch->_row * patchColumns + patch->_column] = patch;
+        }
+    }
+
+    // Link neighboring patches, including those of adjacent tiles
+    for (size_t i = 0, count = patches.size(); i < count; ++i)
+    {
+        TerrainPatch* patch = patches[i];
+        unsigned int key = patch->_row * patchColumns + patch->_column;
+        std::unordered_map<unsigned int, TerrainPatch*>::const_iterator itr;
+        patch->_neighbors[TerrainPatch::EDGE_WEST] = patch->_column > 0 && (itr = grid.find(key - 1)) != grid.end() ? itr->second : NULL;
+        patch->_neighbors[TerrainPatch::EDGE_EAST] = patch->_column + 1 < patchColumns && (itr = grid.find(key + 1)) != grid.end() ? itr->second : NULL;
+        patch->_neighbors[TerrainPatch::EDGE_NORTH] = patch->_row > 0 && (itr = grid.find(key - patchColumns)) != grid.end() ? itr->second : NULL;
+        patch->_neighbors[TerrainPatch::EDGE_SOUTH] = (itr = grid.find(key + patchColumns)) != grid.end() ? itr->second : NULL;
+    }
+}
+
+HeightField* TerrainPager::loadTile(int x, int z) const
+{
+    std::string path = _path;
+    replaceToken(path, "{x}", x);
+    replaceToken(path, "{z}", z);
+
+    // Read normalized height values from the tile
+    if (_raw)
+        return HeightField::createFromRAW(path.c_str(), _tileColumns, _tileRows, 0, 1);
+    return HeightField::createFromImage(path.c_str(), 0, 1);
+}
+
+void TerrainPager::loaderThreadProc(void* arg)
+{
+    GP_ASSERT(arg);
+    TerrainPager* pager = (TerrainPager*)arg;
+
+    std::unique_lock<std::mutex> lock(*pager->_loaderMutex);
+    while (true)
+    {
+        while (pager->_loaderThreadsActive && pager->_requests.empty())
+            pager->_loaderCondition->wait(lock);
+        if (!pager->_loaderThreadsActive)
+            break;
+
+        Request request = pager->_requests.front();
+        pager->_requests.pop_front();
+
+        // Load without holding the lock so the game thread and other loaders are not blocked
+        lock.unlock();
+        request.heightfield = pager->loadTile(request.x, request.z);
+        lock.lock();
+
+        pager->_completed.push_back(request);
+    }
+}
+
+}
@@ -0,0 +1,196 @@
+#ifndef TERRAINPAGER_H_
+#define TERRAINPAGER_H_
+
+#include "HeightField.h"
+#include "Properties.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+namespace gameplay
+{
+
+class Terrain;
+class TerrainPatch;
+class Node;
+
+/**
+ * Streams the tiles of a paged terrain in and out around a focus point.
+ *
+ * Tile heightmaps are loaded on worker threads. Once loaded, the patches of a tile
+ * are built on the thread that updates the terrain (since they create GPU resources),
+ * unless geometry is disabled, and, if enabled, a static heightfield rigid body is
+ * created for the tile. Tiles
+ * outside the load radius are kept until the memory budget is exceeded, at which
+ * point the most distant ones are evicted first.
+ *
+ * @script{ignore}
+ */
+class TerrainPager
+{
+    friend class Terrain;
+
+private:
+
+    /**
+     * A tile of the paged terrain.
+     */
+    struct Tile
+    {
+        Tile();
+
+        int x;
+        int z;
+        HeightField* heightfield;
+        std::vector<TerrainPatch*> patches;
+        Node* collisionNode;
+        size_t memoryUsage;
+        bool built;
+        bool failed;
+    };
+
+    /**
+     * A tile load handed to the worker threads.
+     */
+    struct Request
+    {
+        int x;
+        int z;
+        HeightField* heightfield;
+    };
+
+    /**
+     * A layer set on the terrain, applied to the patches of tiles as they are built.
+     */
+    struct Layer
+    {
+        int index;
+        std::string texturePath;
+        Vector2 textureRepeat;
+        std::string blendPath;
+        int blendChannel;
+        int row;
+        int column;
+    };
+
+    /**
+     * Constructor.
+     */
+    TerrainPager(Terrain* terrain);
+
+    /**
+     * Hidden copy constructor.
+     */
+    TerrainPager(const TerrainPager&);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    TerrainPager& operator=(const TerrainPager&);
+
+    /**
+     * Destructor.
+     */
+    ~TerrainPager();
+
+    /**
+     * Creates a pager for the given terrain from the heightmap and paging sections of
+     * a terrain definition.
+     *
+     * @return The new pager, or NULL if the definition is invalid.
+     */
+    static TerrainPager* create(Terrain* terrain, Properties* heightmap, Properties* paging,
+                                unsigned int patchSize, unsigned int maxStep, float skirtScale);
+
+    /**
+     * Reads the tile layout of a paged terrain definition without creating a pager.
+     *
+     * @return True if the layout is valid.
+     */
+    static bool getLayout(Properties* heightmap, Properties* paging, unsigned int* tileColumns,
+                          unsigned int* tileRows, unsigned int* tilesX, unsigned int* tilesZ);
+
+    /**
+     * Loads and builds the tiles around the given position and evicts distant tiles.
+     *
+     * @param x The X position, in height samples from the west edge of the terrain.
+     * @param z The Z position, in height samples from the north edge of the terrain.
+     */
+    void update(float x, float z);
+
+    /**
+     * Returns the normalized height at the given position, or zero if the tile
+     * containing the position is not loaded.
+     */
+    float getHeight(float x, float z) const;
+
+    /**
+     * Returns the heightfield normal at the given position, or the up vector if the tile
+     * containing the position is not loaded.
+     */
+    Vector3 getNormal(float x, float z) const;
+
+    /**
+     * Returns the number of height samples along the X axis of the whole terrain.
+     */
+    unsigned int getColumnCount() const;
+
+    /**
+     * Returns the number of height samples along the Z axis of the whole terrain.
+     */
+    unsigned int getRowCount() const;
+
+    /**
+     * Records a layer so that it is also applied to tiles built later.
+     */
+    void setLayer(int index, const char* texturePath, const Vector2& textureRepeat,
+                  const char* blendPath, int blendChannel, int row, int column);
+
+    /**
+     * Removes the collision nodes of all tiles from the terrain's node.
+     */
+    void releaseCollision();
+
+    Tile* findTile(int x, int z) const;
+
+    void buildTile(Tile* tile);
+
+    void createCollision(Tile* tile);
+
+    void evictTile(Tile* tile);
+
+    void updatePatches();
+
+    HeightField* loadTile(int x, int z) const;
+
+    static void loaderThreadProc(void* arg);
+
+    Terrain* _terrain;
+    std::string _path;
+    bool _raw;
+    bool _quantized;
+    unsigned int _tileColumns;
+    unsigned int _tileRows;
+    unsigned int _tilesX;
+    unsigned int _tilesZ;
+    unsigned int _patchSize;
+    unsigned int _maxStep;
+    float _skirtScale;
+    int _radius;
+    size_t _memoryBudget;
+    unsigned int _tilesPerUpdate;
+    bool _collision;
+    bool _geometry;
+    std::map<unsigned int, Tile*> _tiles;
+    std::vector<Layer> _layers;
+    bool _budgetWarning;
+    bool _loaderThreadsActive;
+    std::deque<Request> _requests;
+    std::vector<Request> _completed;
+    std::vector<std::thread*> _loaderThreads;
+    std::unique_ptr<std::mutex> _loaderMutex;
+    std::unique_ptr<std::condition_variable> _loaderCondition;
+};
+
+}
+
+#endif
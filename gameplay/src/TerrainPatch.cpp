@@ -15,8 +15,11 @@ template <class T> T clamp(T value, T min, T max) { return value < min ? min : (
 
 #define TERRAINPATCH_DIRTY_MATERIAL 1
 #define TERRAINPATCH_DIRTY_BOUNDS 2
-#define TERRAINPATCH_DIRTY_LEVEL 4
-#define TERRAINPATCH_DIRTY_ALL (TERRAINPATCH_DIRTY_MATERIAL | TERRAINPATCH_DIRTY_BOUNDS | TERRAINPATCH_DIRTY_LEVEL)
+#define TERRAINPATCH_DIRTY_ALL (TERRAINPATCH_DIRTY_MATERIAL | TERRAINPATCH_DIRTY_BOUNDS)
+
+// A patch only switches to a coarser level once the level's projected error is below this
+// fraction of the terrain's pixel error, which keeps patches near a threshold from popping.
+#define TERRAINPATCH_LOD_HYSTERESIS 0.75f
 
 /**
  * Custom material auto-binding resolver for terrain.
@@ -30,8 +33,10 @@ static TerrainAutoBindingResolver __autoBindingResolver;
 static int __currentPatchIndex = -1;
 
 TerrainPatch::TerrainPatch() :
-    _terrain(NULL), _row(0), _column(0), _camera(NULL), _level(0), _bits(TERRAINPATCH_DIRTY_ALL)
+    _terrain(NULL), _row(0), _column(0), _geometryMemoryUsage(0), _level(0), _bits(TERRAINPATCH_DIRTY_ALL)
 {
+    for (unsigned int i = 0; i < EDGE_COUNT; ++i)
+        _neighbors[i] = NULL;
 }
 
 TerrainPatch::~TerrainPatch()
@@ -48,7 +53,6 @@ TerrainPatch::~TerrainPatch()
     {
         deleteLayer(*_layers.begin());
     }
-    SAFE_RELEASE(_camera);
 }
 
 TerrainPatch* TerrainPatch::create(Terrain* terrain, unsigned int index,
@@ -66,10 +70,22 @@ TerrainPatch* TerrainPatch::create(Terrain* terrain, unsigned int index,
     patch->_column = column;
 
     // Add patch lods
-    for (unsigned int step = 1; step <= maxStep; step *= 2)
+    if (terrain->_sharedVertices)
     {
-        patch->addLOD(heights, width, height, x1, z1, x2, z2, xOffset, zOffset, step, verticalSkirtSize);
+        patch->addSharedLODs(heights, width, height, x1, z1, x2, z2, xOffset, zOffset, maxStep);
     }
+    else
+    {
+        for (unsigned int step = 1; step <= maxStep; step *= 2)
+        {
+            patch->addLOD(heights, width, height, x1, z1, x2, z2, xOffset, zOffset, step, verticalSkirtSize);
+        }
+    }
+
+    // Coarser levels never have less error than finer ones, so level selection can stop
+    // at the coarsest acceptable level.
+    for (size_t i = 1, count = patch->_levels.size(); i < count; ++i)
+        patch->_levels[i]->error = std::max(patch->_levels[i]->error, patch->_levels[i - 1]->error);
 
     // Set our bounding box using the base LOD mesh
     BoundingBox& bounds = patch->_boundingBox;
@@ -87,21 +103,42 @@ Material* TerrainPatch::getMaterial(int index) const
 {
     if (index == -1)
     {
-        Scene* scene = _terrain->_node ? _terrain->_node->getScene() : NULL;
-        Camera* camera = scene ? scene->getActiveCamera() : NULL;
-        if (!camera)
-        {
-            _level = const_cast<TerrainPatch*>(this)->computeLOD(camera, getBoundingBox(true));
-        }
-        else
-        {
-            _level = 0;
-        }
+        // The current level is selected by the terrain each time it is drawn
         return _levels[_level]->model->getMaterial();
     }
     return _levels[index]->model->getMaterial();
 }
 
+// Returns the largest vertical distance between the heights of a patch and the surface
+// interpolated from every step-th height (the last row and column end on the patch edge).
+static float computeGeometricError(const float* heights, unsigned int width,
+                                   unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2, unsigned int step)
+{
+    float error = 0.0f;
+    if (step == 1)
+        return error;
+
+    for (unsigned int z = z1; z <= z2; ++z)
+    {
+        unsigned int za = z1 + ((z - z1) / step) * step;
+        unsigned int zb = std::min(za + step, z2);
+        float tz = zb > za ? (float)(z - za) / (zb - za) : 0.0f;
+
+        for (unsigned int x = x1; x <= x2; ++x)
+        {
+            unsigned int xa = x1 + ((x - x1) / step) * step;
+            unsigned int xb = std::min(xa + step, x2);
+            float tx = xb > xa ? (float)(x - xa) / (xb - xa) : 0.0f;
+
+            float north = heights[za * width + xa] + (heights[za * width + xb] - heights[za * width + xa]) * tx;
+            float south = heights[zb * width + xa] + (heights[zb * width + xb] - heights[zb * width + xa]) * tx;
+            float interpolated = north + (south - north) * tz;
+            error = std::max(error, std::fabs(heights[z * width + x] - interpolated));
+        }
+    }
+    return error;
+}
+
 void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int height,
                           unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
                           float xOffset, float zOffset,
@@ -136,8 +173,6 @@ void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int heigh
     unsigned int index = 0;
     Vector3 min(FLT_MAX, FLT_MAX, FLT_MAX);
     Vector3 max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
-    float stepXScaled = step * _terrain->_localScale.x;
-    float stepZScaled = step * _terrain->_localScale.z;
     bool zskirt = verticalSkirtSize > 0 ? true : false;
     for (unsigned int z = z1; ; )
     {
@@ -176,18 +211,7 @@ void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int heigh
             // Compute normal
             if (!_terrain->_normalMap)
             {
-                Vector3 p(v[0], computeHeight(heights, width, x, z), v[2]);
-                Vector3 w(Vector3(x>=step ? v[0]-stepXScaled : v[0], computeHeight(heights, width, x>=step ? x-step : x, z), v[2]), p);
-                Vector3 e(Vector3(x<width-step ? v[0]+stepXScaled : v[0], computeHeight(heights, width, x<width-step ? x+step : x, z), v[2]), p);
-                Vector3 s(Vector3(v[0], computeHeight(heights, width, x, z>=step ? z-step : z), z>=step ? v[2]-stepZScaled : v[2]), p);
-                Vector3 n(Vector3(v[0], computeHeight(heights, width, x, z<height-step ? z+step : z), z<height-step ? v[2]+stepZScaled : v[2]), p);
-                Vector3 normals[4];
-                Vector3::cross(n, w, &normals[0]);
-                Vector3::cross(w, s, &normals[1]);
-                Vector3::cross(e, n, &normals[2]);
-                Vector3::cross(s, e, &normals[3]);
-                Vector3 normal = -(normals[0] + normals[1] + normals[2] + normals[3]);
-                normal.normalize();
+                Vector3 normal = computeNormal(heights, width, height, x, z, step, v[0], v[2]);
                 v[3] = normal.x;
                 v[4] = normal.y;
                 v[5] = normal.z;
@@ -332,6 +356,8 @@ void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int heigh
     SAFE_DELETE_ARRAY(vertices);
     SAFE_DELETE_ARRAY(indices);
 
+    _geometryMemoryUsage += vertexCount * vertexElements * sizeof(float) + indexCount * sizeof(unsigned short);
+
     // Create model
     Model* model = Model::create(mesh);
     mesh->release();
@@ -339,9 +365,238 @@ void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int heigh
     // Add this level
     Level* level = new Level();
     level->model = model;
+    level->error = computeGeometricError(heights, width, x1, z1, x2, z2, step) * _terrain->_localScale.y;
     _levels.push_back(level);
 }
 
+void TerrainPatch::addSharedLODs(float* heights, unsigned int width, unsigned int height,
+                                 unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
+                                 float xOffset, float zOffset, unsigned int maxStep)
+{
+    // All levels share the full resolution vertices of the patch. Vertical skirts are not
+    // needed since neighboring levels are stitched together.
+    unsigned int patchWidth = (x2 - x1) + 1;
+    unsigned int patchHeight = (z2 - z1) + 1;
+    unsigned int vertexCount = patchHeight * patchWidth;
+    if (vertexCount > USHRT_MAX + 1)
+    {
+        GP_WARN("Vertex count of %d for terrain patch exceeds the limit of 65536. Please specifiy a smaller patch size.", vertexCount);
+        GP_ASSERT(vertexCount <= USHRT_MAX + 1);
+    }
+
+    unsigned int vertexElements = _terrain->_normalMap ? 5 : 8; //<x,y,z>[i,j,k]<u,v>
+    float* vertices = new float[vertexCount * vertexElements];
+    Vector3 min(FLT_MAX, FLT_MAX, FLT_MAX);
+    Vector3 max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    float* v = vertices;
+    for (unsigned int z = z1; z <= z2; ++z)
+    {
+        for (unsigned int x = x1; x <= x2; ++x)
+        {
+            // Compute position - apply the local scale of the terrain into the vertex data
+            v[0] = (x + xOffset) * _terrain->_localScale.x;
+            v[1] = computeHeight(heights, width, x, z);
+            v[2] = (z + zOffset) * _terrain->_localScale.z;
+
+            min.set(std::min(min.x, v[0]), std::min(min.y, v[1]), std::min(min.z, v[2]));
+            max.set(std::max(max.x, v[0]), std::max(max.y, v[1]), std::max(max.z, v[2]));
+
+            // Compute normal
+            if (!_terrain->_normalMap)
+            {
+                Vector3 normal = computeNormal(heights, width, height, x, z, 1, v[0], v[2]);
+                v[3] = normal.x;
+                v[4] = normal.y;
+                v[5] = normal.z;
+                v += 3;
+            }
+
+            v += 3;
+
+            // Compute texture coord
+            v[0] = (float)x / width;
+            v[1] = 1.0f - (float)z / height;
+            v += 2;
+        }
+    }
+
+    Vector3 center(min + ((max - min) * 0.5f));
+
+    // Create mesh
+    VertexFormat::Element elements[3];
+    elements[0] = VertexFormat::Element(VertexFormat::POSITION, 3);
+    if (_terrain->_normalMap)
+    {
+        elements[1] = VertexFormat::Element(VertexFormat::TEXCOORD0, 2);
+    }
+    else
+    {
+        elements[1] = VertexFormat::Element(VertexFormat::NORMAL, 3);
+        elements[2] = VertexFormat::Element(VertexFormat::TEXCOORD0, 2);
+    }
+    VertexFormat format(elements, _terrain->_normalMap ? 2 : 3);
+    Mesh* mesh = Mesh::createMesh(format, vertexCount);
+    mesh->setVertexData(vertices);
+    mesh->setBoundingBox(BoundingBox(min, max));
+    mesh->setBoundingSphere(BoundingSphere(center, center.distance(max)));
+    SAFE_DELETE_ARRAY(vertices);
+
+    _geometryMemoryUsage += vertexCount * vertexElements * sizeof(float);
+
+    // Add one mesh part per level. Each level gets its own model (and material) over the shared mesh,
+    // but only the level's own part is ever drawn (see drawStitched).
+    std::vector<unsigned short> indices;
+    for (unsigned int step = 1; step <= maxStep; step *= 2)
+    {
+        Level* level = new Level();
+        level->error = computeGeometricError(heights, width, x1, z1, x2, z2, step) * _terrain->_localScale.y;
+        generateStitchedIndices(patchWidth, patchHeight, step, &indices, &level->ranges);
+
+        MeshPart* part = mesh->addPart(Mesh::TRIANGLES, Mesh::INDEX16, (unsigned int)indices.size());
+        part->setIndexData(&indices[0], 0, (unsigned int)indices.size());
+        _geometryMemoryUsage += indices.size() * sizeof(unsigned short);
+
+        _levels.push_back(level);
+    }
+
+    // Create the models once all the parts exist.
+    for (size_t i = 0, count = _levels.size(); i < count; ++i)
+    {
+        _levels[i]->model = Model::create(mesh);
+    }
+    mesh->release();
+}
+
+// Snaps a sample position on a patch edge to the nearest position of the next coarser level.
+static unsigned int snapToCoarserLevel(unsigned int position, unsigned int step, unsigned int last)
+{
+    unsigned int coarseStep = step * 2;
+    unsigned int lower = (position / coarseStep) * coarseStep;
+    unsigned int upper = std::min(lower + coarseStep, last);
+    return (position - lower <= upper - position) ? lower : upper;
+}
+
+void TerrainPatch::generateStitchedIndices(unsigned int columns, unsigned int rows, unsigned int step,
+                                           std::vector<unsigned short>* indices, std::vector<IndexRange>* ranges)
+{
+    GP_ASSERT(columns >= 2 && rows >= 2 && step > 0);
+    GP_ASSERT(indices);
+    GP_ASSERT(ranges);
+
+    const unsigned int lastX = columns - 1;
+    const unsigned int lastZ = rows - 1;
+
+    // Sample positions of this level (the last row and column always end on the patch edge).
+    std::vector<unsigned int> xs, zs;
+    for (unsigned int x = 0; ; x = std::min(x + step, lastX))
+    {
+        xs.push_back(x);
+        if (x == lastX)
+            break;
+    }
+    for (unsigned int z = 0; ; z = std::min(z + step, lastZ))
+    {
+        zs.push_back(z);
+        if (z == lastZ)
+            break;
+    }
+    const unsigned int cellsX = (unsigned int)xs.size() - 1;
+    const unsigned int cellsZ = (unsigned int)zs.size() - 1;
+
+    // Triangles are bucketed by (edge mask, stitch bits).
+    std::map<std::pair<unsigned int, unsigned int>, std::vector<unsigned short> > buckets;
+
+    for (unsigned int j = 0; j < cellsZ; ++j)
+    {
+        for (unsigned int i = 0; i < cellsX; ++i)
+        {
+            unsigned int cx[4] = { xs[i], xs[i + 1], xs[i], xs[i + 1] };
+            unsigned int cz[4] = { zs[j], zs[j], zs[j + 1], zs[j + 1] };
+
+            // Split each cell along the diagonal that points towards the patch center, so the
+            // corner cells are split through the corner vertex and each of their triangles
+            // touches a single edge.
+            static const unsigned int mainDiagonal[6] = { 0, 2, 3, 0, 3, 1 };
+            static const unsigned int antiDiagonal[6] = { 0, 2, 1, 1, 2, 3 };
+            const unsigned int* corners = ((2 * i + 1 < cellsX) == (2 * j + 1 < cellsZ)) ? mainDiagonal : antiDiagonal;
+
+            for (unsigned int t = 0; t < 6; t += 3)
+            {
+                unsigned int tx[3], tz[3];
+                unsigned int mask = 0;
+                for (unsigned int k = 0; k < 3; ++k)
+                {
+                    tx[k] = cx[corners[t + k]];
+                    tz[k] = cz[corners[t + k]];
+
+                    // Find the edge (if any) that would move this vertex when stitched.
+                    if (tx[k] == 0 && snapToCoarserLevel(tz[k], step, lastZ) != tz[k])
+                        mask |= 1 << EDGE_WEST;
+                    else if (tx[k] == lastX && snapToCoarserLevel(tz[k], step, lastZ) != tz[k])
+                        mask |= 1 << EDGE_EAST;
+                    else if (tz[k] == 0 && snapToCoarserLevel(tx[k], step, lastX) != tx[k])
+                        mask |= 1 << EDGE_NORTH;
+                    else if (tz[k] == lastZ && snapToCoarserLevel(tx[k], step, lastX) != tx[k])
+                        mask |= 1 << EDGE_SOUTH;
+                }
+
+                // Emit the triangle for every combination of stitched edges it depends on.
+                for (unsigned int stitch = 0; stitch <= mask; ++stitch)
+                {
+                    if ((stitch & mask) != stitch)
+                        continue;
+
+                    unsigned short triangle[3];
+                    for (unsigned int k = 0; k < 3; ++k)
+                    {
+                        unsigned int x = tx[k];
+                        unsigned int z = tz[k];
+                        if ((x == 0 && (stitch & (1 << EDGE_WEST))) || (x == lastX && (stitch & (1 << EDGE_EAST))))
+                            z = snapToCoarserLevel(z, step, lastZ);
+                        else if ((z == 0 && (stitch & (1 << EDGE_NORTH))) || (z == lastZ && (stitch & (1 << EDGE_SOUTH))))
+                            x = snapToCoarserLevel(x, step, lastX);
+                        triangle[k] = (unsigned short)(z * columns + x);
+                    }
+
+                    // Stitching collapses some triangles.
+                    if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2])
+                        continue;
+
+                    std::vector<unsigned short>& bucket = buckets[std::make_pair(mask, stitch)];
+                    bucket.insert(bucket.end(), triangle, triangle + 3);
+                }
+            }
+        }
+    }
+
+    // Lay out the single-edge buckets around the interior so that any combination of
+    // stitched edges needs at most a few contiguous draws (and the unstitched patch one).
+    static const unsigned int W = 1 << EDGE_WEST, E = 1 << EDGE_EAST, N = 1 << EDGE_NORTH, S = 1 << EDGE_SOUTH;
+    static const unsigned int order[9][2] = { { W, W }, { N, N }, { W, 0 }, { N, 0 }, { 0, 0 }, { E, 0 }, { S, 0 }, { E, E }, { S, S } };
+
+    indices->clear();
+    ranges->clear();
+    for (unsigned int i = 0; i < 9; ++i)
+    {
+        std::map<std::pair<unsigned int, unsigned int>, std::vector<unsigned short> >::iterator itr = buckets.find(std::make_pair(order[i][0], order[i][1]));
+        if (itr == buckets.end())
+            continue;
+
+        IndexRange range = { itr->first.first, itr->first.second, (unsigned int)indices->size(), (unsigned int)itr->second.size() };
+        ranges->push_back(range);
+        indices->insert(indices->end(), itr->second.begin(), itr->second.end());
+        buckets.erase(itr);
+    }
+
+    // Triangles that depend on several edges (only in very narrow levels) follow.
+    for (std::map<std::pair<unsigned int, unsigned int>, std::vector<unsigned short> >::iterator itr = buckets.begin(); itr != buckets.end(); ++itr)
+    {
+        IndexRange range = { itr->first.first, itr->first.second, (unsigned int)indices->size(), (unsigned int)itr->second.size() };
+        ranges->push_back(range);
+        indices->insert(indices->end(), itr->second.begin(), itr->second.end());
+    }
+}
+
 void TerrainPatch::deleteLayer(Layer* layer)
 {
     // Release layer samplers
@@ -579,13 +834,86 @@ unsigned int TerrainPatch::draw(bool wireframe)
     if (!updateMaterial())
         return 0;
 
-    // Compute the LOD level from the camera's perspective
-    _level = computeLOD(camera, bounds);
+    // The LOD level was selected by the terrain for all patches beforehand (see Terrain::updateLevels).
+    if (_terrain->_sharedVertices)
+        return drawStitched(wireframe);
 
     // Draw the model for the current LOD
     return _levels[_level]->model->draw(wireframe);
 }
 
+unsigned int TerrainPatch::getStitchedEdges() const
+{
+    // Edges next to a coarser patch are stitched to it (the terrain keeps neighboring levels within one).
+    unsigned int edges = 0;
+    for (unsigned int i = 0; i < EDGE_COUNT; ++i)
+    {
+        if (_neighbors[i] && _neighbors[i]->_level > _level)
+            edges |= 1 << i;
+    }
+    return edges;
+}
+
+unsigned int TerrainPatch::drawStitched(bool wireframe)
+{
+    Level* level = _levels[_level];
+    Material* material = level->model->getMaterial();
+    if (!material)
+        return 0;
+
+    // Select the index ranges for the stitched edges, merging ranges that are contiguous.
+    unsigned int edges = getStitchedEdges();
+    unsigned int starts[16];
+    unsigned int counts[16];
+    unsigned int drawCount = 0;
+    for (size_t i = 0, count = level->ranges.size(); i < count; ++i)
+    {
+        const IndexRange& range = level->ranges[i];
+        if ((edges & range.mask) != range.stitch)
+            continue;
+
+        if (drawCount > 0 && starts[drawCount - 1] + counts[drawCount - 1] == range.start)
+        {
+            counts[drawCount - 1] += range.count;
+        }
+        else if (drawCount < 16)
+        {
+            starts[drawCount] = range.start;
+            counts[drawCount] = range.count;
+            ++drawCount;
+        }
+    }
+
+    MeshPart* part = level->model->getMesh()->getPart(_level);
+    GP_ASSERT(part);
+    Technique* technique = material->getTechnique();
+    GP_ASSERT(technique);
+    for (unsigned int i = 0, passCount = technique->getPassCount(); i < passCount; ++i)
+    {
+        Pass* pass = technique->getPassByIndex(i);
+        GP_ASSERT(pass);
+        pass->bind();
+        GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, part->getIndexBuffer()) );
+        for (unsigned int j = 0; j < drawCount; ++j)
+        {
+            if (wireframe)
+            {
+                for (unsigned int k = 0; k < counts[j]; k += 3)
+                {
+                    GL_ASSERT( glDrawElements(GL_LINE_LOOP, 3, GL_UNSIGNED_SHORT, (const GLvoid*)((starts[j] + k) * sizeof(unsigned short))) );
+                }
+            }
+            else
+            {
+                GL_ASSERT( glDrawElements(GL_TRIANGLES, counts[j], GL_UNSIGNED_SHORT, (const GLvoid*)(starts[j] * sizeof(unsigned short))) );
+            }
+        }
+        pass->unbind();
+    }
+
+    return 1;
+}
+
 const BoundingBox& TerrainPatch::getBoundingBox(bool worldSpace) const
 {
     if (!worldSpace)
@@ -606,68 +934,35 @@ const BoundingBox& TerrainPatch::getBoundingBox(bool worldSpace) const
     return _boundingBoxWorld;
 }
 
-void TerrainPatch::cameraChanged(Camera* camera)
+unsigned int TerrainPatch::computeLOD(const Vector3& cameraPosition, float errorScale, bool perspective) const
 {
-    _bits |= TERRAINPATCH_DIRTY_LEVEL;
-}
+    // base level
+    if (!_terrain->isFlagSet(Terrain::LEVEL_OF_DETAIL) || _levels.size() <= 1)
+        return 0;
 
-unsigned int TerrainPatch::computeLOD(Camera* camera, const BoundingBox& worldBounds) 
-{
-    if (camera != _camera)
+    // The projected size of a level's geometric error is error * errorScale / distance for
+    // perspective cameras, so find the largest error that projects within the pixel error.
+    float maxError = _terrain->_pixelError / errorScale;
+    if (perspective)
     {
-        if (_camera != NULL)
-        {
-            _camera->removeListener(this);
-            _camera->release();
-        }
-        _camera = camera;
-        _camera->addRef();
-        _camera->addListener(this);
-        _bits |= TERRAINPATCH_DIRTY_LEVEL;
+        // Distance from the camera to the closest point of the patch bounds
+        const BoundingBox& bounds = getBoundingBox(true);
+        float dx = std::max(0.0f, std::max(bounds.min.x - cameraPosition.x, cameraPosition.x - bounds.max.x));
+        float dy = std::max(0.0f, std::max(bounds.min.y - cameraPosition.y, cameraPosition.y - bounds.max.y));
+        float dz = std::max(0.0f, std::max(bounds.min.z - cameraPosition.z, cameraPosition.z - bounds.max.z));
+        maxError *= std::sqrt(dx * dx + dy * dy + dz * dz);
     }
 
-    // base level
-    if (!_terrain->isFlagSet(Terrain::LEVEL_OF_DETAIL) || _levels.size() == 0)
-        return 0;
-
-    if (!(_bits & TERRAINPATCH_DIRTY_LEVEL))
-        return _level;
-
-    _bits &= ~TERRAINPATCH_DIRTY_LEVEL;
-
-    // Compute LOD to use based on very simple distance metric. TODO: Optimize me.
-    Game* game = Game::getInstance();
-    Rectangle vp(0, 0, game->getWidth(), game->getHeight());
-    Vector3 corners[8];
-    Vector2 min(FLT_MAX, FLT_MAX);
-    Vector2 max(-FLT_MAX, -FLT_MAX);
-    worldBounds.getCorners(corners);
-    for (unsigned int i = 0; i < 8; ++i)
-    {
-        const Vector3& corner = corners[i];
-        float x, y;
-        camera->project(vp, corners[i], &x, &y);
-        if (x < min.x)
-            min.x = x;
-        if (y < min.y)
-            min.y = y;
-        if (x > max.x)
-            max.x = x;
-        if (y > max.y)
-            max.y = y;
-    }
-    float area = (max.x - min.x) * (max.y - min.y);
-    float screenArea = game->getWidth() * game->getHeight() / 10.0f;
-    float error = screenArea / area;
-
-    // Level LOD based on distance from camera
-    size_t maxLod = _levels.size()-1;
-    size_t lod = (size_t)error;
-    lod = std::max(lod, (size_t)0);
-    lod = std::min(lod, maxLod);
-    _level = lod;
-
-    return _level;
+    // Use the coarsest level within the error, but only move to a coarser level than the
+    // current one once its error is comfortably within the limit.
+    unsigned int current = std::min(_level, (unsigned int)_levels.size() - 1);
+    for (unsigned int i = (unsigned int)_levels.size() - 1; i > 0; --i)
+    {
+        float error = _levels[i]->error;
+        if (error <= (i > current ? maxError * TERRAINPATCH_LOD_HYSTERESIS : maxError))
+            return i;
+    }
+    return 0;
 }
 
 const Vector3& TerrainPatch::getAmbientColor() const
@@ -686,6 +981,26 @@ float TerrainPatch::computeHeight(float* heights, unsigned int width, unsigned i
     return heights[z * width + x] * _terrain->_localScale.y;
 }
 
+Vector3 TerrainPatch::computeNormal(float* heights, unsigned int width, unsigned int height, unsigned int x, unsigned int z,
+                                    unsigned int step, float positionX, float positionZ)
+{
+    float stepXScaled = step * _terrain->_localScale.x;
+    float stepZScaled = step * _terrain->_localScale.z;
+    Vector3 p(positionX, computeHeight(heights, width, x, z), positionZ);
+    Vector3 w(Vector3(x>=step ? positionX-stepXScaled : positionX, computeHeight(heights, width, x>=step ? x-step : x, z), positionZ), p);
+    Vector3 e(Vector3(x<width-step ? positionX+stepXScaled : positionX, computeHeight(heights, width, x<width-step ? x+step : x, z), positionZ), p);
+    Vector3 s(Vector3(positionX, computeHeight(heights, width, x, z>=step ? z-step : z), z>=step ? positionZ-stepZScaled : positionZ), p);
+    Vector3 n(Vector3(positionX, computeHeight(heights, width, x, z<height-step ? z+step : z), z<height-step ? positionZ+stepZScaled : positionZ), p);
+    Vector3 normals[4];
+    Vector3::cross(n, w, &normals[0]);
+    Vector3::cross(w, s, &normals[1]);
+    Vector3::cross(e, n, &normals[2]);
+    Vector3::cross(s, e, &normals[3]);
+    Vector3 normal = -(normals[0] + normals[1] + normals[2] + normals[3]);
+    normal.normalize();
+    return normal;
+}
+
 TerrainPatch::Layer::Layer() :
     index(0), row(-1), column(-1), textureIndex(-1), blendIndex(-1)
 {
@@ -695,7 +1010,7 @@ TerrainPatch::Layer::~Layer()
 {
 }
 
-TerrainPatch::Level::Level() : model(NULL)
+TerrainPatch::Level::Level() : model(NULL), error(0.0f)
 {
 }
 
@@ -13,9 +13,10 @@ class TerrainAutoBindingResolver;
 /**
  * Defines a single patch for a Terrain.
  */
-class TerrainPatch : public Camera::Listener
+class TerrainPatch
 {
     friend class Terrain;
+    friend class TerrainPager;
     friend class TerrainAutoBindingResolver;
 
 public:
@@ -41,16 +42,49 @@ public:
     const BoundingBox& getBoundingBox(bool worldSpace) const;
 
     /**
-     * @see Camera::Listener
+     * Internal use only.
+     *
+     * @script{ignore}
      */
-    void cameraChanged(Camera* camera);
+    static std::string passCallback(Pass* pass, void* cookie);
 
     /**
-     * Internal use only.
+     * A range of triangles within the index buffer of a level built from shared vertices.
+     *
+     * Triangles along the patch edges are stored twice: once as is and once stitched to
+     * the next coarser level. A range is drawn when the stitched edges of the patch, masked
+     * by the range's edge mask, equal the range's stitch bits.
      *
      * @script{ignore}
      */
-    static std::string passCallback(Pass* pass, void* cookie);
+    struct IndexRange
+    {
+        /** The edges whose stitching affects the triangles in this range (bits 0-3: west, east, north, south). */
+        unsigned int mask;
+        /** The subset of the masked edges that are stitched in this range. */
+        unsigned int stitch;
+        /** The first index of the range. */
+        unsigned int start;
+        /** The number of indices in the range. */
+        unsigned int count;
+    };
+
+    /**
+     * Generates the triangle list indices for one level of detail of a patch built from shared vertices.
+     *
+     * The vertices are the full resolution samples of the patch, in rows of the given number of columns.
+     * This does not require a graphics context.
+     *
+     * @param columns The number of samples along the x axis of the patch.
+     * @param rows The number of samples along the z axis of the patch.
+     * @param step The sample step of the level of detail (a power of two).
+     * @param indices Returns the indices, grouped into the returned ranges.
+     * @param ranges Returns the index ranges, ordered so that the unstitched patch is a single range.
+     *
+     * @script{ignore}
+     */
+    static void generateStitchedIndices(unsigned int columns, unsigned int rows, unsigned int step,
+                                        std::vector<unsigned short>* indices, std::vector<IndexRange>* ranges);
 
 private:
 
@@ -96,10 +130,24 @@ private:
     struct Level
     {
         Model* model;
+        std::vector<IndexRange> ranges;
+        float error;
 
         Level();
     };
 
+    /**
+     * The patch edges, used as bit positions for stitching masks.
+     */
+    enum Edge
+    {
+        EDGE_WEST,
+        EDGE_EAST,
+        EDGE_NORTH,
+        EDGE_SOUTH,
+        EDGE_COUNT
+    };
+
     struct LayerCompare
     {
         bool operator() (const Layer* lhs, const Layer* rhs) const;
@@ -115,6 +163,13 @@ private:
                 unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
                 float xOffset, float zOffset, unsigned int step, float verticalSkirtSize);
 
+    void addSharedLODs(float* heights, unsigned int width, unsigned int height,
+                       unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
+                       float xOffset, float zOffset, unsigned int maxStep);
+
+    unsigned int drawStitched(bool wireframe);
+
+    unsigned int getStitchedEdges() const;
 
     bool setLayer(int index, const char* texturePath, const Vector2& textureRepeat, const char* blendPath, int blendChannel);
 
@@ -126,7 +181,7 @@ private:
 
     bool updateMaterial();
 
-    unsigned int computeLOD(Camera* camera, const BoundingBox& worldBounds);
+    unsigned int computeLOD(const Vector3& cameraPosition, float errorScale, bool perspective) const;
 
     const Vector3& getAmbientColor() const;
 
@@ -134,6 +189,9 @@ private:
 
     float computeHeight(float* heights, unsigned int width, unsigned int x, unsigned int z);
 
+    Vector3 computeNormal(float* heights, unsigned int width, unsigned int height, unsigned int x, unsigned int z,
+                          unsigned int step, float positionX, float positionZ);
+
     void updateNodeBindings();
 
     std::string passCreated(Pass* pass);
@@ -143,11 +201,12 @@ private:
     unsigned int _row;
     unsigned int _column;
     std::vector<Level*> _levels;
+    TerrainPatch* _neighbors[EDGE_COUNT];
+    size_t _geometryMemoryUsage;
     std::set<Layer*, LayerCompare> _layers;
     std::vector<Texture::Sampler*> _samplers;
     mutable BoundingBox _boundingBox;
     mutable BoundingBox _boundingBoxWorld;
-    mutable Camera* _camera;
     mutable unsigned int _level;
     mutable int _bits;
 };
@@ -3,13 +3,21 @@
 #include "Matrix.h"
 #include "Scene.h"
 
+// The number of tiles along each side of a chunk. A full chunk has 4 vertices per tile,
+// which keeps its indices within the range of an unsigned short.
+#define TILESET_CHUNK_SIZE 32
+
+// The maximum number of vertices drawn in a single sprite batch.
+#define TILESET_MAX_BATCH_VERTICES 65536
+
 namespace gameplay
 {
-  
+
 TileSet::TileSet() : Drawable(),
     _tiles(NULL), _tileWidth(0), _tileHeight(0),
     _rowCount(0), _columnCount(0), _width(0), _height(0),
-    _opacity(1.0f), _color(Vector4::one()), _batch(NULL)
+    _opacity(1.0f), _color(Vector4::one()), _batch(NULL), _chunkRowCount(0), _chunkColumnCount(0),
+    _visibleChunkCount(0), _chunkRebuildCount(0)
 {
 }
 
@@ -48,6 +56,8 @@ TileSet* TileSet::create(const char* imagePath,
     tileset->_columnCount = columnCount;
     tileset->_width = tileWidth * columnCount;
     tileset->_height = tileHeight * rowCount;
+    tileset->_defaultProjection = batch->getProjectionMatrix();
+    tileset->createChunks();
     return tileset;
 }
     
@@ -151,7 +161,12 @@ void TileSet::setTileSource(unsigned int column, unsigned int row, const Vector2
     GP_ASSERT(column < _columnCount);
     GP_ASSERT(row < _rowCount);
     
-    _tiles[row * _columnCount + column] = source;
+    Vector2& tile = _tiles[row * _columnCount + column];
+    if (tile != source)
+    {
+        tile = source;
+        _chunks[(row / TILESET_CHUNK_SIZE) * _chunkColumnCount + column / TILESET_CHUNK_SIZE].dirty = true;
+    }
 }
 
 void TileSet::getTileSource(unsigned int column, unsigned int row, Vector2* source)
@@ -196,7 +211,11 @@ float TileSet::getHeight() const
     
 void TileSet::setOpacity(float opacity)
 {
-    _opacity = opacity;
+    if (_opacity != opacity)
+    {
+        _opacity = opacity;
+        setChunksDirty();
+    }
 }
 
 float TileSet::getOpacity() const
@@ -206,7 +225,11 @@ float TileSet::getOpacity() const
 
 void TileSet::setColor(const Vector4& color)
 {
-    _color = color;
+    if (_color != color)
+    {
+        _color = color;
+        setChunksDirty();
+    }
 }
 
 const Vector4& TileSet::getColor() const
@@ -214,9 +237,101 @@ const Vector4& TileSet::getColor() const
     return _color;
 }
 
+unsigned int TileSet::getVisibleChunkCount() const
+{
+    return _visibleChunkCount;
+}
+
+unsigned int TileSet::getChunkRebuildCount() const
+{
+    return _chunkRebuildCount;
+}
+
+void TileSet::createChunks()
+{
+    _chunkRowCount = (_rowCount + TILESET_CHUNK_SIZE - 1) / TILESET_CHUNK_SIZE;
+    _chunkColumnCount = (_columnCount + TILESET_CHUNK_SIZE - 1) / TILESET_CHUNK_SIZE;
+    _chunks.clear();
+    _chunks.resize(_chunkRowCount * _chunkColumnCount);
+    setChunksDirty();
+}
+
+void TileSet::setChunksDirty()
+{
+    for (size_t i = 0, count = _chunks.size(); i < count; ++i)
+    {
+        _chunks[i].dirty = true;
+    }
+}
+
+void TileSet::buildChunk(unsigned int chunkColumn, unsigned int chunkRow)
+{
+    GP_ASSERT(_batch && _batch->getSampler() && _batch->getSampler()->getTexture());
+
+    Chunk& chunk = _chunks[chunkRow * _chunkColumnCount + chunkColumn];
+    chunk.vertices.clear();
+    chunk.indices.clear();
+    chunk.dirty = false;
+
+    Texture* texture = _batch->getSampler()->getTexture();
+    float textureWidthRatio = 1.0f / (float)texture->getWidth();
+    float textureHeightRatio = 1.0f / (float)texture->getHeight();
+    float r = _color.x;
+    float g = _color.y;
+    float b = _color.z;
+    float a = _color.w * _opacity;
+
+    unsigned int rowStart = chunkRow * TILESET_CHUNK_SIZE;
+    unsigned int rowEnd = std::min(rowStart + TILESET_CHUNK_SIZE, _rowCount);
+    unsigned int columnStart = chunkColumn * TILESET_CHUNK_SIZE;
+    unsigned int columnEnd = std::min(columnStart + TILESET_CHUNK_SIZE, _columnCount);
+    for (unsigned int row = rowStart; row < rowEnd; ++row)
+    {
+        // Row zero is the top row of the tile set
+        float y = _tileHeight * (_rowCount - 1 - row);
+        float y2 = y + _tileHeight;
+        for (unsigned int col = columnStart; col < columnEnd; ++col)
+        {
+            // Negative values are skipped to allow blank tiles
+            const Vector2& source = _tiles[row * _columnCount + col];
+            if (source.x < 0 || source.y < 0)
+                continue;
+
+            float x = _tileWidth * col;
+            float x2 = x + _tileWidth;
+            float u1 = textureWidthRatio * source.x;
+            float v1 = 1.0f - textureHeightRatio * source.y;
+            float u2 = u1 + textureWidthRatio * _tileWidth;
+            float v2 = v1 - textureHeightRatio * _tileHeight;
+
+            // Connect this tile to the previous one with a degenerate triangle
+            unsigned short index = (unsigned short)chunk.vertices.size();
+            if (index > 0)
+            {
+                chunk.indices.push_back(index - 1);
+                chunk.indices.push_back(index);
+            }
+            chunk.indices.push_back(index);
+            chunk.indices.push_back(index + 1);
+            chunk.indices.push_back(index + 2);
+            chunk.indices.push_back(index + 3);
+
+            SpriteBatch::SpriteVertex v[4] =
+            {
+                { x, y, 0, u1, v1, r, g, b, a },
+                { x, y2, 0, u1, v2, r, g, b, a },
+                { x2, y, 0, u2, v1, r, g, b, a },
+                { x2, y2, 0, u2, v2, r, g, b, a }
+            };
+            chunk.vertices.insert(chunk.vertices.end(), v, v + 4);
+        }
+    }
+}
+
 unsigned int TileSet::draw(bool wireframe)
 {
     // Apply scene camera projection and translation offsets
+    Matrix projectionMatrix = _defaultProjection;
     Vector3 position = Vector3::zero();
     if (_node && _node->getScene())
     {
@@ -227,9 +342,7 @@ unsigned int TileSet::draw(bool wireframe)
             if (cameraNode)
             {
                 // Scene projection
-                Matrix projectionMatrix;
                 projectionMatrix = _node->getProjectionMatrix();
-                _batch->setProjectionMatrix(projectionMatrix);
 
                 position.x -= cameraNode->getTranslationWorld().x;
                 position.y -= cameraNode->getTranslationWorld().y;
@@ -242,34 +355,78 @@ unsigned int TileSet::draw(bool wireframe)
         position.y += translation.y;
         position.z += translation.z;
     }
-    
-    // Draw each cell in the tile set
-    position.y += _tileHeight * (_rowCount - 1);
-    float xStart = position.x;
+
+    _visibleChunkCount = 0;
+    _chunkRebuildCount = 0;
+
+    // The cached chunk vertices are relative to the tile set, so the offset is applied
+    // through the projection matrix instead.
+    projectionMatrix.translate(position);
+    _batch->setProjectionMatrix(projectionMatrix);
+
+    // Find the range of chunks overlapping the view by unprojecting the corners of
+    // the viewport into tile set space. Draw all chunks if the projection is not
+    // orthographic or cannot be inverted.
+    unsigned int chunkColumnStart = 0;
+    unsigned int chunkColumnEnd = _chunkColumnCount;
+    unsigned int chunkRowStart = 0;
+    unsigned int chunkRowEnd = _chunkRowCount;
+    Matrix inverseProjection;
+    const float* m = projectionMatrix.m;
+    if (m[3] == 0 && m[7] == 0 && m[11] == 0 && projectionMatrix.invert(&inverseProjection))
+    {
+        Vector3 corner1(-1.0f, -1.0f, 0.0f);
+        Vector3 corner2(1.0f, 1.0f, 0.0f);
+        inverseProjection.transformPoint(&corner1);
+        inverseProjection.transformPoint(&corner2);
+        float minX = std::min(corner1.x, corner2.x);
+        float maxX = std::max(corner1.x, corner2.x);
+        float minY = std::min(corner1.y, corner2.y);
+        float maxY = std::max(corner1.y, corner2.y);
+        if (maxX < 0 || minX > _width || maxY < 0 || minY > _height)
+            return 0;
+
+        // Chunk rows start at the top of the tile set, while y increases upwards
+        float chunkWidth = _tileWidth * TILESET_CHUNK_SIZE;
+        float chunkHeight = _tileHeight * TILESET_CHUNK_SIZE;
+        chunkColumnStart = (unsigned int)std::max(0.0f, minX / chunkWidth);
+        chunkColumnEnd = (unsigned int)std::min((float)_chunkColumnCount, maxX / chunkWidth + 1.0f);
+        chunkRowStart = (unsigned int)std::max(0.0f, (_height - maxY) / chunkHeight);
+        chunkRowEnd = (unsigned int)std::min((float)_chunkRowCount, (_height - minY) / chunkHeight + 1.0f);
+    }
+
+    // Draw the cached vertices of each visible chunk
+    unsigned int vertexCount = 0;
+    unsigned int drawCalls = 1;
     _batch->start();
-    for (unsigned int row = 0; row < _rowCount; row++)
+    for (unsigned int chunkRow = chunkRowStart; chunkRow < chunkRowEnd; ++chunkRow)
     {
-        for (unsigned int col = 0; col < _columnCount; col++)
+        for (unsigned int chunkColumn = chunkColumnStart; chunkColumn < chunkColumnEnd; ++chunkColumn)
         {
-            Vector2 scale = Vector2(_tileWidth, _tileHeight);
-            
-            // Negative values are skipped to allow blank tiles
-            if (_tiles[row * _columnCount + col].x >= 0 &&
-                _tiles[row * _columnCount + col].y >= 0)
+            Chunk& chunk = _chunks[chunkRow * _chunkColumnCount + chunkColumn];
+            ++_visibleChunkCount;
+            if (chunk.dirty)
             {
-                Rectangle source = Rectangle(_tiles[row * _columnCount + col].x,
-                                             _tiles[row * _columnCount + col].y, _tileWidth, _tileHeight);
-                _batch->draw(position, source, scale, Vector4(_color.x, _color.y, _color.z, _color.w * _opacity),
-                             Vector2(0.5f, 0.5f), 0);
+                buildChunk(chunkColumn, chunkRow);
+                ++_chunkRebuildCount;
             }
-            
-            position.x += _tileWidth;
+            if (chunk.vertices.empty())
+                continue;
+
+            // Flush the batch before its indices overflow
+            if (vertexCount + chunk.vertices.size() > TILESET_MAX_BATCH_VERTICES)
+            {
+                _batch->finish();
+                _batch->start();
+                vertexCount = 0;
+                ++drawCalls;
+            }
+            _batch->draw(&chunk.vertices[0], chunk.vertices.size(), &chunk.indices[0], chunk.indices.size());
+            vertexCount += chunk.vertices.size();
         }
-        position.x = xStart;
-        position.y -= _tileHeight;
     }
     _batch->finish();
-    return 1;
+    return drawCalls;
 }
 
 Drawable* TileSet::clone(NodeCloneContext& context)
@@ -277,18 +434,19 @@ Drawable* TileSet::clone(NodeCloneContext& context)
     TileSet* tilesetClone = new TileSet();
 
     // Clone properties
-    tilesetClone->_tiles = new Vector2[tilesetClone->_rowCount * tilesetClone->_columnCount];
-    memset(tilesetClone->_tiles, -1, sizeof(float) * tilesetClone->_rowCount * tilesetClone->_columnCount * 2);
-    memcpy(tilesetClone->_tiles, _tiles, sizeof(Vector2) * tilesetClone->_rowCount * tilesetClone->_columnCount);
     tilesetClone->_tileWidth = _tileWidth;
     tilesetClone->_tileHeight = _tileHeight;
     tilesetClone->_rowCount = _rowCount;
     tilesetClone->_columnCount = _columnCount;
+    tilesetClone->_tiles = new Vector2[tilesetClone->_rowCount * tilesetClone->_columnCount];
+    memcpy(tilesetClone->_tiles, _tiles, sizeof(Vector2) * tilesetClone->_rowCount * tilesetClone->_columnCount);
     tilesetClone->_width = _tileWidth * _columnCount;
     tilesetClone->_height = _tileHeight * _rowCount;
     tilesetClone->_opacity = _opacity;
     tilesetClone->_color = _color;
     tilesetClone->_batch = _batch;
+    tilesetClone->_defaultProjection = _defaultProjection;
+    tilesetClone->createChunks();
 
     return tilesetClone;
 }
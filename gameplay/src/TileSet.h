@@ -26,6 +26,10 @@ namespace gameplay
  * a gutter of duplicate pixels on each side of the region.
  *
  * The tile set does not support rotation or scaling.
+ *
+ * Tiles are grouped into square chunks whose vertex data is built once and
+ * only rebuilt when a tile, the color or the opacity in the chunk changes.
+ * Only the chunks that overlap the view of the active camera are drawn.
  */
 class TileSet : public Ref, public Drawable
 {
@@ -147,6 +151,20 @@ public:
      * @return The color(RGBA) for the sprite.
      */
     const Vector4& getColor() const;
+
+    /**
+     * Gets the number of chunks that overlapped the view in the last call to draw.
+     *
+     * @return The number of visible chunks.
+     */
+    unsigned int getVisibleChunkCount() const;
+
+    /**
+     * Gets the number of chunks whose vertex data was rebuilt in the last call to draw.
+     *
+     * @return The number of rebuilt chunks.
+     */
+    unsigned int getChunkRebuildCount() const;
    
     /**
      * @see Drawable::draw
@@ -176,6 +194,37 @@ protected:
 
 private:
 
+    /**
+     * Cached vertex data for a square group of tiles.
+     */
+    struct Chunk
+    {
+        /** The tile vertices, relative to the bottom left corner of the tile set. */
+        std::vector<SpriteBatch::SpriteVertex> vertices;
+        /** The triangle strip indices, with degenerate triangles between tiles. */
+        std::vector<unsigned short> indices;
+        /** If the vertex data must be rebuilt before drawing. */
+        bool dirty;
+    };
+
+    /**
+     * Creates the chunks for the current row and column count.
+     */
+    void createChunks();
+
+    /**
+     * Rebuilds the vertex data of a chunk.
+     *
+     * @param chunkColumn The column of the chunk.
+     * @param chunkRow The row of the chunk.
+     */
+    void buildChunk(unsigned int chunkColumn, unsigned int chunkRow);
+
+    /**
+     * Marks the vertex data of all chunks as dirty.
+     */
+    void setChunksDirty();
+
     Vector2* _tiles;
     float _tileWidth;
     float _tileHeight;
@@ -186,6 +235,12 @@ private:
     SpriteBatch* _batch;
     float _opacity;
     Vector4 _color;
+    Matrix _defaultProjection;
+    std::vector<Chunk> _chunks;
+    unsigned int _chunkRowCount;
+    unsigned int _chunkColumnCount;
+    unsigned int _visibleChunkCount;
+    unsigned int _chunkRebuildCount;
 };
     
 }
@@ -8,6 +8,11 @@ namespace gameplay
 
 int Transform::_suspendTransformChanged(0);
 std::vector<Transform*> Transform::_transformsChanged;
+std::vector<Transform*> Transform::_transformsChangedDeferred;
+unsigned int Transform::_deliveredCount(0);
+unsigned int Transform::_coalescedCount(0);
+unsigned int Transform::_lastDeliveredCount(0);
+unsigned int Transform::_lastCoalescedCount(0);
 
 Transform::Transform()
     : _matrixDirtyBits(0), _listeners(NULL)
@@ -47,6 +52,12 @@ Transform::Transform(const Transform& copy)
 
 Transform::~Transform()
 {
+    if (_matrixDirtyBits & DIRTY_NOTIFY_DEFERRED)
+    {
+        std::vector<Transform*>::iterator itr = std::find(_transformsChangedDeferred.begin(), _transformsChangedDeferred.end(), this);
+        if (itr != _transformsChangedDeferred.end())
+            _transformsChangedDeferred.erase(itr);
+    }
     SAFE_DELETE(_listeners);
 }
 
@@ -92,6 +103,54 @@ bool Transform::isTransformChangedSuspended()
     return (_suspendTransformChanged > 0);
 }
 
+void Transform::flushTransformChanged()
+{
+    // Listeners may change transforms again, which queues them for another pass.
+    std::vector<Transform*> transforms;
+    while (!_transformsChangedDeferred.empty())
+    {
+        transforms.swap(_transformsChangedDeferred);
+        for (size_t i = 0, count = transforms.size(); i < count; ++i)
+        {
+            Transform* t = transforms[i];
+            GP_ASSERT(t);
+            t->_matrixDirtyBits &= ~DIRTY_NOTIFY_DEFERRED;
+        }
+        for (size_t i = 0, count = transforms.size(); i < count; ++i)
+        {
+            Transform* t = transforms[i];
+            if (t->_listeners == NULL)
+                continue;
+            for (std::list<TransformListener>::iterator itr = t->_listeners->begin(); itr != t->_listeners->end(); ++itr)
+            {
+                TransformListener& l = *itr;
+                GP_ASSERT(l.listener);
+                if (l.listener->isTransformChangedDeferred())
+                {
+                    l.listener->transformChanged(t, l.cookie);
+                    ++_deliveredCount;
+                }
+            }
+        }
+        transforms.clear();
+    }
+
+    _lastDeliveredCount = _deliveredCount;
+    _lastCoalescedCount = _coalescedCount;
+    _deliveredCount = 0;
+    _coalescedCount = 0;
+}
+
+unsigned int Transform::getTransformChangedDeliveredCount()
+{
+    return _lastDeliveredCount;
+}
+
+unsigned int Transform::getTransformChangedCoalescedCount()
+{
+    return _lastCoalescedCount;
+}
+
 const char* Transform::getTypeName() const
 {
     return "Transform";
@@ -993,11 +1052,29 @@ void Transform::transformChanged()
 {
     if (_listeners)
     {
+        bool deferred = false;
         for (std::list<TransformListener>::iterator itr = _listeners->begin(); itr != _listeners->end(); ++itr)
         {
             TransformListener& l = *itr;
             GP_ASSERT(l.listener);
-            l.listener->transformChanged(this, l.cookie);
+            if (l.listener->isTransformChangedDeferred())
+                deferred = true;
+            else
+                l.listener->transformChanged(this, l.cookie);
+        }
+
+        // Queue the transform once for its deferred listeners until the next flush.
+        if (deferred)
+        {
+            if (_matrixDirtyBits & DIRTY_NOTIFY_DEFERRED)
+            {
+                ++_coalescedCount;
+            }
+            else
+            {
+                _matrixDirtyBits |= DIRTY_NOTIFY_DEFERRED;
+                _transformsChangedDeferred.push_back(this);
+            }
         }
     }
     fireScriptEvent<void>(GP_GET_SCRIPT_EVENT(Transform, transformChanged), dynamic_cast<void*>(this));
@@ -123,6 +123,35 @@ public:
      */
     static bool isTransformChangedSuspended();
 
+    /**
+     * Notifies the listeners that accept deferred transform changed events of the
+     * transforms that changed since the last flush.
+     *
+     * Each changed transform notifies its deferred listeners once, no matter how many
+     * times it changed. This is called once per frame by the game after the update
+     * and before audio and rendering.
+     *
+     * @script{ignore}
+     */
+    static void flushTransformChanged();
+
+    /**
+     * Gets the number of deferred transform changed notifications delivered by the last flush.
+     *
+     * @return The number of notifications delivered.
+     * @script{ignore}
+     */
+    static unsigned int getTransformChangedDeliveredCount();
+
+    /**
+     * Gets the number of deferred transform changed notifications that were coalesced
+     * into an already queued notification before the last flush.
+     *
+     * @return The number of notifications saved.
+     * @script{ignore}
+     */
+    static unsigned int getTransformChangedCoalescedCount();
+
     /**
      * Listener interface for Transform events.
      */
@@ -139,6 +168,18 @@ public:
          * @param cookie Cookie value that was specified when the listener was registered.
          */
         virtual void transformChanged(Transform* transform, long cookie) = 0;
+
+        /**
+         * Determines if the listener only needs to be notified once per frame.
+         *
+         * Deferred listeners are notified when Transform::flushTransformChanged() is called,
+         * once per changed transform, instead of on every change. Only listeners that do not
+         * depend on the change before the end of the frame update should be deferred.
+         *
+         * @return True if notifications may be deferred, false by default.
+         * @script{ignore}
+         */
+        virtual bool isTransformChangedDeferred() const { return false; }
     };
 
     /**
@@ -825,7 +866,8 @@ protected:
         DIRTY_TRANSLATION = 0x01,
         DIRTY_SCALE = 0x02,
         DIRTY_ROTATION = 0x04,
-        DIRTY_NOTIFY = 0x08
+        DIRTY_NOTIFY = 0x08,
+        DIRTY_NOTIFY_DEFERRED = 0x10
     };
 
     /**
@@ -896,6 +938,11 @@ private:
 
     static int _suspendTransformChanged;
     static std::vector<Transform*> _transformsChanged;
+    static std::vector<Transform*> _transformsChangedDeferred;
+    static unsigned int _deliveredCount;
+    static unsigned int _coalescedCount;
+    static unsigned int _lastDeliveredCount;
+    static unsigned int _lastCoalescedCount;
     
 };
 
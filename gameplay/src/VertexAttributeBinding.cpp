@@ -9,8 +9,38 @@ namespace gameplay
 static GLuint __maxVertexAttribs = 0;
 static std::vector<VertexAttributeBinding*> __vertexAttributeBindingCache;
 
+// Returns the GL data type of a vertex element type.
+static GLenum getGLType(VertexFormat::Type type)
+{
+    switch (type)
+    {
+    case VertexFormat::HALF_FLOAT:
+#ifdef OPENGL_ES
+        return GL_HALF_FLOAT_OES;
+#else
+        return GL_HALF_FLOAT;
+#endif
+    case VertexFormat::BYTE:
+        return GL_BYTE;
+    case VertexFormat::UNSIGNED_BYTE:
+        return GL_UNSIGNED_BYTE;
+    case VertexFormat::SHORT:
+        return GL_SHORT;
+    case VertexFormat::UNSIGNED_SHORT:
+        return GL_UNSIGNED_SHORT;
+    case VertexFormat::INT_2_10_10_10:
+#ifdef GL_INT_2_10_10_10_REV
+        return GL_INT_2_10_10_10_REV;
+#else
+        return 0x8D9F; // GL_INT_2_10_10_10_REV (OpenGL ES 3.0)
+#endif
+    default:
+        return GL_FLOAT;
+    }
+}
+
 VertexAttributeBinding::VertexAttributeBinding() :
-    _handle(0), _attributes(NULL), _mesh(NULL), _effect(NULL)
+    _handle(0), _attributes(NULL), _mesh(NULL), _effect(NULL), _vertexBuffer(0), _vertexOffset(0)
 {
 }
 
@@ -90,7 +120,11 @@ VertexAttributeBinding* VertexAttributeBinding::create(Mesh* mesh, const VertexF
     VertexAttributeBinding* b = new VertexAttributeBinding();
 
 #ifdef GP_USE_VAO
+#ifdef GP_GL_RECORDER
+    if (mesh && gl::hasVertexArrays())
+#else
     if (mesh && glGenVertexArrays)
+#endif
     {
         GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, 0) );
         GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
@@ -198,10 +232,10 @@ VertexAttributeBinding* VertexAttributeBinding::create(Mesh* mesh, const VertexF
         else
         {
             void* pointer = vertexPointer ? (void*)(((unsigned char*)vertexPointer) + offset) : (void*)offset;
-            b->setVertexAttribPointer(attrib, (GLint)e.size, GL_FLOAT, GL_FALSE, (GLsizei)vertexFormat.getVertexSize(), pointer);
+            b->setVertexAttribPointer(attrib, (GLint)e.size, getGLType(e.type), e.normalized ? GL_TRUE : GL_FALSE, (GLsizei)vertexFormat.getVertexSize(), pointer);
         }
 
-        offset += e.size * sizeof(float);
+        offset += e.getSizeInBytes();
     }
 
     if (b->_handle)
@@ -235,6 +269,14 @@ void VertexAttributeBinding::setVertexAttribPointer(GLuint indx, GLint size, GLe
     }
 }
 
+void VertexAttributeBinding::setVertexBuffer(VertexBufferHandle buffer, size_t offset)
+{
+    GP_ASSERT(_mesh == NULL);
+
+    _vertexBuffer = buffer;
+    _vertexOffset = offset;
+}
+
 void VertexAttributeBinding::bind()
 {
     if (_handle)
@@ -251,7 +293,7 @@ void VertexAttributeBinding::bind()
         }
         else
         {
-            GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, 0) );
+            GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer) );
         }
 
         GP_ASSERT(_attributes);
@@ -260,7 +302,7 @@ void VertexAttributeBinding::bind()
             VertexAttribute& a = _attributes[i];
             if (a.enabled)
             {
-                GL_ASSERT( glVertexAttribPointer(i, a.size, a.type, a.normalized, a.stride, a.pointer) );
+                GL_ASSERT( glVertexAttribPointer(i, a.size, a.type, a.normalized, a.stride, (unsigned char*)a.pointer + _vertexOffset) );
                 GL_ASSERT( glEnableVertexAttribArray(i) );
             }
         }
@@ -277,7 +319,7 @@ void VertexAttributeBinding::unbind()
     else
     {
         // Software mode
-        if (_mesh)
+        if (_mesh || _vertexBuffer)
         {
             GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, 0) );
         }
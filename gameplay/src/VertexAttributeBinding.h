@@ -31,6 +31,8 @@ class Effect;
  */
 class VertexAttributeBinding : public Ref
 {
+    friend class MeshBatch;
+
 public:
 
     /**
@@ -110,10 +112,23 @@ private:
 
     void setVertexAttribPointer(GLuint indx, GLint size, GLenum type, GLboolean normalize, GLsizei stride, void* pointer);
 
+    /**
+     * Sets the vertex buffer used by a binding that is not attached to a mesh.
+     *
+     * The vertex attribute pointers of the binding are offsets into this buffer, relative
+     * to the given base offset.
+     *
+     * @param buffer The vertex buffer, or 0 to use client-side vertex arrays.
+     * @param offset The offset of the first vertex in the buffer, in bytes.
+     */
+    void setVertexBuffer(VertexBufferHandle buffer, size_t offset);
+
     GLuint _handle;
     VertexAttribute* _attributes;
     Mesh* _mesh;
     Effect* _effect;
+    VertexBufferHandle _vertexBuffer;
+    size_t _vertexOffset;
 };
 
 }
@@ -17,7 +17,7 @@ VertexFormat::VertexFormat(const Element* elements, unsigned int elementCount)
         memcpy(&element, &elements[i], sizeof(Element));
         _elements.push_back(element);
 
-        _vertexSize += element.size * sizeof(float);
+        _vertexSize += element.getSizeInBytes();
     }
 }
 
@@ -62,18 +62,37 @@ bool VertexFormat::operator != (const VertexFormat& f) const
 }
 
 VertexFormat::Element::Element() :
-    usage(POSITION), size(0)
+    usage(POSITION), size(0), type(FLOAT), normalized(false)
 {
 }
 
-VertexFormat::Element::Element(Usage usage, unsigned int size) :
-    usage(usage), size(size)
+VertexFormat::Element::Element(Usage usage, unsigned int size, Type type, bool normalized) :
+    usage(usage), size(size), type(type), normalized(normalized)
 {
+    GP_ASSERT(type != INT_2_10_10_10 || size == 4);
+}
+
+unsigned int VertexFormat::Element::getSizeInBytes() const
+{
+    switch (type)
+    {
+    case HALF_FLOAT:
+    case SHORT:
+    case UNSIGNED_SHORT:
+        return size * 2;
+    case BYTE:
+    case UNSIGNED_BYTE:
+        return size;
+    case INT_2_10_10_10:
+        return 4;
+    default:
+        return size * sizeof(float);
+    }
 }
 
 bool VertexFormat::Element::operator == (const VertexFormat::Element& e) const
 {
-    return (size == e.size && usage == e.usage);
+    return (size == e.size && usage == e.usage && type == e.type && normalized == e.normalized);
 }
 
 bool VertexFormat::Element::operator != (const VertexFormat::Element& e) const
@@ -35,13 +35,33 @@ public:
         TEXCOORD7 = 15
     };
 
+    /**
+     * Defines the data types of the values in a vertex element.
+     *
+     * HALF_FLOAT and INT_2_10_10_10 require OpenGL 3.3 or OpenGL ES 3.0
+     * (or the corresponding half float and 10-10-10-2 vertex extensions).
+     */
+    enum Type
+    {
+        FLOAT = 0,
+        HALF_FLOAT = 1,
+        BYTE = 2,
+        UNSIGNED_BYTE = 3,
+        SHORT = 4,
+        UNSIGNED_SHORT = 5,
+        INT_2_10_10_10 = 6
+    };
+
     /**
      * Defines a single element within a vertex format.
      *
-     * All vertex elements are assumed to be of type float, but can
-     * have a varying number of float values (1-4), which is represented
-     * by the size attribute. Additionally, vertex elements are assumed
-     * to be tightly packed.
+     * A vertex element has a varying number of values (1-4), which is
+     * represented by the size attribute, of the given type. Integer values
+     * can be normalized, in which case they are mapped to [0, 1] (unsigned)
+     * or [-1, 1] (signed) when read by the shader. INT_2_10_10_10 elements
+     * pack four signed values into 32 bits and must have a size of 4.
+     * Vertex elements are assumed to be tightly packed, so elements should
+     * be padded to a multiple of 4 bytes.
      */
     class Element
     {
@@ -56,6 +76,16 @@ public:
          */
         unsigned int size;
 
+        /**
+         * The data type of the values in the vertex element.
+         */
+        Type type;
+
+        /**
+         * Whether integer values are normalized when read by the shader.
+         */
+        bool normalized;
+
         /**
          * Constructor.
          */
@@ -65,9 +95,18 @@ public:
          * Constructor.
          *
          * @param usage The vertex element usage semantic.
-         * @param size The number of float values in the vertex element.
+         * @param size The number of values in the vertex element.
+         * @param type The data type of the values.
+         * @param normalized Whether integer values are normalized.
+         */
+        Element(Usage usage, unsigned int size, Type type = FLOAT, bool normalized = false);
+
+        /**
+         * Gets the size (in bytes) of this vertex element.
+         *
+         * @return The size of the element in bytes.
          */
-        Element(Usage usage, unsigned int size);
+        unsigned int getSizeInBytes() const;
 
         /**
          * Compares two vertex elements for equality.
@@ -7,6 +7,7 @@
 #include "AnimationTarget.h"
 #include "Base.h"
 #include "Game.h"
+#include "Node.h"
 #include "Quaternion.h"
 #include "Ref.h"
 #include "ScriptController.h"
@@ -34,6 +35,8 @@ void luaRegister_AnimationClip()
         {"getElapsedTime", lua_AnimationClip_getElapsedTime},
         {"getEndTime", lua_AnimationClip_getEndTime},
         {"getId", lua_AnimationClip_getId},
+        {"getLod", lua_AnimationClip_getLod},
+        {"getLodNode", lua_AnimationClip_getLodNode},
         {"getLoopBlendTime", lua_AnimationClip_getLoopBlendTime},
         {"getRefCount", lua_AnimationClip_getRefCount},
         {"getRepeatCount", lua_AnimationClip_getRepeatCount},
@@ -53,6 +56,7 @@ void luaRegister_AnimationClip()
         {"removeScriptCallback", lua_AnimationClip_removeScriptCallback},
         {"setActiveDuration", lua_AnimationClip_setActiveDuration},
         {"setBlendWeight", lua_AnimationClip_setBlendWeight},
+        {"setLodNode", lua_AnimationClip_setLodNode},
         {"setLoopBlendTime", lua_AnimationClip_setLoopBlendTime},
         {"setRepeatCount", lua_AnimationClip_setRepeatCount},
         {"setSpeed", lua_AnimationClip_setSpeed},
@@ -702,6 +706,85 @@ int lua_AnimationClip_getId(lua_State* state)
     return 0;
 }
 
+int lua_AnimationClip_getLod(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                AnimationClip* instance = getInstance(state);
+                unsigned int result = instance->getLod();
+
+                // Push the return value onto the stack.
+                lua_pushunsigned(state, result);
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_AnimationClip_getLod - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
+int lua_AnimationClip_getLodNode(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                AnimationClip* instance = getInstance(state);
+                void* returnPtr = ((void*)instance->getLodNode());
+                if (returnPtr)
+                {
+                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
+                    object->instance = returnPtr;
+                    object->owns = false;
+                    luaL_getmetatable(state, "Node");
+                    lua_setmetatable(state, -2);
+                }
+                else
+                {
+                    lua_pushnil(state);
+                }
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_AnimationClip_getLodNode - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_AnimationClip_getLoopBlendTime(lua_State* state)
 {
     // Get the number of parameters.
@@ -1441,6 +1524,48 @@ int lua_AnimationClip_setBlendWeight(lua_State* state)
     return 0;
 }
 
+int lua_AnimationClip_setLodNode(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                (lua_type(state, 2) == LUA_TUSERDATA || lua_type(state, 2) == LUA_TTABLE || lua_type(state, 2) == LUA_TNIL))
+            {
+                // Get parameter 1 off the stack.
+                bool param1Valid;
+                gameplay::ScriptUtil::LuaArray<Node> param1 = gameplay::ScriptUtil::getObjectPointer<Node>(2, "Node", false, &param1Valid);
+                if (!param1Valid)
+                {
+                    lua_pushstring(state, "Failed to convert parameter 1 to type 'Node'.");
+                    lua_error(state);
+                }
+
+                AnimationClip* instance = getInstance(state);
+                instance->setLodNode(param1);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_AnimationClip_setLodNode - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_AnimationClip_setLoopBlendTime(lua_State* state)
 {
     // Get the number of parameters.
@@ -22,6 +22,8 @@ int lua_AnimationClip_getDuration(lua_State* state);
 int lua_AnimationClip_getElapsedTime(lua_State* state);
 int lua_AnimationClip_getEndTime(lua_State* state);
 int lua_AnimationClip_getId(lua_State* state);
+int lua_AnimationClip_getLod(lua_State* state);
+int lua_AnimationClip_getLodNode(lua_State* state);
 int lua_AnimationClip_getLoopBlendTime(lua_State* state);
 int lua_AnimationClip_getRefCount(lua_State* state);
 int lua_AnimationClip_getRepeatCount(lua_State* state);
@@ -41,6 +43,7 @@ int lua_AnimationClip_removeScript(lua_State* state);
 int lua_AnimationClip_removeScriptCallback(lua_State* state);
 int lua_AnimationClip_setActiveDuration(lua_State* state);
 int lua_AnimationClip_setBlendWeight(lua_State* state);
+int lua_AnimationClip_setLodNode(lua_State* state);
 int lua_AnimationClip_setLoopBlendTime(lua_State* state);
 int lua_AnimationClip_setRepeatCount(lua_State* state);
 int lua_AnimationClip_setSpeed(lua_State* state);
@@ -14,6 +14,13 @@ void luaRegister_AnimationController()
 {
     const luaL_Reg lua_members[] = 
     {
+        {"getLodClipCount", lua_AnimationController_getLodClipCount},
+        {"getLodScreenSize", lua_AnimationController_getLodScreenSize},
+        {"getLodUpdateInterval", lua_AnimationController_getLodUpdateInterval},
+        {"isLodEnabled", lua_AnimationController_isLodEnabled},
+        {"setLodEnabled", lua_AnimationController_setLodEnabled},
+        {"setLodScreenSize", lua_AnimationController_setLodScreenSize},
+        {"setLodUpdateInterval", lua_AnimationController_setLodUpdateInterval},
         {"stopAllAnimations", lua_AnimationController_stopAllAnimations},
         {NULL, NULL}
     };
@@ -30,6 +37,274 @@ static AnimationController* getInstance(lua_State* state)
     return (AnimationController*)((gameplay::ScriptUtil::LuaObject*)userdata)->instance;
 }
 
+int lua_AnimationController_getLodClipCount(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                lua_type(state, 2) == LUA_TNUMBER)
+            {
+                // Get parameter 1 off the stack.
+                AnimationController::LodLevel param1 = (AnimationController::LodLevel)luaL_checkint(state, 2);
+
+                AnimationController* instance = getInstance(state);
+                unsigned int result = instance->getLodClipCount(param1);
+
+                // Push the return value onto the stack.
+                lua_pushunsigned(state, result);
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_AnimationController_getLodClipCount - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
+int lua_AnimationController_getLodScreenSize(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                lua_type(state, 2) == LUA_TNUMBER)
+            {
+                // Get parameter 1 off the stack.
+                AnimationController::LodLevel param1 = (AnimationController::LodLevel)luaL_checkint(state, 2);
+
+                AnimationController* instance = getInstance(state);
+                float result = instance->getLodScreenSize(param1);
+
+                // Push the return value onto the stack.
+                lua_pushnumber(state, result);
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_AnimationController_getLodScreenSize - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
+int lua_AnimationController_getLodUpdateInterval(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                lua_type(state, 2) == LUA_TNUMBER)
+            {
+                // Get parameter 1 off the stack.
+                AnimationController::LodLevel param1 = (AnimationController::LodLevel)luaL_checkint(state, 2);
+
+                AnimationController* instance = getInstance(state);
+                unsigned int result = instance->getLodUpdateInterval(param1);
+
+                // Push the return value onto the stack.
+                lua_pushunsigned(state, result);
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_AnimationController_getLodUpdateInterval - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
+int lua_AnimationController_isLodEnabled(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                AnimationController* instance = getInstance(state);
+                bool result = instance->isLodEnabled();
+
+                // Push the return value onto the stack.
+                lua_pushboolean(state, result);
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_AnimationController_isLodEnabled - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
+int lua_AnimationController_setLodEnabled(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                lua_type(state, 2) == LUA_TBOOLEAN)
+            {
+                // Get parameter 1 off the stack.
+                bool param1 = gameplay::ScriptUtil::luaCheckBool(state, 2);
+
+                AnimationController* instance = getInstance(state);
+                instance->setLodEnabled(param1);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_AnimationController_setLodEnabled - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
+int lua_AnimationController_setLodScreenSize(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 3:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                lua_type(state, 2) == LUA_TNUMBER &&
+                lua_type(state, 3) == LUA_TNUMBER)
+            {
+                // Get parameter 1 off the stack.
+                AnimationController::LodLevel param1 = (AnimationController::LodLevel)luaL_checkint(state, 2);
+
+                // Get parameter 2 off the stack.
+                float param2 = (float)luaL_checknumber(state, 3);
+
+                AnimationController* instance = getInstance(state);
+                instance->setLodScreenSize(param1, param2);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_AnimationController_setLodScreenSize - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 3).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
+int lua_AnimationController_setLodUpdateInterval(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 3:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                lua_type(state, 2) == LUA_TNUMBER &&
+                lua_type(state, 3) == LUA_TNUMBER)
+            {
+                // Get parameter 1 off the stack.
+                AnimationController::LodLevel param1 = (AnimationController::LodLevel)luaL_checkint(state, 2);
+
+                // Get parameter 2 off the stack.
+                unsigned int param2 = (unsigned int)luaL_checkunsigned(state, 3);
+
+                AnimationController* instance = getInstance(state);
+                instance->setLodUpdateInterval(param1, param2);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_AnimationController_setLodUpdateInterval - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 3).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_AnimationController_stopAllAnimations(lua_State* state)
 {
     // Get the number of parameters.
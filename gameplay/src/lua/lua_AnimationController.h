@@ -6,6 +6,13 @@ namespace gameplay
 {
 
 // Lua bindings for AnimationController.
+int lua_AnimationController_getLodClipCount(lua_State* state);
+int lua_AnimationController_getLodScreenSize(lua_State* state);
+int lua_AnimationController_getLodUpdateInterval(lua_State* state);
+int lua_AnimationController_isLodEnabled(lua_State* state);
+int lua_AnimationController_setLodEnabled(lua_State* state);
+int lua_AnimationController_setLodScreenSize(lua_State* state);
+int lua_AnimationController_setLodUpdateInterval(lua_State* state);
 int lua_AnimationController_stopAllAnimations(lua_State* state);
 
 void luaRegister_AnimationController();
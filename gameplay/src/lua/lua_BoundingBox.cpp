@@ -258,19 +258,7 @@ int lua_BoundingBox_getCenter(lua_State* state)
                 if ((lua_type(state, 1) == LUA_TUSERDATA))
                 {
                     BoundingBox* instance = getInstance(state);
-                    void* returnPtr = (void*)new Vector3(instance->getCenter());
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Vector3");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getCenter(), "Vector3");
 
                     return 1;
                 }
@@ -546,19 +534,7 @@ int lua_BoundingBox_max(lua_State* state)
     }
     else
     {
-        void* returnPtr = (void*)new Vector3(instance->max);
-        if (returnPtr)
-        {
-            gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-            object->instance = returnPtr;
-            object->owns = true;
-            luaL_getmetatable(state, "Vector3");
-            lua_setmetatable(state, -2);
-        }
-        else
-        {
-            lua_pushnil(state);
-        }
+        gameplay::ScriptUtil::pushValue<Vector3>(state, instance->max, "Vector3");
 
         return 1;
     }
@@ -650,19 +626,7 @@ int lua_BoundingBox_min(lua_State* state)
     }
     else
     {
-        void* returnPtr = (void*)new Vector3(instance->min);
-        if (returnPtr)
-        {
-            gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-            object->instance = returnPtr;
-            object->owns = true;
-            luaL_getmetatable(state, "Vector3");
-            lua_setmetatable(state, -2);
-        }
-        else
-        {
-            lua_pushnil(state);
-        }
+        gameplay::ScriptUtil::pushValue<Vector3>(state, instance->min, "Vector3");
 
         return 1;
     }
@@ -212,19 +212,7 @@ int lua_BoundingSphere_center(lua_State* state)
     }
     else
     {
-        void* returnPtr = (void*)new Vector3(instance->center);
-        if (returnPtr)
-        {
-            gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-            object->instance = returnPtr;
-            object->owns = true;
-            luaL_getmetatable(state, "Vector3");
-            lua_setmetatable(state, -2);
-        }
-        else
-        {
-            lua_pushnil(state);
-        }
+        gameplay::ScriptUtil::pushValue<Vector3>(state, instance->center, "Vector3");
 
         return 1;
     }
@@ -33,6 +33,7 @@ void luaRegister_Camera()
         {"getInverseViewProjectionMatrix", lua_Camera_getInverseViewProjectionMatrix},
         {"getNearPlane", lua_Camera_getNearPlane},
         {"getNode", lua_Camera_getNode},
+        {"getProjectedSize", lua_Camera_getProjectedSize},
         {"getProjectionMatrix", lua_Camera_getProjectionMatrix},
         {"getRefCount", lua_Camera_getRefCount},
         {"getViewMatrix", lua_Camera_getViewMatrix},
@@ -536,6 +537,51 @@ int lua_Camera_getNode(lua_State* state)
     return 0;
 }
 
+int lua_Camera_getProjectedSize(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                (lua_type(state, 2) == LUA_TUSERDATA || lua_type(state, 2) == LUA_TNIL))
+            {
+                // Get parameter 1 off the stack.
+                bool param1Valid;
+                gameplay::ScriptUtil::LuaArray<BoundingSphere> param1 = gameplay::ScriptUtil::getObjectPointer<BoundingSphere>(2, "BoundingSphere", true, &param1Valid);
+                if (!param1Valid)
+                {
+                    lua_pushstring(state, "Failed to convert parameter 1 to type 'BoundingSphere'.");
+                    lua_error(state);
+                }
+
+                Camera* instance = getInstance(state);
+                float result = instance->getProjectedSize(*param1);
+
+                // Push the return value onto the stack.
+                lua_pushnumber(state, result);
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_Camera_getProjectedSize - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_Camera_getProjectionMatrix(lua_State* state)
 {
     // Get the number of parameters.
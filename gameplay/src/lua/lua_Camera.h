@@ -18,6 +18,7 @@ int lua_Camera_getInverseViewMatrix(lua_State* state);
 int lua_Camera_getInverseViewProjectionMatrix(lua_State* state);
 int lua_Camera_getNearPlane(lua_State* state);
 int lua_Camera_getNode(lua_State* state);
+int lua_Camera_getProjectedSize(lua_State* state);
 int lua_Camera_getProjectionMatrix(lua_State* state);
 int lua_Camera_getRefCount(lua_State* state);
 int lua_Camera_getViewMatrix(lua_State* state);
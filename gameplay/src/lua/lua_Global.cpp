@@ -3,6 +3,7 @@
 #include "lua_Global.h"
 #include "AIMessage.h"
 #include "AnimationClip.h"
+#include "AnimationController.h"
 #include "AudioSource.h"
 #include "Camera.h"
 #include "Container.h"
@@ -61,7 +62,6 @@ void luaRegister_lua_Global()
     gameplay::ScriptUtil::setGlobalHierarchyPair("Button", "CheckBox");
     gameplay::ScriptUtil::setGlobalHierarchyPair("Button", "RadioButton");
     gameplay::ScriptUtil::setGlobalHierarchyPair("Camera::Listener", "AudioListener");
-    gameplay::ScriptUtil::setGlobalHierarchyPair("Camera::Listener", "TerrainPatch");
     gameplay::ScriptUtil::setGlobalHierarchyPair("Container", "Form");
     gameplay::ScriptUtil::setGlobalHierarchyPair("Control", "Button");
     gameplay::ScriptUtil::setGlobalHierarchyPair("Control", "CheckBox");
@@ -210,6 +210,16 @@ void luaRegister_lua_Global()
         gameplay::ScriptUtil::registerEnumValue(AnimationClip::Listener::TIME, "TIME", scopePath);
     }
 
+    // Register enumeration AnimationController::LodLevel.
+    {
+        std::vector<std::string> scopePath;
+        scopePath.push_back("AnimationController");
+        gameplay::ScriptUtil::registerEnumValue(AnimationController::LOD_FULL, "LOD_FULL", scopePath);
+        gameplay::ScriptUtil::registerEnumValue(AnimationController::LOD_REDUCED, "LOD_REDUCED", scopePath);
+        gameplay::ScriptUtil::registerEnumValue(AnimationController::LOD_LOW, "LOD_LOW", scopePath);
+        gameplay::ScriptUtil::registerEnumValue(AnimationController::LOD_HIDDEN, "LOD_HIDDEN", scopePath);
+    }
+
     // Register enumeration AudioSource::State.
     {
         std::vector<std::string> scopePath;
@@ -1009,6 +1019,19 @@ void luaRegister_lua_Global()
         gameplay::ScriptUtil::registerEnumValue(Touch::TOUCH_MOVE, "TOUCH_MOVE", scopePath);
     }
 
+    // Register enumeration VertexFormat::Type.
+    {
+        std::vector<std::string> scopePath;
+        scopePath.push_back("VertexFormat");
+        gameplay::ScriptUtil::registerEnumValue(VertexFormat::FLOAT, "FLOAT", scopePath);
+        gameplay::ScriptUtil::registerEnumValue(VertexFormat::HALF_FLOAT, "HALF_FLOAT", scopePath);
+        gameplay::ScriptUtil::registerEnumValue(VertexFormat::BYTE, "BYTE", scopePath);
+        gameplay::ScriptUtil::registerEnumValue(VertexFormat::UNSIGNED_BYTE, "UNSIGNED_BYTE", scopePath);
+        gameplay::ScriptUtil::registerEnumValue(VertexFormat::SHORT, "SHORT", scopePath);
+        gameplay::ScriptUtil::registerEnumValue(VertexFormat::UNSIGNED_SHORT, "UNSIGNED_SHORT", scopePath);
+        gameplay::ScriptUtil::registerEnumValue(VertexFormat::INT_2_10_10_10, "INT_2_10_10_10", scopePath);
+    }
+
     // Register enumeration VertexFormat::Usage.
     {
         std::vector<std::string> scopePath;
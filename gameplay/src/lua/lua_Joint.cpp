@@ -49,6 +49,7 @@ void luaRegister_Joint()
         {"getActiveCameraTranslationWorld", lua_Joint_getActiveCameraTranslationWorld},
         {"getAgent", lua_Joint_getAgent},
         {"getAnimation", lua_Joint_getAnimation},
+        {"getAnimationLod", lua_Joint_getAnimationLod},
         {"getAnimationPropertyComponentCount", lua_Joint_getAnimationPropertyComponentCount},
         {"getAnimationPropertyValue", lua_Joint_getAnimationPropertyValue},
         {"getAudioSource", lua_Joint_getAudioSource},
@@ -125,6 +126,7 @@ void luaRegister_Joint()
         {"scaleZ", lua_Joint_scaleZ},
         {"set", lua_Joint_set},
         {"setAgent", lua_Joint_setAgent},
+        {"setAnimationLod", lua_Joint_setAnimationLod},
         {"setAnimationPropertyValue", lua_Joint_setAnimationPropertyValue},
         {"setAudioSource", lua_Joint_setAudioSource},
         {"setCamera", lua_Joint_setCamera},
@@ -1065,19 +1067,7 @@ int lua_Joint_getActiveCameraTranslationView(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Joint* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getActiveCameraTranslationView());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getActiveCameraTranslationView(), "Vector3");
 
                 return 1;
             }
@@ -1109,19 +1099,7 @@ int lua_Joint_getActiveCameraTranslationWorld(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Joint* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getActiveCameraTranslationWorld());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getActiveCameraTranslationWorld(), "Vector3");
 
                 return 1;
             }
@@ -1258,6 +1236,41 @@ int lua_Joint_getAnimation(lua_State* state)
     return 0;
 }
 
+int lua_Joint_getAnimationLod(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                Joint* instance = getInstance(state);
+                int result = instance->getAnimationLod();
+
+                // Push the return value onto the stack.
+                lua_pushinteger(state, result);
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_Joint_getAnimationLod - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_Joint_getAnimationPropertyComponentCount(lua_State* state)
 {
     // Get the number of parameters.
@@ -1402,19 +1415,7 @@ int lua_Joint_getBackVector(lua_State* state)
                 if ((lua_type(state, 1) == LUA_TUSERDATA))
                 {
                     Joint* instance = getInstance(state);
-                    void* returnPtr = (void*)new Vector3(instance->getBackVector());
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Vector3");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getBackVector(), "Vector3");
 
                     return 1;
                 }
@@ -1640,19 +1641,7 @@ int lua_Joint_getDownVector(lua_State* state)
                 if ((lua_type(state, 1) == LUA_TUSERDATA))
                 {
                     Joint* instance = getInstance(state);
-                    void* returnPtr = (void*)new Vector3(instance->getDownVector());
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Vector3");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getDownVector(), "Vector3");
 
                     return 1;
                 }
@@ -1799,19 +1788,7 @@ int lua_Joint_getForwardVector(lua_State* state)
                 if ((lua_type(state, 1) == LUA_TUSERDATA))
                 {
                     Joint* instance = getInstance(state);
-                    void* returnPtr = (void*)new Vector3(instance->getForwardVector());
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Vector3");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getForwardVector(), "Vector3");
 
                     return 1;
                 }
@@ -1868,19 +1845,7 @@ int lua_Joint_getForwardVectorView(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Joint* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getForwardVectorView());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getForwardVectorView(), "Vector3");
 
                 return 1;
             }
@@ -1912,19 +1877,7 @@ int lua_Joint_getForwardVectorWorld(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Joint* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getForwardVectorWorld());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getForwardVectorWorld(), "Vector3");
 
                 return 1;
             }
@@ -2213,19 +2166,7 @@ int lua_Joint_getLeftVector(lua_State* state)
                 if ((lua_type(state, 1) == LUA_TUSERDATA))
                 {
                     Joint* instance = getInstance(state);
-                    void* returnPtr = (void*)new Vector3(instance->getLeftVector());
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Vector3");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getLeftVector(), "Vector3");
 
                     return 1;
                 }
@@ -2583,19 +2524,7 @@ int lua_Joint_getRightVector(lua_State* state)
                 if ((lua_type(state, 1) == LUA_TUSERDATA))
                 {
                     Joint* instance = getInstance(state);
-                    void* returnPtr = (void*)new Vector3(instance->getRightVector());
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Vector3");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getRightVector(), "Vector3");
 
                     return 1;
                 }
@@ -2652,19 +2581,7 @@ int lua_Joint_getRightVectorWorld(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Joint* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getRightVectorWorld());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getRightVectorWorld(), "Vector3");
 
                 return 1;
             }
@@ -3228,19 +3145,7 @@ int lua_Joint_getTranslationView(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Joint* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getTranslationView());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getTranslationView(), "Vector3");
 
                 return 1;
             }
@@ -3272,19 +3177,7 @@ int lua_Joint_getTranslationWorld(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Joint* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getTranslationWorld());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getTranslationWorld(), "Vector3");
 
                 return 1;
             }
@@ -3493,19 +3386,7 @@ int lua_Joint_getUpVector(lua_State* state)
                 if ((lua_type(state, 1) == LUA_TUSERDATA))
                 {
                     Joint* instance = getInstance(state);
-                    void* returnPtr = (void*)new Vector3(instance->getUpVector());
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Vector3");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getUpVector(), "Vector3");
 
                     return 1;
                 }
@@ -3562,19 +3443,7 @@ int lua_Joint_getUpVectorWorld(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Joint* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getUpVectorWorld());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getUpVectorWorld(), "Vector3");
 
                 return 1;
             }
@@ -4916,6 +4785,42 @@ int lua_Joint_setAgent(lua_State* state)
     return 0;
 }
 
+int lua_Joint_setAnimationLod(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                lua_type(state, 2) == LUA_TNUMBER)
+            {
+                // Get parameter 1 off the stack.
+                int param1 = (int)luaL_checkint(state, 2);
+
+                Joint* instance = getInstance(state);
+                instance->setAnimationLod(param1);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_Joint_setAnimationLod - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_Joint_setAnimationPropertyValue(lua_State* state)
 {
     // Get the number of parameters.
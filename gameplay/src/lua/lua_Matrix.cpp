@@ -128,19 +128,7 @@ int lua_Matrix__init(lua_State* state)
     {
         case 0:
         {
-            void* returnPtr = ((void*)new Matrix());
-            if (returnPtr)
-            {
-                gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                object->instance = returnPtr;
-                object->owns = true;
-                luaL_getmetatable(state, "Matrix");
-                lua_setmetatable(state, -2);
-            }
-            else
-            {
-                lua_pushnil(state);
-            }
+            gameplay::ScriptUtil::pushValue<Matrix>(state, Matrix(), "Matrix");
 
             return 1;
             break;
@@ -154,19 +142,7 @@ int lua_Matrix__init(lua_State* state)
                     // Get parameter 1 off the stack.
                     gameplay::ScriptUtil::LuaArray<float> param1 = gameplay::ScriptUtil::getFloatPointer(1);
 
-                    void* returnPtr = ((void*)new Matrix(param1));
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Matrix");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Matrix>(state, Matrix(param1), "Matrix");
 
                     return 1;
                 }
@@ -182,19 +158,7 @@ int lua_Matrix__init(lua_State* state)
                     if (!param1Valid)
                         break;
 
-                    void* returnPtr = ((void*)new Matrix(*param1));
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Matrix");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Matrix>(state, Matrix(*param1), "Matrix");
 
                     return 1;
                 }
@@ -273,19 +237,7 @@ int lua_Matrix__init(lua_State* state)
                     // Get parameter 16 off the stack.
                     float param16 = (float)luaL_checknumber(state, 16);
 
-                    void* returnPtr = ((void*)new Matrix(param1, param2, param3, param4, param5, param6, param7, param8, param9, param10, param11, param12, param13, param14, param15, param16));
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Matrix");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Matrix>(state, Matrix(param1, param2, param3, param4, param5, param6, param7, param8, param9, param10, param11, param12, param13, param14, param15, param16), "Matrix");
 
                     return 1;
                 }
@@ -7,8 +7,14 @@ namespace gameplay
 
 // Lua bindings for Model.
 int lua_Model__gc(lua_State* state);
+int lua_Model_addLod(lua_State* state);
 int lua_Model_addRef(lua_State* state);
 int lua_Model_draw(lua_State* state);
+int lua_Model_getLod(lua_State* state);
+int lua_Model_getLodCount(lua_State* state);
+int lua_Model_getLodHysteresis(lua_State* state);
+int lua_Model_getLodMesh(lua_State* state);
+int lua_Model_getLodScreenSize(lua_State* state);
 int lua_Model_getMaterial(lua_State* state);
 int lua_Model_getMesh(lua_State* state);
 int lua_Model_getMeshPartCount(lua_State* state);
@@ -17,6 +23,8 @@ int lua_Model_getRefCount(lua_State* state);
 int lua_Model_getSkin(lua_State* state);
 int lua_Model_hasMaterial(lua_State* state);
 int lua_Model_release(lua_State* state);
+int lua_Model_setLodHysteresis(lua_State* state);
+int lua_Model_setLodScreenSize(lua_State* state);
 int lua_Model_setMaterial(lua_State* state);
 int lua_Model_static_create(lua_State* state);
 
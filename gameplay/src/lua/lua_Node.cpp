@@ -47,6 +47,7 @@ void luaRegister_Node()
         {"getActiveCameraTranslationWorld", lua_Node_getActiveCameraTranslationWorld},
         {"getAgent", lua_Node_getAgent},
         {"getAnimation", lua_Node_getAnimation},
+        {"getAnimationLod", lua_Node_getAnimationLod},
         {"getAnimationPropertyComponentCount", lua_Node_getAnimationPropertyComponentCount},
         {"getAnimationPropertyValue", lua_Node_getAnimationPropertyValue},
         {"getAudioSource", lua_Node_getAudioSource},
@@ -122,6 +123,7 @@ void luaRegister_Node()
         {"scaleZ", lua_Node_scaleZ},
         {"set", lua_Node_set},
         {"setAgent", lua_Node_setAgent},
+        {"setAnimationLod", lua_Node_setAnimationLod},
         {"setAnimationPropertyValue", lua_Node_setAnimationPropertyValue},
         {"setAudioSource", lua_Node_setAudioSource},
         {"setCamera", lua_Node_setCamera},
@@ -1063,19 +1065,7 @@ int lua_Node_getActiveCameraTranslationView(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Node* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getActiveCameraTranslationView());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getActiveCameraTranslationView(), "Vector3");
 
                 return 1;
             }
@@ -1107,19 +1097,7 @@ int lua_Node_getActiveCameraTranslationWorld(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Node* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getActiveCameraTranslationWorld());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getActiveCameraTranslationWorld(), "Vector3");
 
                 return 1;
             }
@@ -1256,6 +1234,41 @@ int lua_Node_getAnimation(lua_State* state)
     return 0;
 }
 
+int lua_Node_getAnimationLod(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                Node* instance = getInstance(state);
+                int result = instance->getAnimationLod();
+
+                // Push the return value onto the stack.
+                lua_pushinteger(state, result);
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_Node_getAnimationLod - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_Node_getAnimationPropertyComponentCount(lua_State* state)
 {
     // Get the number of parameters.
@@ -1400,19 +1413,7 @@ int lua_Node_getBackVector(lua_State* state)
                 if ((lua_type(state, 1) == LUA_TUSERDATA))
                 {
                     Node* instance = getInstance(state);
-                    void* returnPtr = (void*)new Vector3(instance->getBackVector());
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Vector3");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getBackVector(), "Vector3");
 
                     return 1;
                 }
@@ -1638,19 +1639,7 @@ int lua_Node_getDownVector(lua_State* state)
                 if ((lua_type(state, 1) == LUA_TUSERDATA))
                 {
                     Node* instance = getInstance(state);
-                    void* returnPtr = (void*)new Vector3(instance->getDownVector());
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Vector3");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getDownVector(), "Vector3");
 
                     return 1;
                 }
@@ -1797,19 +1786,7 @@ int lua_Node_getForwardVector(lua_State* state)
                 if ((lua_type(state, 1) == LUA_TUSERDATA))
                 {
                     Node* instance = getInstance(state);
-                    void* returnPtr = (void*)new Vector3(instance->getForwardVector());
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Vector3");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getForwardVector(), "Vector3");
 
                     return 1;
                 }
@@ -1866,19 +1843,7 @@ int lua_Node_getForwardVectorView(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Node* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getForwardVectorView());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getForwardVectorView(), "Vector3");
 
                 return 1;
             }
@@ -1910,19 +1875,7 @@ int lua_Node_getForwardVectorWorld(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Node* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getForwardVectorWorld());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getForwardVectorWorld(), "Vector3");
 
                 return 1;
             }
@@ -2167,19 +2120,7 @@ int lua_Node_getLeftVector(lua_State* state)
                 if ((lua_type(state, 1) == LUA_TUSERDATA))
                 {
                     Node* instance = getInstance(state);
-                    void* returnPtr = (void*)new Vector3(instance->getLeftVector());
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Vector3");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getLeftVector(), "Vector3");
 
                     return 1;
                 }
@@ -2537,19 +2478,7 @@ int lua_Node_getRightVector(lua_State* state)
                 if ((lua_type(state, 1) == LUA_TUSERDATA))
                 {
                     Node* instance = getInstance(state);
-                    void* returnPtr = (void*)new Vector3(instance->getRightVector());
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Vector3");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getRightVector(), "Vector3");
 
                     return 1;
                 }
@@ -2606,19 +2535,7 @@ int lua_Node_getRightVectorWorld(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Node* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getRightVectorWorld());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getRightVectorWorld(), "Vector3");
 
                 return 1;
             }
@@ -3182,19 +3099,7 @@ int lua_Node_getTranslationView(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Node* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getTranslationView());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getTranslationView(), "Vector3");
 
                 return 1;
             }
@@ -3226,19 +3131,7 @@ int lua_Node_getTranslationWorld(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Node* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getTranslationWorld());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getTranslationWorld(), "Vector3");
 
                 return 1;
             }
@@ -3447,19 +3340,7 @@ int lua_Node_getUpVector(lua_State* state)
                 if ((lua_type(state, 1) == LUA_TUSERDATA))
                 {
                     Node* instance = getInstance(state);
-                    void* returnPtr = (void*)new Vector3(instance->getUpVector());
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Vector3");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getUpVector(), "Vector3");
 
                     return 1;
                 }
@@ -3516,19 +3397,7 @@ int lua_Node_getUpVectorWorld(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 Node* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getUpVectorWorld());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getUpVectorWorld(), "Vector3");
 
                 return 1;
             }
@@ -4870,6 +4739,42 @@ int lua_Node_setAgent(lua_State* state)
     return 0;
 }
 
+int lua_Node_setAnimationLod(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                lua_type(state, 2) == LUA_TNUMBER)
+            {
+                // Get parameter 1 off the stack.
+                int param1 = (int)luaL_checkint(state, 2);
+
+                Node* instance = getInstance(state);
+                instance->setAnimationLod(param1);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_Node_setAnimationLod - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_Node_setAnimationPropertyValue(lua_State* state)
 {
     // Get the number of parameters.
@@ -281,19 +281,7 @@ int lua_PhysicsCharacter_getCurrentVelocity(lua_State* state)
             if ((lua_type(state, 1) == LUA_TUSERDATA))
             {
                 PhysicsCharacter* instance = getInstance(state);
-                void* returnPtr = (void*)new Vector3(instance->getCurrentVelocity());
-                if (returnPtr)
-                {
-                    gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                    object->instance = returnPtr;
-                    object->owns = true;
-                    luaL_getmetatable(state, "Vector3");
-                    lua_setmetatable(state, -2);
-                }
-                else
-                {
-                    lua_pushnil(state);
-                }
+                gameplay::ScriptUtil::pushValue<Vector3>(state, instance->getCurrentVelocity(), "Vector3");
 
                 return 1;
             }
@@ -625,19 +625,7 @@ int lua_PhysicsRigidBodyParameters_angularFactor(lua_State* state)
     }
     else
     {
-        void* returnPtr = (void*)new Vector3(instance->angularFactor);
-        if (returnPtr)
-        {
-            gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-            object->instance = returnPtr;
-            object->owns = true;
-            luaL_getmetatable(state, "Vector3");
-            lua_setmetatable(state, -2);
-        }
-        else
-        {
-            lua_pushnil(state);
-        }
+        gameplay::ScriptUtil::pushValue<Vector3>(state, instance->angularFactor, "Vector3");
 
         return 1;
     }
@@ -669,19 +657,7 @@ int lua_PhysicsRigidBodyParameters_anisotropicFriction(lua_State* state)
     }
     else
     {
-        void* returnPtr = (void*)new Vector3(instance->anisotropicFriction);
-        if (returnPtr)
-        {
-            gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-            object->instance = returnPtr;
-            object->owns = true;
-            luaL_getmetatable(state, "Vector3");
-            lua_setmetatable(state, -2);
-        }
-        else
-        {
-            lua_pushnil(state);
-        }
+        gameplay::ScriptUtil::pushValue<Vector3>(state, instance->anisotropicFriction, "Vector3");
 
         return 1;
     }
@@ -800,19 +776,7 @@ int lua_PhysicsRigidBodyParameters_linearFactor(lua_State* state)
     }
     else
     {
-        void* returnPtr = (void*)new Vector3(instance->linearFactor);
-        if (returnPtr)
-        {
-            gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-            object->instance = returnPtr;
-            object->owns = true;
-            luaL_getmetatable(state, "Vector3");
-            lua_setmetatable(state, -2);
-        }
-        else
-        {
-            lua_pushnil(state);
-        }
+        gameplay::ScriptUtil::pushValue<Vector3>(state, instance->linearFactor, "Vector3");
 
         return 1;
     }
@@ -99,19 +99,7 @@ int lua_Quaternion__init(lua_State* state)
     {
         case 0:
         {
-            void* returnPtr = ((void*)new Quaternion());
-            if (returnPtr)
-            {
-                gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                object->instance = returnPtr;
-                object->owns = true;
-                luaL_getmetatable(state, "Quaternion");
-                lua_setmetatable(state, -2);
-            }
-            else
-            {
-                lua_pushnil(state);
-            }
+            gameplay::ScriptUtil::pushValue<Quaternion>(state, Quaternion(), "Quaternion");
 
             return 1;
             break;
@@ -125,19 +113,7 @@ int lua_Quaternion__init(lua_State* state)
                     // Get parameter 1 off the stack.
                     gameplay::ScriptUtil::LuaArray<float> param1 = gameplay::ScriptUtil::getFloatPointer(1);
 
-                    void* returnPtr = ((void*)new Quaternion(param1));
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Quaternion");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Quaternion>(state, Quaternion(param1), "Quaternion");
 
                     return 1;
                 }
@@ -153,19 +129,7 @@ int lua_Quaternion__init(lua_State* state)
                     if (!param1Valid)
                         break;
 
-                    void* returnPtr = ((void*)new Quaternion(*param1));
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Quaternion");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Quaternion>(state, Quaternion(*param1), "Quaternion");
 
                     return 1;
                 }
@@ -181,19 +145,7 @@ int lua_Quaternion__init(lua_State* state)
                     if (!param1Valid)
                         break;
 
-                    void* returnPtr = ((void*)new Quaternion(*param1));
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Quaternion");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Quaternion>(state, Quaternion(*param1), "Quaternion");
 
                     return 1;
                 }
@@ -219,19 +171,7 @@ int lua_Quaternion__init(lua_State* state)
                     // Get parameter 2 off the stack.
                     float param2 = (float)luaL_checknumber(state, 2);
 
-                    void* returnPtr = ((void*)new Quaternion(*param1, param2));
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Quaternion");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Quaternion>(state, Quaternion(*param1, param2), "Quaternion");
 
                     return 1;
                 }
@@ -262,19 +202,7 @@ int lua_Quaternion__init(lua_State* state)
                     // Get parameter 4 off the stack.
                     float param4 = (float)luaL_checknumber(state, 4);
 
-                    void* returnPtr = ((void*)new Quaternion(param1, param2, param3, param4));
-                    if (returnPtr)
-                    {
-                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
-                        object->instance = returnPtr;
-                        object->owns = true;
-                        luaL_getmetatable(state, "Quaternion");
-                        lua_setmetatable(state, -2);
-                    }
-                    else
-                    {
-                        lua_pushnil(state);
-                    }
+                    gameplay::ScriptUtil::pushValue<Quaternion>(state, Quaternion(param1, param2, param3, param4), "Quaternion");
 
                     return 1;
                 }
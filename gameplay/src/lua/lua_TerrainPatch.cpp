@@ -19,7 +19,6 @@ void luaRegister_TerrainPatch()
 {
     const luaL_Reg lua_members[] = 
     {
-        {"cameraChanged", lua_TerrainPatch_cameraChanged},
         {"getBoundingBox", lua_TerrainPatch_getBoundingBox},
         {"getMaterial", lua_TerrainPatch_getMaterial},
         {"getMaterialCount", lua_TerrainPatch_getMaterialCount},
@@ -38,48 +37,6 @@ static TerrainPatch* getInstance(lua_State* state)
     return (TerrainPatch*)((gameplay::ScriptUtil::LuaObject*)userdata)->instance;
 }
 
-int lua_TerrainPatch_cameraChanged(lua_State* state)
-{
-    // Get the number of parameters.
-    int paramCount = lua_gettop(state);
-
-    // Attempt to match the parameters to a valid binding.
-    switch (paramCount)
-    {
-        case 2:
-        {
-            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
-                (lua_type(state, 2) == LUA_TUSERDATA || lua_type(state, 2) == LUA_TTABLE || lua_type(state, 2) == LUA_TNIL))
-            {
-                // Get parameter 1 off the stack.
-                bool param1Valid;
-                gameplay::ScriptUtil::LuaArray<Camera> param1 = gameplay::ScriptUtil::getObjectPointer<Camera>(2, "Camera", false, &param1Valid);
-                if (!param1Valid)
-                {
-                    lua_pushstring(state, "Failed to convert parameter 1 to type 'Camera'.");
-                    lua_error(state);
-                }
-
-                TerrainPatch* instance = getInstance(state);
-                instance->cameraChanged(param1);
-                
-                return 0;
-            }
-
-            lua_pushstring(state, "lua_TerrainPatch_cameraChanged - Failed to match the given parameters to a valid function signature.");
-            lua_error(state);
-            break;
-        }
-        default:
-        {
-            lua_pushstring(state, "Invalid number of parameters (expected 2).");
-            lua_error(state);
-            break;
-        }
-    }
-    return 0;
-}
-
 int lua_TerrainPatch_getBoundingBox(lua_State* state)
 {
     // Get the number of parameters.
@@ -6,7 +6,6 @@ namespace gameplay
 {
 
 // Lua bindings for TerrainPatch.
-int lua_TerrainPatch_cameraChanged(lua_State* state);
 int lua_TerrainPatch_getBoundingBox(lua_State* state);
 int lua_TerrainPatch_getMaterial(lua_State* state);
 int lua_TerrainPatch_getMaterialCount(lua_State* state);
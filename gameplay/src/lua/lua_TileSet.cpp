@@ -20,6 +20,7 @@ void luaRegister_TileSet()
     {
         {"addRef", lua_TileSet_addRef},
         {"draw", lua_TileSet_draw},
+        {"getChunkRebuildCount", lua_TileSet_getChunkRebuildCount},
         {"getColor", lua_TileSet_getColor},
         {"getColumnCount", lua_TileSet_getColumnCount},
         {"getHeight", lua_TileSet_getHeight},
@@ -30,6 +31,7 @@ void luaRegister_TileSet()
         {"getTileHeight", lua_TileSet_getTileHeight},
         {"getTileSource", lua_TileSet_getTileSource},
         {"getTileWidth", lua_TileSet_getTileWidth},
+        {"getVisibleChunkCount", lua_TileSet_getVisibleChunkCount},
         {"getWidth", lua_TileSet_getWidth},
         {"release", lua_TileSet_release},
         {"setColor", lua_TileSet_setColor},
@@ -180,6 +182,41 @@ int lua_TileSet_draw(lua_State* state)
     return 0;
 }
 
+int lua_TileSet_getChunkRebuildCount(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                TileSet* instance = getInstance(state);
+                unsigned int result = instance->getChunkRebuildCount();
+
+                // Push the return value onto the stack.
+                lua_pushunsigned(state, result);
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_TileSet_getChunkRebuildCount - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_TileSet_getColor(lua_State* state)
 {
     // Get the number of parameters.
@@ -563,6 +600,41 @@ int lua_TileSet_getTileWidth(lua_State* state)
     return 0;
 }
 
+int lua_TileSet_getVisibleChunkCount(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                TileSet* instance = getInstance(state);
+                unsigned int result = instance->getVisibleChunkCount();
+
+                // Push the return value onto the stack.
+                lua_pushunsigned(state, result);
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_TileSet_getVisibleChunkCount - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_TileSet_getWidth(lua_State* state)
 {
     // Get the number of parameters.
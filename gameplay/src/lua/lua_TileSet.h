@@ -9,6 +9,7 @@ namespace gameplay
 int lua_TileSet__gc(lua_State* state);
 int lua_TileSet_addRef(lua_State* state);
 int lua_TileSet_draw(lua_State* state);
+int lua_TileSet_getChunkRebuildCount(lua_State* state);
 int lua_TileSet_getColor(lua_State* state);
 int lua_TileSet_getColumnCount(lua_State* state);
 int lua_TileSet_getHeight(lua_State* state);
@@ -19,6 +20,7 @@ int lua_TileSet_getRowCount(lua_State* state);
 int lua_TileSet_getTileHeight(lua_State* state);
 int lua_TileSet_getTileSource(lua_State* state);
 int lua_TileSet_getTileWidth(lua_State* state);
+int lua_TileSet_getVisibleChunkCount(lua_State* state);
 int lua_TileSet_getWidth(lua_State* state);
 int lua_TileSet_release(lua_State* state);
 int lua_TileSet_setColor(lua_State* state);
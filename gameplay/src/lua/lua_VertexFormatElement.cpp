@@ -12,7 +12,10 @@ void luaRegister_VertexFormatElement()
 {
     const luaL_Reg lua_members[] = 
     {
+        {"getSizeInBytes", lua_VertexFormatElement_getSizeInBytes},
+        {"normalized", lua_VertexFormatElement_normalized},
         {"size", lua_VertexFormatElement_size},
+        {"type", lua_VertexFormatElement_type},
         {"usage", lua_VertexFormatElement_usage},
         {NULL, NULL}
     };
@@ -130,9 +133,126 @@ int lua_VertexFormatElement__init(lua_State* state)
             lua_error(state);
             break;
         }
+        case 3:
+        {
+            do
+            {
+                if (lua_type(state, 1) == LUA_TNUMBER &&
+                    lua_type(state, 2) == LUA_TNUMBER &&
+                    lua_type(state, 3) == LUA_TNUMBER)
+                {
+                    // Get parameter 1 off the stack.
+                    VertexFormat::Usage param1 = (VertexFormat::Usage)luaL_checkint(state, 1);
+
+                    // Get parameter 2 off the stack.
+                    unsigned int param2 = (unsigned int)luaL_checkunsigned(state, 2);
+
+                    // Get parameter 3 off the stack.
+                    VertexFormat::Type param3 = (VertexFormat::Type)luaL_checkint(state, 3);
+
+                    void* returnPtr = ((void*)new VertexFormat::Element(param1, param2, param3));
+                    if (returnPtr)
+                    {
+                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
+                        object->instance = returnPtr;
+                        object->owns = true;
+                        luaL_getmetatable(state, "VertexFormatElement");
+                        lua_setmetatable(state, -2);
+                    }
+                    else
+                    {
+                        lua_pushnil(state);
+                    }
+
+                    return 1;
+                }
+            } while (0);
+
+            lua_pushstring(state, "lua_VertexFormatElement__init - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        case 4:
+        {
+            do
+            {
+                if (lua_type(state, 1) == LUA_TNUMBER &&
+                    lua_type(state, 2) == LUA_TNUMBER &&
+                    lua_type(state, 3) == LUA_TNUMBER &&
+                    lua_type(state, 4) == LUA_TBOOLEAN)
+                {
+                    // Get parameter 1 off the stack.
+                    VertexFormat::Usage param1 = (VertexFormat::Usage)luaL_checkint(state, 1);
+
+                    // Get parameter 2 off the stack.
+                    unsigned int param2 = (unsigned int)luaL_checkunsigned(state, 2);
+
+                    // Get parameter 3 off the stack.
+                    VertexFormat::Type param3 = (VertexFormat::Type)luaL_checkint(state, 3);
+
+                    // Get parameter 4 off the stack.
+                    bool param4 = gameplay::ScriptUtil::luaCheckBool(state, 4);
+
+                    void* returnPtr = ((void*)new VertexFormat::Element(param1, param2, param3, param4));
+                    if (returnPtr)
+                    {
+                        gameplay::ScriptUtil::LuaObject* object = (gameplay::ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(gameplay::ScriptUtil::LuaObject));
+                        object->instance = returnPtr;
+                        object->owns = true;
+                        luaL_getmetatable(state, "VertexFormatElement");
+                        lua_setmetatable(state, -2);
+                    }
+                    else
+                    {
+                        lua_pushnil(state);
+                    }
+
+                    return 1;
+                }
+            } while (0);
+
+            lua_pushstring(state, "lua_VertexFormatElement__init - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 0, 2, 3 or 4).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
+int lua_VertexFormatElement_getSizeInBytes(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                VertexFormat::Element* instance = getInstance(state);
+                unsigned int result = instance->getSizeInBytes();
+
+                // Push the return value onto the stack.
+                lua_pushunsigned(state, result);
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_VertexFormatElement_getSizeInBytes - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
         default:
         {
-            lua_pushstring(state, "Invalid number of parameters (expected 0 or 2).");
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
             lua_error(state);
             break;
         }
@@ -140,6 +260,35 @@ int lua_VertexFormatElement__init(lua_State* state)
     return 0;
 }
 
+int lua_VertexFormatElement_normalized(lua_State* state)
+{
+    // Validate the number of parameters.
+    if (lua_gettop(state) > 2)
+    {
+        lua_pushstring(state, "Invalid number of parameters (expected 1 or 2).");
+        lua_error(state);
+    }
+
+    VertexFormat::Element* instance = getInstance(state);
+    if (lua_gettop(state) == 2)
+    {
+        // Get parameter 2 off the stack.
+        bool param2 = gameplay::ScriptUtil::luaCheckBool(state, 2);
+
+        instance->normalized = param2;
+        return 0;
+    }
+    else
+    {
+        bool result = instance->normalized;
+
+        // Push the return value onto the stack.
+        lua_pushboolean(state, result);
+
+        return 1;
+    }
+}
+
 int lua_VertexFormatElement_size(lua_State* state)
 {
     // Validate the number of parameters.
@@ -169,6 +318,35 @@ int lua_VertexFormatElement_size(lua_State* state)
     }
 }
 
+int lua_VertexFormatElement_type(lua_State* state)
+{
+    // Validate the number of parameters.
+    if (lua_gettop(state) > 2)
+    {
+        lua_pushstring(state, "Invalid number of parameters (expected 1 or 2).");
+        lua_error(state);
+    }
+
+    VertexFormat::Element* instance = getInstance(state);
+    if (lua_gettop(state) == 2)
+    {
+        // Get parameter 2 off the stack.
+        VertexFormat::Type param2 = (VertexFormat::Type)luaL_checkint(state, 2);
+
+        instance->type = param2;
+        return 0;
+    }
+    else
+    {
+        VertexFormat::Type result = instance->type;
+
+        // Push the return value onto the stack.
+        lua_pushnumber(state, (int)result);
+
+        return 1;
+    }
+}
+
 int lua_VertexFormatElement_usage(lua_State* state)
 {
     // Validate the number of parameters.
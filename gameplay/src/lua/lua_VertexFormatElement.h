@@ -8,7 +8,10 @@ namespace gameplay
 // Lua bindings for VertexFormat::Element.
 int lua_VertexFormatElement__gc(lua_State* state);
 int lua_VertexFormatElement__init(lua_State* state);
+int lua_VertexFormatElement_getSizeInBytes(lua_State* state);
+int lua_VertexFormatElement_normalized(lua_State* state);
 int lua_VertexFormatElement_size(lua_State* state);
+int lua_VertexFormatElement_type(lua_State* state);
 int lua_VertexFormatElement_usage(lua_State* state);
 
 void luaRegister_VertexFormatElement();
@@ -0,0 +1,348 @@
+#include "BenchmarkGame.h"
+
+// Declare our game instance
+BenchmarkGame game;
+
+// Frames measured in each scenario when the config does not specify it
+#define DEFAULT_FRAME_COUNT 300
+
+// Models scenario: a grid of ducks, each with its own material
+#define MODEL_GRID_SIZE 20
+#define MODEL_SPACING 2.0f
+
+// Sprites scenario: moving and rotating sprites drawn with one sprite batch
+#define SPRITE_COUNT 2000
+#define SPRITE_SIZE 32.0f
+
+// Terrain scenario: a camera flying over the terrain
+#define TERRAIN_CAMERA_HEIGHT 1500.0f
+#define TERRAIN_CAMERA_SPEED 2.0f
+
+// Tile set scenario: a camera scrolling over a large tile set that changes a tile every frame
+#define TILESET_SIZE 512
+#define TILESET_TILE_SIZE 32.0f
+#define TILESET_CAMERA_SPEED 0.5f
+
+// Characters scenarios: a crowd of skinned, animated characters, with and without animation LOD
+#define CHARACTER_COLUMNS 40
+#define CHARACTER_ROWS 25
+#define CHARACTER_SPACING 10.0f
+
+static const char* SCENARIO_NAMES[] = { "models", "sprites", "terrain", "tileset", "chars", "chars-lod" };
+
+BenchmarkGame::BenchmarkGame()
+    : _scene(NULL), _spriteBatch(NULL), _tileSet(NULL), _scenario(MODELS), _scenarioFrame(0), _frameCount(DEFAULT_FRAME_COUNT)
+{
+    memset(&_totals, 0, sizeof(_totals));
+}
+
+BenchmarkGame::~BenchmarkGame()
+{
+}
+
+void BenchmarkGame::initialize()
+{
+    Properties* config = getConfig()->getNamespace("benchmark", true);
+    if (config && config->getInt("frames") > 0)
+        _frameCount = (unsigned int)config->getInt("frames");
+
+#ifdef GP_GL_RECORDER
+    print("Benchmark: %u frames per scenario, %s.\n", _frameCount, GLRecorder::isNullBackend() ? "null GL backend" : "GL driver");
+#else
+    print("Benchmark: %u frames per scenario. Build with GP_GL_RECORDER to count GL calls.\n", _frameCount);
+#endif
+    print("%-10s %9s %8s %10s %8s %8s %8s %9s %9s %8s %9s\n",
+        "scenario", "ms/frame", "draws", "vertices", "states", "buffers", "textures", "uniforms", "KB", "binds", "rebuilds");
+}
+
+void BenchmarkGame::finalize()
+{
+    unloadScenario();
+}
+
+void BenchmarkGame::update(float elapsedTime)
+{
+    if (_scenario == SCENARIO_COUNT)
+        return;
+
+    // The statistics of a frame are stored when Game::frame ends it, so the previous frame
+    // is measured here. The first frame of a scenario loads it and is not measured.
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (_scenarioFrame > 1)
+        measureFrame(std::chrono::duration<double, std::milli>(now - _frameStart).count());
+    _frameStart = now;
+
+    if (_scenarioFrame > _frameCount)
+    {
+        printScenario();
+        unloadScenario();
+        _scenario = (Scenario)(_scenario + 1);
+        if (_scenario == SCENARIO_COUNT)
+        {
+            exit();
+            return;
+        }
+        _scenarioFrame = 0;
+    }
+    if (_scenarioFrame == 0)
+    {
+        memset(&_totals, 0, sizeof(_totals));
+        loadScenario();
+    }
+    ++_scenarioFrame;
+
+    switch (_scenario)
+    {
+    case MODELS:
+        for (Node* node = _scene->getFirstNode(); node != NULL; node = node->getNextSibling())
+        {
+            if (node->getDrawable())
+                node->rotateY(elapsedTime * 0.001f);
+        }
+        break;
+
+    case TERRAIN:
+        _scene->getActiveCamera()->getNode()->translateForward(elapsedTime * TERRAIN_CAMERA_SPEED);
+        break;
+
+    case TILESET:
+        {
+            // Scroll diagonally and change the tile under the center of the view, which
+            // dirties the chunk that holds it.
+            Node* cameraNode = _scene->getActiveCamera()->getNode();
+            cameraNode->translate(elapsedTime * TILESET_CAMERA_SPEED, elapsedTime * TILESET_CAMERA_SPEED * 0.5f, 0.0f);
+            unsigned int column = (unsigned int)(cameraNode->getTranslationX() / TILESET_TILE_SIZE) % TILESET_SIZE;
+            unsigned int row = TILESET_SIZE - 1 - (unsigned int)(cameraNode->getTranslationY() / TILESET_TILE_SIZE) % TILESET_SIZE;
+            _tileSet->setTileSource(column, row, Vector2(_scenarioFrame % 2 ? TILESET_TILE_SIZE : 0.0f, 0.0f));
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void BenchmarkGame::render(float elapsedTime)
+{
+    clear(CLEAR_COLOR_DEPTH, Vector4::zero(), 1.0f, 0);
+
+    switch (_scenario)
+    {
+    case MODELS:
+    case TERRAIN:
+    case TILESET:
+    case CHARACTERS:
+    case CHARACTERS_LOD:
+        if (_scene)
+            _scene->visit(this, &BenchmarkGame::drawNode);
+        break;
+
+    case SPRITES:
+        if (_spriteBatch)
+        {
+            // Every sprite moves and turns each frame, so the whole batch is rewritten.
+            float time = (float)_scenarioFrame * 0.02f;
+            Rectangle src(0, 0, (float)_spriteBatch->getSampler()->getTexture()->getWidth(), (float)_spriteBatch->getSampler()->getTexture()->getHeight());
+            _spriteBatch->start();
+            for (unsigned int i = 0; i < SPRITE_COUNT; ++i)
+            {
+                float x = (float)(i % 50) * (getWidth() / 50.0f) + sin(time + i) * SPRITE_SIZE;
+                float y = (float)(i / 50) * (getHeight() / 40.0f);
+                _spriteBatch->draw(Vector3(x, y, 0), src, Vector2(SPRITE_SIZE, SPRITE_SIZE), Vector4::one(), Vector2(0.5f, 0.5f), time + i);
+            }
+            _spriteBatch->finish();
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void BenchmarkGame::loadScenario()
+{
+    switch (_scenario)
+    {
+    case MODELS:
+        {
+            _scene = Scene::create();
+            Camera* camera = Camera::createPerspective(45.0f, getAspectRatio(), 1.0f, 200.0f);
+            Node* cameraNode = _scene->addNode("camera");
+            cameraNode->setCamera(camera);
+            cameraNode->setTranslation(0.0f, 25.0f, 35.0f);
+            cameraNode->rotateX(MATH_DEG_TO_RAD(-35.0f));
+            _scene->setActiveCamera(camera);
+            SAFE_RELEASE(camera);
+
+            Bundle* bundle = Bundle::create("res/common/duck.gpb");
+            Node* duck = bundle->loadNode("duck");
+            SAFE_RELEASE(bundle);
+            static_cast<Model*>(duck->getDrawable())->setMaterial("res/common/benchmark.material#duck");
+            for (unsigned int i = 0; i < MODEL_GRID_SIZE * MODEL_GRID_SIZE; ++i)
+            {
+                Node* node = duck->clone();
+                node->setTranslation(((float)(i % MODEL_GRID_SIZE) - MODEL_GRID_SIZE * 0.5f) * MODEL_SPACING, 0.0f,
+                                     ((float)(i / MODEL_GRID_SIZE) - MODEL_GRID_SIZE * 0.5f) * MODEL_SPACING);
+                _scene->addNode(node);
+                SAFE_RELEASE(node);
+            }
+            SAFE_RELEASE(duck);
+        }
+        break;
+
+    case SPRITES:
+        _spriteBatch = SpriteBatch::create("res/png/logo.png", NULL, SPRITE_COUNT);
+        break;
+
+    case TERRAIN:
+        {
+            _scene = Scene::create();
+            Camera* camera = Camera::createPerspective(45.0f, getAspectRatio(), 1.0f, 20000.0f);
+            Node* cameraNode = _scene->addNode("camera");
+            cameraNode->setCamera(camera);
+            cameraNode->setTranslation(0.0f, TERRAIN_CAMERA_HEIGHT, 4000.0f);
+            cameraNode->rotateX(MATH_DEG_TO_RAD(-20.0f));
+            _scene->setActiveCamera(camera);
+            SAFE_RELEASE(camera);
+
+            Terrain* terrain = Terrain::create("res/common/benchmark.terrain");
+            _scene->addNode("terrain")->setDrawable(terrain);
+            SAFE_RELEASE(terrain);
+        }
+        break;
+
+    case TILESET:
+        {
+            _scene = Scene::create();
+            Camera* camera = Camera::createOrthographic(getWidth(), getHeight(), getAspectRatio(), 0.0f, 1.0f);
+            Node* cameraNode = _scene->addNode("camera");
+            cameraNode->setCamera(camera);
+            cameraNode->setTranslation(getWidth() * 0.5f, getHeight() * 0.5f, 0.0f);
+            _scene->setActiveCamera(camera);
+            SAFE_RELEASE(camera);
+
+            _tileSet = TileSet::create("res/png/logo.png", TILESET_TILE_SIZE, TILESET_TILE_SIZE, TILESET_SIZE, TILESET_SIZE);
+            for (unsigned int row = 0; row < TILESET_SIZE; ++row)
+            {
+                for (unsigned int column = 0; column < TILESET_SIZE; ++column)
+                    _tileSet->setTileSource(column, row, Vector2((column + row) % 2 ? TILESET_TILE_SIZE : 0.0f, 0.0f));
+            }
+            _scene->addNode("tileset")->setDrawable(_tileSet);
+        }
+        break;
+
+    case CHARACTERS:
+        loadCharacters(false);
+        break;
+
+    case CHARACTERS_LOD:
+        loadCharacters(true);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void BenchmarkGame::loadCharacters(bool lodEnabled)
+{
+    getAnimationController()->setLodEnabled(lodEnabled);
+
+    _scene = Scene::create();
+    Camera* camera = Camera::createPerspective(45.0f, getAspectRatio(), 1.0f, 500.0f);
+    Node* cameraNode = _scene->addNode("camera");
+    cameraNode->setCamera(camera);
+    cameraNode->setTranslation(0.0f, 20.0f, 40.0f);
+    cameraNode->rotateX(MATH_DEG_TO_RAD(-10.0f));
+    _scene->setActiveCamera(camera);
+    SAFE_RELEASE(camera);
+
+    // The grid is wider than the view, so part of the crowd is off screen and part of it
+    // is small in the distance.
+    Scene* characterScene = Scene::load("res/common/sample.gpb");
+    Node* character = characterScene->findNode("boycharacter");
+    static_cast<Model*>(character->findNode("boymesh")->getDrawable())->setMaterial("res/common/benchmark.material#boy");
+    character->getAnimation("animations")->createClips("res/common/boy.animation");
+    for (unsigned int i = 0; i < CHARACTER_COLUMNS * CHARACTER_ROWS; ++i)
+    {
+        Node* node = character->clone();
+        node->setTranslation(((float)(i % CHARACTER_COLUMNS) - CHARACTER_COLUMNS * 0.5f) * CHARACTER_SPACING, 0.0f,
+                             -(float)(i / CHARACTER_COLUMNS) * CHARACTER_SPACING);
+        AnimationClip* clip = node->getAnimation()->getClip(i % 2 ? "walking" : "running");
+        clip->play();
+        _scene->addNode(node);
+        SAFE_RELEASE(node);
+    }
+    SAFE_RELEASE(characterScene);
+}
+
+void BenchmarkGame::unloadScenario()
+{
+    getAnimationController()->stopAllAnimations();
+    SAFE_RELEASE(_tileSet);
+    SAFE_RELEASE(_scene);
+    SAFE_DELETE(_spriteBatch);
+}
+
+void BenchmarkGame::measureFrame(double milliseconds)
+{
+    ++_totals.frames;
+    _totals.milliseconds += milliseconds;
+#ifdef GP_GL_RECORDER
+    const GLRecorder::Statistics& statistics = GLRecorder::getFrameStatistics();
+    _totals.drawCalls += statistics.drawCalls;
+    _totals.vertices += statistics.vertices;
+    _totals.stateChanges += statistics.stateChanges;
+    _totals.bufferUploads += statistics.bufferUploads;
+    _totals.textureUploads += statistics.textureUploads;
+    _totals.uniformUploads += statistics.uniformUploads;
+    _totals.bytesUploaded += statistics.bytesUploaded;
+#endif
+    _totals.parameterBinds += RenderState::getParameterBindCount();
+    _totals.parameterBindingRebuilds += RenderState::getParameterBindingRebuildCount();
+    if (_tileSet)
+    {
+        _totals.visibleChunks += _tileSet->getVisibleChunkCount();
+        _totals.chunkRebuilds += _tileSet->getChunkRebuildCount();
+    }
+    for (unsigned int i = 0; i <= AnimationController::LOD_HIDDEN; ++i)
+        _totals.lodClips[i] += getAnimationController()->getLodClipCount((AnimationController::LodLevel)i);
+}
+
+void BenchmarkGame::printScenario()
+{
+    double frames = (double)std::max(_totals.frames, 1u);
+    print("%-10s %9.3f %8.1f %10.1f %8.1f %8.1f %8.1f %9.1f %9.1f %8.1f %9.2f\n",
+        SCENARIO_NAMES[_scenario],
+        _totals.milliseconds / frames,
+        _totals.drawCalls / frames,
+        _totals.vertices / frames,
+        _totals.stateChanges / frames,
+        _totals.bufferUploads / frames,
+        _totals.textureUploads / frames,
+        _totals.uniformUploads / frames,
+        _totals.bytesUploaded / frames / 1024.0,
+        _totals.parameterBinds / frames,
+        _totals.parameterBindingRebuilds / frames);
+    if (_scenario == TILESET)
+        print("%-10s %.1f visible chunks, %.2f chunk rebuilds per frame\n", "", _totals.visibleChunks / frames, _totals.chunkRebuilds / frames);
+    if (_scenario == CHARACTERS || _scenario == CHARACTERS_LOD)
+    {
+        print("%-10s clips per frame: %.1f full, %.1f reduced, %.1f low, %.1f hidden\n", "",
+            _totals.lodClips[AnimationController::LOD_FULL] / frames, _totals.lodClips[AnimationController::LOD_REDUCED] / frames,
+            _totals.lodClips[AnimationController::LOD_LOW] / frames, _totals.lodClips[AnimationController::LOD_HIDDEN] / frames);
+    }
+}
+
+bool BenchmarkGame::drawNode(Node* node)
+{
+    // Skip models that are out of view, and parts of the characters that have no material here (their shadows).
+    Drawable* drawable = node->getDrawable();
+    Model* model = dynamic_cast<Model*>(drawable);
+    if (model && (!model->getMaterial() || !node->getBoundingSphere().intersects(_scene->getActiveCamera()->getFrustum())))
+        return true;
+
+    if (drawable)
+        drawable->draw();
+    return true;
+}
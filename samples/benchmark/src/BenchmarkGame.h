@@ -0,0 +1,136 @@
+#ifndef BENCHMARKGAME_H_
+#define BENCHMARKGAME_H_
+
+#include "gameplay.h"
+
+using namespace gameplay;
+
+/**
+ * Benchmark game.
+ *
+ * Runs a fixed set of rendering scenarios one after the other for a configured number
+ * of frames each, prints the average frame time and GL call counts of every scenario,
+ * and exits. It is meant to be built with GP_HEADLESS and GP_GL_RECORDER, which run the
+ * full render path against the null GL backend and count the GL calls it makes.
+ */
+class BenchmarkGame : public Game
+{
+public:
+
+    /**
+     * Constructor.
+     */
+    BenchmarkGame();
+
+    /**
+     * Destructor.
+     */
+    virtual ~BenchmarkGame();
+
+protected:
+
+    /**
+     * @see Game::initialize
+     */
+    void initialize();
+
+    /**
+     * @see Game::finalize
+     */
+    void finalize();
+
+    /**
+     * @see Game::update
+     */
+    void update(float elapsedTime);
+
+    /**
+     * @see Game::render
+     */
+    void render(float elapsedTime);
+
+private:
+
+    /**
+     * The scenarios, in the order they are run.
+     */
+    enum Scenario
+    {
+        MODELS,
+        SPRITES,
+        TERRAIN,
+        TILESET,
+        CHARACTERS,
+        CHARACTERS_LOD,
+        SCENARIO_COUNT
+    };
+
+    /**
+     * Totals of the measured frames of the current scenario.
+     */
+    struct Totals
+    {
+        unsigned int frames;
+        double milliseconds;
+        unsigned long long drawCalls;
+        unsigned long long vertices;
+        unsigned long long stateChanges;
+        unsigned long long bufferUploads;
+        unsigned long long textureUploads;
+        unsigned long long uniformUploads;
+        unsigned long long bytesUploaded;
+        unsigned long long parameterBinds;
+        unsigned long long parameterBindingRebuilds;
+        unsigned long long visibleChunks;
+        unsigned long long chunkRebuilds;
+        unsigned long long lodClips[AnimationController::LOD_HIDDEN + 1];
+    };
+
+    /**
+     * Loads the resources of the current scenario.
+     */
+    void loadScenario();
+
+    /**
+     * Loads a grid of animated characters.
+     *
+     * @param lodEnabled true to evaluate their clips at animation levels of detail.
+     */
+    void loadCharacters(bool lodEnabled);
+
+    /**
+     * Releases the resources of the current scenario.
+     */
+    void unloadScenario();
+
+    /**
+     * Adds the statistics of the last frame to the totals of the current scenario.
+     *
+     * @param milliseconds The time the frame took.
+     */
+    void measureFrame(double milliseconds);
+
+    /**
+     * Prints the averages of the current scenario.
+     */
+    void printScenario();
+
+    /**
+     * Draws the drawable of a node.
+     *
+     * @param node The node to draw.
+     * @return true to continue visiting the scene.
+     */
+    bool drawNode(Node* node);
+
+    Scene* _scene;
+    SpriteBatch* _spriteBatch;
+    TileSet* _tileSet;
+    Scenario _scenario;
+    unsigned int _scenarioFrame;
+    unsigned int _frameCount;
+    std::chrono::steady_clock::time_point _frameStart;
+    Totals _totals;
+};
+
+#endif
@@ -1,12 +1,25 @@
 #include "Base.h"
 #include "AnimationChannel.h"
 #include "Transform.h"
+#include "Quaternion.h"
+
+// Largest quantized value of a key time or scalar component (16 bits)
+#define QUANTIZED_MAX 65535.0f
+
+// Largest quantized value of a quaternion component (15 bits)
+#define QUANTIZED_QUATERNION_MAX 32767.0f
+
+// Range of the three smallest components of a unit quaternion: [-1/sqrt(2), 1/sqrt(2)]
+#define QUATERNION_COMPONENT_MAX 0.70710678118654752440f
+
+// The most keys removed between two kept keys, which bounds the time spent reducing long channels
+#define KEY_REDUCTION_MAX_SPAN 1024
 
 namespace gameplay
 {
 
 AnimationChannel::AnimationChannel(void) :
-    _targetAttrib(0)
+    _targetAttrib(0), _compressedDuration(0)
 {
 }
 
@@ -28,6 +41,27 @@ void AnimationChannel::writeBinary(FILE* file)
     Object::writeBinary(file);
     write(_targetId, file);
     write(_targetAttrib, file);
+    write((unsigned char)(isCompressed() ? 1 : 0), file);
+    if (isCompressed())
+    {
+        write((unsigned int)_compressedTimes.size(), file);
+        write(_compressedDuration, file);
+        for (std::vector<unsigned short>::const_iterator i = _compressedTimes.begin(); i != _compressedTimes.end(); ++i)
+        {
+            write(*i, file);
+        }
+        write((unsigned int)getQuaternionOffset(), file);
+        write(Transform::getPropertySize(_targetAttrib), file);
+        for (std::vector<float>::const_iterator i = _compressedRanges.begin(); i != _compressedRanges.end(); ++i)
+        {
+            write(*i, file);
+        }
+        for (std::vector<unsigned short>::const_iterator i = _compressedValues.begin(); i != _compressedValues.end(); ++i)
+        {
+            write(*i, file);
+        }
+        return;
+    }
     write((unsigned int)_keytimes.size(), file);
     for (std::vector<float>::const_iterator i = _keytimes.begin(); i != _keytimes.end(); ++i)
     {
@@ -49,6 +83,13 @@ void AnimationChannel::writeText(FILE* file)
     fprintfElement(file, "%f ", "tangentsIn", _tangentsIn);
     fprintfElement(file, "%f ", "tangentsOut", _tangentsOut);
     fprintfElement(file, "%u ", "interpolations", _interpolations);
+    if (isCompressed())
+    {
+        fprintfElement(file, "compressedDuration", _compressedDuration);
+        fprintfElement(file, "%u ", "compressedKeytimes", _compressedTimes);
+        fprintfElement(file, "%f ", "compressedRanges", _compressedRanges);
+        fprintfElement(file, "%u ", "compressedValues", _compressedValues);
+    }
     fprintElementEnd(file);
 }
 
@@ -106,11 +147,13 @@ void AnimationChannel::setTargetAttribute(unsigned int attrib)
 void AnimationChannel::setKeyTimes(const std::vector<float>& values)
 {
     _keytimes = values;
+    _compressedTimes.clear();
 }
 
 void AnimationChannel::setKeyValues(const std::vector<float>& values)
 {
     _keyValues = values;
+    _compressedTimes.clear();
 }
 
 void AnimationChannel::setTangentsIn(const std::vector<float>& values)
@@ -175,6 +218,198 @@ void AnimationChannel::removeDuplicates()
     LOG(3, "      Removed %d duplicate keyframes from channel.\n", startCount- _keytimes.size());
 }
 
+bool AnimationChannel::compress(float tolerance)
+{
+    _compressedTimes.clear();
+    _compressedValues.clear();
+    _compressedRanges.clear();
+
+    size_t keyCount = _keytimes.size();
+    size_t propSize = Transform::getPropertySize(_targetAttrib);
+    if (keyCount == 0 || propSize == 0 || _keyValues.size() != keyCount * propSize)
+        return false;
+
+    float startTime = _keytimes.front();
+    float duration = _keytimes.back() - startTime;
+    if (keyCount > 1 && duration <= 0.0f)
+    {
+        LOG(1, "Warning: Not compressing channel '%s' with a duration of zero.\n", _targetId.c_str());
+        return false;
+    }
+
+    int quaternionOffset = getQuaternionOffset();
+
+    // The error allowed for each component when removing keys
+    std::vector<float> maxError(propSize);
+    for (size_t c = 0; c < propSize; ++c)
+    {
+        if (quaternionOffset >= 0 && c >= (size_t)quaternionOffset && c < (size_t)quaternionOffset + 4)
+        {
+            // Unit quaternion components range over [-1, 1]
+            maxError[c] = tolerance * 2.0f;
+            continue;
+        }
+        float minValue = _keyValues[c];
+        float maxValue = _keyValues[c];
+        for (size_t i = 1; i < keyCount; ++i)
+        {
+            minValue = std::min(minValue, _keyValues[i * propSize + c]);
+            maxValue = std::max(maxValue, _keyValues[i * propSize + c]);
+        }
+        maxError[c] = tolerance * (maxValue - minValue);
+    }
+
+    // Keep the last key of the longest run of keys that can be interpolated from each kept key
+    std::vector<size_t> keys;
+    keys.push_back(0);
+    while (keys.back() < keyCount - 1)
+    {
+        size_t begin = keys.back();
+        size_t end = begin + 1;
+        while (end + 1 < keyCount && end - begin <= KEY_REDUCTION_MAX_SPAN && canRemoveKeys(begin, end + 1, maxError))
+            ++end;
+        keys.push_back(end);
+    }
+
+    // Quantize key times over the duration
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        float time = keyCount > 1 ? (_keytimes[keys[i]] - startTime) / duration : 0.0f;
+        unsigned short quantizedTime = (unsigned short)floorf(time * QUANTIZED_MAX + 0.5f);
+        if (i > 0 && quantizedTime <= _compressedTimes.back())
+        {
+            LOG(1, "Warning: Not compressing channel '%s' with keys closer than %f ms.\n", _targetId.c_str(), duration / QUANTIZED_MAX);
+            _compressedTimes.clear();
+            return false;
+        }
+        _compressedTimes.push_back(quantizedTime);
+    }
+    _compressedDuration = (unsigned int)_keytimes.back() - (unsigned int)startTime;
+
+    // Quantize scalar components over the range of the kept keys
+    for (size_t c = 0; c < propSize; ++c)
+    {
+        if (quaternionOffset >= 0 && c >= (size_t)quaternionOffset && c < (size_t)quaternionOffset + 4)
+            continue;
+        float minValue = _keyValues[keys[0] * propSize + c];
+        float maxValue = minValue;
+        for (size_t i = 1; i < keys.size(); ++i)
+        {
+            minValue = std::min(minValue, _keyValues[keys[i] * propSize + c]);
+            maxValue = std::max(maxValue, _keyValues[keys[i] * propSize + c]);
+        }
+        _compressedRanges.push_back(minValue);
+        _compressedRanges.push_back((maxValue - minValue) / QUANTIZED_MAX);
+    }
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        const float* values = &_keyValues[keys[i] * propSize];
+        const float* range = &_compressedRanges[0];
+        for (size_t c = 0; c < propSize; ++c)
+        {
+            if (quaternionOffset >= 0 && c >= (size_t)quaternionOffset && c < (size_t)quaternionOffset + 4)
+                continue;
+            float step = range[1];
+            _compressedValues.push_back(step > 0.0f ? (unsigned short)std::min(floorf((values[c] - range[0]) / step + 0.5f), QUANTIZED_MAX) : 0);
+            range += 2;
+        }
+
+        if (quaternionOffset >= 0)
+        {
+            // Store the three smallest components of the normalized quaternion, negated if
+            // needed so that the largest is positive, with its index in the top bits.
+            Quaternion q(const_cast<float*>(values + quaternionOffset));
+            q.normalize();
+            float components[4] = { q.x, q.y, q.z, q.w };
+            unsigned int largest = 0;
+            for (unsigned int j = 1; j < 4; ++j)
+            {
+                if (fabs(components[j]) > fabs(components[largest]))
+                    largest = j;
+            }
+            float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+            for (unsigned int j = 0, k = 0; j < 4; ++j)
+            {
+                if (j == largest)
+                    continue;
+                float value = (sign * components[j] + QUATERNION_COMPONENT_MAX) * (QUANTIZED_QUATERNION_MAX / (2.0f * QUATERNION_COMPONENT_MAX));
+                unsigned short quantized = (unsigned short)std::max(0.0f, std::min(floorf(value + 0.5f), QUANTIZED_QUATERNION_MAX));
+                if (k < 2)
+                    quantized |= ((largest >> k) & 1) << 15;
+                _compressedValues.push_back(quantized);
+                ++k;
+            }
+        }
+    }
+
+    // Measure the error at every original key against the compressed curve
+    float maxScalarError = 0.0f;
+    float maxRotationError = 0.0f;
+    std::vector<float> from(propSize);
+    std::vector<float> to(propSize);
+    size_t segment = 0;
+    for (size_t i = 0; i < keyCount; ++i)
+    {
+        float time = keyCount > 1 ? (_keytimes[i] - startTime) / duration : 0.0f;
+        while (segment + 2 < keys.size() && time >= _compressedTimes[segment + 1] / QUANTIZED_MAX)
+            ++segment;
+        decompressKey(segment, &from[0]);
+        float s = 0.0f;
+        if (segment + 1 < keys.size())
+        {
+            decompressKey(segment + 1, &to[0]);
+            float fromTime = _compressedTimes[segment] / QUANTIZED_MAX;
+            float toTime = _compressedTimes[segment + 1] / QUANTIZED_MAX;
+            s = std::max(0.0f, std::min((time - fromTime) / (toTime - fromTime), 1.0f));
+        }
+
+        const float* values = &_keyValues[i * propSize];
+        for (size_t c = 0; c < propSize; ++c)
+        {
+            if (quaternionOffset >= 0 && c == (size_t)quaternionOffset)
+            {
+                Quaternion result;
+                if (segment + 1 < keys.size())
+                    Quaternion::slerp(Quaternion(&from[c]), Quaternion(&to[c]), s, &result);
+                else
+                    result = Quaternion(&from[c]);
+                Quaternion q(const_cast<float*>(values + c));
+                q.normalize();
+                float dot = fabs(result.x * q.x + result.y * q.y + result.z * q.z + result.w * q.w);
+                maxRotationError = std::max(maxRotationError, 2.0f * acosf(std::min(dot, 1.0f)));
+                c += 3;
+                continue;
+            }
+            float value = segment + 1 < keys.size() ? from[c] + (to[c] - from[c]) * s : from[c];
+            maxScalarError = std::max(maxScalarError, fabs(value - values[c]));
+        }
+    }
+
+    unsigned int oldSize = sizeof(unsigned int) * (5 + _keytimes.size() + _interpolations.size()) + sizeof(float) * (_keyValues.size() + _tangentsIn.size() + _tangentsOut.size());
+    unsigned int newSize = getByteSize();
+    LOG(1, "Compressed channel '%s' (%s): %lu -> %lu keys, %u -> %u bytes (%.1f%% saved), max error %f, max rotation error %f degrees.\n",
+        _targetId.c_str(), Transform::getPropertyString(_targetAttrib), keyCount, keys.size(), oldSize, newSize,
+        oldSize > 0 ? 100.0f * ((float)oldSize - (float)newSize) / oldSize : 0.0f, maxScalarError, maxRotationError * 180.0f / MATH_PI);
+    return true;
+}
+
+bool AnimationChannel::isCompressed() const
+{
+    return !_compressedTimes.empty();
+}
+
+unsigned int AnimationChannel::getByteSize() const
+{
+    if (isCompressed())
+    {
+        return sizeof(unsigned int) * 4 + sizeof(float) * _compressedRanges.size() +
+            sizeof(unsigned short) * (_compressedTimes.size() + _compressedValues.size());
+    }
+    return sizeof(unsigned int) * (5 + _keytimes.size() + _interpolations.size()) +
+        sizeof(float) * (_keyValues.size() + _tangentsIn.size() + _tangentsOut.size());
+}
+
 unsigned int AnimationChannel::getInterpolationType(const char* str)
 {
     unsigned int value = 0;
@@ -245,4 +480,95 @@ void AnimationChannel::deleteRange(size_t begin, size_t end, size_t propSize)
     // TODO: also remove key frames from _tangentsIn and _tangentsOut once other curve types are supported.
 }
 
+int AnimationChannel::getQuaternionOffset() const
+{
+    // Matches the rotation offsets of the runtime's transform curves
+    switch (_targetAttrib)
+    {
+    case Transform::ANIMATE_ROTATE:
+    case Transform::ANIMATE_ROTATE_TRANSLATE:
+        return 0;
+    case Transform::ANIMATE_SCALE_ROTATE:
+    case Transform::ANIMATE_SCALE_ROTATE_TRANSLATE:
+        return 3;
+    default:
+        return -1;
+    }
+}
+
+bool AnimationChannel::canRemoveKeys(size_t begin, size_t end, const std::vector<float>& maxError) const
+{
+    size_t propSize = maxError.size();
+    int quaternionOffset = getQuaternionOffset();
+    const float* from = &_keyValues[begin * propSize];
+    const float* to = &_keyValues[end * propSize];
+    float duration = _keytimes[end] - _keytimes[begin];
+
+    for (size_t i = begin + 1; i < end; ++i)
+    {
+        float s = (_keytimes[i] - _keytimes[begin]) / duration;
+        const float* values = &_keyValues[i * propSize];
+        for (size_t c = 0; c < propSize; ++c)
+        {
+            if (quaternionOffset >= 0 && c == (size_t)quaternionOffset)
+            {
+                Quaternion q1(const_cast<float*>(from + c));
+                Quaternion q2(const_cast<float*>(to + c));
+                Quaternion q(const_cast<float*>(values + c));
+                q1.normalize();
+                q2.normalize();
+                q.normalize();
+                Quaternion result;
+                Quaternion::slerp(q1, q2, s, &result);
+
+                // q and -q are the same rotation
+                float sign = (result.x * q.x + result.y * q.y + result.z * q.z + result.w * q.w) < 0.0f ? -1.0f : 1.0f;
+                if (fabs(result.x - sign * q.x) > maxError[c] || fabs(result.y - sign * q.y) > maxError[c + 1] ||
+                    fabs(result.z - sign * q.z) > maxError[c + 2] || fabs(result.w - sign * q.w) > maxError[c + 3])
+                    return false;
+                c += 3;
+                continue;
+            }
+            if (fabs(from[c] + (to[c] - from[c]) * s - values[c]) > maxError[c])
+                return false;
+        }
+    }
+    return true;
+}
+
+void AnimationChannel::decompressKey(size_t index, float* values) const
+{
+    size_t propSize = Transform::getPropertySize(_targetAttrib);
+    int quaternionOffset = getQuaternionOffset();
+    size_t stride = quaternionOffset >= 0 ? propSize - 1 : propSize;
+    const unsigned short* quantized = &_compressedValues[index * stride];
+    const float* range = _compressedRanges.empty() ? NULL : &_compressedRanges[0];
+
+    for (size_t c = 0; c < propSize; ++c)
+    {
+        if (quaternionOffset >= 0 && c == (size_t)quaternionOffset)
+        {
+            c += 3;
+            continue;
+        }
+        values[c] = range[0] + range[1] * (*quantized++);
+        range += 2;
+    }
+
+    if (quaternionOffset >= 0)
+    {
+        unsigned int largest = (quantized[0] >> 15) | ((quantized[1] >> 15) << 1);
+        float* q = values + quaternionOffset;
+        float sum = 0.0f;
+        for (unsigned int j = 0, k = 0; j < 4; ++j)
+        {
+            if (j == largest)
+                continue;
+            q[j] = (quantized[k++] & 0x7fff) * (2.0f * QUATERNION_COMPONENT_MAX / QUANTIZED_QUATERNION_MAX) - QUATERNION_COMPONENT_MAX;
+            sum += q[j] * q[j];
+        }
+        q[largest] = sum < 1.0f ? sqrt(1.0f - sum) : 0.0f;
+    }
+}
+
 }
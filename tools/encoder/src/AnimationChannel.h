@@ -65,6 +65,33 @@ public:
      */
     void removeDuplicates();
 
+    /**
+     * Compresses the key frames of the animation channel.
+     *
+     * Keys that can be interpolated from the neighboring keys within the given tolerance are
+     * removed, leaving keys spaced where the animation changes. Key times are quantized to
+     * 16 bits over the duration of the channel, scalar values to 16 bits over the range of each
+     * component and rotations are stored as the three smallest components of the quaternion,
+     * in 15 bits each. The key count, size and error of the channel are logged.
+     *
+     * Compressed channels are always linearly interpolated at runtime.
+     *
+     * @param tolerance The error allowed by removing keys, relative to the range of each component.
+     *
+     * @return True if the channel was compressed, false if it is written uncompressed.
+     */
+    bool compress(float tolerance);
+
+    /**
+     * Returns true if the channel has been compressed.
+     */
+    bool isCompressed() const;
+
+    /**
+     * Returns the size in bytes of the key frame data written for the channel.
+     */
+    unsigned int getByteSize() const;
+
     /**
      * Returns the interpolation type value for the given string or zero if not valid.
      * Example: "LINEAR" returns AnimationChannel::LINEAR
@@ -86,6 +113,23 @@ private:
      */
     void deleteRange(size_t begin, size_t end, size_t propSize);
 
+    /**
+     * Returns the offset of the rotation quaternion within the key values, or -1 if the
+     * target attribute has no rotation.
+     */
+    int getQuaternionOffset() const;
+
+    /**
+     * Returns true if the keys between the given keys can be interpolated from them within
+     * the given error of each component.
+     */
+    bool canRemoveKeys(size_t begin, size_t end, const std::vector<float>& maxError) const;
+
+    /**
+     * Decodes the values of the given compressed key.
+     */
+    void decompressKey(size_t index, float* values) const;
+
 private:
 
     std::string _targetId;
@@ -95,6 +139,10 @@ private:
     std::vector<float> _tangentsIn;
     std::vector<float> _tangentsOut;
     std::vector<unsigned int> _interpolations;
+    unsigned int _compressedDuration;
+    std::vector<unsigned short> _compressedTimes;
+    std::vector<unsigned short> _compressedValues;
+    std::vector<float> _compressedRanges;
 };
 
 }
@@ -27,7 +27,13 @@ EncoderArguments::EncoderArguments(size_t argc, const char** argv) :
     _fontFormat(Font::BITMAP),
     _textOutput(false),
     _optimizeAnimations(false),
+    _optimizeMeshes(false),
+    _compressAnimations(false),
+    _animationTolerance(0.0005f),
+    _lodCount(0),
+    _lodRatio(0.5f),
     _animationGrouping(ANIMATIONGROUP_PROMPT),
+    _vertexPrecision(VERTEXPRECISION_FULL),
     _outputMaterial(false)
 {
     __instance = this;
@@ -170,6 +176,11 @@ EncoderArguments::AnimationGroupOption EncoderArguments::getAnimationGrouping()
     return _animationGrouping;
 }
 
+EncoderArguments::VertexPrecision EncoderArguments::getVertexPrecision() const
+{
+    return _vertexPrecision;
+}
+
 const std::vector<EncoderArguments::HeightmapOption>& EncoderArguments::getHeightmapOptions() const
 {
     return _heightmaps;
@@ -261,6 +272,29 @@ void EncoderArguments::printUsage() const
         "\t\tremoving any channels that contain default/identity values\n" \
         "\t\tand removing any duplicate contiguous keyframes, which are \n" \
         "\t\tcommon when exporting baked animation data.\n" \
+    "  -ca[:<tolerance>]\n" \
+        "\t\tCompresses animations by removing keyframes that can be\n" \
+        "\t\tinterpolated from their neighbors within <tolerance> of each\n" \
+        "\t\tvalue's range (default 0.0005), and quantizing key times,\n" \
+        "\t\tscales and translations to 16 bits and rotations to 48 bits.\n" \
+        "\t\tPrints the size and error of each animation channel.\n" \
+    "  -om\n" \
+        "\t\tOptimizes meshes by reordering triangles for vertex cache \n" \
+        "\t\tlocality and reduced overdraw, and reordering vertices for \n" \
+        "\t\tvertex fetch locality. Prints cache statistics per mesh.\n" \
+    "  -lod <count>[,<ratio>]\n" \
+        "\t\tGenerates <count> levels of detail for each mesh by edge \n" \
+        "\t\tcollapse, each keeping <ratio> of the triangles of the previous\n" \
+        "\t\tlevel (default 0.5). Texture seams, mesh part boundaries and\n" \
+        "\t\topen borders are preserved. Models switch levels at runtime\n" \
+        "\t\tbased on their projected size on screen.\n" \
+    "  -q:high\tStores normals, tangents and binormals as 16-bit integers, and\n" \
+        "\t\tvertex colors and blend weights as 16-bit normalized integers.\n" \
+    "  -q:low\tStores normals, tangents and binormals packed in 32 bits \n" \
+        "\t\t(10-10-10-2), vertex colors and blend weights as 8-bit normalized\n" \
+        "\t\tintegers and texture coordinates as half floats.\n" \
+        "\t\tPositions are always stored as floats. Requires OpenGL 3.3 or\n" \
+        "\t\tOpenGL ES 3.0 at runtime.\n" \
     "  -h <size> \"<node ids>\" <filename>\n" \
         "\t\tGenerates a single heightmap image using meshes from the \n" \
         "\t\tspecified nodes. \n" \
@@ -314,6 +348,31 @@ bool EncoderArguments::optimizeAnimationsEnabled() const
     return _optimizeAnimations;
 }
 
+bool EncoderArguments::optimizeMeshesEnabled() const
+{
+    return _optimizeMeshes;
+}
+
+bool EncoderArguments::compressAnimationsEnabled() const
+{
+    return _compressAnimations;
+}
+
+float EncoderArguments::getAnimationTolerance() const
+{
+    return _animationTolerance;
+}
+
+unsigned int EncoderArguments::getLodCount() const
+{
+    return _lodCount;
+}
+
+float EncoderArguments::getLodRatio() const
+{
+    return _lodRatio;
+}
+
 bool EncoderArguments::outputMaterialEnabled() const
 {
     return _outputMaterial;
@@ -397,6 +456,25 @@ void EncoderArguments::readOption(const std::vector<std::string>& options, size_
             _fontFormat = Font::DISTANCE_FIELD;
         }
         break;
+    case 'c':
+        if (str.compare("-ca") == 0)
+        {
+            _compressAnimations = true;
+        }
+        else if (str.compare(0, 4, "-ca:") == 0)
+        {
+            // read the tolerance
+            float tolerance = (float)atof(str.c_str() + 4);
+            if (tolerance < 0.0f || tolerance >= 1.0f)
+            {
+                LOG(1, "Error: invalid tolerance '%s' for -ca (expected a value between 0 and 1).\n", str.c_str() + 4);
+                _parseError = true;
+                return;
+            }
+            _compressAnimations = true;
+            _animationTolerance = tolerance;
+        }
+        break;
     case 'g':
         if (str.compare("-groupAnimations:auto") == 0 || str.compare("-g:auto") == 0)
         {
@@ -442,6 +520,11 @@ void EncoderArguments::readOption(const std::vector<std::string>& options, size_
             // Optimize animations
             _optimizeAnimations = true;
         }
+        else if (str == "-om")
+        {
+            // Optimize meshes
+            _optimizeMeshes = true;
+        }
         break;
     case 'h':
         {
@@ -509,6 +592,31 @@ void EncoderArguments::readOption(const std::vector<std::string>& options, size_
             }
         }
         break;
+    case 'l':
+        if (str.compare("-lod") == 0)
+        {
+            // read the level count and optional ratio
+            (*index)++;
+            if (*index >= options.size())
+            {
+                LOG(1, "Error: missing argument for -lod.\n");
+                _parseError = true;
+                return;
+            }
+            std::vector<std::string> values;
+            splitString(options[*index].c_str(), &values);
+            int count = values.size() > 0 ? atoi(values[0].c_str()) : 0;
+            float ratio = values.size() > 1 ? (float)atof(values[1].c_str()) : 0.5f;
+            if (count <= 0 || ratio <= 0.0f || ratio >= 1.0f)
+            {
+                LOG(1, "Error: invalid argument '%s' for -lod (expected <count>[,<ratio>] with a ratio between 0 and 1).\n", options[*index].c_str());
+                _parseError = true;
+                return;
+            }
+            _lodCount = (unsigned int)count;
+            _lodRatio = ratio;
+        }
+        break;
     case 'm':
         if (str.compare("-m") == 0)
         {
@@ -653,6 +761,21 @@ void EncoderArguments::readOption(const std::vector<std::string>& options, size_
             }
         }
         break;
+    case 'q':
+        if (str.compare("-quantize:high") == 0 || str.compare("-q:high") == 0)
+        {
+            _vertexPrecision = VERTEXPRECISION_HIGH;
+        }
+        else if (str.compare("-quantize:low") == 0 || str.compare("-q:low") == 0)
+        {
+            _vertexPrecision = VERTEXPRECISION_LOW;
+        }
+        else
+        {
+            LOG(1, "Error: unknown vertex precision '%s' (expected -q:high or -q:low).\n", str.c_str());
+            _parseError = true;
+        }
+        break;
     case 'v':
         (*index)++;
         if (*index < options.size())
@@ -48,6 +48,13 @@ public:
         ANIMATIONGROUP_AUTO,
         ANIMATIONGROUP_OFF
     };
+
+    enum VertexPrecision
+    {
+        VERTEXPRECISION_FULL,
+        VERTEXPRECISION_HIGH,
+        VERTEXPRECISION_LOW
+    };
     
     /**
      * Constructor.
@@ -104,6 +111,8 @@ public:
 
     AnimationGroupOption getAnimationGrouping() const;
 
+    VertexPrecision getVertexPrecision() const;
+
     const std::vector<HeightmapOption>& getHeightmapOptions() const;
 
     /**
@@ -162,6 +171,26 @@ public:
 
     bool optimizeAnimationsEnabled() const;
 
+    bool optimizeMeshesEnabled() const;
+
+    bool compressAnimationsEnabled() const;
+
+    /**
+     * Returns the error allowed when removing animation keyframes, relative to the range of each value.
+     */
+    float getAnimationTolerance() const;
+
+    /**
+     * Returns the number of levels of detail to generate for each mesh, not counting the
+     * mesh itself, or zero if no levels of detail should be generated.
+     */
+    unsigned int getLodCount() const;
+
+    /**
+     * Returns the fraction of triangles kept by each level of detail relative to the previous level.
+     */
+    float getLodRatio() const;
+
     bool outputMaterialEnabled() const;
 
     const char* getNodeId() const;
@@ -208,7 +237,13 @@ private:
     Font::FontFormat _fontFormat;
     bool _textOutput;
     bool _optimizeAnimations;
+    bool _optimizeMeshes;
+    bool _compressAnimations;
+    float _animationTolerance;
+    unsigned int _lodCount;
+    float _lodRatio;
     AnimationGroupOption _animationGrouping;
+    VertexPrecision _vertexPrecision;
     bool _outputMaterial;
 
     std::vector<std::string> _groupAnimationNodeId;
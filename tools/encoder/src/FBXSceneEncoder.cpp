@@ -1152,6 +1152,7 @@ Mesh* FBXSceneEncoder::loadMesh(FbxMesh* fbxMesh)
     {
         return mesh;
     }
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
     mesh = new Mesh();
     // GamePlay requires that a mesh have a unique ID but FbxMesh doesn't have a string ID.
     const char* name = fbxMesh->GetNode()->GetName();
@@ -1288,6 +1289,10 @@ Mesh* FBXSceneEncoder::loadMesh(FbxMesh* fbxMesh)
         mesh->addVetexAttribute(BLENDINDICES, Vertex::BLEND_INDICES_COUNT);
     }
 
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+    LOG(2, "Loaded mesh '%s': %d polygon vertices, %u unique vertices (%.2f ms).\n",
+        mesh->getId().c_str(), vertexIndex, (unsigned int)mesh->getVertexCount(), elapsed.count());
+
     _gamePlayFile.addMesh(mesh);
     saveMesh(fbxMesh->GetUniqueID(), mesh);
     return mesh;
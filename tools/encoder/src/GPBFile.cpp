@@ -315,6 +315,28 @@ void GPBFile::adjust()
         }
     }
 
+    if (EncoderArguments::getInstance()->getLodCount() > 0)
+    {
+        LOG(1, "Generating levels of detail.\n");
+        generateLods();
+    }
+
+    if (EncoderArguments::getInstance()->optimizeMeshesEnabled())
+    {
+        LOG(1, "Optimizing meshes.\n");
+        optimizeMeshes();
+    }
+
+    EncoderArguments::VertexPrecision vertexPrecision = EncoderArguments::getInstance()->getVertexPrecision();
+    if (vertexPrecision != EncoderArguments::VERTEXPRECISION_FULL)
+    {
+        LOG(1, "Quantizing vertex attributes.\n");
+        for (std::list<Mesh*>::iterator i = _geometry.begin(); i != _geometry.end(); ++i)
+        {
+            (*i)->quantize(vertexPrecision == EncoderArguments::VERTEXPRECISION_HIGH);
+        }
+    }
+
     for (std::list<Node*>::const_iterator i = _nodes.begin(); i != _nodes.end(); ++i)
     {
         computeBounds(*i);
@@ -326,6 +348,12 @@ void GPBFile::adjust()
         optimizeAnimations();
     }
 
+    if (EncoderArguments::getInstance()->compressAnimationsEnabled())
+    {
+        LOG(1, "Compressing animations.\n");
+        compressAnimations();
+    }
+
     // TODO:
     // remove ambient _lights
     // for each node
@@ -398,6 +426,58 @@ void GPBFile::computeBounds(Node* node)
     }
 }
 
+void GPBFile::generateLods()
+{
+    unsigned int lodCount = EncoderArguments::getInstance()->getLodCount();
+    float ratio = EncoderArguments::getInstance()->getLodRatio();
+
+    // Models that share a mesh share its levels of detail
+    std::map<Mesh*, std::vector<Mesh*> > lods;
+    for (std::list<Node*>::const_iterator i = _nodes.begin(); i != _nodes.end(); ++i)
+    {
+        Model* model = (*i)->getModel();
+        Mesh* mesh = model ? model->getMesh() : NULL;
+        if (!mesh || model->getLodCount() > 0)
+            continue;
+
+        std::map<Mesh*, std::vector<Mesh*> >::iterator itr = lods.find(mesh);
+        if (itr == lods.end())
+        {
+            itr = lods.insert(std::make_pair(mesh, std::vector<Mesh*>())).first;
+            Mesh* previous = mesh;
+            for (unsigned int level = 1; level <= lodCount; ++level)
+            {
+                Mesh* lod = previous->simplify(ratio);
+                if (!lod)
+                    break;
+                char id[16];
+                sprintf(id, "_lod%u", level);
+                lod->setId(mesh->getId() + id);
+                addMesh(lod);
+                itr->second.push_back(lod);
+                previous = lod;
+            }
+        }
+
+        // Keep the triangle density on screen about constant: each level has 'ratio' times
+        // the triangles of the previous one, so it is drawn at sqrt(ratio) times the size.
+        float screenSize = 0.5f;
+        for (std::vector<Mesh*>::const_iterator j = itr->second.begin(); j != itr->second.end(); ++j)
+        {
+            model->addLod(*j, screenSize);
+            screenSize *= sqrt(ratio);
+        }
+    }
+}
+
+void GPBFile::optimizeMeshes()
+{
+    for (std::list<Mesh*>::iterator i = _geometry.begin(); i != _geometry.end(); ++i)
+    {
+        (*i)->optimize();
+    }
+}
+
 void GPBFile::optimizeAnimations()
 {
     const unsigned int animationCount = _animations.getAnimationCount();
@@ -432,6 +512,37 @@ void GPBFile::optimizeAnimations()
     }
 }
 
+void GPBFile::compressAnimations()
+{
+    float tolerance = EncoderArguments::getInstance()->getAnimationTolerance();
+    unsigned int channelCount = 0;
+    unsigned int compressedCount = 0;
+    unsigned int oldSize = 0;
+    unsigned int newSize = 0;
+
+    const unsigned int animationCount = _animations.getAnimationCount();
+    for (unsigned int animationIndex = 0; animationIndex < animationCount; ++animationIndex)
+    {
+        Animation* animation = _animations.getAnimation(animationIndex);
+        assert(animation);
+
+        for (unsigned int channelIndex = 0; channelIndex < animation->getAnimationChannelCount(); ++channelIndex)
+        {
+            AnimationChannel* channel = animation->getAnimationChannel(channelIndex);
+            assert(channel);
+
+            oldSize += channel->getByteSize();
+            if (channel->compress(tolerance))
+                ++compressedCount;
+            newSize += channel->getByteSize();
+            ++channelCount;
+        }
+    }
+
+    LOG(1, "Compressed %u of %u animation channels: %u -> %u bytes (%.1f%% saved).\n",
+        compressedCount, channelCount, oldSize, newSize, oldSize > 0 ? 100.0f * ((float)oldSize - (float)newSize) / oldSize : 0.0f);
+}
+
 void GPBFile::decomposeTransformAnimationChannel(Animation* animation, AnimationChannel* channel, int channelIndex)
 {
     LOG(2, "  Optimizing animaton channel %s:%d.\n", animation->getId().c_str(), channelIndex+1);
@@ -21,7 +21,7 @@ namespace gameplay
  * Increment the version number when making a change that break binary compatibility.
  * [0] is major, [1] is minor.
  */
-const unsigned char GPB_VERSION[2] = {1, 5};
+const unsigned char GPB_VERSION[2] = {1, 8};
 
 /**
  * The GamePlay Binary file class handles writing the GamePlay Binary file.
@@ -127,11 +127,26 @@ private:
      */
     void computeBounds(Node* node);
 
+    /**
+     * Generates the levels of detail of all models by simplifying their meshes.
+     */
+    void generateLods();
+
+    /**
+     * Optimizes the triangle and vertex order of all meshes.
+     */
+    void optimizeMeshes();
+
     /**
      * Optimizes animation data by removing unneccessary channels and keyframes.
      */
     void optimizeAnimations();
 
+    /**
+     * Compresses the key frames of all animation channels.
+     */
+    void compressAnimations();
+
     /**
      * Decomposes an ANIMATE_SCALE_ROTATE_TRANSLATE channel into 3 new channels. (Scale, Rotate and Translate)
      * 
@@ -9,43 +9,213 @@ namespace gameplay
 // Number of threads to spawn for the heightmap generator
 #define THREAD_COUNT 8
 
+// Maximum number of triangles in a leaf of the heightmap BVH
+#define BVH_LEAF_SIZE 4
+
+// Maximum depth of the BVH traversal stack
+#define BVH_STACK_SIZE 64
+
+// Triangle stored in the heightmap BVH
+struct HeightmapTriangle
+{
+    Vector3 v0;
+    Vector3 v1;
+    Vector3 v2;
+    Vector3 min;
+    Vector3 max;
+    Vector3 center;
+};
+
+// Node of the heightmap BVH. Nodes are stored depth first, so the first child of an
+// inner node immediately follows it and only the index of the second child is stored.
+struct HeightmapBVHNode
+{
+    Vector3 min;
+    Vector3 max;
+    unsigned int offset;                // First triangle of a leaf or second child of an inner node
+    unsigned int count;                 // Number of triangles in a leaf, zero for inner nodes
+};
+
+// Bounding volume hierarchy over the triangles of all meshes in the heightmap
+struct HeightmapBVH
+{
+    std::vector<HeightmapTriangle> triangles;
+    std::vector<HeightmapBVHNode> nodes;
+};
+
 // Thread data structure
 struct HeightmapThreadData
 {
+    const HeightmapBVH* bvh;            // [in]
     float rayHeight;                    // [in]
-    const Vector3* rayDirection;        // [in]
-    const std::vector<Mesh*>* meshes;   // [in]
-    const BoundingVolume* bounds;       // [in]
     float minX;                         // [in]
-    float maxX;                         // [in]
     float minZ;                         // [in]
-    float maxZ;                         // [in]
     float stepX;                        // [in]
     float stepZ;                        // [in]
-    float minHeight;                    // [out]
-    float maxHeight;                    // [out]
-    float* heights;                     // [in][out]
     int width;                          // [in]
     int height;                         // [in]
-    int heightIndex;                    // [in]
+    float* heights;                     // [in][out]
+    float minHeight;                    // [out]
+    float maxHeight;                    // [out]
+    int failedRayCasts;                 // [out]
 };
 
 // Globals used by thread
-int __processedHeightmapScanLines = 0;
+std::atomic<int> __nextHeightmapScanLine(0);
+std::atomic<int> __processedHeightmapScanLines(0);
 int __totalHeightmapScanlines = 0;
 int __failedRayCasts = 0;
 
 // Forward declarations
 int generateHeightmapChunk(void* threadData);
-bool intersect(const Vector3& rayOrigin, const Vector3& rayDirection, const Vector3& boxMin, const Vector3& boxMax, float* distance = NULL);
 int intersect_triangle(const float orig[3], const float dir[3], const float vert0[3], const float vert1[3], const float vert2[3], float *t, float *u, float *v);
-bool intersect(const Vector3& rayOrigin, const Vector3& rayDirection, const std::vector<Vertex>& vertices, const std::vector<MeshPart*>& parts, Vector3* point);
+
+// Orders triangles by the position of their center along an axis
+struct HeightmapTriangleCompare
+{
+    HeightmapTriangleCompare(int axis) : axis(axis) { }
+
+    bool operator()(const HeightmapTriangle& a, const HeightmapTriangle& b) const
+    {
+        return (&a.center.x)[axis] < (&b.center.x)[axis];
+    }
+
+    int axis;
+};
+
+// Builds the BVH node for the triangles in [start, end) and returns its index.
+static unsigned int buildBVHNode(HeightmapBVH& bvh, unsigned int start, unsigned int end)
+{
+    unsigned int index = bvh.nodes.size();
+    bvh.nodes.push_back(HeightmapBVHNode());
+
+    Vector3 min(FLT_MAX, FLT_MAX, FLT_MAX);
+    Vector3 max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    Vector3 centerMin(FLT_MAX, 0, FLT_MAX);
+    Vector3 centerMax(-FLT_MAX, 0, -FLT_MAX);
+    for (unsigned int i = start; i < end; ++i)
+    {
+        const HeightmapTriangle& triangle = bvh.triangles[i];
+        min.set(std::min(min.x, triangle.min.x), std::min(min.y, triangle.min.y), std::min(min.z, triangle.min.z));
+        max.set(std::max(max.x, triangle.max.x), std::max(max.y, triangle.max.y), std::max(max.z, triangle.max.z));
+        centerMin.set(std::min(centerMin.x, triangle.center.x), 0, std::min(centerMin.z, triangle.center.z));
+        centerMax.set(std::max(centerMax.x, triangle.center.x), 0, std::max(centerMax.z, triangle.center.z));
+    }
+    bvh.nodes[index].min = min;
+    bvh.nodes[index].max = max;
+
+    // Rays are always cast straight down, so only splitting along X or Z separates them.
+    unsigned int count = end - start;
+    int axis = (centerMax.x - centerMin.x) >= (centerMax.z - centerMin.z) ? 0 : 2;
+    if (count <= BVH_LEAF_SIZE || (&centerMax.x)[axis] <= (&centerMin.x)[axis])
+    {
+        bvh.nodes[index].offset = start;
+        bvh.nodes[index].count = count;
+        return index;
+    }
+
+    // Split at the median so the tree stays balanced
+    unsigned int middle = start + count / 2;
+    std::nth_element(bvh.triangles.begin() + start, bvh.triangles.begin() + middle, bvh.triangles.begin() + end, HeightmapTriangleCompare(axis));
+
+    buildBVHNode(bvh, start, middle);
+    unsigned int second = buildBVHNode(bvh, middle, end);
+    bvh.nodes[index].offset = second;
+    bvh.nodes[index].count = 0;
+    return index;
+}
+
+// Builds a BVH over the triangles of the given meshes.
+static void buildBVH(const std::vector<Mesh*>& meshes, HeightmapBVH* bvh)
+{
+    for (unsigned int i = 0, meshCount = meshes.size(); i < meshCount; ++i)
+    {
+        const Mesh* mesh = meshes[i];
+        const std::vector<Vertex>& vertices = mesh->vertices;
+        for (unsigned int j = 0, partCount = mesh->parts.size(); j < partCount; ++j)
+        {
+            const MeshPart* part = mesh->parts[j];
+            for (unsigned int k = 0, indexCount = part->getIndicesCount(); k + 2 < indexCount; k += 3)
+            {
+                HeightmapTriangle triangle;
+                triangle.v0 = vertices[part->getIndex(k)].position;
+                triangle.v1 = vertices[part->getIndex(k + 1)].position;
+                triangle.v2 = vertices[part->getIndex(k + 2)].position;
+                triangle.min.set(std::min(triangle.v0.x, std::min(triangle.v1.x, triangle.v2.x)),
+                                 std::min(triangle.v0.y, std::min(triangle.v1.y, triangle.v2.y)),
+                                 std::min(triangle.v0.z, std::min(triangle.v1.z, triangle.v2.z)));
+                triangle.max.set(std::max(triangle.v0.x, std::max(triangle.v1.x, triangle.v2.x)),
+                                 std::max(triangle.v0.y, std::max(triangle.v1.y, triangle.v2.y)),
+                                 std::max(triangle.v0.z, std::max(triangle.v1.z, triangle.v2.z)));
+                Vector3::add(triangle.min, triangle.max, &triangle.center);
+                triangle.center.scale(0.5f);
+                bvh->triangles.push_back(triangle);
+            }
+        }
+    }
+
+    if (bvh->triangles.size() > 0)
+    {
+        bvh->nodes.reserve(2 * bvh->triangles.size() / BVH_LEAF_SIZE + 1);
+        buildBVHNode(*bvh, 0, bvh->triangles.size());
+    }
+}
+
+// Casts a ray straight down through (x, z) and returns the height of the highest
+// triangle hit, or -FLT_MAX if the ray hits nothing.
+static float castRay(const HeightmapBVH& bvh, float rayHeight, float x, float z)
+{
+    const float orig[3] = { x, rayHeight, z };
+    const float dir[3] = { 0.0f, -1.0f, 0.0f };
+    float h = -FLT_MAX;
+
+    unsigned int stack[BVH_STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        unsigned int index = stack[--top];
+        const HeightmapBVHNode& node = bvh.nodes[index];
+
+        // Skip nodes the ray misses and nodes entirely below the highest hit so far
+        if (x < node.min.x || x > node.max.x || z < node.min.z || z > node.max.z || node.max.y <= h)
+            continue;
+
+        if (node.count > 0)
+        {
+            for (unsigned int i = node.offset, end = node.offset + node.count; i < end; ++i)
+            {
+                const HeightmapTriangle& triangle = bvh.triangles[i];
+                if (x < triangle.min.x || x > triangle.max.x || z < triangle.min.z || z > triangle.max.z)
+                    continue;
+
+                float t, u, v;
+                if (intersect_triangle(orig, dir, &triangle.v0.x, &triangle.v1.x, &triangle.v2.x, &t, &u, &v) && rayHeight - t > h)
+                    h = rayHeight - t;
+            }
+        }
+        else
+        {
+            // Visit the higher child first so the lower one is more likely to be skipped
+            unsigned int first = index + 1;
+            unsigned int second = node.offset;
+            if (bvh.nodes[first].max.y < bvh.nodes[second].max.y)
+                std::swap(first, second);
+            assert(top + 2 <= BVH_STACK_SIZE);
+            stack[top++] = second;
+            stack[top++] = first;
+        }
+    }
+
+    return h;
+}
 
 void Heightmap::generate(const std::vector<std::string>& nodeIds, int width, int height, const char* filename, bool highP)
 {
     LOG(1, "Generating heightmap: %s...\n", filename);
 
     // Initialize state variables
+    __nextHeightmapScanLine = 0;
     __processedHeightmapScanLines = 0;
     __totalHeightmapScanlines = 0;
     __failedRayCasts = 0;
@@ -91,11 +261,22 @@ void Heightmap::generate(const std::vector<std::string>& nodeIds, int width, int
         return;
     }
 
+    // Build a BVH over all triangles so each ray only visits the triangles beneath it.
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    HeightmapBVH bvh;
+    buildBVH(meshes, &bvh);
+    if (bvh.triangles.size() == 0)
+    {
+        LOG(1, "WARNING: Skipping generation of heightmap '%s'. Meshes have no triangles.\n", filename);
+        return;
+    }
+    std::chrono::duration<double> buildTime = std::chrono::steady_clock::now() - startTime;
+    LOG(2, "\tBuilt BVH over %u triangles (%u nodes) in %.3f seconds.\n", (unsigned int)bvh.triangles.size(), (unsigned int)bvh.nodes.size(), buildTime.count());
+
     // Shoot rays down from a point just above the max Y position of the mesh.
-    // Compute ray-triangle intersection tests against the ray and this mesh to 
+    // Compute ray-triangle intersection tests against the ray and this mesh to
     // generate heightmap data.
-    Vector3 rayOrigin(0, bounds.max.y + 10, 0);
-    Vector3 rayDirection(0, -1, 0);
+    float rayHeight = bounds.max.y + 10;
 
     float minX = bounds.min.x;
     float maxX = bounds.max.x;
@@ -112,28 +293,22 @@ void Heightmap::generate(const std::vector<std::string>& nodeIds, int width, int
     int threadCount = min(THREAD_COUNT, height);
 
     // Split the work into separate threads to make max use of available cpu cores and speed up computation.
+    // Threads take scan lines one at a time from a shared counter, so threads that get cheap
+    // rows (empty space, flat ground) keep pulling work instead of idling.
     HeightmapThreadData* threadData = new HeightmapThreadData[threadCount];
     THREAD_HANDLE* threads = new THREAD_HANDLE[threadCount];
-    int stepSize = height / threadCount;
-    for (int i = 0, remaining = height; i < threadCount; ++i, remaining -= stepSize)
+    for (int i = 0; i < threadCount; ++i)
     {
         HeightmapThreadData& data = threadData[i];
-        data.rayHeight = rayOrigin.y;
-        data.rayDirection = &rayDirection;
-        data.bounds = &bounds;
-        data.meshes = &meshes;
+        data.bvh = &bvh;
+        data.rayHeight = rayHeight;
         data.minX = minX;
-        data.maxX = maxX;
-        data.minZ = minZ + (stepSize * i);
-        data.maxZ = data.minZ + stepSize - 1;
-        if (i == threadCount - 1)
-            data.maxZ = maxZ;
+        data.minZ = minZ;
         data.stepX = (maxX - minX) / width;
         data.stepZ = (maxZ - minZ) / height;
-        data.heights = heights;
         data.width = width;
-        data.height = remaining > stepSize ? stepSize : remaining;
-        data.heightIndex = width * (stepSize * i);
+        data.height = height;
+        data.heights = heights;
 
         // Start the processing thread
         if (!createThread(&threads[i], &generateHeightmapChunk, &data))
@@ -157,9 +332,12 @@ void Heightmap::generate(const std::vector<std::string>& nodeIds, int width, int
             minHeight = threadData[i].minHeight;
         if (threadData[i].maxHeight > maxHeight)
             maxHeight = threadData[i].maxHeight;
+        __failedRayCasts += threadData[i].failedRayCasts;
     }
 
+    std::chrono::duration<double> totalTime = std::chrono::steady_clock::now() - startTime;
     LOG(1, "\r\tDone.\n");
+    LOG(2, "\tCast %d rays in %.3f seconds.\n", size, totalTime.count());
 
     if (__failedRayCasts)
     {
@@ -263,60 +441,37 @@ error:
 int generateHeightmapChunk(void* threadData)
 {
     HeightmapThreadData* data = (HeightmapThreadData*)threadData;
+    const HeightmapBVH& bvh = *data->bvh;
 
-    Vector3 rayOrigin(0, data->rayHeight, 0);
-    const Vector3& rayDirection = *data->rayDirection;
-    const std::vector<Mesh*>& meshes = *data->meshes;
-    float* heights = data->heights;
-
-    Vector3 intersectionPoint;
     float minHeight = FLT_MAX;
     float maxHeight = -FLT_MAX;
-    int index = data->heightIndex;
+    int failedRayCasts = 0;
 
-    int zi = 0;
-    for (float z = data->minZ; zi < data->height; z += data->stepZ, ++zi)
+    for (int zi = __nextHeightmapScanLine++; zi < data->height; zi = __nextHeightmapScanLine++)
     {
         LOG(1, "\r\t%d%%", (int)(((float)__processedHeightmapScanLines / __totalHeightmapScanlines) * 100.0f));
 
-        rayOrigin.z = z;
+        float z = data->minZ + zi * data->stepZ;
+        float* heights = data->heights + zi * data->width;
 
-        int xi = 0;
-        for (float x = data->minX; xi < data->width; x += data->stepX, ++xi)
+        for (int xi = 0; xi < data->width; ++xi)
         {
-            float h = -FLT_MAX;
-            rayOrigin.x = x;
+            // Pick the highest intersecting Y value of all meshes
+            float h = castRay(bvh, data->rayHeight, data->minX + xi * data->stepX, z);
+            heights[xi] = h;
 
-            for (unsigned int i = 0, count = meshes.size(); i < count; ++i)
+            if (h == -FLT_MAX)
             {
-                // Pick the highest intersecting Y value of all meshes
-                Mesh* mesh = meshes[i];
-
-                // Perform a quick ray/bounding box test to quick-out
-                if (!intersect(rayOrigin, rayDirection, mesh->bounds.min, mesh->bounds.max))
-                    continue;
-
-                // Compute the intersection point of ray with mesh
-                if (intersect(rayOrigin, rayDirection, mesh->vertices, mesh->parts, &intersectionPoint))
-                {
-                    if (intersectionPoint.y > h)
-                    {
-                        h = intersectionPoint.y;
-
-                        // Update min/max height values
-                        if (h < minHeight)
-                            minHeight = h;
-                        if (h > maxHeight)
-                            maxHeight = h;
-                    }
-                }
+                ++failedRayCasts;
+            }
+            else
+            {
+                // Update min/max height values
+                if (h < minHeight)
+                    minHeight = h;
+                if (h > maxHeight)
+                    maxHeight = h;
             }
-
-            // Update the glboal height array
-            heights[index++] = h;
-
-            if (h == -FLT_MAX)
-                ++__failedRayCasts;
         }
 
         ++__processedHeightmapScanLines;
@@ -325,6 +480,7 @@ int generateHeightmapChunk(void* threadData)
     // Update min/max height for this thread data
     data->minHeight = minHeight;
     data->maxHeight = maxHeight;
+    data->failedRayCasts = failedRayCasts;
 
     return 0;
 }
@@ -393,154 +549,4 @@ int intersect_triangle(const float orig[3], const float dir[3], const float vert
    return 1;
 }
 
-// Performs an intersection test between a ray and the given mesh part and stores the result in "point".
-bool intersect(const Vector3& rayOrigin, const Vector3& rayDirection, const std::vector<Vertex>& vertices, const std::vector<MeshPart*>& parts, Vector3* point)
-{
-    const float* orig = &rayOrigin.x;
-    const float* dir = &rayDirection.x;
-
-    float minT = FLT_MAX;
-
-    for (unsigned int i = 0, partCount = parts.size(); i < partCount; ++i)
-    {
-        MeshPart* part = parts[i];
-
-        for (unsigned int j = 0, indexCount = part->getIndicesCount(); j < indexCount; j += 3)
-        {
-            const float* v0 = &vertices[part->getIndex( j )].position.x;
-            const float* v1 = &vertices[part->getIndex(j+1)].position.x;
-            const float* v2 = &vertices[part->getIndex(j+2)].position.x;
-
-            // Perform a quick check (in 2D) to determine if the point is definitely NOT in the triangle
-            float xmin, xmax, zmin, zmax;
-            xmin = v0[0] < v1[0] ? v0[0] : v1[0]; xmin = xmin < v2[0] ? xmin : v2[0];
-            xmax = v0[0] > v1[0] ? v0[0] : v1[0]; xmax = xmax > v2[0] ? xmax : v2[0];
-            zmin = v0[2] < v1[2] ? v0[2] : v1[2]; zmin = zmin < v2[2] ? zmin : v2[2];
-            zmax = v0[2] > v1[2] ? v0[2] : v1[2]; zmax = zmax > v2[2] ? zmax : v2[2];
-            if (orig[0] < xmin || orig[0] > xmax || orig[2] < zmin || orig[2] > zmax)
-                continue;
-
-            // Perform a full ray/traingle intersection test in 3D to get the intersection point
-            float t, u, v;
-            if (intersect_triangle(orig, dir, v0, v1, v2, &t, &u, &v))
-            {
-                // Found an intersection!
-                if (t < minT)
-                {
-                    minT = t;
-
-                    if (point)
-                    {
-                        Vector3 rd(rayDirection);
-                        rd.scale(t);
-                        Vector3::add(rayOrigin, rd, point);
-                    }
-                }
-                //return true;
-            }
-        }
-    }
-
-    return (minT != FLT_MAX);//false;
-}
-
-// Ray/Box intersection test.
-bool intersect(const Vector3& rayOrigin, const Vector3& rayDirection, const Vector3& boxMin, const Vector3& boxMax, float* distance)
-{
-    const Vector3& origin = rayOrigin;
-    const Vector3& direction = rayDirection;
-    const Vector3& min = boxMin;
-    const Vector3& max = boxMax;
-
-    // Intermediate calculation variables.
-    float dnear = 0.0f;
-    float dfar = 0.0f;
-    float tmin = 0.0f;
-    float tmax = 0.0f;
-
-    // X direction.
-    float div = 1.0f / direction.x;
-    if (div >= 0.0f)
-    {
-        tmin = (min.x - origin.x) * div;
-        tmax = (max.x - origin.x) * div;
-    }
-    else
-    {
-        tmin = (max.x - origin.x) * div;
-        tmax = (min.x - origin.x) * div;
-    }
-    dnear = tmin;
-    dfar = tmax;
-
-    // Check if the ray misses the box.
-    if (dnear > dfar || dfar < 0.0f)
-    {
-        return false;
-    }
-
-    // Y direction.
-    div = 1.0f / direction.y;
-    if (div >= 0.0f)
-    {
-        tmin = (min.y - origin.y) * div;
-        tmax = (max.y - origin.y) * div;
-    }
-    else
-    {
-        tmin = (max.y - origin.y) * div;
-        tmax = (min.y - origin.y) * div;
-    }
-
-    // Update the near and far intersection distances.
-    if (tmin > dnear)
-    {
-        dnear = tmin;
-    }
-    if (tmax < dfar)
-    {
-        dfar = tmax;
-    }
-    // Check if the ray misses the box.
-    if (dnear > dfar || dfar < 0.0f)
-    {
-        return false;
-    }
-
-    // Z direction.
-    div = 1.0f / direction.z;
-    if (div >= 0.0f)
-    {
-        tmin = (min.z - origin.z) * div;
-        tmax = (max.z - origin.z) * div;
-    }
-    else
-    {
-        tmin = (max.z - origin.z) * div;
-        tmax = (min.z - origin.z) * div;
-    }
-
-    // Update the near and far intersection distances.
-    if (tmin > dnear)
-    {
-        dnear = tmin;
-    }
-    if (tmax < dfar)
-    {
-        dfar = tmax;
-    }
-
-    // Check if the ray misses the box.
-    if (dnear > dfar || dfar < 0.0f)
-    {
-        return false;
-    }
-
-    // The ray intersects the box
-    if (distance)
-        *distance = dnear;
-
-    return true;
-}
-
 }
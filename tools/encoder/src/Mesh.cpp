@@ -23,6 +23,122 @@ const char* Mesh::getElementName(void) const
     return "Mesh";
 }
 
+// Converts a float to a 16-bit half float, rounding to nearest.
+static unsigned short toHalfFloat(float value)
+{
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(float));
+    unsigned int sign = (bits >> 16) & 0x8000;
+    unsigned int mantissa = bits & 0x7fffff;
+    int exponent = (int)((bits >> 23) & 0xff);
+
+    // Infinity and NaN
+    if (exponent == 0xff)
+        return (unsigned short)(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+
+    exponent = exponent - 127 + 15;
+    if (exponent >= 31)
+        return (unsigned short)(sign | 0x7c00);
+    if (exponent <= 0)
+    {
+        // Subnormal half float, or zero if too small
+        if (exponent < -10)
+            return (unsigned short)sign;
+        mantissa |= 0x800000;
+        unsigned int shift = 14 - exponent;
+        unsigned int half = mantissa >> shift;
+        if ((mantissa >> (shift - 1)) & 1)
+            ++half;
+        return (unsigned short)(sign | half);
+    }
+
+    // A carry out of the mantissa correctly rounds up into the exponent
+    unsigned int half = sign | (exponent << 10) | (mantissa >> 13);
+    if (mantissa & 0x1000)
+        ++half;
+    return (unsigned short)half;
+}
+
+static float clampValue(float value, float min, float max)
+{
+    return value < min ? min : (value > max ? max : value);
+}
+
+// Gets the values of the given vertex element, padded with zeros to 4 values.
+static void getElementValues(const Vertex& vertex, unsigned int usage, float values[4])
+{
+    values[0] = values[1] = values[2] = values[3] = 0.0f;
+    switch (usage)
+    {
+    case POSITION:
+        memcpy(values, &vertex.position.x, sizeof(float) * 3);
+        break;
+    case NORMAL:
+        memcpy(values, &vertex.normal.x, sizeof(float) * 3);
+        break;
+    case TANGENT:
+        memcpy(values, &vertex.tangent.x, sizeof(float) * 3);
+        break;
+    case BINORMAL:
+        memcpy(values, &vertex.binormal.x, sizeof(float) * 3);
+        break;
+    case COLOR:
+        memcpy(values, &vertex.diffuse.x, sizeof(float) * 4);
+        break;
+    case BLENDWEIGHTS:
+        memcpy(values, &vertex.blendWeights.x, sizeof(float) * 4);
+        break;
+    case BLENDINDICES:
+        memcpy(values, &vertex.blendIndices.x, sizeof(float) * 4);
+        break;
+    default:
+        if (usage >= TEXCOORD0 && usage <= TEXCOORD7)
+            memcpy(values, &vertex.texCoord[usage - TEXCOORD0].x, sizeof(float) * 2);
+        break;
+    }
+}
+
+// Writes the values of a vertex element in the element's type.
+static void writeElementBinary(const VertexElement& element, const float values[4], FILE* file)
+{
+    switch (element.type)
+    {
+    case TYPE_HALF_FLOAT:
+        for (unsigned int i = 0; i < element.size; ++i)
+            write(toHalfFloat(values[i]), file);
+        break;
+    case TYPE_BYTE:
+        for (unsigned int i = 0; i < element.size; ++i)
+            write((char)(element.normalized ? floorf(clampValue(values[i], -1.0f, 1.0f) * 127.0f + 0.5f) : values[i]), file);
+        break;
+    case TYPE_UNSIGNED_BYTE:
+        for (unsigned int i = 0; i < element.size; ++i)
+            write((unsigned char)(element.normalized ? floorf(clampValue(values[i], 0.0f, 1.0f) * 255.0f + 0.5f) : values[i]), file);
+        break;
+    case TYPE_SHORT:
+        for (unsigned int i = 0; i < element.size; ++i)
+            write((unsigned short)(short)(element.normalized ? floorf(clampValue(values[i], -1.0f, 1.0f) * 32767.0f + 0.5f) : values[i]), file);
+        break;
+    case TYPE_UNSIGNED_SHORT:
+        for (unsigned int i = 0; i < element.size; ++i)
+            write((unsigned short)(element.normalized ? floorf(clampValue(values[i], 0.0f, 1.0f) * 65535.0f + 0.5f) : values[i]), file);
+        break;
+    case TYPE_INT_2_10_10_10:
+        {
+            // Signed values packed as (w << 30) | (z << 20) | (y << 10) | x
+            unsigned int packed = 0;
+            for (unsigned int i = 0; i < 3; ++i)
+                packed |= ((unsigned int)(int)floorf(clampValue(values[i], -1.0f, 1.0f) * 511.0f + 0.5f) & 0x3ff) << (i * 10);
+            packed |= ((unsigned int)(int)floorf(clampValue(values[3], -1.0f, 1.0f) + 0.5f) & 0x3) << 30;
+            write(packed, file);
+        }
+        break;
+    default:
+        write(values, element.size, file);
+        break;
+    }
+}
+
 void Mesh::writeBinary(FILE* file)
 {
     Object::writeBinary(file);
@@ -40,7 +156,23 @@ void Mesh::writeBinary(FILE* file)
 
 void Mesh::writeBinaryVertices(FILE* file)
 {
-    if (vertices.size() > 0)
+    if (vertices.size() > 0 && isQuantized())
+    {
+        // Write the number of bytes for the vertex data
+        write((unsigned int)(vertices.size() * getVertexByteSize()), file);
+
+        // Write each vertex element in its own type
+        float values[4];
+        for (std::vector<Vertex>::const_iterator i = vertices.begin(); i != vertices.end(); ++i)
+        {
+            for (std::vector<VertexElement>::const_iterator j = _vertexFormat.begin(); j != _vertexFormat.end(); ++j)
+            {
+                getElementValues(*i, j->usage, values);
+                writeElementBinary(*j, values, file);
+            }
+        }
+    }
+    else if (vertices.size() > 0)
     {
         // Assumes that all vertices are the same size.
         // Write the number of bytes for the vertex data
@@ -146,6 +278,76 @@ const VertexElement& Mesh::getVertexElement(unsigned int index) const
     return _vertexFormat[index];
 }
 
+unsigned int Mesh::getVertexByteSize() const
+{
+    unsigned int size = 0;
+    for (std::vector<VertexElement>::const_iterator i = _vertexFormat.begin(); i != _vertexFormat.end(); ++i)
+        size += i->byteSize();
+    return size;
+}
+
+bool Mesh::isQuantized() const
+{
+    for (std::vector<VertexElement>::const_iterator i = _vertexFormat.begin(); i != _vertexFormat.end(); ++i)
+    {
+        if (i->type != TYPE_FLOAT)
+            return true;
+    }
+    return false;
+}
+
+void Mesh::quantize(bool highPrecision)
+{
+    unsigned int oldSize = getVertexByteSize();
+
+    // Blend indices fit in bytes unless the skin has more than 256 joints
+    float maxBlendIndex = 0.0f;
+    for (std::vector<Vertex>::const_iterator i = vertices.begin(); i != vertices.end(); ++i)
+    {
+        maxBlendIndex = std::max(maxBlendIndex, std::max(std::max(i->blendIndices.x, i->blendIndices.y), std::max(i->blendIndices.z, i->blendIndices.w)));
+    }
+
+    for (std::vector<VertexElement>::iterator i = _vertexFormat.begin(); i != _vertexFormat.end(); ++i)
+    {
+        VertexElement& element = *i;
+        switch (element.usage)
+        {
+        case NORMAL:
+        case TANGENT:
+        case BINORMAL:
+            // Padded to 4 values to keep the vertex 4-byte aligned
+            element.size = 4;
+            element.type = highPrecision ? TYPE_SHORT : TYPE_INT_2_10_10_10;
+            element.normalized = true;
+            break;
+        case COLOR:
+        case BLENDWEIGHTS:
+            element.type = highPrecision ? TYPE_UNSIGNED_SHORT : TYPE_UNSIGNED_BYTE;
+            element.normalized = true;
+            break;
+        case BLENDINDICES:
+            element.type = maxBlendIndex < 256.0f ? TYPE_UNSIGNED_BYTE : TYPE_UNSIGNED_SHORT;
+            element.normalized = false;
+            break;
+        default:
+            // Half float texture coordinates lose sub-texel precision on large textures,
+            // so they are only used at low precision.
+            if (!highPrecision && element.usage >= TEXCOORD0 && element.usage <= TEXCOORD7)
+            {
+                element.type = TYPE_HALF_FLOAT;
+                element.normalized = false;
+            }
+            break;
+        }
+    }
+
+    unsigned int newSize = getVertexByteSize();
+    unsigned int vertexCount = vertices.size();
+    LOG(1, "Quantized mesh '%s': %u -> %u bytes per vertex, %u -> %u bytes for %u vertices (%.1f%% saved).\n",
+        getId().c_str(), oldSize, newSize, oldSize * vertexCount, newSize * vertexCount, vertexCount,
+        oldSize > 0 ? 100.0f * (oldSize - newSize) / oldSize : 0.0f);
+}
+
 bool Mesh::contains(const Vertex& vertex) const
 {
     return vertexLookupTable.count(vertex) > 0;
@@ -161,7 +363,7 @@ unsigned int Mesh::addVertex(const Vertex& vertex)
 
 unsigned int Mesh::getVertexIndex(const Vertex& vertex)
 {
-    std::map<Vertex,unsigned int>::iterator it;
+    std::unordered_map<Vertex, unsigned int, VertexHash>::iterator it;
     it = vertexLookupTable.find(vertex);
     return it->second;
 }
@@ -230,4 +432,825 @@ void Mesh::computeBounds()
     bounds.radius = sqrt(bounds.radius);
 }
 
+// Size of the simulated post-transform vertex cache used when ordering triangles
+#define VERTEX_CACHE_SIZE 32
+
+// Size of the FIFO cache used to measure the average cache miss ratio (ACMR)
+#define VERTEX_CACHE_FIFO_SIZE 16
+
+// Maximum relative ACMR increase accepted when reordering triangles to reduce overdraw
+#define OVERDRAW_ACMR_THRESHOLD 1.05f
+
+// Returns the number of cache misses when drawing a triangle with a FIFO cache, where
+// timestamps holds the time each vertex last entered the cache.
+static unsigned int simulateFifoCache(const unsigned int* triangle, std::vector<unsigned int>& timestamps, unsigned int* time)
+{
+    unsigned int misses = 0;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        unsigned int vertex = triangle[i];
+        if (*time - timestamps[vertex] > VERTEX_CACHE_FIFO_SIZE)
+        {
+            timestamps[vertex] = (*time)++;
+            ++misses;
+        }
+    }
+    return misses;
+}
+
+// Computes the average number of vertex cache misses per triangle.
+static float computeACMR(const std::vector<unsigned int>& indices, unsigned int vertexCount)
+{
+    unsigned int triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return 0.0f;
+
+    std::vector<unsigned int> timestamps(vertexCount, 0);
+    unsigned int time = VERTEX_CACHE_FIFO_SIZE + 1;
+    unsigned int misses = 0;
+    for (unsigned int i = 0; i < triangleCount; ++i)
+        misses += simulateFifoCache(&indices[i * 3], timestamps, &time);
+    return (float)misses / triangleCount;
+}
+
+// Scores a vertex by its position in the cache and the number of triangles still using it.
+static float computeVertexScore(int cachePosition, unsigned int remainingTriangles)
+{
+    if (remainingTriangles == 0)
+        return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0)
+    {
+        // Vertices of the last triangle get a fixed score so that the next triangle does
+        // not simply reuse them in a strip-like fashion.
+        if (cachePosition < 3)
+            score = 0.75f;
+        else
+            score = powf(1.0f - (cachePosition - 3) * (1.0f / (VERTEX_CACHE_SIZE - 3)), 1.5f);
+    }
+
+    // Boost vertices with few remaining triangles so that they are finished off quickly
+    score += 2.0f * powf((float)remainingTriangles, -0.5f);
+    return score;
+}
+
+// Reorders triangles for post-transform vertex cache locality (Tom Forsyth's linear-speed
+// vertex cache optimization).
+static void optimizeVertexCache(std::vector<unsigned int>& indices, unsigned int vertexCount)
+{
+    unsigned int triangleCount = indices.size() / 3;
+    if (triangleCount < 2)
+        return;
+
+    // Build the list of triangles that use each vertex
+    std::vector<unsigned int> remaining(vertexCount, 0);
+    for (unsigned int i = 0, count = triangleCount * 3; i < count; ++i)
+        ++remaining[indices[i]];
+    std::vector<unsigned int> offsets(vertexCount + 1, 0);
+    for (unsigned int i = 0; i < vertexCount; ++i)
+        offsets[i + 1] = offsets[i] + remaining[i];
+    std::vector<unsigned int> adjacency(triangleCount * 3);
+    std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+    for (unsigned int i = 0, count = triangleCount * 3; i < count; ++i)
+        adjacency[fill[indices[i]]++] = i / 3;
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (unsigned int i = 0; i < vertexCount; ++i)
+        vertexScore[i] = computeVertexScore(-1, remaining[i]);
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    int best = -1;
+    float bestScore = -FLT_MAX;
+    for (unsigned int i = 0; i < triangleCount; ++i)
+    {
+        const unsigned int* triangle = &indices[i * 3];
+        triangleScore[i] = vertexScore[triangle[0]] + vertexScore[triangle[1]] + vertexScore[triangle[2]];
+        if (triangleScore[i] > bestScore)
+        {
+            best = i;
+            bestScore = triangleScore[i];
+        }
+    }
+
+    std::vector<unsigned int> result;
+    result.reserve(triangleCount * 3);
+    unsigned int cache[VERTEX_CACHE_SIZE + 3];
+    unsigned int cacheCount = 0;
+    unsigned int cursor = 0;
+    while (result.size() < triangleCount * 3)
+    {
+        if (best < 0)
+        {
+            // Nothing in the cache has triangles left; continue with the next triangle in input order
+            while (emitted[cursor])
+                ++cursor;
+            best = cursor;
+        }
+
+        emitted[best] = true;
+        const unsigned int* triangle = &indices[best * 3];
+        result.insert(result.end(), triangle, triangle + 3);
+
+        // Move the vertices of the triangle to the front of the cache
+        unsigned int newCache[VERTEX_CACHE_SIZE + 3];
+        unsigned int newCount = 0;
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            if (std::find(newCache, newCache + newCount, triangle[i]) == newCache + newCount)
+                newCache[newCount++] = triangle[i];
+
+            // Remove the triangle from the vertex's list of remaining triangles
+            unsigned int* begin = &adjacency[offsets[triangle[i]]];
+            unsigned int* end = begin + remaining[triangle[i]];
+            unsigned int* it = std::find(begin, end, (unsigned int)best);
+            assert(it != end);
+            *it = *(end - 1);
+            --remaining[triangle[i]];
+        }
+        for (unsigned int i = 0; i < cacheCount; ++i)
+        {
+            if (cache[i] != triangle[0] && cache[i] != triangle[1] && cache[i] != triangle[2])
+                newCache[newCount++] = cache[i];
+        }
+
+        // Update the scores of all vertices that are (or just were) in the cache
+        for (unsigned int i = 0; i < newCount; ++i)
+        {
+            unsigned int vertex = newCache[i];
+            cachePosition[vertex] = i < VERTEX_CACHE_SIZE ? (int)i : -1;
+            vertexScore[vertex] = computeVertexScore(cachePosition[vertex], remaining[vertex]);
+        }
+
+        // Pick the best triangle among those using a cached vertex
+        best = -1;
+        bestScore = -FLT_MAX;
+        for (unsigned int i = 0; i < newCount; ++i)
+        {
+            unsigned int vertex = newCache[i];
+            for (unsigned int j = offsets[vertex], end = offsets[vertex] + remaining[vertex]; j < end; ++j)
+            {
+                unsigned int t = adjacency[j];
+                const unsigned int* other = &indices[t * 3];
+                triangleScore[t] = vertexScore[other[0]] + vertexScore[other[1]] + vertexScore[other[2]];
+                if (triangleScore[t] > bestScore)
+                {
+                    best = t;
+                    bestScore = triangleScore[t];
+                }
+            }
+        }
+
+        cacheCount = std::min(newCount, (unsigned int)VERTEX_CACHE_SIZE);
+        memcpy(cache, newCache, cacheCount * sizeof(unsigned int));
+    }
+
+    indices.swap(result);
+}
+
+// A run of consecutive triangles that is moved as a whole when reducing overdraw
+struct TriangleCluster
+{
+    unsigned int start;
+    unsigned int end;
+    float sortKey;
+
+    bool operator<(const TriangleCluster& c) const
+    {
+        return sortKey > c.sortKey;
+    }
+};
+
+// Reorders clusters of cache-optimized triangles so that triangles facing away from the
+// center of the mesh, which are likely to occlude the rest, are drawn first (Sander et al.,
+// "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw").
+static void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices)
+{
+    unsigned int triangleCount = indices.size() / 3;
+    if (triangleCount < 2)
+        return;
+
+    // Split the triangles into clusters whose cold-cache ACMR stays within the threshold
+    // of the whole part, so that the clusters can be drawn in any order.
+    float maxACMR = computeACMR(indices, vertices.size()) * OVERDRAW_ACMR_THRESHOLD;
+    std::vector<TriangleCluster> clusters;
+    std::vector<unsigned int> timestamps(vertices.size(), 0);
+    unsigned int time = VERTEX_CACHE_FIFO_SIZE + 1;
+    unsigned int misses = 0;
+    TriangleCluster cluster;
+    cluster.start = 0;
+    for (unsigned int i = 0; i < triangleCount; ++i)
+    {
+        misses += simulateFifoCache(&indices[i * 3], timestamps, &time);
+        if (i + 1 == triangleCount || misses <= maxACMR * (i + 1 - cluster.start))
+        {
+            cluster.end = i + 1;
+            clusters.push_back(cluster);
+            cluster.start = i + 1;
+
+            // Start the next cluster with a cold cache
+            time += VERTEX_CACHE_FIFO_SIZE + 1;
+            misses = 0;
+        }
+    }
+    if (clusters.size() < 2)
+        return;
+
+    // Compute the area weighted centroid of the part
+    Vector3 center;
+    float area = 0.0f;
+    for (unsigned int i = 0; i < triangleCount; ++i)
+    {
+        const Vector3& p0 = vertices[indices[i * 3]].position;
+        const Vector3& p1 = vertices[indices[i * 3 + 1]].position;
+        const Vector3& p2 = vertices[indices[i * 3 + 2]].position;
+        Vector3 e1, e2, n;
+        Vector3::subtract(p1, p0, &e1);
+        Vector3::subtract(p2, p0, &e2);
+        Vector3::cross(e1, e2, &n);
+        float a = n.length();
+        center.x += (p0.x + p1.x + p2.x) * a;
+        center.y += (p0.y + p1.y + p2.y) * a;
+        center.z += (p0.z + p1.z + p2.z) * a;
+        area += a;
+    }
+    if (area > 0.0f)
+        center.scale(1.0f / (3.0f * area));
+
+    // Sort the clusters by how far out along their average normal they lie
+    for (unsigned int c = 0, count = clusters.size(); c < count; ++c)
+    {
+        Vector3 clusterCenter;
+        Vector3 clusterNormal;
+        float clusterArea = 0.0f;
+        for (unsigned int i = clusters[c].start; i < clusters[c].end; ++i)
+        {
+            const Vector3& p0 = vertices[indices[i * 3]].position;
+            const Vector3& p1 = vertices[indices[i * 3 + 1]].position;
+            const Vector3& p2 = vertices[indices[i * 3 + 2]].position;
+            Vector3 e1, e2, n;
+            Vector3::subtract(p1, p0, &e1);
+            Vector3::subtract(p2, p0, &e2);
+            Vector3::cross(e1, e2, &n);
+            float a = n.length();
+            clusterCenter.x += (p0.x + p1.x + p2.x) * a;
+            clusterCenter.y += (p0.y + p1.y + p2.y) * a;
+            clusterCenter.z += (p0.z + p1.z + p2.z) * a;
+            clusterNormal.add(n);
+            clusterArea += a;
+        }
+        if (clusterArea > 0.0f)
+            clusterCenter.scale(1.0f / (3.0f * clusterArea));
+        float length = clusterNormal.length();
+        if (length > 0.0f)
+            clusterNormal.scale(1.0f / length);
+
+        Vector3 offset;
+        Vector3::subtract(clusterCenter, center, &offset);
+        clusters[c].sortKey = Vector3::dot(offset, clusterNormal);
+    }
+    std::stable_sort(clusters.begin(), clusters.end());
+
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+    for (unsigned int c = 0, count = clusters.size(); c < count; ++c)
+        result.insert(result.end(), indices.begin() + clusters[c].start * 3, indices.begin() + clusters[c].end * 3);
+    indices.swap(result);
+}
+
+void Mesh::optimize()
+{
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    unsigned int vertexCount = vertices.size();
+    unsigned int triangleCount = 0;
+    float acmrBefore = 0.0f;
+    float acmrAfter = 0.0f;
+
+    for (std::vector<MeshPart*>::iterator i = parts.begin(); i != parts.end(); ++i)
+    {
+        MeshPart* part = *i;
+        if (part->getPrimitiveType() != MeshPart::TRIANGLES)
+            continue;
+
+        std::vector<unsigned int> indices = part->getIndices();
+        unsigned int partTriangles = indices.size() / 3;
+        acmrBefore += computeACMR(indices, vertexCount) * partTriangles;
+
+        optimizeVertexCache(indices, vertexCount);
+        optimizeOverdraw(indices, vertices);
+
+        acmrAfter += computeACMR(indices, vertexCount) * partTriangles;
+        triangleCount += partTriangles;
+        part->setIndices(indices);
+    }
+
+    // Reorder the vertices in the order they are first referenced, keeping any
+    // unreferenced vertices at the end.
+    std::vector<unsigned int> remap(vertexCount, UINT_MAX);
+    unsigned int next = 0;
+    for (std::vector<MeshPart*>::iterator i = parts.begin(); i != parts.end(); ++i)
+    {
+        const std::vector<unsigned int>& indices = (*i)->getIndices();
+        for (std::vector<unsigned int>::const_iterator j = indices.begin(); j != indices.end(); ++j)
+        {
+            if (remap[*j] == UINT_MAX)
+                remap[*j] = next++;
+        }
+    }
+    for (unsigned int i = 0; i < vertexCount; ++i)
+    {
+        if (remap[i] == UINT_MAX)
+            remap[i] = next++;
+    }
+
+    std::vector<Vertex> remappedVertices(vertexCount);
+    vertexLookupTable.clear();
+    for (unsigned int i = 0; i < vertexCount; ++i)
+    {
+        remappedVertices[remap[i]] = vertices[i];
+        vertexLookupTable[vertices[i]] = remap[i];
+    }
+    vertices.swap(remappedVertices);
+
+    for (std::vector<MeshPart*>::iterator i = parts.begin(); i != parts.end(); ++i)
+    {
+        std::vector<unsigned int> indices = (*i)->getIndices();
+        for (std::vector<unsigned int>::iterator j = indices.begin(); j != indices.end(); ++j)
+            *j = remap[*j];
+        (*i)->setIndices(indices);
+    }
+
+    if (triangleCount > 0)
+    {
+        acmrBefore /= triangleCount;
+        acmrAfter /= triangleCount;
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+    LOG(1, "Optimized mesh '%s': %u triangles, %u unique vertices, ACMR %.3f -> %.3f (%.2f ms).\n",
+        getId().c_str(), triangleCount, vertexCount, acmrBefore, acmrAfter, elapsed.count());
+}
+
+// Maximum simplification error, as a fraction of the mesh bounding radius
+#define SIMPLIFY_MAX_ERROR 0.05f
+
+// Weight of the planes that keep open borders from moving inward
+#define SIMPLIFY_BORDER_WEIGHT 10.0f
+
+// Simplified meshes that keep more than this fraction of the triangles are discarded
+#define SIMPLIFY_MIN_REDUCTION 0.9f
+
+// Symmetric 4x4 error quadric of a set of planes, stored as its upper triangle.
+struct SimplifyQuadric
+{
+    double m[10];
+};
+
+static void addPlaneQuadric(SimplifyQuadric& q, const Vector3& normal, const Vector3& point, double weight)
+{
+    double a = normal.x, b = normal.y, c = normal.z;
+    double d = -(a * point.x + b * point.y + c * point.z);
+    q.m[0] += weight * a * a; q.m[1] += weight * a * b; q.m[2] += weight * a * c; q.m[3] += weight * a * d;
+    q.m[4] += weight * b * b; q.m[5] += weight * b * c; q.m[6] += weight * b * d;
+    q.m[7] += weight * c * c; q.m[8] += weight * c * d;
+    q.m[9] += weight * d * d;
+}
+
+static void addQuadric(SimplifyQuadric& q, const SimplifyQuadric& other)
+{
+    for (unsigned int i = 0; i < 10; ++i)
+        q.m[i] += other.m[i];
+}
+
+// Returns the sum of the squared distances of a point to the planes of the quadric.
+static double evaluateQuadric(const SimplifyQuadric& q, const Vector3& p)
+{
+    double x = p.x, y = p.y, z = p.z;
+    double error = q.m[0] * x * x + 2.0 * q.m[1] * x * y + 2.0 * q.m[2] * x * z + 2.0 * q.m[3] * x
+                 + q.m[4] * y * y + 2.0 * q.m[5] * y * z + 2.0 * q.m[6] * y
+                 + q.m[7] * z * z + 2.0 * q.m[8] * z
+                 + q.m[9];
+    return error > 0.0 ? error : 0.0;
+}
+
+static Vector3 computeTriangleNormal(const Vector3& p0, const Vector3& p1, const Vector3& p2)
+{
+    Vector3 e1, e2, normal;
+    Vector3::subtract(p1, p0, &e1);
+    Vector3::subtract(p2, p0, &e2);
+    Vector3::cross(e1, e2, &normal);
+    return normal;
+}
+
+static bool lessPosition(const Vector3& a, const Vector3& b)
+{
+    if (a.x != b.x)
+        return a.x < b.x;
+    if (a.y != b.y)
+        return a.y < b.y;
+    return a.z < b.z;
+}
+
+// A candidate collapse of the position 'from' onto the position 'to'. The versions
+// invalidate the candidate when the quadric of either position changes.
+struct SimplifyCollapse
+{
+    double error;
+    unsigned int from;
+    unsigned int to;
+    unsigned int fromVersion;
+    unsigned int toVersion;
+
+    // Orders the heap with the lowest error first
+    bool operator<(const SimplifyCollapse& other) const
+    {
+        return error > other.error;
+    }
+};
+
+// Half-edge collapse simplification over the welded positions of a mesh. Vertices that
+// share a position but differ in other attributes (texture seams, hard edges) are moved
+// together, each onto the copy of the target position it shares an edge with, so the
+// simplified mesh only ever references vertices of the source mesh.
+struct MeshSimplifier
+{
+    const std::vector<Vertex>& vertices;
+    std::vector<unsigned int> indices;
+    std::vector<unsigned int> trianglePart;
+    std::vector<bool> triangleAlive;
+    std::vector<unsigned int> partTriangleCount;
+    unsigned int triangleCount;
+
+    std::vector<unsigned int> vertexPosition;
+    std::vector<Vector3> positions;
+    std::vector<SimplifyQuadric> quadrics;
+    std::vector<std::vector<unsigned int> > positionTriangles;
+    std::vector<unsigned int> versions;
+    std::vector<bool> alive;
+    std::vector<bool> locked;
+    std::vector<bool> border;
+    std::vector<SimplifyCollapse> heap;
+
+    MeshSimplifier(const std::vector<Vertex>& vertices) : vertices(vertices), triangleCount(0)
+    {
+    }
+
+    unsigned int getPosition(unsigned int triangle, unsigned int corner) const
+    {
+        return vertexPosition[indices[triangle * 3 + corner]];
+    }
+
+    bool containsPosition(unsigned int triangle, unsigned int position) const
+    {
+        return getPosition(triangle, 0) == position || getPosition(triangle, 1) == position || getPosition(triangle, 2) == position;
+    }
+
+    void weldPositions()
+    {
+        unsigned int vertexCount = vertices.size();
+        std::vector<unsigned int> order(vertexCount);
+        for (unsigned int i = 0; i < vertexCount; ++i)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), VertexPositionLess(vertices));
+
+        vertexPosition.resize(vertexCount);
+        for (unsigned int i = 0; i < vertexCount; ++i)
+        {
+            if (i == 0 || lessPosition(vertices[order[i - 1]].position, vertices[order[i]].position))
+                positions.push_back(vertices[order[i]].position);
+            vertexPosition[order[i]] = positions.size() - 1;
+        }
+    }
+
+    struct VertexPositionLess
+    {
+        const std::vector<Vertex>& vertices;
+        VertexPositionLess(const std::vector<Vertex>& vertices) : vertices(vertices) { }
+        bool operator()(unsigned int a, unsigned int b) const
+        {
+            return lessPosition(vertices[a].position, vertices[b].position);
+        }
+    };
+
+    void classifyPositions()
+    {
+        unsigned int positionCount = positions.size();
+        SimplifyQuadric zero;
+        memset(&zero, 0, sizeof(zero));
+        quadrics.assign(positionCount, zero);
+        positionTriangles.resize(positionCount);
+        versions.assign(positionCount, 0);
+        alive.assign(positionCount, true);
+        locked.assign(positionCount, false);
+        border.assign(positionCount, false);
+
+        // Positions shared by several mesh parts keep the part boundaries in place
+        std::vector<unsigned int> positionPart(positionCount, UINT_MAX);
+        for (unsigned int t = 0; t < triangleCount; ++t)
+        {
+            for (unsigned int c = 0; c < 3; ++c)
+            {
+                unsigned int p = getPosition(t, c);
+                if (positionPart[p] == UINT_MAX)
+                    positionPart[p] = trianglePart[t];
+                else if (positionPart[p] != trianglePart[t])
+                    locked[p] = true;
+                positionTriangles[p].push_back(t);
+            }
+        }
+
+        // Count the triangles on each edge to find open borders and non-manifold edges
+        std::map<std::pair<unsigned int, unsigned int>, unsigned int> edges;
+        for (unsigned int t = 0; t < triangleCount; ++t)
+        {
+            for (unsigned int c = 0; c < 3; ++c)
+            {
+                unsigned int a = getPosition(t, c), b = getPosition(t, (c + 1) % 3);
+                ++edges[std::make_pair(std::min(a, b), std::max(a, b))];
+            }
+        }
+
+        for (unsigned int t = 0; t < triangleCount; ++t)
+        {
+            const Vector3& p0 = positions[getPosition(t, 0)];
+            Vector3 normal = computeTriangleNormal(p0, positions[getPosition(t, 1)], positions[getPosition(t, 2)]);
+            if (normal.isZero())
+                continue;
+            normal.normalize();
+            for (unsigned int c = 0; c < 3; ++c)
+                addPlaneQuadric(quadrics[getPosition(t, c)], normal, p0, 1.0);
+
+            for (unsigned int c = 0; c < 3; ++c)
+            {
+                unsigned int a = getPosition(t, c), b = getPosition(t, (c + 1) % 3);
+                unsigned int count = edges[std::make_pair(std::min(a, b), std::max(a, b))];
+                if (count > 2)
+                {
+                    locked[a] = locked[b] = true;
+                }
+                else if (count == 1)
+                {
+                    // A plane through the border edge, perpendicular to the triangle
+                    border[a] = border[b] = true;
+                    Vector3 edge, borderNormal;
+                    Vector3::subtract(positions[b], positions[a], &edge);
+                    Vector3::cross(edge, normal, &borderNormal);
+                    if (!borderNormal.isZero())
+                    {
+                        borderNormal.normalize();
+                        addPlaneQuadric(quadrics[a], borderNormal, positions[a], SIMPLIFY_BORDER_WEIGHT);
+                        addPlaneQuadric(quadrics[b], borderNormal, positions[a], SIMPLIFY_BORDER_WEIGHT);
+                    }
+                }
+            }
+        }
+    }
+
+    void getNeighbors(unsigned int position, std::vector<unsigned int>& neighbors) const
+    {
+        neighbors.clear();
+        const std::vector<unsigned int>& triangles = positionTriangles[position];
+        for (std::vector<unsigned int>::const_iterator i = triangles.begin(); i != triangles.end(); ++i)
+        {
+            if (!triangleAlive[*i])
+                continue;
+            for (unsigned int c = 0; c < 3; ++c)
+            {
+                unsigned int p = getPosition(*i, c);
+                if (p != position)
+                    neighbors.push_back(p);
+            }
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    }
+
+    void pushCollapse(unsigned int from, unsigned int to)
+    {
+        if (locked[from])
+            return;
+        SimplifyCollapse collapse;
+        SimplifyQuadric q = quadrics[from];
+        addQuadric(q, quadrics[to]);
+        collapse.error = evaluateQuadric(q, positions[to]);
+        collapse.from = from;
+        collapse.to = to;
+        collapse.fromVersion = versions[from];
+        collapse.toVersion = versions[to];
+        heap.push_back(collapse);
+        std::push_heap(heap.begin(), heap.end());
+    }
+
+    void pushCollapses(unsigned int position)
+    {
+        std::vector<unsigned int> neighbors;
+        getNeighbors(position, neighbors);
+        for (std::vector<unsigned int>::const_iterator i = neighbors.begin(); i != neighbors.end(); ++i)
+        {
+            pushCollapse(position, *i);
+            pushCollapse(*i, position);
+        }
+    }
+
+    // Checks that collapsing 'from' onto 'to' keeps the mesh manifold, keeps open borders
+    // and texture seams in place and does not flip any triangle, and finds the vertex
+    // each copy of 'from' moves onto.
+    bool canCollapse(unsigned int from, unsigned int to, std::map<unsigned int, unsigned int>& vertexMap) const
+    {
+        vertexMap.clear();
+        const std::vector<unsigned int>& triangles = positionTriangles[from];
+        std::vector<unsigned int> removedPerPart(partTriangleCount.size(), 0);
+        unsigned int sharedCount = 0;
+        for (std::vector<unsigned int>::const_iterator i = triangles.begin(); i != triangles.end(); ++i)
+        {
+            unsigned int t = *i;
+            if (!triangleAlive[t] || !containsPosition(t, to))
+                continue;
+            ++sharedCount;
+            if (++removedPerPart[trianglePart[t]] >= partTriangleCount[trianglePart[t]])
+                return false;
+
+            unsigned int fromVertex = 0, toVertex = 0;
+            for (unsigned int c = 0; c < 3; ++c)
+            {
+                if (getPosition(t, c) == from)
+                    fromVertex = indices[t * 3 + c];
+                else if (getPosition(t, c) == to)
+                    toVertex = indices[t * 3 + c];
+            }
+            std::map<unsigned int, unsigned int>::const_iterator itr = vertexMap.find(fromVertex);
+            if (itr != vertexMap.end() && itr->second != toVertex)
+                return false;
+            vertexMap[fromVertex] = toVertex;
+        }
+        if (sharedCount == 0 || (border[from] && (sharedCount != 1 || !border[to])))
+            return false;
+
+        // Only the triangles on the edge may share both positions' neighbors
+        std::vector<unsigned int> fromNeighbors, toNeighbors, common;
+        getNeighbors(from, fromNeighbors);
+        getNeighbors(to, toNeighbors);
+        std::set_intersection(fromNeighbors.begin(), fromNeighbors.end(), toNeighbors.begin(), toNeighbors.end(), std::back_inserter(common));
+        if (common.size() != sharedCount)
+            return false;
+
+        for (std::vector<unsigned int>::const_iterator i = triangles.begin(); i != triangles.end(); ++i)
+        {
+            unsigned int t = *i;
+            if (!triangleAlive[t] || containsPosition(t, to))
+                continue;
+
+            Vector3 before[3], after[3];
+            for (unsigned int c = 0; c < 3; ++c)
+            {
+                unsigned int p = getPosition(t, c);
+                before[c] = positions[p];
+                after[c] = positions[p == from ? to : p];
+                if (p == from && vertexMap.find(indices[t * 3 + c]) == vertexMap.end())
+                    return false;
+            }
+            Vector3 normalBefore = computeTriangleNormal(before[0], before[1], before[2]);
+            Vector3 normalAfter = computeTriangleNormal(after[0], after[1], after[2]);
+            if (normalBefore.dot(normalAfter) <= 0.0f)
+                return false;
+        }
+        return true;
+    }
+
+    void collapse(unsigned int from, unsigned int to, const std::map<unsigned int, unsigned int>& vertexMap)
+    {
+        std::vector<unsigned int>& triangles = positionTriangles[from];
+        std::vector<unsigned int>& toTriangles = positionTriangles[to];
+        for (std::vector<unsigned int>::const_iterator i = triangles.begin(); i != triangles.end(); ++i)
+        {
+            unsigned int t = *i;
+            if (!triangleAlive[t])
+                continue;
+            if (containsPosition(t, to))
+            {
+                triangleAlive[t] = false;
+                --partTriangleCount[trianglePart[t]];
+                --triangleCount;
+                continue;
+            }
+            for (unsigned int c = 0; c < 3; ++c)
+            {
+                if (getPosition(t, c) == from)
+                    indices[t * 3 + c] = vertexMap.find(indices[t * 3 + c])->second;
+            }
+            toTriangles.push_back(t);
+        }
+        triangles.clear();
+
+        std::vector<unsigned int> remaining;
+        for (std::vector<unsigned int>::const_iterator i = toTriangles.begin(); i != toTriangles.end(); ++i)
+        {
+            if (triangleAlive[*i])
+                remaining.push_back(*i);
+        }
+        toTriangles.swap(remaining);
+
+        addQuadric(quadrics[to], quadrics[from]);
+        alive[from] = false;
+        ++versions[to];
+        pushCollapses(to);
+    }
+
+    void simplify(unsigned int targetCount, double maxError)
+    {
+        for (unsigned int p = 0, count = positions.size(); p < count; ++p)
+        {
+            std::vector<unsigned int> neighbors;
+            getNeighbors(p, neighbors);
+            for (std::vector<unsigned int>::const_iterator i = neighbors.begin(); i != neighbors.end(); ++i)
+                pushCollapse(p, *i);
+        }
+
+        std::map<unsigned int, unsigned int> vertexMap;
+        while (triangleCount > targetCount && !heap.empty())
+        {
+            std::pop_heap(heap.begin(), heap.end());
+            SimplifyCollapse c = heap.back();
+            heap.pop_back();
+            if (c.error > maxError)
+                break;
+            if (!alive[c.from] || !alive[c.to] || c.fromVersion != versions[c.from] || c.toVersion != versions[c.to])
+                continue;
+            if (canCollapse(c.from, c.to, vertexMap))
+                collapse(c.from, c.to, vertexMap);
+        }
+    }
+};
+
+Mesh* Mesh::simplify(float ratio) const
+{
+    if (vertices.empty() || parts.empty())
+        return NULL;
+
+    MeshSimplifier simplifier(vertices);
+    simplifier.partTriangleCount.resize(parts.size(), 0);
+    for (unsigned int i = 0; i < parts.size(); ++i)
+    {
+        // Lines and points have no surface to simplify
+        if (parts[i]->getPrimitiveType() != MeshPart::TRIANGLES)
+            return NULL;
+        const std::vector<unsigned int>& indices = parts[i]->getIndices();
+        unsigned int partTriangles = indices.size() / 3;
+        simplifier.indices.insert(simplifier.indices.end(), indices.begin(), indices.begin() + partTriangles * 3);
+        simplifier.trianglePart.insert(simplifier.trianglePart.end(), partTriangles, i);
+        simplifier.partTriangleCount[i] = partTriangles;
+        simplifier.triangleCount += partTriangles;
+    }
+    unsigned int sourceTriangleCount = simplifier.triangleCount;
+    simplifier.triangleAlive.assign(sourceTriangleCount, true);
+
+    simplifier.weldPositions();
+    simplifier.classifyPositions();
+
+    Vector3 min(FLT_MAX, FLT_MAX, FLT_MAX), max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (std::vector<Vector3>::const_iterator i = simplifier.positions.begin(); i != simplifier.positions.end(); ++i)
+    {
+        min.set(std::min(min.x, i->x), std::min(min.y, i->y), std::min(min.z, i->z));
+        max.set(std::max(max.x, i->x), std::max(max.y, i->y), std::max(max.z, i->z));
+    }
+    double maxError = SIMPLIFY_MAX_ERROR * 0.5f * min.distance(max);
+
+    simplifier.simplify((unsigned int)(sourceTriangleCount * ratio), maxError * maxError);
+    if (simplifier.triangleCount > sourceTriangleCount * SIMPLIFY_MIN_REDUCTION)
+    {
+        LOG(2, "Mesh '%s' could not be simplified below %u of %u triangles.\n", getId().c_str(), simplifier.triangleCount, sourceTriangleCount);
+        return NULL;
+    }
+
+    // Copy the vertices that are still referenced, in the order they are first referenced
+    Mesh* mesh = new Mesh();
+    mesh->_vertexFormat = _vertexFormat;
+    std::vector<unsigned int> remap(vertices.size(), UINT_MAX);
+    for (unsigned int i = 0; i < parts.size(); ++i)
+    {
+        std::vector<unsigned int> indices;
+        for (unsigned int t = 0; t < sourceTriangleCount; ++t)
+        {
+            if (simplifier.trianglePart[t] != i || !simplifier.triangleAlive[t])
+                continue;
+            for (unsigned int c = 0; c < 3; ++c)
+            {
+                unsigned int index = simplifier.indices[t * 3 + c];
+                if (remap[index] == UINT_MAX)
+                    remap[index] = mesh->addVertex(vertices[index]);
+                indices.push_back(remap[index]);
+            }
+        }
+        MeshPart* part = new MeshPart();
+        part->setIndices(indices);
+        mesh->addMeshPart(part);
+    }
+    mesh->computeBounds();
+
+    LOG(1, "Simplified mesh '%s': %u -> %u triangles, %u -> %u vertices.\n",
+        getId().c_str(), sourceTriangleCount, simplifier.triangleCount, (unsigned int)vertices.size(), (unsigned int)mesh->vertices.size());
+    return mesh;
+}
+
 }
@@ -45,6 +45,26 @@ public:
     size_t getVertexCount() const;
     const Vertex& getVertex(unsigned int index) const;
 
+    /**
+     * Returns the size of a vertex in bytes, as written to the binary file.
+     */
+    unsigned int getVertexByteSize() const;
+
+    /**
+     * Returns true if any vertex element is stored in a type other than float.
+     */
+    bool isQuantized() const;
+
+    /**
+     * Stores normals, tangents, binormals, colors, blend data and (at low precision)
+     * texture coordinates in compact vertex element types. Positions stay as floats.
+     *
+     * @param highPrecision Use 16-bit normals and colors and keep float texture
+     *                      coordinates, instead of 10-10-10-2 normals, 8-bit colors
+     *                      and half float texture coordinates.
+     */
+    void quantize(bool highPrecision);
+
     size_t getVertexElementCount() const;
     const VertexElement& getVertexElement(unsigned int index) const;
 
@@ -65,11 +85,31 @@ public:
 
     void computeBounds();
 
+    /**
+     * Reorders the triangles of each mesh part for post-transform vertex cache
+     * locality and reduced overdraw, then reorders the vertices in the order they
+     * are first referenced for vertex fetch locality.
+     */
+    void optimize();
+
+    /**
+     * Creates a simplified copy of this mesh by collapsing the edges that change its
+     * shape the least, measured with quadric error metrics. Texture seams, mesh part
+     * boundaries and open borders are preserved, and the simplified mesh has the same
+     * vertex format and number of mesh parts as this mesh.
+     *
+     * @param ratio The fraction of the triangles to keep.
+     *
+     * @return The new mesh, or NULL if the mesh could not be reduced by at least 10%
+     *         without exceeding the maximum error. The caller owns the new mesh.
+     */
+    Mesh* simplify(float ratio) const;
+
     Model* model;
     std::vector<Vertex> vertices;
     std::vector<MeshPart*> parts;
     BoundingVolume bounds;
-    std::map<Vertex, unsigned int> vertexLookupTable;
+    std::unordered_map<Vertex, unsigned int, VertexHash> vertexLookupTable;
 
 private:
     std::vector<VertexElement> _vertexFormat;
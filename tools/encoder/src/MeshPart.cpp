@@ -76,6 +76,11 @@ unsigned int MeshPart::indexFormatSize() const
     }
 }
 
+unsigned int MeshPart::getPrimitiveType() const
+{
+    return _primitiveType;
+}
+
 MeshPart::IndexFormat MeshPart::getIndexFormat() const
 {
     return _indexFormat;
@@ -86,6 +91,22 @@ unsigned int MeshPart::getIndex(unsigned int i) const
     return _indices[i];
 }
 
+const std::vector<unsigned int>& MeshPart::getIndices() const
+{
+    return _indices;
+}
+
+void MeshPart::setIndices(const std::vector<unsigned int>& indices)
+{
+    _indexFormat = INDEX16;
+    _indices.clear();
+    _indices.reserve(indices.size());
+    for (std::vector<unsigned int>::const_iterator i = indices.begin(); i != indices.end(); ++i)
+    {
+        addIndex(*i);
+    }
+}
+
 void MeshPart::writeBinaryIndex(unsigned int index, FILE* file)
 {
     switch (_indexFormat)
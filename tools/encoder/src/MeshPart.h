@@ -52,6 +52,11 @@ public:
      */
     size_t getIndicesCount() const;
 
+    /**
+     * Returns the primitive type.
+     */
+    unsigned int getPrimitiveType() const;
+
     /**
      * Returns the index format.
      */
@@ -62,6 +67,16 @@ public:
      */
     unsigned int getIndex(unsigned int i) const;
 
+    /**
+     * Returns the list of indices.
+     */
+    const std::vector<unsigned int>& getIndices() const;
+
+    /**
+     * Replaces the list of indices.
+     */
+    void setIndices(const std::vector<unsigned int>& indices);
+
 private:
 
     /**
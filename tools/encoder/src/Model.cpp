@@ -72,6 +72,13 @@ void Model::writeBinary(FILE* file)
             }
         }
     }
+    // Write the level of detail meshes and the screen size each is drawn below
+    write((unsigned int)_lodMeshes.size(), file);
+    for (unsigned int i = 0; i < _lodMeshes.size(); ++i)
+    {
+        _lodMeshes[i]->writeBinaryXref(file);
+        write(_lodScreenSizes[i], file);
+    }
 }
 
 void Model::writeText(FILE* file)
@@ -98,6 +105,13 @@ void Model::writeText(FILE* file)
             fprintfElement(file, "material", mat->getId().c_str());
         }
     }
+    for (unsigned int i = 0; i < _lodMeshes.size(); ++i)
+    {
+        fprintf(file, "<lod>\n");
+        fprintfElement(file, "ref", _lodMeshes[i]->getId());
+        fprintfElement(file, "screenSize", _lodScreenSizes[i]);
+        fprintf(file, "</lod>\n");
+    }
     fprintElementEnd(file);
 }
 
@@ -152,4 +166,16 @@ void Model::setMaterial(Material* material, int partIndex)
     }
 }
 
+void Model::addLod(Mesh* mesh, float screenSize)
+{
+    assert(mesh);
+    _lodMeshes.push_back(mesh);
+    _lodScreenSizes.push_back(screenSize);
+}
+
+unsigned int Model::getLodCount() const
+{
+    return (unsigned int)_lodMeshes.size();
+}
+
 }
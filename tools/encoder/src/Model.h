@@ -34,12 +34,26 @@ public:
     void setSkin(MeshSkin* skin);
     void setMaterial(Material* material, int partIndex = -1);
 
+    /**
+     * Adds a level of detail to this model, after the levels already added.
+     *
+     * @param mesh The simplified mesh of the level. It must have the same number of
+     *             mesh parts as the model's mesh.
+     * @param screenSize The projected diameter of the mesh bounds, as a fraction of the
+     *                   screen height, below which the level is drawn.
+     */
+    void addLod(Mesh* mesh, float screenSize);
+
+    unsigned int getLodCount() const;
+
 private:
 
     Mesh* _mesh;
     MeshSkin* _meshSkin;
     std::vector<Material*> _materials;
     Material* _material;
+    std::vector<Mesh*> _lodMeshes;
+    std::vector<float> _lodScreenSizes;
 };
 
 }
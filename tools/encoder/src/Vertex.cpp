@@ -15,6 +15,31 @@ Vertex::~Vertex(void)
 {
 }
 
+// Combines a float into a hash so that values comparing equal (0.0f and -0.0f) hash the same.
+static inline size_t hashFloat(size_t seed, float value)
+{
+    unsigned int bits = 0;
+    if (value != 0.0f)
+        memcpy(&bits, &value, sizeof(float));
+    return seed ^ (bits + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+size_t Vertex::hash() const
+{
+    // Only the attributes that usually differ between vertices are hashed,
+    // the remaining ones are compared by operator== on collision.
+    size_t h = 0;
+    h = hashFloat(h, position.x);
+    h = hashFloat(h, position.y);
+    h = hashFloat(h, position.z);
+    h = hashFloat(h, normal.x);
+    h = hashFloat(h, normal.y);
+    h = hashFloat(h, normal.z);
+    h = hashFloat(h, texCoord[0].x);
+    h = hashFloat(h, texCoord[0].y);
+    return h;
+}
+
 unsigned int Vertex::byteSize() const
 {
     unsigned int count = POSITION_COUNT;
@@ -96,6 +96,11 @@ public:
             diffuse==v.diffuse && blendWeights==v.blendWeights && blendIndices==v.blendIndices;
     }
 
+    /**
+     * Returns a hash of this vertex that is consistent with operator==.
+     */
+    size_t hash() const;
+
     /**
      * Returns the size of this vertex in bytes.
      */
@@ -116,6 +121,18 @@ public:
      */
     void normalizeBlendWeight();
 };
+
+/**
+ * Hash functor for using vertices as keys of unordered containers.
+ */
+struct VertexHash
+{
+    size_t operator()(const Vertex& vertex) const
+    {
+        return vertex.hash();
+    }
+};
+
 }
 
 #endif
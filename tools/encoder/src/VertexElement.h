@@ -13,7 +13,7 @@ public:
     /**
      * Constructor.
      */
-    VertexElement(unsigned int t, unsigned int c);
+    VertexElement(unsigned int t, unsigned int c, unsigned int type = TYPE_FLOAT, bool normalized = false);
 
     /**
      * Destructor.
@@ -26,8 +26,17 @@ public:
 
     static const char* usageStr(unsigned int usage);
 
+    static const char* typeStr(unsigned int type);
+
+    /**
+     * Returns the size of this element in bytes.
+     */
+    unsigned int byteSize() const;
+
     unsigned int usage;
     unsigned int size;
+    unsigned int type;
+    bool normalized;
 };
 
 }
@@ -11,6 +11,9 @@ static inline void outputBindingInvocation(ostream& o, const FunctionBinding& b,
 static inline void outputGetParam(ostream& o, const FunctionBinding::Param& p, int i, int indentLevel, bool offsetIndex, int numBindings);
 static inline void outputMatchedBinding(ostream& o, const FunctionBinding& b, unsigned int paramCount, unsigned int indentLevel, int numBindings);
 static inline void outputReturnValue(ostream& o, const FunctionBinding& b, int indentLevel);
+static inline bool isMathValueReturn(const FunctionBinding& b);
+static inline void outputValueReturnBegin(ostream& o, const FunctionBinding& b);
+static inline void outputValueReturnEnd(ostream& o, const FunctionBinding& b);
 static inline std::string getTypeName(const FunctionBinding::Param& param);
 
 FunctionBinding::Param::Param(FunctionBinding::Param::Type type, Kind kind, const string& info) : 
@@ -136,7 +139,10 @@ void FunctionBinding::write(ostream& o, const vector<FunctionBinding>& bindings)
                     o << "        void* returnPtr = (void*)instance->" << bindings[0].name << ";\n";
                 break;
             case FunctionBinding::Param::KIND_VALUE:
-                o << "        void* returnPtr = (void*)new " << bindings[0].returnParam << "(instance->" << bindings[0].name << ");\n";
+                o << "        ";
+                outputValueReturnBegin(o, bindings[0]);
+                o << "instance->" << bindings[0].name;
+                outputValueReturnEnd(o, bindings[0]);
                 break;
             case FunctionBinding::Param::KIND_REFERENCE:
                 o << "        void* returnPtr = (void*)&(instance->" << bindings[0].name << ");\n";
@@ -214,10 +220,12 @@ void FunctionBinding::write(ostream& o, const vector<FunctionBinding>& bindings)
                 o << bindings[0].name << ");\n";
                 break;
             case FunctionBinding::Param::KIND_VALUE:
-                o << "        void* returnPtr = (void*)new " << bindings[0].returnParam << "(";
+                o << "        ";
+                outputValueReturnBegin(o, bindings[0]);
                 if (bindings[0].classname.size() > 0)
                     o << bindings[0].classname << "::";
-                o << bindings[0].name << ");\n";
+                o << bindings[0].name;
+                outputValueReturnEnd(o, bindings[0]);
                 break;
             case FunctionBinding::Param::KIND_REFERENCE:
                 o << "        void* returnPtr = (void*)&(";
@@ -264,7 +272,10 @@ void FunctionBinding::write(ostream& o, const vector<FunctionBinding>& bindings)
                     o << "    void* returnPtr = (void*)instance->" << bindings[0].name << ";\n";
                 break;
             case FunctionBinding::Param::KIND_VALUE:
-                o << "    void* returnPtr = (void*)new " << bindings[0].returnParam << "(instance->" << bindings[0].name << ");\n";
+                o << "    ";
+                outputValueReturnBegin(o, bindings[0]);
+                o << "instance->" << bindings[0].name;
+                outputValueReturnEnd(o, bindings[0]);
                 break;
             case FunctionBinding::Param::KIND_REFERENCE:
                 o << "    void* returnPtr = (void*)&(instance->" << bindings[0].name << ");\n";
@@ -308,10 +319,12 @@ void FunctionBinding::write(ostream& o, const vector<FunctionBinding>& bindings)
                 o << bindings[0].name << ");\n";
                 break;
             case FunctionBinding::Param::KIND_VALUE:
-                o << "    void* returnPtr = (void*)new " << bindings[0].returnParam << "(";
+                o << "    ";
+                outputValueReturnBegin(o, bindings[0]);
                 if (bindings[0].classname.size() > 0)
                     o << bindings[0].classname << "::";
-                o << bindings[0].name << ");\n";
+                o << bindings[0].name;
+                outputValueReturnEnd(o, bindings[0]);
                 break;
             case FunctionBinding::Param::KIND_REFERENCE:
                 o << "    void* returnPtr = (void*)&(";
@@ -587,6 +600,55 @@ static inline void indent(ostream& o, int indentLevel)
         o << "    ";
 }
 
+static inline bool isMathValueReturn(const FunctionBinding& b)
+{
+    // The math types are small and trivially copyable, so values of these types are
+    // stored directly inside the Lua userdata instead of in a separate heap allocation.
+    if (b.returnParam.type == FunctionBinding::Param::TYPE_CONSTRUCTOR ||
+        (b.returnParam.type == FunctionBinding::Param::TYPE_OBJECT && b.returnParam.kind == FunctionBinding::Param::KIND_VALUE))
+    {
+        string name = Generator::getInstance()->getUniqueNameFromRef(b.returnParam.info);
+        return name == "Vector2" || name == "Vector3" || name == "Vector4" || name == "Quaternion" || name == "Matrix";
+    }
+    return false;
+}
+
+static inline void outputValueReturnBegin(ostream& o, const FunctionBinding& b)
+{
+    // Math values are copied into the Lua userdata itself; other objects are copied to the heap.
+    if (isMathValueReturn(b))
+    {
+        string type = b.returnParam.type == FunctionBinding::Param::TYPE_CONSTRUCTOR ?
+            Generator::getInstance()->getIdentifier(b.returnParam.info) : getTypeName(b.returnParam);
+        o << "gameplay::ScriptUtil::pushValue<" << type << ">(state, ";
+    }
+    else
+    {
+        o << "void* returnPtr = (void*)new " << b.returnParam << "(";
+    }
+}
+
+static inline void outputValueReturnEnd(ostream& o, const FunctionBinding& b)
+{
+    if (isMathValueReturn(b))
+        o << ", \"" << Generator::getInstance()->getUniqueNameFromRef(b.returnParam.info) << "\");\n";
+    else
+        o << ");\n";
+}
+
+static inline void outputArguments(ostream& o, const FunctionBinding& b, unsigned int paramCount, bool isNonStatic)
+{
+    for (unsigned int i = 0, count = paramCount - ((isNonStatic) ? 1 : 0); i < count; i++)
+    {
+        if (b.paramTypes[i].type == FunctionBinding::Param::TYPE_OBJECT && b.paramTypes[i].kind != FunctionBinding::Param::KIND_POINTER)
+            o << "*";
+        o << "param" << i + 1;
+
+        if (i != count - 1)
+            o << ", ";
+    }
+}
+
 static inline void outputBindingInvocation(ostream& o, const FunctionBinding& b, unsigned int paramCount, unsigned int indentLevel, int numBindings)
 {
     bool isNonStatic = (b.type == FunctionBinding::MEMBER_FUNCTION && b.returnParam.type != FunctionBinding::Param::TYPE_CONSTRUCTOR);
@@ -633,6 +695,23 @@ static inline void outputBindingInvocation(ostream& o, const FunctionBinding& b,
         indent(o, indentLevel);
         o << "}\n";
     }
+    else if (isMathValueReturn(b))
+    {
+        // Math values are pushed by value (see outputValueReturnBegin).
+        indent(o, indentLevel);
+        outputValueReturnBegin(o, b);
+        if (b.returnParam.type == FunctionBinding::Param::TYPE_CONSTRUCTOR)
+            o << Generator::getInstance()->getIdentifier(b.returnParam.info) << "(";
+        else if (b.type == FunctionBinding::STATIC_FUNCTION)
+            o << b.classname << "::" << b.name << "(";
+        else if (b.type == FunctionBinding::GLOBAL_FUNCTION)
+            o << b.name << "(";
+        else
+            o << "instance->" << b.name << "(";
+        outputArguments(o, b, paramCount, isNonStatic);
+        o << ")";
+        outputValueReturnEnd(o, b);
+    }
     else
     {
         // Create a variable to hold the return type (if appropriate).
@@ -697,15 +776,7 @@ static inline void outputBindingInvocation(ostream& o, const FunctionBinding& b,
         }
 
         // Pass the arguments.
-        for (unsigned int i = 0, count = paramCount - ((isNonStatic) ? 1 : 0); i < count; i++)
-        {
-            if (b.paramTypes[i].type == FunctionBinding::Param::TYPE_OBJECT && b.paramTypes[i].kind != FunctionBinding::Param::KIND_POINTER)
-                o << "*";
-            o << "param" << i + 1;
-
-            if (i != count - 1)
-                o << ", ";
-        }
+        outputArguments(o, b, paramCount, isNonStatic);
 
         // Add the closing brace from the casting, if neccessary
         if (needsExtraClosingBrace)
@@ -1007,6 +1078,10 @@ static inline void outputReturnValue(ostream& o, const FunctionBinding& b, int i
         break;
     case FunctionBinding::Param::TYPE_OBJECT:
     case FunctionBinding::Param::TYPE_CONSTRUCTOR:
+        // Math values have already been pushed.
+        if (isMathValueReturn(b))
+            break;
+
         o << "if (returnPtr)\n";
         indent(o, indentLevel);
         o << "{\n";